@@ -0,0 +1,100 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_BENCHMARKS_BENCHMARK_CONTEXT_HPP
+#define LOGI_BENCHMARKS_BENCHMARK_CONTEXT_HPP
+
+#include <array>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+#include "logi/logi.hpp"
+
+namespace benchmark {
+
+/**
+ * @brief Headless Vulkan context shared by the benchmarks that require a device. Selects the first physical device and
+ *        creates a logical device with a single queue from the first graphics capable queue family.
+ */
+struct Context {
+  explicit Context(const std::vector<const char*>& deviceExtensions = {}, const void* deviceCreateNext = nullptr) {
+    vk::ApplicationInfo appInfo;
+    appInfo.pApplicationName = "LogiBenchmark";
+    appInfo.pEngineName = "Logi";
+    appInfo.apiVersion = VK_API_VERSION_1_2;
+
+    vk::InstanceCreateInfo instanceCI;
+    instanceCI.pApplicationInfo = &appInfo;
+    instance = logi::createInstance(instanceCI);
+
+    std::vector<logi::PhysicalDevice> devices = instance.enumeratePhysicalDevices();
+    if (devices.empty()) {
+      throw std::runtime_error("No Vulkan capable device found.");
+    }
+    physicalDevice = devices.front();
+
+    std::vector<vk::QueueFamilyProperties> familyProperties = physicalDevice.getQueueFamilyProperties();
+    for (uint32_t i = 0; i < familyProperties.size(); i++) {
+      if (familyProperties[i].queueFlags & vk::QueueFlagBits::eGraphics) {
+        queueFamilyIndex = i;
+        break;
+      }
+    }
+
+    static const std::array<float, 1> kPriorities = {1.0f};
+    vk::DeviceQueueCreateInfo queueCI(vk::DeviceQueueCreateFlags(), queueFamilyIndex, 1u, kPriorities.data());
+
+    vk::DeviceCreateInfo deviceCI;
+    deviceCI.pNext = deviceCreateNext;
+    deviceCI.queueCreateInfoCount = 1u;
+    deviceCI.pQueueCreateInfos = &queueCI;
+    deviceCI.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
+    deviceCI.ppEnabledExtensionNames = deviceExtensions.data();
+    device = physicalDevice.createLogicalDevice(deviceCI);
+
+    for (const logi::QueueFamily& family : device.enumerateQueueFamilies()) {
+      if (static_cast<uint32_t>(family) == queueFamilyIndex) {
+        queueFamily = family;
+      }
+    }
+    queue = queueFamily.getQueue(0u);
+  }
+
+  ~Context() {
+    instance.destroy();
+  }
+
+  logi::VulkanInstance instance;
+  logi::PhysicalDevice physicalDevice;
+  logi::LogicalDevice device;
+  logi::QueueFamily queueFamily;
+  logi::Queue queue;
+  uint32_t queueFamilyIndex = 0u;
+};
+
+template <typename Function>
+double measureMs(Function&& function) {
+  auto start = std::chrono::high_resolution_clock::now();
+  function();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // namespace benchmark
+
+#endif // LOGI_BENCHMARKS_BENCHMARK_CONTEXT_HPP
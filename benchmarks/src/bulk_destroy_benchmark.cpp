@@ -0,0 +1,69 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares per-object teardown (MemoryAllocator::destroyBuffer) with the bulk path (MemoryAllocator::destroyBuffers)
+// for a large number of small VMA buffers.
+
+#include <cstdio>
+#include <vector>
+#include "benchmark_context.hpp"
+
+namespace {
+
+constexpr size_t kBufferCount = 100000u;
+
+std::vector<logi::VMABuffer> createBuffers(logi::MemoryAllocator& allocator) {
+  vk::BufferCreateInfo bufferCI;
+  bufferCI.size = 256u;
+  bufferCI.usage = vk::BufferUsageFlagBits::eUniformBuffer;
+  bufferCI.sharingMode = vk::SharingMode::eExclusive;
+
+  VmaAllocationCreateInfo allocationCI = {};
+  allocationCI.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+
+  std::vector<logi::VMABuffer> buffers;
+  buffers.reserve(kBufferCount);
+  for (size_t i = 0u; i < kBufferCount; i++) {
+    buffers.emplace_back(allocator.createBuffer(bufferCI, allocationCI));
+  }
+
+  return buffers;
+}
+
+} // namespace
+
+int main() {
+  benchmark::Context context;
+  logi::MemoryAllocator allocator = context.device.createMemoryAllocator();
+
+  std::vector<logi::VMABuffer> buffers = createBuffers(allocator);
+  double individual = benchmark::measureMs([&]() {
+    for (const logi::VMABuffer& buffer : buffers) {
+      allocator.destroyBuffer(buffer);
+    }
+  });
+
+  buffers = createBuffers(allocator);
+  double bulk = benchmark::measureMs([&]() { allocator.destroyBuffers(buffers); });
+
+  std::printf("%zu buffers\n", kBufferCount);
+  std::printf("%-16s %9.2f ms\n", "destroyBuffer", individual);
+  std::printf("%-16s %9.2f ms\n", "destroyBuffers", bulk);
+
+  return 0;
+}
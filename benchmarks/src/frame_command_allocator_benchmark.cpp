@@ -0,0 +1,73 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares allocating and freeing command buffers individually every frame with the per-frame transient pool ring of
+// FrameCommandAllocator, which recycles each frame's command buffers with a single vkResetCommandPool.
+
+#include <cstdio>
+#include <vector>
+#include "benchmark_context.hpp"
+
+namespace {
+
+constexpr uint32_t kFramesInFlight = 3u;
+constexpr size_t kFrameCount = 1000u;
+constexpr size_t kCommandBuffersPerFrame = 64u;
+
+void record(const logi::CommandBuffer& commandBuffer) {
+  commandBuffer.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+  commandBuffer.end();
+}
+
+} // namespace
+
+int main() {
+  benchmark::Context context;
+
+  logi::CommandPool commandPool = context.queueFamily.createCommandPool(vk::CommandPoolCreateFlagBits::eTransient);
+  double individual = benchmark::measureMs([&]() {
+    for (size_t frame = 0u; frame < kFrameCount; frame++) {
+      std::vector<logi::CommandBuffer> commandBuffers;
+      commandBuffers.reserve(kCommandBuffersPerFrame);
+      for (size_t i = 0u; i < kCommandBuffersPerFrame; i++) {
+        commandBuffers.emplace_back(commandPool.allocateCommandBuffer(vk::CommandBufferLevel::ePrimary));
+        record(commandBuffers.back());
+      }
+      commandPool.freeCommandBuffers(commandBuffers);
+    }
+  });
+  commandPool.destroy();
+
+  logi::FrameCommandAllocator frameCommands(context.queueFamily, kFramesInFlight);
+  double ring = benchmark::measureMs([&]() {
+    for (size_t frame = 0u; frame < kFrameCount; frame++) {
+      frameCommands.beginFrame();
+      for (size_t i = 0u; i < kCommandBuffersPerFrame; i++) {
+        record(frameCommands.allocateCommandBuffer());
+      }
+    }
+  });
+  size_t commandBufferCount = frameCommands.getCommandBufferCount();
+  frameCommands.destroy();
+
+  std::printf("%zu frames, %zu command buffers per frame\n", kFrameCount, kCommandBuffersPerFrame);
+  std::printf("%-22s %9.2f ms\n", "allocate/free", individual);
+  std::printf("%-22s %9.2f ms (%zu command buffers)\n", "FrameCommandAllocator", ring, commandBufferCount);
+
+  return 0;
+}
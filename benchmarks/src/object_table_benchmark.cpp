@@ -0,0 +1,147 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares the generational slot map used by VulkanObjectComposite with the previously used
+// std::unordered_map<size_t, std::shared_ptr<T>> for create / lookup / destroy churn.
+
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "benchmark_context.hpp"
+#include "logi/base/slot_map.hpp"
+
+namespace {
+
+struct Object {
+  explicit Object(size_t id) : id(id) {}
+
+  size_t id;
+  uint64_t payload[4] = {};
+};
+
+constexpr size_t kObjectCount = 100000u;
+constexpr size_t kLookupCount = 1000000u;
+constexpr size_t kChurnRounds = 10u;
+
+struct Result {
+  double create;
+  double lookup;
+  double destroy;
+  double iterate;
+  size_t checksum;
+};
+
+Result benchmarkUnorderedMap(const std::vector<size_t>& lookupOrder) {
+  Result result {};
+  std::unordered_map<size_t, std::shared_ptr<Object>> objects;
+  std::vector<size_t> ids;
+  ids.reserve(kObjectCount);
+  size_t nextId = 0u;
+
+  for (size_t round = 0u; round < kChurnRounds; round++) {
+    result.create += benchmark::measureMs([&]() {
+      for (size_t i = 0u; i < kObjectCount; i++) {
+        auto object = std::make_shared<Object>(nextId++);
+        ids.emplace_back(object->id);
+        objects.emplace(object->id, std::move(object));
+      }
+    });
+
+    result.lookup += benchmark::measureMs([&]() {
+      for (size_t i = 0u; i < kLookupCount; i++) {
+        result.checksum += objects.at(ids[lookupOrder[i]])->id;
+      }
+    });
+
+    result.iterate += benchmark::measureMs([&]() {
+      for (const auto& entry : objects) {
+        result.checksum += entry.second->payload[0];
+      }
+    });
+
+    result.destroy += benchmark::measureMs([&]() {
+      for (size_t id : ids) {
+        objects.erase(id);
+      }
+    });
+    ids.clear();
+  }
+
+  return result;
+}
+
+Result benchmarkSlotMap(const std::vector<size_t>& lookupOrder) {
+  Result result {};
+  logi::SlotMap<std::shared_ptr<Object>> objects;
+  std::vector<size_t> ids;
+  ids.reserve(kObjectCount);
+
+  for (size_t round = 0u; round < kChurnRounds; round++) {
+    result.create += benchmark::measureMs([&]() {
+      for (size_t i = 0u; i < kObjectCount; i++) {
+        auto object = std::make_shared<Object>(0u);
+        Object* raw = object.get();
+        raw->id = objects.insert(std::move(object));
+        ids.emplace_back(raw->id);
+      }
+    });
+
+    result.lookup += benchmark::measureMs([&]() {
+      for (size_t i = 0u; i < kLookupCount; i++) {
+        result.checksum += (*objects.find(ids[lookupOrder[i]]))->id;
+      }
+    });
+
+    result.iterate += benchmark::measureMs([&]() {
+      objects.forEach([&result](const std::shared_ptr<Object>& object) { result.checksum += object->payload[0]; });
+    });
+
+    result.destroy += benchmark::measureMs([&]() {
+      for (size_t id : ids) {
+        objects.erase(id);
+      }
+    });
+    ids.clear();
+  }
+
+  return result;
+}
+
+void print(const char* name, const Result& result) {
+  std::printf("%-16s create %9.2f ms | lookup %9.2f ms | iterate %9.2f ms | destroy %9.2f ms (checksum %zu)\n", name,
+              result.create, result.lookup, result.iterate, result.destroy, result.checksum);
+}
+
+} // namespace
+
+int main() {
+  std::mt19937_64 random(42u);
+  std::uniform_int_distribution<size_t> distribution(0u, kObjectCount - 1u);
+  std::vector<size_t> lookupOrder(kLookupCount);
+  for (size_t& index : lookupOrder) {
+    index = distribution(random);
+  }
+
+  std::printf("%zu objects, %zu lookups, %zu churn rounds\n", kObjectCount, kLookupCount, kChurnRounds);
+  print("unordered_map", benchmarkUnorderedMap(lookupOrder));
+  print("slot_map", benchmarkSlotMap(lookupOrder));
+
+  return 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures scaling of ParallelCommandRecorder from one thread up to the number of hardware threads. Each draw of the
+// draw list records viewport, scissor and stencil reference state into the inherited render pass. No pipeline is
+// bound, so the measurement stays on the CPU recording side.
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include "benchmark_context.hpp"
+
+namespace {
+
+constexpr size_t kDrawCount = 100000u;
+constexpr uint32_t kRounds = 10u;
+constexpr vk::Extent2D kExtent {256u, 256u};
+constexpr vk::Format kFormat = vk::Format::eR8G8B8A8Unorm;
+
+logi::RenderPass createRenderPass(const logi::LogicalDevice& device) {
+  vk::AttachmentDescription attachment({}, kFormat, vk::SampleCountFlagBits::e1, vk::AttachmentLoadOp::eClear,
+                                       vk::AttachmentStoreOp::eStore, vk::AttachmentLoadOp::eDontCare,
+                                       vk::AttachmentStoreOp::eDontCare, vk::ImageLayout::eUndefined,
+                                       vk::ImageLayout::eColorAttachmentOptimal);
+  vk::AttachmentReference colorReference(0u, vk::ImageLayout::eColorAttachmentOptimal);
+  vk::SubpassDescription subpass({}, vk::PipelineBindPoint::eGraphics, 0u, nullptr, 1u, &colorReference);
+
+  return device.createRenderPass(vk::RenderPassCreateInfo({}, 1u, &attachment, 1u, &subpass));
+}
+
+} // namespace
+
+int main() {
+  benchmark::Context context;
+  logi::MemoryAllocator allocator = context.device.createMemoryAllocator();
+
+  vk::ImageCreateInfo imageCI({}, vk::ImageType::e2D, kFormat, vk::Extent3D(kExtent, 1u), 1u, 1u,
+                              vk::SampleCountFlagBits::e1, vk::ImageTiling::eOptimal,
+                              vk::ImageUsageFlagBits::eColorAttachment);
+  VmaAllocationCreateInfo allocationCI = {};
+  allocationCI.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+  logi::VMAImage image = allocator.createImage(imageCI, allocationCI);
+  logi::ImageView imageView =
+    image.createImageView({}, vk::ImageViewType::e2D, kFormat, vk::ComponentMapping(),
+                          vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0u, 1u, 0u, 1u));
+
+  logi::RenderPass renderPass = createRenderPass(context.device);
+  logi::Framebuffer framebuffer = context.device.createFramebuffer(vk::FramebufferCreateInfo(
+    {}, renderPass, 1u, &static_cast<const vk::ImageView&>(imageView), kExtent.width, kExtent.height, 1u));
+
+  vk::ClearValue clearValue;
+  vk::RenderPassBeginInfo renderPassBegin(renderPass, framebuffer, vk::Rect2D({0, 0}, kExtent), 1u, &clearValue);
+
+  logi::CommandPool commandPool =
+    context.queueFamily.createCommandPool(vk::CommandPoolCreateFlagBits::eResetCommandBuffer);
+  logi::CommandBuffer primaryCommandBuffer = commandPool.allocateCommandBuffer(vk::CommandBufferLevel::ePrimary);
+
+  vk::Viewport viewport(0.0f, 0.0f, static_cast<float>(kExtent.width), static_cast<float>(kExtent.height), 0.0f, 1.0f);
+  vk::Rect2D scissor({0, 0}, kExtent);
+  logi::ParallelCommandRecorder::RecordFunction record = [&](const logi::CommandBuffer& commandBuffer, size_t begin,
+                                                             size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      commandBuffer.setViewport(0u, viewport);
+      commandBuffer.setScissor(0u, scissor);
+      commandBuffer.setStencilReference(vk::StencilFaceFlagBits::eFrontAndBack, static_cast<uint32_t>(i));
+    }
+  };
+
+  uint32_t maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  double singleThreadMs = 0.0;
+  std::printf("%zu draws x %u rounds\n", kDrawCount, kRounds);
+
+  for (uint32_t threadCount = 1u; threadCount <= maxThreads; threadCount++) {
+    logi::ParallelCommandRecorder recorder(context.queueFamily, threadCount);
+    double totalMs = 0.0;
+
+    for (uint32_t round = 0u; round < kRounds; round++) {
+      recorder.beginFrame();
+      primaryCommandBuffer.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+      totalMs += benchmark::measureMs(
+        [&]() { recorder.recordRenderPass(primaryCommandBuffer, renderPassBegin, kDrawCount, record); });
+      primaryCommandBuffer.end();
+      primaryCommandBuffer.reset();
+    }
+
+    double frameMs = totalMs / kRounds;
+    if (threadCount == 1u) {
+      singleThreadMs = frameMs;
+    }
+    std::printf("%2u threads %9.3f ms/frame (speedup %5.2fx)\n", threadCount, frameMs, singleThreadMs / frameMs);
+    recorder.destroy();
+  }
+
+  commandPool.destroy();
+  framebuffer.destroy();
+  renderPass.destroy();
+  allocator.destroyImage(image);
+
+  return 0;
+}
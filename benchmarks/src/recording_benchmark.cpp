@@ -0,0 +1,107 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures per-command recording overhead of logi::CommandBuffer compared to raw vulkan-hpp calls that use the device
+// vk::DispatchLoaderDynamic, the compact CommandDispatchTable and vk::DispatchLoaderStatic. Build once with
+// LOGI_DISPATCH=dynamic and once with LOGI_DISPATCH=static to compare the two Logi dispatch modes. Recorded commands are dynamic state commands, which
+// are valid outside of a render pass and are cheap on the driver side, so the measurement is dominated by dispatch.
+
+#include <cstdio>
+#include "benchmark_context.hpp"
+
+namespace {
+
+constexpr uint32_t kCommandCount = 300000u;
+constexpr uint32_t kRounds = 10u;
+
+template <typename Record>
+double measureNsPerCommand(const logi::CommandBuffer& commandBuffer, Record&& record) {
+  double totalMs = 0.0;
+
+  for (uint32_t round = 0u; round < kRounds; round++) {
+    commandBuffer.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+    totalMs += benchmark::measureMs(record);
+    commandBuffer.end();
+    commandBuffer.reset();
+  }
+
+  return totalMs * 1.0e6 / (static_cast<double>(kCommandCount) * 3.0 * kRounds);
+}
+
+} // namespace
+
+int main() {
+  benchmark::Context context;
+  logi::CommandPool commandPool =
+    context.queueFamily.createCommandPool(vk::CommandPoolCreateFlagBits::eResetCommandBuffer);
+  logi::CommandBuffer commandBuffer = commandPool.allocateCommandBuffer(vk::CommandBufferLevel::ePrimary);
+
+  const vk::DispatchLoaderDynamic& dispatcher = context.device.getDispatcher();
+  logi::CommandDispatchTable table(dispatcher);
+  auto vkCommandBuffer = static_cast<vk::CommandBuffer>(commandBuffer);
+
+  vk::Viewport viewport(0.0f, 0.0f, 1920.0f, 1080.0f, 0.0f, 1.0f);
+  vk::Rect2D scissor({0, 0}, {1920u, 1080u});
+
+  double rawDynamic = measureNsPerCommand(commandBuffer, [&]() {
+    for (uint32_t i = 0u; i < kCommandCount; i++) {
+      vkCommandBuffer.setViewport(0u, viewport, dispatcher);
+      vkCommandBuffer.setScissor(0u, scissor, dispatcher);
+      vkCommandBuffer.setStencilReference(vk::StencilFaceFlagBits::eFrontAndBack, i, dispatcher);
+    }
+  });
+
+  double rawTable = measureNsPerCommand(commandBuffer, [&]() {
+    for (uint32_t i = 0u; i < kCommandCount; i++) {
+      vkCommandBuffer.setViewport(0u, viewport, table);
+      vkCommandBuffer.setScissor(0u, scissor, table);
+      vkCommandBuffer.setStencilReference(vk::StencilFaceFlagBits::eFrontAndBack, i, table);
+    }
+  });
+
+  vk::DispatchLoaderStatic staticDispatcher;
+  double rawStatic = measureNsPerCommand(commandBuffer, [&]() {
+    for (uint32_t i = 0u; i < kCommandCount; i++) {
+      vkCommandBuffer.setViewport(0u, viewport, staticDispatcher);
+      vkCommandBuffer.setScissor(0u, scissor, staticDispatcher);
+      vkCommandBuffer.setStencilReference(vk::StencilFaceFlagBits::eFrontAndBack, i, staticDispatcher);
+    }
+  });
+
+  double logiRecording = measureNsPerCommand(commandBuffer, [&]() {
+    for (uint32_t i = 0u; i < kCommandCount; i++) {
+      commandBuffer.setViewport(0u, viewport);
+      commandBuffer.setScissor(0u, scissor);
+      commandBuffer.setStencilReference(vk::StencilFaceFlagBits::eFrontAndBack, i);
+    }
+  });
+
+#ifdef LOGI_STATIC_DISPATCH
+  const char* mode = "static";
+#else
+  const char* mode = "dynamic";
+#endif
+
+  std::printf("%u commands x %u rounds, Logi dispatch: %s\n", kCommandCount * 3u, kRounds, mode);
+  std::printf("%-28s %7.2f ns/command\n", "vulkan-hpp (dynamic loader)", rawDynamic);
+  std::printf("%-28s %7.2f ns/command\n", "vulkan-hpp (dispatch table)", rawTable);
+  std::printf("%-28s %7.2f ns/command\n", "vulkan-hpp (static loader)", rawStatic);
+  std::printf("%-28s %7.2f ns/command\n", "logi::CommandBuffer", logiRecording);
+
+  return 0;
+}
@@ -70,6 +70,13 @@ class ExampleBase {
 
   void drawFrame();
 
+  /**
+   * @brief Acquire, record, submit and present a single frame.
+   *
+   * @return vk::Result::eErrorOutOfDateKHR if the swapchain has to be recreated.
+   */
+  vk::Result submitFrame();
+
   virtual void recreateSwapChain(); // Only redefined by imGUI_base
 
   virtual void initialize() = 0;
@@ -108,6 +115,7 @@ class ExampleBase {
   std::vector<logi::Semaphore> imageAvailableSemaphores_;
   std::vector<logi::Semaphore> renderFinishedSemaphores_;
   std::vector<logi::Fence> inFlightFences_;
+  logi::FrameCommandAllocator frameCommands_;
 
   ExampleConfiguration config_;
 
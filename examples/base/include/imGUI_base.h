@@ -32,8 +32,6 @@ class ImGUIBase : public ExampleBase {
 
   void imGUI_createRenderPass();
 
-  void imGUI_createCommandBuffers();
-
   void imGUI_createFrameBuffers();
 
   void recreateSwapChain() override;
@@ -45,8 +43,7 @@ class ImGUIBase : public ExampleBase {
 
   ImGuiIO io_;
 
-  logi::CommandPool imGUI_commandPool_;
-  std::vector<logi::CommandBuffer> imGUI_commandBuffers_;
+  logi::CommandBuffer imGUI_commandBuffer_;
 
   std::vector<logi::Framebuffer> imGUI_framebuffers_;
 
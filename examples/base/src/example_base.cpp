@@ -327,6 +327,9 @@ void ExampleBase::buildSyncObjects() {
     renderFinishedSemaphores_.emplace_back(vulkanState_.defaultLogicalDevice_->createSemaphore(vk::SemaphoreCreateInfo()));
     inFlightFences_.emplace_back(vulkanState_.defaultLogicalDevice_->createFence(vk::FenceCreateInfo(vk::FenceCreateFlagBits::eSignaled)));
   }
+
+  // Transient command buffers that are re-recorded every frame.
+  frameCommands_ = logi::FrameCommandAllocator(vulkanState_.graphicsFamily_, static_cast<uint32_t>(config_.maxFramesInFlight));
 }
 
 void ExampleBase::onViewChanged() {}
@@ -345,15 +348,36 @@ void ExampleBase::recreateSwapChain() {
 }
 
 void ExampleBase::drawFrame() {
+  if (submitFrame() == vk::Result::eErrorOutOfDateKHR) {
+    recreateSwapChain();
+  }
+
+  // Notify if view changed.
+  if (viewChanged) {
+    onViewChanged();
+    viewChanged = false;
+  }
+}
+
+vk::Result ExampleBase::submitFrame() {
+  // With VULKAN_HPP_NO_EXCEPTIONS out of date swapchain is reported through the result of acquire and present.
+#ifndef VULKAN_HPP_NO_EXCEPTIONS
   try {
+#endif
     // Wait if drawing is still in progress.
     inFlightFences_[currentFrame_].wait(std::numeric_limits<uint64_t>::max());
 
     // Acquire next image.
-    const uint32_t imageIndex =
-      swapchain_
-        .acquireNextImageKHR(std::numeric_limits<uint64_t>::max(), imageAvailableSemaphores_[currentFrame_], nullptr)
-        .value;
+    vk::ResultValue<uint32_t> acquireResult = swapchain_.acquireNextImageKHR(
+      std::numeric_limits<uint64_t>::max(), imageAvailableSemaphores_[currentFrame_], nullptr);
+    if (acquireResult.result == vk::Result::eErrorOutOfDateKHR) {
+      return acquireResult.result;
+    }
+    const uint32_t imageIndex = acquireResult.value;
+
+    // Begin the frame only after a successful acquire so every begun frame is also ended. Must precede the fence reset
+    // since beginFrame waits on the fence the frame was last submitted with.
+    frameCommands_.beginFrame();
     inFlightFences_[currentFrame_].reset();
 
     static const vk::PipelineStageFlags wait_stages{vk::PipelineStageFlagBits::eColorAttachmentOutput};
@@ -380,22 +404,20 @@ void ExampleBase::drawFrame() {
     submit_info.pSignalSemaphores = &static_cast<const vk::Semaphore&>(renderFinishedSemaphores_[currentFrame_]);
 
     vulkanState_.defaultGraphicsQueue_->submit({submit_info}, inFlightFences_[currentFrame_]);
+    frameCommands_.endFrame(inFlightFences_[currentFrame_]);
 
     // Present image.
-    vulkanState_.defaultPresentQueue_->presentKHR(
+    vk::Result presentResult = vulkanState_.defaultPresentQueue_->presentKHR(
       vk::PresentInfoKHR(1, &static_cast<const vk::Semaphore&>(renderFinishedSemaphores_[currentFrame_]), 1,
                          &static_cast<const vk::SwapchainKHR&>(swapchain_), &imageIndex));
 
     currentFrame_ = (currentFrame_ + 1) % config_.maxFramesInFlight;
+    return presentResult;
+#ifndef VULKAN_HPP_NO_EXCEPTIONS
   } catch (const vk::OutOfDateKHRError&) {
-    recreateSwapChain();
-  }
-
-  // Notify if view changed.
-  if (viewChanged) {
-    onViewChanged();
-    viewChanged = false;
+    return vk::Result::eErrorOutOfDateKHR;
   }
+#endif
 }
 
 void ExampleBase::mainLoop() {
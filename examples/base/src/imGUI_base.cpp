@@ -19,7 +19,6 @@ void ImGUIBase::imGUI_initOverlay() {
     // Setup Vulkan biniding
     imGUI_createDescriptorPool();
     imGUI_createRenderPass();
-    imGUI_createCommandBuffers();
     imGUI_createFrameBuffers();
 
     ImGui_ImplVulkan_InitInfo init_info = {};
@@ -110,15 +109,6 @@ void ImGUIBase::imGUI_createRenderPass() {
     imGUI_renderPass_ = vulkanState_.defaultLogicalDevice_->createRenderPass(createInfo);
 }
 
-void ImGUIBase::imGUI_createCommandBuffers() {
-    imGUI_commandPool_ = 
-        vulkanState_.graphicsFamily_.createCommandPool(vk::CommandPoolCreateFlagBits::eResetCommandBuffer);
-    
-    imGUI_commandBuffers_ = 
-        imGUI_commandPool_.allocateCommandBuffers(vk::CommandBufferLevel::ePrimary,
-                                                  static_cast<uint32_t>(swapchainImages_.size()));
-}
-
 void ImGUIBase::imGUI_createFrameBuffers() {
     // Destroy previous framebuffers
     for (const auto& framebuffer : imGUI_framebuffers_) {
@@ -157,10 +147,13 @@ void ImGUIBase::recreateSwapChain() {
 // Only needed command buffer is generated
 logi::CommandBuffer* ImGUIBase::imGUI_createOverlay(const uint32_t& i) {
 
+    // Overlay is re-recorded every frame, take a transient command buffer of the current frame.
+    imGUI_commandBuffer_ = frameCommands_.allocateCommandBuffer(vk::CommandBufferLevel::ePrimary);
+
     vk::CommandBufferBeginInfo beginInfo = {};
-    beginInfo.flags = vk::CommandBufferUsageFlagBits::eSimultaneousUse;
+    beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
 
-    imGUI_commandBuffers_[i].begin(beginInfo);
+    imGUI_commandBuffer_.begin(beginInfo);
 
     vk::RenderPassBeginInfo renderPassInfo = {};
     renderPassInfo.renderPass = imGUI_renderPass_;
@@ -172,17 +165,17 @@ logi::CommandBuffer* ImGUIBase::imGUI_createOverlay(const uint32_t& i) {
     renderPassInfo.clearValueCount = 1;
     renderPassInfo.pClearValues = &clearValue;
 
-    imGUI_commandBuffers_[i].beginRenderPass(renderPassInfo, vk::SubpassContents::eInline);
+    imGUI_commandBuffer_.beginRenderPass(renderPassInfo, vk::SubpassContents::eInline);
 
     ImDrawData* drawData = ImGui::GetDrawData();
     // if (drawData->DisplaySize.x <= 0.0f || drawData->DisplaySize.y <= 0.0f) return nullptr; // Minimized window
 
-    ImGui_ImplVulkan_RenderDrawData(drawData, static_cast<vk::CommandBuffer>(imGUI_commandBuffers_[i]));
+    ImGui_ImplVulkan_RenderDrawData(drawData, static_cast<vk::CommandBuffer>(imGUI_commandBuffer_));
     
-    imGUI_commandBuffers_[i].endRenderPass();
-    imGUI_commandBuffers_[i].end();
+    imGUI_commandBuffer_.endRenderPass();
+    imGUI_commandBuffer_.end();
 
-    return &imGUI_commandBuffers_[i];
+    return &imGUI_commandBuffer_;
 }
 
 void ImGUIBase::mainLoop() {
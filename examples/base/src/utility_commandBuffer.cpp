@@ -48,6 +48,9 @@ namespace utility
         if(queueType == Graphics) {utility::submitGraphicsCommand(vulkanState, submitInfo);}
         else if(queueType == Compute) {utility::submitComputeCommand(vulkanState, submitInfo);}
         else {utility::submitPresentCommand(vulkanState, submitInfo);}
+
+        // Submission waits for the queue to become idle, command buffer can be freed.
+        commandBuffer.destroy();
     }
     
     void submitGraphicsCommand(const VulkanState& vulkanState, const vk::SubmitInfo& submitInfo)
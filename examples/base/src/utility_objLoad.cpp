@@ -1,4 +1,5 @@
 #include "utility.h"
+#include <unordered_map>
 
 #define TINYOBJLOADER_IMPLEMENTATION
 #include "tiny_obj_loader.h"
@@ -0,0 +1,83 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_BASE_DEFERRED_DESTRUCTION_QUEUE_HPP
+#define LOGI_BASE_DEFERRED_DESTRUCTION_QUEUE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace logi {
+
+/**
+ * @brief Queue of destruction callbacks that are executed once the GPU has passed the point at which the destroyed
+ *        objects were last used. The point is an arbitrary monotonically increasing value, e.g. a timeline semaphore
+ *        value or a frame index. Callbacks are executed in batches, outside of the internal lock.
+ */
+class DeferredDestructionQueue {
+ public:
+  DeferredDestructionQueue() = default;
+
+  DeferredDestructionQueue(const DeferredDestructionQueue&) = delete;
+
+  DeferredDestructionQueue& operator=(const DeferredDestructionQueue&) = delete;
+
+  /**
+   * @brief Enqueue destruction callback.
+   *
+   * @param retireValue Value after which the callback may be executed.
+   * @param destroy     Destruction callback.
+   */
+  void enqueue(uint64_t retireValue, std::function<void()> destroy);
+
+  /**
+   * @brief   Execute all callbacks whose retire value is less than or equal to the given completed value.
+   *
+   * @param   completedValue  Last value that was completed by the GPU.
+   * @return  Number of executed callbacks.
+   */
+  size_t collect(uint64_t completedValue);
+
+  /**
+   * @brief   Execute all pending callbacks regardless of their retire value.
+   *
+   * @return  Number of executed callbacks.
+   */
+  size_t flush();
+
+  /**
+   * @brief   Number of pending callbacks.
+   */
+  size_t size() const;
+
+ private:
+  /**
+   * @brief Remove callbacks up to the given position. Caller must hold the lock.
+   */
+  std::vector<std::function<void()>> take(std::multimap<uint64_t, std::function<void()>>::iterator end);
+
+  mutable std::mutex mutex_;
+  std::multimap<uint64_t, std::function<void()>> pending_;
+};
+
+} // namespace logi
+
+#endif // LOGI_BASE_DEFERRED_DESTRUCTION_QUEUE_HPP
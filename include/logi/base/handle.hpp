@@ -23,9 +23,23 @@
 
 namespace logi {
 
+template <typename H>
+class HandleRef;
+
+/**
+ * @brief Handle to the Logi object. Owning handles share the ownership of the referred object. Borrowed handles (see
+ *        HandleRef) only refer to the object and can be copied without any atomic reference count operations.
+ *
+ * @tparam  T Type of the referred object.
+ */
 template <typename T>
 class Handle {
+  template <typename H>
+  friend class HandleRef;
+
  public:
+  using element_type = T;
+
   /**
    * @brief Default null handle constructor.
    */
@@ -45,6 +59,13 @@ class Handle {
    */
   size_t id() const;
 
+  /**
+   * @brief     Check if the handle keeps the referred object alive.
+   *
+   * @return    False if the handle is null or borrowed.
+   */
+  bool owning() const;
+
   /**
    * @brief Converts to true if the referred VulkanObject is valid
    */
@@ -77,6 +98,11 @@ size_t Handle<T>::id() const {
   return object_->id();
 }
 
+template <typename T>
+bool Handle<T>::owning() const {
+  return object_.use_count() > 0;
+}
+
 template <typename T>
 Handle<T>::operator bool() const {
   return object_ && object_->valid();
@@ -97,6 +123,84 @@ bool Handle<T>::operator!() const {
   return !object_ || !object_->valid();
 }
 
+/**
+ * @brief Non-owning view of the handle of type H. Creating and copying the view does not touch the reference count of
+ *        the referred object. Views are returned by the non-owning parent accessors of CommandBuffer, Queue, Buffer,
+ *        Image and their views (e.g. CommandBuffer::getLogicalDeviceRef), whose owning variants would otherwise copy a
+ *        handle per call. Recording and submission take Vulkan handles or const references to Logi handles, so they
+ *        need no view overloads. The user must ensure that the referred object outlives the view. Use lock() to obtain
+ *        an owning handle.
+ *
+ * @tparam  H Handle type (e.g. LogicalDevice).
+ */
+template <typename H>
+class HandleRef {
+ public:
+  using element_type = typename H::element_type;
+
+  /**
+   * @brief Default null view constructor.
+   */
+  HandleRef() = default;
+
+  /**
+   * @brief Create view of the given handle.
+   *
+   * @param handle  Viewed handle.
+   */
+  HandleRef(const H& handle) : handle_(borrow(handle.object_.get())) {}
+
+  /**
+   * @brief Create view of the given object.
+   *
+   * @param object  Viewed object.
+   */
+  explicit HandleRef(element_type& object) : handle_(borrow(&object)) {}
+
+  /**
+   * @brief   Retrieve owning handle to the viewed object.
+   *
+   * @return  Owning handle or null handle if the view is null.
+   */
+  H lock() const {
+    element_type* object = handle_.object_.get();
+    return object ? H(std::static_pointer_cast<element_type>(object->shared_from_this())) : H();
+  }
+
+  /**
+   * @brief Call a method of the viewed handle. The handle must not be copied out of the view, since the copy would not
+   *        own the object either (see Handle::owning) and could outlive it. Use lock() to obtain an owning copy.
+   */
+  const H* operator->() const {
+    return &handle_;
+  }
+
+  /**
+   * @brief Converts to true if the viewed VulkanObject is valid
+   */
+  explicit operator bool() const {
+    return static_cast<bool>(handle_);
+  }
+
+  bool operator==(const HandleRef<H>& other) const {
+    return handle_ == other.handle_;
+  }
+
+  bool operator!=(const HandleRef<H>& other) const {
+    return handle_ != other.handle_;
+  }
+
+ private:
+  /**
+   * @brief Create handle that points to the object without owning it (aliasing constructor with empty owner).
+   */
+  static H borrow(element_type* object) {
+    return H(std::shared_ptr<element_type>(std::shared_ptr<element_type>(), object));
+  }
+
+  H handle_;
+};
+
 } // namespace logi
 
 #endif // LOGI_BASE_HANDLE_HPP
@@ -0,0 +1,143 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_BASE_MPSC_RING_HPP
+#define LOGI_BASE_MPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace logi {
+
+/**
+ * @brief Bounded lock-free multi-producer single-consumer ring buffer. Each cell carries a sequence number that tells
+ *        whether it is free for the producer of the given position or filled for the consumer, so producers only
+ *        contend on a single compare-exchange of the enqueue position and never block each other or the consumer.
+ *
+ * @tparam  T Value type. Must be default constructible and move assignable.
+ */
+template <typename T>
+class MpscRing {
+ public:
+  /**
+   * @param capacity  Maximum number of values in the ring. Rounded up to a power of two.
+   */
+  explicit MpscRing(size_t capacity = 256u);
+
+  MpscRing(const MpscRing&) = delete;
+
+  MpscRing& operator=(const MpscRing&) = delete;
+
+  /**
+   * @brief   Move the value into the ring. May be called from multiple threads. The value is left untouched when the
+   *          ring is full.
+   *
+   * @return  True if the value was pushed, false if the ring is full.
+   */
+  bool tryPush(T&& value);
+
+  /**
+   * @brief   Move the oldest value out of the ring. Must only be called by the consumer.
+   *
+   * @return  True if a value was popped, false if the ring is empty.
+   */
+  bool tryPop(T& value);
+
+  size_t capacity() const;
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence {0u};
+    T value {};
+  };
+
+  static constexpr size_t kCacheLineSize = 64u;
+
+  std::unique_ptr<Cell[]> cells_;
+  size_t mask_ = 0u;
+  alignas(kCacheLineSize) std::atomic<size_t> enqueuePosition_ {0u};
+  alignas(kCacheLineSize) size_t dequeuePosition_ = 0u;
+};
+
+template <typename T>
+MpscRing<T>::MpscRing(size_t capacity) {
+  size_t size = 2u;
+  while (size < capacity) {
+    size <<= 1u;
+  }
+
+  cells_ = std::make_unique<Cell[]>(size);
+  mask_ = size - 1u;
+
+  for (size_t i = 0u; i < size; i++) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+template <typename T>
+bool MpscRing<T>::tryPush(T&& value) {
+  size_t position = enqueuePosition_.load(std::memory_order_relaxed);
+  Cell* cell;
+
+  while (true) {
+    cell = &cells_[position & mask_];
+    size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+    if (difference == 0) {
+      // Cell is free for this position. Claim it.
+      if (enqueuePosition_.compare_exchange_weak(position, position + 1u, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+      // Consumer has not yet released the cell of the previous lap.
+      return false;
+    } else {
+      position = enqueuePosition_.load(std::memory_order_relaxed);
+    }
+  }
+
+  cell->value = std::move(value);
+  cell->sequence.store(position + 1u, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+bool MpscRing<T>::tryPop(T& value) {
+  Cell& cell = cells_[dequeuePosition_ & mask_];
+  if (cell.sequence.load(std::memory_order_acquire) != dequeuePosition_ + 1u) {
+    return false;
+  }
+
+  value = std::move(cell.value);
+  cell.sequence.store(dequeuePosition_ + mask_ + 1u, std::memory_order_release);
+  dequeuePosition_++;
+  return true;
+}
+
+template <typename T>
+size_t MpscRing<T>::capacity() const {
+  return mask_ + 1u;
+}
+
+} // namespace logi
+
+#endif // LOGI_BASE_MPSC_RING_HPP
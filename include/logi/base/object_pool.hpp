@@ -0,0 +1,146 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_BASE_OBJECT_POOL_HPP
+#define LOGI_BASE_OBJECT_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace logi {
+
+/**
+ * @brief Fixed size block pool. Blocks are carved from slabs and recycled through an intrusive free list. Block size
+ *        and alignment are fixed by the first allocation; requests that do not fit are forwarded to the global heap.
+ *        Slabs are released when the pool is destroyed.
+ */
+class ObjectPool {
+ public:
+  /**
+   * @brief Initialize empty pool.
+   *
+   * @param blocksPerSlab Number of blocks allocated at once when the pool runs out of free blocks.
+   */
+  explicit ObjectPool(size_t blocksPerSlab = 64u);
+
+  ObjectPool(const ObjectPool&) = delete;
+
+  ObjectPool& operator=(const ObjectPool&) = delete;
+
+  ~ObjectPool();
+
+  /**
+   * @brief   Allocate memory block.
+   *
+   * @param   size      Size of the block.
+   * @param   alignment Alignment of the block.
+   * @return  Pointer to the allocated block.
+   */
+  void* allocate(size_t size, size_t alignment);
+
+  /**
+   * @brief   Return memory block to the pool.
+   *
+   * @param   pointer   Pointer to the block.
+   * @param   size      Size that was used to allocate the block.
+   * @param   alignment Alignment that was used to allocate the block.
+   */
+  void deallocate(void* pointer, size_t size, size_t alignment);
+
+  /**
+   * @brief   Number of blocks that are currently handed out by the pool.
+   */
+  size_t allocatedBlocks() const;
+
+  /**
+   * @brief   Number of blocks owned by the pool.
+   */
+  size_t capacity() const;
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  bool fits(size_t size, size_t alignment) const;
+
+  void allocateSlab();
+
+  mutable std::mutex mutex_;
+  size_t blocksPerSlab_;
+  size_t blockSize_;
+  size_t blockAlignment_;
+  size_t allocatedBlocks_;
+  std::vector<void*> slabs_;
+  FreeBlock* freeList_;
+};
+
+/**
+ * @brief Standard library compatible allocator that allocates single objects from the shared ObjectPool. Intended to be
+ *        used with std::allocate_shared, where object and control block share a single pool block. The allocator keeps
+ *        the pool alive until all objects allocated from it are released.
+ *
+ * @tparam  T Value type.
+ */
+template <typename T>
+class PoolAllocator {
+  template <typename U>
+  friend class PoolAllocator;
+
+ public:
+  using value_type = T;
+
+  explicit PoolAllocator(std::shared_ptr<ObjectPool> pool) : pool_(std::move(pool)) {}
+
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>& other) : pool_(other.pool_) {}
+
+  T* allocate(size_t n) {
+    if (n != 1u) {
+      return std::allocator<T>().allocate(n);
+    }
+    return static_cast<T*>(pool_->allocate(sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* pointer, size_t n) {
+    if (n != 1u) {
+      std::allocator<T>().deallocate(pointer, n);
+      return;
+    }
+    pool_->deallocate(pointer, sizeof(T), alignof(T));
+  }
+
+  template <typename U>
+  bool operator==(const PoolAllocator<U>& other) const {
+    return pool_ == other.pool_;
+  }
+
+  template <typename U>
+  bool operator!=(const PoolAllocator<U>& other) const {
+    return pool_ != other.pool_;
+  }
+
+ private:
+  std::shared_ptr<ObjectPool> pool_;
+};
+
+} // namespace logi
+
+#endif // LOGI_BASE_OBJECT_POOL_HPP
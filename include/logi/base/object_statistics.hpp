@@ -0,0 +1,182 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_BASE_OBJECT_STATISTICS_HPP
+#define LOGI_BASE_OBJECT_STATISTICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace logi {
+
+/**
+ * Upper bounds (in milliseconds) of the object lifetime histogram buckets. The last bucket collects all longer
+ * lifetimes.
+ */
+constexpr std::array<double, 5u> kObjectAgeBucketBounds = {16.0, 100.0, 1000.0, 10000.0, 60000.0};
+
+constexpr size_t kObjectAgeBucketCount = kObjectAgeBucketBounds.size() + 1u;
+
+/**
+ * @brief Statistics of a single object type.
+ */
+struct ObjectTypeStatistics {
+  /**
+   * Name of the object type (e.g. "Buffer").
+   */
+  std::string typeName;
+
+  /**
+   * Number of currently alive objects.
+   */
+  size_t liveCount = 0u;
+
+  /**
+   * Highest number of simultaneously alive objects. For object types that are owned by multiple parents (e.g.
+   * descriptor sets) this is the sum of per parent peaks.
+   */
+  size_t peakCount = 0u;
+
+  /**
+   * Total number of created objects.
+   */
+  uint64_t createdCount = 0u;
+
+  /**
+   * Total number of destroyed objects.
+   */
+  uint64_t destroyedCount = 0u;
+
+  /**
+   * Objects created per second since the previous snapshot.
+   */
+  double createRate = 0.0;
+
+  /**
+   * Objects destroyed per second since the previous snapshot.
+   */
+  double destroyRate = 0.0;
+
+  /**
+   * Histogram of lifetimes of the destroyed objects (see kObjectAgeBucketBounds).
+   */
+  std::array<uint64_t, kObjectAgeBucketCount> ageHistogram {};
+};
+
+/**
+ * @brief Snapshot of object statistics.
+ */
+struct ObjectStatistics {
+  /**
+   * @brief   Find statistics of the given type.
+   *
+   * @param   typeName  Name of the object type.
+   * @return  Pointer to the statistics or nullptr if the type is not present.
+   */
+  const ObjectTypeStatistics* find(const std::string& typeName) const;
+
+  /**
+   * @brief   Serialize the snapshot to JSON.
+   *
+   * @return  JSON string.
+   */
+  std::string toJson() const;
+
+  /**
+   * Duration of the interval (in seconds) over which the rates were computed.
+   */
+  double interval = 0.0;
+
+  /**
+   * Per type statistics.
+   */
+  std::vector<ObjectTypeStatistics> types;
+};
+
+/**
+ * @brief Lock-free counters of a single object type. Used by VulkanObjectComposite when LOGI_ENABLE_OBJECT_STATISTICS
+ *        is defined.
+ */
+class ObjectCounters {
+ public:
+  ObjectCounters() = default;
+
+  ObjectCounters(const ObjectCounters&) = delete;
+
+  ObjectCounters& operator=(const ObjectCounters&) = delete;
+
+  /**
+   * @brief Record creation of an object.
+   */
+  void recordCreate();
+
+  /**
+   * @brief Record destruction of an object.
+   *
+   * @param age Lifetime of the destroyed object.
+   */
+  void recordDestroy(std::chrono::steady_clock::duration age);
+
+  /**
+   * @brief Add the counters to the given statistics.
+   *
+   * @param statistics  Statistics to which the counters are added.
+   */
+  void accumulate(ObjectTypeStatistics& statistics) const;
+
+ private:
+  std::atomic<size_t> liveCount_ {0u};
+  std::atomic<size_t> peakCount_ {0u};
+  std::atomic<uint64_t> createdCount_ {0u};
+  std::atomic<uint64_t> destroyedCount_ {0u};
+  std::array<std::atomic<uint64_t>, kObjectAgeBucketCount> ageHistogram_ {};
+};
+
+/**
+ * @brief Computes create and destroy rates of consecutive snapshots.
+ */
+class ObjectRateTracker {
+ public:
+  ObjectRateTracker();
+
+  /**
+   * @brief Compute rates of the given snapshot relative to the previous one and remember its totals.
+   *
+   * @param statistics  Snapshot whose interval and rates are filled in.
+   */
+  void update(ObjectStatistics& statistics);
+
+  /**
+   * @brief Same as update, but with explicitly given snapshot time.
+   */
+  void update(ObjectStatistics& statistics, std::chrono::steady_clock::time_point time);
+
+ private:
+  std::chrono::steady_clock::time_point previousTime_;
+  std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> previousTotals_;
+};
+
+} // namespace logi
+
+#endif // LOGI_BASE_OBJECT_STATISTICS_HPP
@@ -0,0 +1,84 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_BASE_RESULT_HPP
+#define LOGI_BASE_RESULT_HPP
+
+#include <initializer_list>
+#include "logi/base/common.hpp"
+
+namespace logi {
+
+/**
+ * @brief   Result handling of the hot-path wrappers (submit, present, acquire, wait, map). With exceptions enabled these
+ *          behave like vulkan-hpp and throw vk::SystemError for error results. When built with VULKAN_HPP_NO_EXCEPTIONS
+ *          the result is returned to the caller instead of being asserted, so that recoverable errors such as
+ *          vk::Result::eErrorOutOfDateKHR can be handled without exceptions.
+ *
+ * @param   result  Result returned by the Vulkan command.
+ * @param   message Message of the thrown exception.
+ * @return  Nothing with exceptions enabled, otherwise the result.
+ */
+inline vk::ResultValueType<void>::type checkResult(vk::Result result, const char* message) {
+#ifdef VULKAN_HPP_NO_EXCEPTIONS
+  static_cast<void>(message);
+  return result;
+#else
+  vk::createResultValue(result, message);
+#endif
+}
+
+/**
+ * @brief   Same as checkResult(vk::Result, const char*) for commands that have more than one success code.
+ *
+ * @param   result        Result returned by the Vulkan command.
+ * @param   message       Message of the thrown exception.
+ * @param   successCodes  Results that are not treated as errors.
+ * @return  Result of the command.
+ */
+inline vk::Result checkResult(vk::Result result, const char* message, std::initializer_list<vk::Result> successCodes) {
+#ifdef VULKAN_HPP_NO_EXCEPTIONS
+  static_cast<void>(message);
+  static_cast<void>(successCodes);
+  return result;
+#else
+  return vk::createResultValue(result, message, successCodes);
+#endif
+}
+
+/**
+ * @brief   Same as checkResult(vk::Result, const char*) for commands that return a value.
+ *
+ * @param   result  Result returned by the Vulkan command.
+ * @param   data    Value returned by the Vulkan command.
+ * @param   message Message of the thrown exception.
+ * @return  Value with exceptions enabled, otherwise the result and the value.
+ */
+template <typename T>
+typename vk::ResultValueType<T>::type checkResult(vk::Result result, T& data, const char* message) {
+#ifdef VULKAN_HPP_NO_EXCEPTIONS
+  static_cast<void>(message);
+  return vk::ResultValue<T>(result, data);
+#else
+  return vk::createResultValue(result, data, message);
+#endif
+}
+
+} // namespace logi
+
+#endif // LOGI_BASE_RESULT_HPP
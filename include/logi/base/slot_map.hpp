@@ -0,0 +1,326 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_BASE_SLOT_MAP_HPP
+#define LOGI_BASE_SLOT_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace logi {
+
+/**
+ * @brief Generational slot map. Values are stored in fixed size pages that are never relocated, which keeps
+ *        references to the stored values valid until the value is erased. Occupied slots are additionally tracked in a
+ *        dense index array that is used for iteration. Keys encode the slot index in the lower bits (32 bits on 64-bit
+ *        platforms, 20 bits otherwise) and the slot generation in the remaining upper bits. Generation is incremented on
+ *        every insert and erase, which makes the keys of erased values stale.
+ *
+ * @tparam  T         Value type.
+ * @tparam  PageSize  Number of slots in a single page.
+ */
+template <typename T, size_t PageSize = 256u>
+class SlotMap {
+ public:
+  using key_type = size_t;
+
+  static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+  static constexpr uint32_t kIndexBits = (sizeof(key_type) >= 8u) ? 32u : 20u;
+
+  static constexpr key_type kIndexMask = (static_cast<key_type>(1u) << kIndexBits) - 1u;
+
+  static constexpr uint32_t kGenerationMask = static_cast<uint32_t>(~key_type(0u) >> kIndexBits);
+
+  SlotMap() = default;
+
+  SlotMap(const SlotMap&) = delete;
+
+  SlotMap& operator=(const SlotMap&) = delete;
+
+  /**
+   * @brief   Insert the value and return its key.
+   *
+   * @param   value Value to be inserted.
+   * @return  Key of the inserted value.
+   */
+  key_type insert(T value);
+
+  /**
+   * @brief   Erase the value with the given key and return it. Does nothing if the key is stale.
+   *
+   * @param   key Key of the value.
+   * @return  Erased value or default constructed value if the key is stale.
+   */
+  T erase(key_type key);
+
+  /**
+   * @brief   Retrieve pointer to the value with the given key.
+   *
+   * @param   key Key of the value.
+   * @return  Pointer to the value or nullptr if the key is stale.
+   */
+  T* find(key_type key);
+
+  /**
+   * @brief   Retrieve pointer to the value with the given key.
+   *
+   * @param   key Key of the value.
+   * @return  Pointer to the value or nullptr if the key is stale.
+   */
+  const T* find(key_type key) const;
+
+  /**
+   * @brief   Check if the map contains value with the given key.
+   */
+  bool contains(key_type key) const;
+
+  /**
+   * @brief   Number of stored values.
+   */
+  size_t size() const;
+
+  /**
+   * @brief   Returns true if the map holds no values.
+   */
+  bool empty() const;
+
+  /**
+   * @brief   Erase all values. Keys of the erased values become stale.
+   */
+  void clear();
+
+  /**
+   * @brief   Reserve slots for the given number of values.
+   */
+  void reserve(size_t capacity);
+
+  /**
+   * @brief   Invoke the given function for each stored value in the dense order.
+   */
+  template <typename Function>
+  void forEach(Function&& function) const;
+
+  /**
+   * @brief   Retrieve value at the given dense position.
+   */
+  const T& at(size_t denseIndex) const;
+
+  /**
+   * @brief   Retrieve key of the value at the given dense position.
+   */
+  key_type keyAt(size_t denseIndex) const;
+
+  static uint32_t keyIndex(key_type key);
+
+  static uint32_t keyGeneration(key_type key);
+
+  static key_type makeKey(uint32_t index, uint32_t generation);
+
+ private:
+  struct Slot {
+    T value{};
+    /**
+     * Odd generation marks occupied slot.
+     */
+    uint32_t generation = 0u;
+    /**
+     * Position in dense array when occupied and next free slot otherwise.
+     */
+    uint32_t link = kInvalidIndex;
+  };
+
+  Slot& slot(uint32_t index);
+
+  const Slot& slot(uint32_t index) const;
+
+  void grow();
+
+  std::vector<std::unique_ptr<Slot[]>> pages_;
+  std::vector<uint32_t> dense_;
+  uint32_t freeHead_ = kInvalidIndex;
+  uint32_t capacity_ = 0u;
+};
+
+template <typename T, size_t PageSize>
+typename SlotMap<T, PageSize>::key_type SlotMap<T, PageSize>::insert(T value) {
+  if (freeHead_ == kInvalidIndex) {
+    grow();
+  }
+
+  uint32_t index = freeHead_;
+  Slot& entry = slot(index);
+  freeHead_ = entry.link;
+
+  entry.value = std::move(value);
+  entry.generation++;
+  entry.link = static_cast<uint32_t>(dense_.size());
+  dense_.push_back(index);
+
+  return makeKey(index, entry.generation);
+}
+
+template <typename T, size_t PageSize>
+T SlotMap<T, PageSize>::erase(key_type key) {
+  uint32_t index = keyIndex(key);
+  if (index >= capacity_) {
+    return T{};
+  }
+
+  Slot& entry = slot(index);
+  if ((entry.generation & kGenerationMask) != keyGeneration(key) || (entry.generation & 1u) == 0u) {
+    return T{};
+  }
+
+  T value = std::move(entry.value);
+  entry.value = T{};
+  entry.generation++;
+
+  // Swap remove from the dense array.
+  uint32_t denseIndex = entry.link;
+  uint32_t lastIndex = dense_.back();
+  dense_[denseIndex] = lastIndex;
+  slot(lastIndex).link = denseIndex;
+  dense_.pop_back();
+
+  entry.link = freeHead_;
+  freeHead_ = index;
+
+  return value;
+}
+
+template <typename T, size_t PageSize>
+T* SlotMap<T, PageSize>::find(key_type key) {
+  return const_cast<T*>(static_cast<const SlotMap*>(this)->find(key));
+}
+
+template <typename T, size_t PageSize>
+const T* SlotMap<T, PageSize>::find(key_type key) const {
+  uint32_t index = keyIndex(key);
+  if (index >= capacity_) {
+    return nullptr;
+  }
+
+  const Slot& entry = slot(index);
+  if ((entry.generation & kGenerationMask) != keyGeneration(key) || (entry.generation & 1u) == 0u) {
+    return nullptr;
+  }
+
+  return &entry.value;
+}
+
+template <typename T, size_t PageSize>
+bool SlotMap<T, PageSize>::contains(key_type key) const {
+  return find(key) != nullptr;
+}
+
+template <typename T, size_t PageSize>
+size_t SlotMap<T, PageSize>::size() const {
+  return dense_.size();
+}
+
+template <typename T, size_t PageSize>
+bool SlotMap<T, PageSize>::empty() const {
+  return dense_.empty();
+}
+
+template <typename T, size_t PageSize>
+void SlotMap<T, PageSize>::clear() {
+  for (uint32_t index : dense_) {
+    Slot& entry = slot(index);
+    entry.value = T{};
+    entry.generation++;
+    entry.link = freeHead_;
+    freeHead_ = index;
+  }
+
+  dense_.clear();
+}
+
+template <typename T, size_t PageSize>
+void SlotMap<T, PageSize>::reserve(size_t capacity) {
+  while (capacity_ < capacity) {
+    grow();
+  }
+  dense_.reserve(capacity);
+}
+
+template <typename T, size_t PageSize>
+template <typename Function>
+void SlotMap<T, PageSize>::forEach(Function&& function) const {
+  for (uint32_t index : dense_) {
+    function(slot(index).value);
+  }
+}
+
+template <typename T, size_t PageSize>
+const T& SlotMap<T, PageSize>::at(size_t denseIndex) const {
+  return slot(dense_[denseIndex]).value;
+}
+
+template <typename T, size_t PageSize>
+typename SlotMap<T, PageSize>::key_type SlotMap<T, PageSize>::keyAt(size_t denseIndex) const {
+  uint32_t index = dense_[denseIndex];
+  return makeKey(index, slot(index).generation);
+}
+
+template <typename T, size_t PageSize>
+uint32_t SlotMap<T, PageSize>::keyIndex(key_type key) {
+  return static_cast<uint32_t>(key & kIndexMask);
+}
+
+template <typename T, size_t PageSize>
+uint32_t SlotMap<T, PageSize>::keyGeneration(key_type key) {
+  return static_cast<uint32_t>(key >> kIndexBits);
+}
+
+template <typename T, size_t PageSize>
+typename SlotMap<T, PageSize>::key_type SlotMap<T, PageSize>::makeKey(uint32_t index, uint32_t generation) {
+  return (static_cast<key_type>(generation & kGenerationMask) << kIndexBits) | index;
+}
+
+template <typename T, size_t PageSize>
+typename SlotMap<T, PageSize>::Slot& SlotMap<T, PageSize>::slot(uint32_t index) {
+  return pages_[index / PageSize][index % PageSize];
+}
+
+template <typename T, size_t PageSize>
+const typename SlotMap<T, PageSize>::Slot& SlotMap<T, PageSize>::slot(uint32_t index) const {
+  return pages_[index / PageSize][index % PageSize];
+}
+
+template <typename T, size_t PageSize>
+void SlotMap<T, PageSize>::grow() {
+  pages_.emplace_back(new Slot[PageSize]);
+
+  // Chain new slots into the free list so that the lowest index is handed out first.
+  uint32_t base = capacity_;
+  for (uint32_t i = 0u; i < PageSize; i++) {
+    pages_.back()[i].link = (i + 1u < PageSize) ? base + i + 1u : freeHead_;
+  }
+
+  freeHead_ = base;
+  capacity_ += static_cast<uint32_t>(PageSize);
+}
+
+} // namespace logi
+
+#endif // LOGI_BASE_SLOT_MAP_HPP
@@ -0,0 +1,184 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_BASE_TRACE_RECORDER_HPP
+#define LOGI_BASE_TRACE_RECORDER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace logi {
+
+/**
+ * @brief Event of a TraceRecorder.
+ */
+struct TraceEvent {
+  /**
+   * Name of the event.
+   */
+  std::string name;
+
+  /**
+   * Category of the event. Must point to a string literal.
+   */
+  const char* category = "";
+
+  /**
+   * Chrome trace event phase: 'X' for events with a duration and 'i' for instant events.
+   */
+  char phase = 'X';
+
+  /**
+   * Beginning of the event on the std::chrono::steady_clock in nanoseconds.
+   */
+  int64_t timestamp = 0;
+
+  /**
+   * Duration of the event in nanoseconds.
+   */
+  int64_t duration = 0;
+
+  /**
+   * Track of the event. CPU threads are numbered from 1 in the order they first record an event.
+   */
+  uint32_t track = 0u;
+};
+
+/**
+ * @brief Records CPU and GPU events into a ring buffer and exports them in the Chrome trace event format, which can be
+ *        opened in chrome://tracing and the Perfetto UI. Once the ring buffer is full the oldest events are
+ *        overwritten, so a capture always holds the most recent events. Recording is started and stopped at runtime;
+ *        while stopped, recording an event costs a single atomic load.
+ *
+ *        Logi records its own instrumentation points (queue submit and present, fence and semaphore waits, swapchain
+ *        image acquisition and command buffer recording) into the recorder of the logical device when built with
+ *        LOGI_TRACE. GpuProfiler adds its calibrated zones on the GPU track. All functions are thread safe.
+ */
+class TraceRecorder {
+ public:
+  /**
+   * Track of GPU events.
+   */
+  static constexpr uint32_t kGpuTrack = 0u;
+
+  explicit TraceRecorder(size_t capacity = 65536u);
+
+  /**
+   * @brief Start recording. Events recorded by a previous capture are kept until clear is called.
+   */
+  void start();
+
+  void stop();
+
+  bool isRecording() const;
+
+  /**
+   * @brief Set the capacity of the ring buffer. Discards recorded events.
+   */
+  void setCapacity(size_t capacity);
+
+  size_t getCapacity() const;
+
+  /**
+   * @brief Record an event with a duration on the track of the calling thread.
+   */
+  void recordComplete(std::string_view name, const char* category, int64_t begin, int64_t end);
+
+  /**
+   * @brief Record an event with a duration on the given track.
+   */
+  void recordComplete(std::string_view name, const char* category, int64_t begin, int64_t end, uint32_t track);
+
+  /**
+   * @brief Record an instant event on the track of the calling thread.
+   */
+  void recordInstant(std::string_view name, const char* category, int64_t timestamp);
+
+  /**
+   * @brief Recorded events, oldest first.
+   */
+  std::vector<TraceEvent> getEvents() const;
+
+  /**
+   * @brief Number of events that were overwritten since the last clear.
+   */
+  uint64_t getOverwrittenEventCount() const;
+
+  void clear();
+
+  /**
+   * @brief Recorded events as Chrome trace event JSON.
+   */
+  std::string exportChromeTrace() const;
+
+  /**
+   * @brief   Write recorded events as Chrome trace event JSON to the given file.
+   *
+   * @return  False if the file could not be written.
+   */
+  bool writeChromeTrace(const std::string& path) const;
+
+  /**
+   * @brief Current time of the std::chrono::steady_clock in nanoseconds.
+   */
+  static int64_t now();
+
+  /**
+   * @brief Track of the calling thread.
+   */
+  static uint32_t getThreadTrack();
+
+ private:
+  TraceEvent& nextEvent();
+
+  std::atomic<bool> recording_ {false};
+  mutable std::mutex mutex_;
+  std::vector<TraceEvent> events_;
+  size_t capacity_;
+  size_t next_ = 0u;
+  uint64_t overwritten_ = 0u;
+};
+
+/**
+ * @brief Records an event that lasts from construction to destruction, if the recorder was recording when the scope
+ *        began.
+ */
+class TraceScope {
+ public:
+  TraceScope(TraceRecorder& recorder, const char* name, const char* category);
+
+  TraceScope(const TraceScope&) = delete;
+
+  TraceScope& operator=(const TraceScope&) = delete;
+
+  ~TraceScope();
+
+ private:
+  TraceRecorder* recorder_;
+  const char* name_;
+  const char* category_;
+  int64_t begin_ = 0;
+};
+
+} // namespace logi
+
+#endif // LOGI_BASE_TRACE_RECORDER_HPP
@@ -21,14 +21,18 @@
 
 #include <atomic>
 #include <memory>
-#include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
 #include <variant>
+#include <vector>
 #include "logi/base/exception.hpp"
+#include "logi/base/object_pool.hpp"
+#include "logi/base/object_statistics.hpp"
+#include "logi/base/slot_map.hpp"
 
 namespace logi {
 
-size_t generateUniqueId();
-
 class VulkanObject {
   template <typename T>
   friend class VulkanObjectComposite;
@@ -42,9 +46,11 @@ class VulkanObject {
   explicit VulkanObject(bool valid = true);
 
   /**
-   * @brief   Retrieve VulkanObject unique identifier.
+   * @brief   Retrieve VulkanObject identifier. Identifiers of objects owned by a VulkanObjectComposite are generational
+   *          slot keys that are unique only within the owning composite. Objects that are not owned by a composite
+   *          have identifier 0.
    *
-   * @return  Handle unique identifier.
+   * @return  Handle identifier.
    */
   size_t id() const;
 
@@ -65,6 +71,13 @@ class VulkanObject {
    */
   bool valid() const;
 
+#ifdef LOGI_ENABLE_OBJECT_STATISTICS
+  /**
+   * @brief   Retrieve the time at which the VulkanObject was created.
+   */
+  std::chrono::steady_clock::time_point creationTime() const;
+#endif
+
  protected:
   /**
    * @brief Invalidates VulkanObject. Overriding implementations should free the object's resources and invoke
@@ -74,22 +87,56 @@ class VulkanObject {
 
  private:
   /**
-   * Vulkan object identifier.
+   * Vulkan object identifier. Assigned by the owning VulkanObjectComposite.
    */
-  const size_t id_;
+  size_t id_;
 
   /**
    * Flag that specifies validity of the VulkanObject.
    */
   std::atomic<bool> valid_;
+
+#ifdef LOGI_ENABLE_OBJECT_STATISTICS
+  /**
+   * Time of creation, used for lifetime statistics.
+   */
+  std::chrono::steady_clock::time_point creationTime_;
+#endif
 };
 
+#ifndef LOGI_DISABLE_THREAD_SAFETY
+/**
+ * Mutex guarding VulkanObjectComposite bookkeeping.
+ */
+using CompositeMutex = std::shared_mutex;
+#else
+/**
+ * No-op mutex used when thread safety is disabled.
+ */
+struct CompositeMutex {
+  void lock() {}
+  void unlock() {}
+  void lock_shared() {}
+  void unlock_shared() {}
+};
+#endif
+
+/**
+ * @brief Owns child objects of type T. Unless LOGI_DISABLE_THREAD_SAFETY is defined, bookkeeping of every composite
+ *        is guarded by its own reader-writer lock, so children of different types (and of different parents) never
+ *        contend. Objects are constructed and freed (vkCreate* / vkDestroy*) outside of the lock, which allows multiple
+ *        threads to create and destroy children concurrently. Only the Vulkan objects that the specification requires
+ *        to be externally synchronized (e.g. the VkCommandPool or VkDescriptorPool that a command buffer or a descriptor
+ *        set is allocated from) need to be synchronized by the user.
+ *
+ * @tparam  T Child object type.
+ */
 template <typename T>
 class VulkanObjectComposite {
   friend T;
 
  public:
-  VulkanObjectComposite() = default;
+  VulkanObjectComposite();
 
   /**
    * @brief   Check if the object with the given identifier was generated by this generator.
@@ -103,24 +150,32 @@ class VulkanObjectComposite {
    * @brief   Retrieve the object with the given identifier.
    *
    * @param   id  Object identifier.
-   * @return  Const reference to the handle.
+   * @return  Shared pointer to the object.
    */
-  const std::shared_ptr<T>& getObject(size_t id) const;
+  std::shared_ptr<T> getObject(size_t id) const;
 
   /**
-   * @brief   Retrieve handle map.
+   * @brief   Retrieve snapshot of the owned handles.
    *
-   * @return  Unordered map that maps identifiers to handles.
+   * @return  Vector of handles in the dense storage order.
    */
-  const std::unordered_map<size_t, std::shared_ptr<T>>& getHandles() const;
+  std::vector<std::shared_ptr<T>> getHandles() const;
+
+#ifdef LOGI_ENABLE_OBJECT_STATISTICS
+  /**
+   * @brief   Retrieve counters of the objects created by this composite.
+   */
+  const ObjectCounters& getObjectCounters() const;
+#endif
 
  protected:
   /**
-   * @brief   Creates new handle of HandleType type with the given arguments.
+   * @brief   Creates new handle of HandleType type with the given arguments. Unless LOGI_DISABLE_POOL_ALLOCATION is
+   *          defined, the object is allocated from the composite's type segregated object pool.
    *
    * @tparam  Args  Argument types.
    * @param   args  Arguments.
-   * @return  Reference to the newly created handle.
+   * @return  Reference to the newly created handle. Reference remains valid until the object is destroyed.
    */
   template <typename... Args>
   const std::shared_ptr<T>& createObject(Args&&... args);
@@ -132,6 +187,58 @@ class VulkanObjectComposite {
    */
   void destroyObject(size_t id);
 
+  /**
+   * @brief   Destroys the handle with the given identifier if the predicate accepts the stored object. Identifiers are
+   *          unique only within a composite, so handles that may be owned by another composite (e.g. handles of a
+   *          derived type, such as VMABuffer) must be checked to refer to the stored object before it is destroyed.
+   *
+   * @param   id        Handle identifier.
+   * @param   predicate Invoked with the stored object under the lock.
+   */
+  template <typename Predicate>
+  void destroyObjectIf(size_t id, Predicate&& predicate);
+
+  /**
+   * @brief Destroys the handles with the given identifiers under a single lock acquisition. Stale identifiers are
+   *        skipped.
+   *
+   * @param ids Handle identifiers.
+   */
+  void destroyObjects(const std::vector<size_t>& ids);
+
+  /**
+   * @brief Destroys the handles with the given identifiers whose stored objects are accepted by the predicate (see
+   *        destroyObjectIf). Stale identifiers are skipped.
+   *
+   * @param ids       Handle identifiers.
+   * @param predicate Invoked with the position of the identifier and the stored object under the lock.
+   */
+  template <typename Predicate>
+  void destroyObjectsIf(const std::vector<size_t>& ids, Predicate&& predicate);
+
+  /**
+   * @brief   Removes the handles with the given identifiers without freeing them. Used by bulk destroy paths that
+   *          free the objects themselves (see freeObject) and group the remaining work. Stale identifiers are skipped.
+   *
+   * @param   ids Handle identifiers.
+   * @return  Removed handles.
+   */
+  std::vector<std::shared_ptr<T>> releaseObjects(const std::vector<size_t>& ids);
+
+  /**
+   * @brief Removes the handles with the given identifiers whose stored objects are accepted by the predicate, without
+   *        freeing them (see releaseObjects and destroyObjectsIf).
+   */
+  template <typename Predicate>
+  std::vector<std::shared_ptr<T>> releaseObjectsIf(const std::vector<size_t>& ids, Predicate&& predicate);
+
+  /**
+   * @brief Frees the object that was removed by releaseObjects.
+   *
+   * @param object  Released object.
+   */
+  static void freeObject(T& object);
+
   /**
    * @brief	Destroys all handles.
    */
@@ -139,50 +246,193 @@ class VulkanObjectComposite {
 
  private:
   /**
-   * Maps Handle identifiers to the handles.
+   * Guards objects_.
+   */
+  mutable CompositeMutex mutex_;
+
+  /**
+   * Maps Handle identifiers (generational slot keys) to the handles.
+   */
+  SlotMap<std::shared_ptr<T>> objects_;
+
+#ifdef LOGI_ENABLE_OBJECT_STATISTICS
+  /**
+   * Live count, churn and lifetime counters.
+   */
+  ObjectCounters counters_;
+#endif
+
+#ifndef LOGI_DISABLE_POOL_ALLOCATION
+  /**
+   * Pool from which the objects (together with their shared pointer control blocks) are allocated.
    */
-  std::unordered_map<size_t, std::shared_ptr<T>> objects_;
+  std::shared_ptr<ObjectPool> pool_;
+#endif
 };
 
+template <typename T>
+VulkanObjectComposite<T>::VulkanObjectComposite()
+#ifndef LOGI_DISABLE_POOL_ALLOCATION
+  : pool_(std::make_shared<ObjectPool>())
+#endif
+{
+}
+
 template <typename T>
 bool VulkanObjectComposite<T>::hasObject(size_t id) const {
-  return objects_.find(id) != objects_.end();
+  std::shared_lock<CompositeMutex> lock(mutex_);
+  return objects_.contains(id);
 }
 
 template <typename T>
-const std::shared_ptr<T>& VulkanObjectComposite<T>::getObject(size_t id) const {
-  return objects_.at(id);
+std::shared_ptr<T> VulkanObjectComposite<T>::getObject(size_t id) const {
+  std::shared_lock<CompositeMutex> lock(mutex_);
+  const std::shared_ptr<T>* object = objects_.find(id);
+  if (object == nullptr) {
+    throw std::out_of_range("Object identifier is invalid or stale.");
+  }
+
+  return *object;
 }
 
 template <typename T>
-const std::unordered_map<size_t, std::shared_ptr<T>>& VulkanObjectComposite<T>::getHandles() const {
-  return objects_;
+std::vector<std::shared_ptr<T>> VulkanObjectComposite<T>::getHandles() const {
+  std::shared_lock<CompositeMutex> lock(mutex_);
+  std::vector<std::shared_ptr<T>> handles;
+  handles.reserve(objects_.size());
+  objects_.forEach([&handles](const std::shared_ptr<T>& object) { handles.emplace_back(object); });
+
+  return handles;
 }
 
+#ifdef LOGI_ENABLE_OBJECT_STATISTICS
+template <typename T>
+const ObjectCounters& VulkanObjectComposite<T>::getObjectCounters() const {
+  return counters_;
+}
+#endif
+
 template <typename T>
 template <typename... Args>
 const std::shared_ptr<T>& VulkanObjectComposite<T>::createObject(Args&&... args) {
+  // Construct outside of the lock as the constructor invokes Vulkan.
+#ifndef LOGI_DISABLE_POOL_ALLOCATION
+  std::shared_ptr<T> object = std::allocate_shared<T>(PoolAllocator<T>(pool_), std::forward<Args>(args)...);
+#else
   std::shared_ptr<T> object = std::make_shared<T>(std::forward<Args>(args)...);
-  return objects_.emplace(object->id(), std::move(object)).first->second;
+#endif
+  VulkanObject* base = object.get();
+
+#ifdef LOGI_ENABLE_OBJECT_STATISTICS
+  counters_.recordCreate();
+#endif
+
+  std::unique_lock<CompositeMutex> lock(mutex_);
+  size_t id = objects_.insert(std::move(object));
+  base->id_ = id;
+
+  return *objects_.find(id);
 }
 
 template <typename T>
 void VulkanObjectComposite<T>::destroyObject(size_t id) {
-  auto it = objects_.find(id);
-  if (it != objects_.end()) {
-    static_cast<VulkanObject*>(it->second.get())->free();
+  destroyObjectIf(id, [](const T&) { return true; });
+}
+
+template <typename T>
+template <typename Predicate>
+void VulkanObjectComposite<T>::destroyObjectIf(size_t id, Predicate&& predicate) {
+  std::shared_ptr<T> object;
+
+  {
+    std::unique_lock<CompositeMutex> lock(mutex_);
+    const std::shared_ptr<T>* stored = objects_.find(id);
+    if (stored != nullptr && predicate(**stored)) {
+      object = objects_.erase(id);
+    }
+  }
+
+  // Only the thread that removed the object frees it.
+  if (object) {
+#ifdef LOGI_ENABLE_OBJECT_STATISTICS
+    counters_.recordDestroy(std::chrono::steady_clock::now() - object->creationTime());
+#endif
+    static_cast<VulkanObject*>(object.get())->free();
+  }
+}
+
+template <typename T>
+void VulkanObjectComposite<T>::destroyObjects(const std::vector<size_t>& ids) {
+  for (const std::shared_ptr<T>& object : releaseObjects(ids)) {
+    freeObject(*object);
+  }
+}
+
+template <typename T>
+template <typename Predicate>
+void VulkanObjectComposite<T>::destroyObjectsIf(const std::vector<size_t>& ids, Predicate&& predicate) {
+  for (const std::shared_ptr<T>& object : releaseObjectsIf(ids, std::forward<Predicate>(predicate))) {
+    freeObject(*object);
   }
+}
 
-  objects_.erase(it);
+template <typename T>
+std::vector<std::shared_ptr<T>> VulkanObjectComposite<T>::releaseObjects(const std::vector<size_t>& ids) {
+  return releaseObjectsIf(ids, [](size_t, const T&) { return true; });
+}
+
+template <typename T>
+template <typename Predicate>
+std::vector<std::shared_ptr<T>> VulkanObjectComposite<T>::releaseObjectsIf(const std::vector<size_t>& ids,
+                                                                           Predicate&& predicate) {
+  std::vector<std::shared_ptr<T>> objects;
+  objects.reserve(ids.size());
+
+  std::unique_lock<CompositeMutex> lock(mutex_);
+  for (size_t i = 0u; i < ids.size(); i++) {
+    const std::shared_ptr<T>* stored = objects_.find(ids[i]);
+    if (stored != nullptr && predicate(i, **stored)) {
+      objects.emplace_back(objects_.erase(ids[i]));
+    }
+  }
+  lock.unlock();
+
+#ifdef LOGI_ENABLE_OBJECT_STATISTICS
+  auto now = std::chrono::steady_clock::now();
+  for (const std::shared_ptr<T>& object : objects) {
+    counters_.recordDestroy(now - object->creationTime());
+  }
+#endif
+
+  return objects;
+}
+
+template <typename T>
+void VulkanObjectComposite<T>::freeObject(T& object) {
+  static_cast<VulkanObject&>(object).free();
 }
 
 template <typename T>
 void VulkanObjectComposite<T>::destroyAllObjects() {
-  for (auto it = objects_.begin(); it != objects_.end(); it++) {
-    static_cast<VulkanObject*>(it->second.get())->free();
+  std::vector<std::shared_ptr<T>> objects;
+
+  {
+    std::unique_lock<CompositeMutex> lock(mutex_);
+    objects.reserve(objects_.size());
+    objects_.forEach([&objects](const std::shared_ptr<T>& object) { objects.emplace_back(object); });
+    objects_.clear();
   }
 
-  objects_.clear();
+#ifdef LOGI_ENABLE_OBJECT_STATISTICS
+  auto now = std::chrono::steady_clock::now();
+  for (const std::shared_ptr<T>& object : objects) {
+    counters_.recordDestroy(now - object->creationTime());
+  }
+#endif
+
+  for (const std::shared_ptr<T>& object : objects) {
+    static_cast<VulkanObject*>(object.get())->free();
+  }
 }
 
 } // namespace logi
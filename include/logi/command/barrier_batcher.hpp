@@ -0,0 +1,136 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_COMMAND_BARRIER_BATCHER_HPP
+#define LOGI_COMMAND_BARRIER_BATCHER_HPP
+
+#include <cstdint>
+#include <vector>
+#include "logi/base/common.hpp"
+
+namespace logi {
+
+class CommandDispatchTable;
+
+/**
+ * @brief Counters of a BarrierBatcher.
+ */
+struct BarrierBatchStatistics {
+  /**
+   * Number of pipelineBarrier calls that were batched.
+   */
+  uint64_t batchedCalls = 0u;
+
+  /**
+   * Number of memory, buffer and image barriers that were batched.
+   */
+  uint64_t batchedBarriers = 0u;
+
+  /**
+   * Number of batched barriers that were merged into an already pending barrier of the same resource.
+   */
+  uint64_t mergedBarriers = 0u;
+
+  /**
+   * Number of vkCmdPipelineBarrier calls issued by the flushes.
+   */
+  uint64_t flushes = 0u;
+};
+
+/**
+ * @brief Accumulates pipeline barriers and records them as a single vkCmdPipelineBarrier. Stage masks of the batched
+ *        barriers are OR'ed, global memory barriers are merged into one and buffer and image barriers of the same
+ *        buffer range or image subresource range are merged into one barrier (chained layout transitions are
+ *        collapsed into a single transition). A barrier that overlaps a pending barrier of the same resource without
+ *        matching it exactly, or a barrier with different dependency flags, first flushes the pending barriers, so
+ *        the order of layout transitions is always preserved.
+ *
+ *        The owner must flush the batch before recording any command that may depend on the barriers.
+ */
+class BarrierBatcher {
+ public:
+  BarrierBatcher(vk::CommandBuffer commandBuffer, const CommandDispatchTable& dispatch);
+
+  /**
+   * @brief Add barriers to the batch. Arguments match vkCmdPipelineBarrier.
+   */
+  void add(const vk::PipelineStageFlags& srcStageMask, const vk::PipelineStageFlags& dstStageMask,
+           const vk::DependencyFlags& dependencyFlags, vk::ArrayProxy<const vk::MemoryBarrier> memoryBarriers,
+           vk::ArrayProxy<const vk::BufferMemoryBarrier> bufferMemoryBarriers,
+           vk::ArrayProxy<const vk::ImageMemoryBarrier> imageMemoryBarriers);
+
+  /**
+   * @brief Record pending barriers into the command buffer as a single vkCmdPipelineBarrier.
+   */
+  void flush();
+
+  /**
+   * @brief Drop pending barriers without recording them (e.g. when the command buffer is reset).
+   */
+  void clear();
+
+  /**
+   * @brief Check if there are no pending barriers.
+   */
+  bool empty() const {
+    return !pending_;
+  }
+
+  const vk::PipelineStageFlags& getSrcStageMask() const;
+
+  const vk::PipelineStageFlags& getDstStageMask() const;
+
+  const std::vector<vk::MemoryBarrier>& getMemoryBarriers() const;
+
+  const std::vector<vk::BufferMemoryBarrier>& getBufferMemoryBarriers() const;
+
+  const std::vector<vk::ImageMemoryBarrier>& getImageMemoryBarriers() const;
+
+  const BarrierBatchStatistics& getStatistics() const;
+
+ private:
+  /**
+   * @brief Check if the barriers can be added to the pending batch without flushing it first.
+   */
+  bool isCompatible(const vk::DependencyFlags& dependencyFlags,
+                    const vk::ArrayProxy<const vk::BufferMemoryBarrier>& bufferMemoryBarriers,
+                    const vk::ArrayProxy<const vk::ImageMemoryBarrier>& imageMemoryBarriers) const;
+
+  void addMemoryBarrier(const vk::MemoryBarrier& barrier);
+
+  void addBufferMemoryBarrier(const vk::BufferMemoryBarrier& barrier, size_t pendingCount);
+
+  void addImageMemoryBarrier(const vk::ImageMemoryBarrier& barrier, size_t pendingCount);
+
+  vk::CommandBuffer commandBuffer_;
+  const CommandDispatchTable& dispatch_;
+
+  bool pending_;
+  vk::PipelineStageFlags srcStageMask_;
+  vk::PipelineStageFlags dstStageMask_;
+  vk::DependencyFlags dependencyFlags_;
+  std::vector<vk::MemoryBarrier> memoryBarriers_;
+  std::vector<vk::BufferMemoryBarrier> bufferMemoryBarriers_;
+  std::vector<vk::ImageMemoryBarrier> imageMemoryBarriers_;
+
+  BarrierBatchStatistics statistics_;
+};
+
+} // namespace logi
+
+#endif // LOGI_COMMAND_BARRIER_BATCHER_HPP
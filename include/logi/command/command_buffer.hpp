@@ -31,6 +31,8 @@ class PhysicalDevice;
 class LogicalDevice;
 class CommandPool;
 class QueueFamily;
+class Image;
+class Buffer;
 
 class CommandBuffer : public Handle<CommandBufferImpl> {
  public:
@@ -238,6 +240,58 @@ class CommandBuffer : public Handle<CommandBufferImpl> {
     object_->pushConstants(layout, stageFlags, offset, values);
   }
 
+  /**
+   * @brief Reference: <a href="https://www.khronos.org/registry/vulkan/specs/1.2-extensions/man/html/vkCmdPushConstants.html">vkCmdPushConstants</a>
+   */
+  void pushConstants(vk::PipelineLayout layout, vk::ShaderStageFlags stageFlags, uint32_t offset, uint32_t size,
+                     const void* values) const;
+
+  /**
+   * @brief Push a range of the push constant block. The range is split into one vkCmdPushConstants call per segment of
+   *        the block (see PushConstantBlock), with the stage flags of the segment.
+   *
+   * @param layout  Pipeline layout created with the ranges of the block.
+   * @param block   Push constant block.
+   * @param offset  Offset of the range in the block.
+   * @param size    Size of the range.
+   * @param values  Values of the range.
+   */
+  void pushConstants(vk::PipelineLayout layout, const PushConstantBlock& block, uint32_t offset, uint32_t size,
+                     const void* values) const;
+
+  /**
+   * @brief Push the bytes of the data written since its last push and mark them as pushed. Members written together
+   *        are packed into as few vkCmdPushConstants calls as the ranges allow.
+   */
+  void pushConstants(vk::PipelineLayout layout, PushConstantData& data) const;
+
+  /**
+   * @brief   Push a single member of the push constant block.
+   * @throws  IllegalInvocation If the value is larger than the member.
+   */
+  template <typename T>
+  void pushConstant(vk::PipelineLayout layout, const PushConstantBlock& block, uint32_t memberIndex,
+                    const T& value) const {
+    static_assert(std::is_trivially_copyable<T>::value, "Push constant values must be trivially copyable.");
+    const PushConstantMember& member = block.getMember(memberIndex);
+    if (sizeof(T) > member.size) {
+      throw IllegalInvocation("Value is larger than push constant member \"" + member.name + "\".");
+    }
+
+    object_->pushConstants(layout, block, member.offset, sizeof(T), &value);
+  }
+
+  template <typename T>
+  void pushConstant(vk::PipelineLayout layout, const PushConstantBlock& block, const std::string& memberName,
+                    const T& value) const {
+    pushConstant(layout, block, block.getMemberIndex(memberName), value);
+  }
+
+  /**
+   * @brief Replay all commands of the command list into this command buffer.
+   */
+  void recordCommandList(const CommandList& commandList) const;
+
   /**
    * @brief Reference: <a href="https://www.khronos.org/registry/vulkan/specs/1.2-extensions/man/html/vkResetCommandBuffer.html">vkResetCommandBuffer</a>
    */
@@ -670,8 +724,97 @@ class CommandBuffer : public Handle<CommandBufferImpl> {
 
   CommandPool getCommandPool() const;
 
+  /**
+   * @brief Non-owning variants of the parent accessors. Do not touch reference counts and are intended for recording
+   *        hot paths.
+   */
+  HandleRef<VulkanInstance> getInstanceRef() const;
+
+  HandleRef<PhysicalDevice> getPhysicalDeviceRef() const;
+
+  HandleRef<LogicalDevice> getLogicalDeviceRef() const;
+
+  HandleRef<QueueFamily> getQueueFamilyRef() const;
+
+  HandleRef<CommandPool> getCommandPoolRef() const;
+
   const vk::DispatchLoaderDynamic& getDispatcher() const;
 
+  /**
+   * @brief Enable or disable barrier batching. While enabled, pipelineBarrier calls are accumulated and merged (see
+   *        BarrierBatcher) and recorded as a single vkCmdPipelineBarrier right before the next command that is not a
+   *        state setting command (e.g. draw, dispatch, copy or render pass begin). Disabling batching flushes pending
+   *        barriers.
+   */
+  void setBarrierBatching(bool enabled) const;
+
+  bool isBarrierBatchingEnabled() const;
+
+  /**
+   * @brief Record pending batched barriers.
+   */
+  void flushBarriers() const;
+
+  /**
+   * @brief Counters of batched and merged barriers since the command buffer was created.
+   */
+  const BarrierBatchStatistics& getBarrierBatchStatistics() const;
+
+  /**
+   * @brief Enable or disable redundant state filtering. While enabled, bind and dynamic state commands (bindPipeline,
+   *        bindDescriptorSets, bindVertexBuffers, bindIndexBuffer, setViewport, setScissor, setLineWidth, setDepthBias,
+   *        setBlendConstants, setDepthBounds and the stencil setters) that would not change the current state are
+   *        dropped (see CommandStateCache). The known state is forgotten on begin, reset, executeCommands, render pass
+   *        and subpass boundaries and replayed command lists.
+   */
+  void setRedundantStateFiltering(bool enabled) const;
+
+  bool isRedundantStateFilteringEnabled() const;
+
+  /**
+   * @brief Counters of filtered and elided commands since the command buffer was created.
+   */
+  const StateCacheStatistics& getStateCacheStatistics() const;
+
+  /**
+   * @brief Counters of commands recorded since the command buffer last began recording. Empty unless Logi is built with
+   *        LOGI_COMMAND_STATISTICS and statistics are enabled on the command pool.
+   */
+  CommandStatistics getStatistics() const;
+
+  /**
+   * @brief Record the barrier required before the image subresource range is used with the given usage. The image must
+   *        have state tracking enabled (see Image::enableStateTracking). Only dependencies within this command buffer
+   *        are recorded. Dependencies of the first use of each subresource on earlier command buffers are resolved
+   *        when the command buffer is submitted with Queue::submit, which records them into a preamble command buffer
+   *        submitted right before this one.
+   *
+   *        Transitions must not be recorded inside a render pass and are not supported in secondary command buffers or
+   *        command buffers with the simultaneous use flag. Queue family ownership transfers are not tracked.
+   *
+   * @param image           Tracked image.
+   * @param usage           New usage of the subresource range.
+   * @param range           Subresource range. The aspect mask is ignored.
+   * @param discardContents If true, contents of the range are not preserved, which allows transition from the undefined
+   *                        layout.
+   */
+  void transition(const Image& image, ResourceUsage usage,
+                  const vk::ImageSubresourceRange& range = vk::ImageSubresourceRange({}, 0u, VK_REMAINING_MIP_LEVELS,
+                                                                                     0u, VK_REMAINING_ARRAY_LAYERS),
+                  bool discardContents = false) const;
+
+  /**
+   * @brief Record the barrier required before the buffer range is used with the given usage. The buffer must have state
+   *        tracking enabled (see Buffer::enableStateTracking). See the image overload for details.
+   *
+   * @param buffer  Tracked buffer.
+   * @param usage   New usage of the range.
+   * @param offset  Offset of the range.
+   * @param size    Size of the range or VK_WHOLE_SIZE.
+   */
+  void transition(const Buffer& buffer, ResourceUsage usage, vk::DeviceSize offset = 0u,
+                  vk::DeviceSize size = VK_WHOLE_SIZE) const;
+
   void destroy() const;
 
   operator const vk::CommandBuffer&() const;
@@ -19,8 +19,17 @@
 #ifndef LOGI_COMMAND_COMMAND_BUFFER_IMPL_HPP
 #define LOGI_COMMAND_COMMAND_BUFFER_IMPL_HPP
 
+#include <unordered_map>
+#include <utility>
 #include "logi/base/common.hpp"
 #include "logi/base/vulkan_object.hpp"
+#include "logi/command/barrier_batcher.hpp"
+#include "logi/command/command_dispatch_table.hpp"
+#include "logi/command/command_list.hpp"
+#include "logi/command/command_statistics.hpp"
+#include "logi/command/command_state_cache.hpp"
+#include "logi/program/push_constant_block.hpp"
+#include "logi/synchronization/resource_state.hpp"
 
 namespace logi {
 
@@ -127,9 +136,17 @@ class CommandBufferImpl : public VulkanObject, public std::enable_shared_from_th
   template <typename T>
   void pushConstants(vk::PipelineLayout layout, vk::ShaderStageFlags stageFlags, uint32_t offset,
                      vk::ArrayProxy<const T> values) const {
-    vkCommandBuffer_.pushConstants(layout, stageFlags, offset, values, getDispatcher());
+    vkCommandBuffer_.pushConstants(layout, stageFlags, offset, values, commandDispatch_);
   }
 
+  void pushConstants(vk::PipelineLayout layout, vk::ShaderStageFlags stageFlags, uint32_t offset, uint32_t size,
+                     const void* values) const;
+
+  void pushConstants(vk::PipelineLayout layout, const PushConstantBlock& block, uint32_t offset, uint32_t size,
+                     const void* values) const;
+
+  void recordCommandList(const CommandList& commandList) const;
+
   vk::ResultValueType<void>::type reset(const vk::CommandBufferResetFlags&) const;
 
   void resetEvent(vk::Event event, const vk::PipelineStageFlags& stageMask) const;
@@ -163,7 +180,10 @@ class CommandBufferImpl : public VulkanObject, public std::enable_shared_from_th
 
   template <typename T>
   void updateBuffer(vk::Buffer dstBuffer, vk::DeviceSize dstOffset, vk::ArrayProxy<const T> data) const {
-    vkCommandBuffer_.updateBuffer(dstBuffer, dstOffset, data, getDispatcher());
+    flushBarriers();
+    countCommand(&CommandStatistics::copies);
+    countCommand(&CommandStatistics::copyBytes, data.size() * sizeof(T));
+    vkCommandBuffer_.updateBuffer(dstBuffer, dstOffset, data, commandDispatch_);
   }
 
   void waitEvents(vk::ArrayProxy<const vk::Event> events, const vk::PipelineStageFlags& srcStageMask,
@@ -345,6 +365,40 @@ class CommandBufferImpl : public VulkanObject, public std::enable_shared_from_th
 
   const vk::DispatchLoaderDynamic& getDispatcher() const;
 
+  void setBarrierBatching(bool enabled) const;
+
+  bool isBarrierBatchingEnabled() const;
+
+  void flushBarriers() const {
+    if (!barrierBatcher_.empty()) {
+      barrierBatcher_.flush();
+    }
+  }
+
+  const BarrierBatchStatistics& getBarrierBatchStatistics() const;
+
+  void setRedundantStateFiltering(bool enabled) const;
+
+  bool isRedundantStateFilteringEnabled() const;
+
+  void invalidateStateCache() const {
+    if (filterRedundantState_) {
+      stateCache_.invalidate();
+    }
+  }
+
+  const StateCacheStatistics& getStateCacheStatistics() const;
+
+  void transition(const std::shared_ptr<SharedImageState>& image, ResourceUsage usage,
+                  const vk::ImageSubresourceRange& range, bool discardContents) const;
+
+  void transition(const std::shared_ptr<SharedBufferState>& buffer, ResourceUsage usage, vk::DeviceSize offset,
+                  vk::DeviceSize size) const;
+
+  vk::CommandBuffer reconcileResourceStates() const;
+
+  CommandStatistics getStatistics() const;
+
   void destroy() const;
 
   operator const vk::CommandBuffer&() const;
@@ -355,8 +409,50 @@ class CommandBufferImpl : public VulkanObject, public std::enable_shared_from_th
   // endregion
 
  private:
+  /**
+   * @brief Add to a command counter. Compiled out unless LOGI_ENABLE_COMMAND_STATISTICS is defined.
+   */
+  void countCommand(uint64_t CommandStatistics::*counter, uint64_t count = 1u) const {
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+    if (collectStatistics_) {
+      statistics_.*counter += count;
+    }
+#endif
+  }
+
+  void countBarriers(uint64_t barrierCount) const {
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+    if (collectStatistics_) {
+      statistics_.barrierCommands++;
+      statistics_.barriers += barrierCount;
+    }
+#endif
+  }
+
+  void recordTransitionBarriers() const;
+
+  void clearResourceStates() const;
+
   CommandPoolImpl& commandPool_;
+  const vk::DispatchLoaderDynamic& dispatcher_;
+  const CommandDispatchTable& commandDispatch_;
   vk::CommandBuffer vkCommandBuffer_;
+  mutable BarrierBatcher barrierBatcher_;
+  mutable bool batchBarriers_;
+  mutable CommandStateCache stateCache_;
+  mutable bool filterRedundantState_;
+  mutable std::unordered_map<SharedImageState*, std::pair<std::shared_ptr<SharedImageState>, ImageState>> imageStates_;
+  mutable std::unordered_map<SharedBufferState*, std::pair<std::shared_ptr<SharedBufferState>, BufferState>>
+    bufferStates_;
+  mutable ResourceBarriers transitionBarriers_;
+  mutable std::shared_ptr<CommandBufferImpl> preamble_;
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+  mutable CommandStatistics statistics_;
+  mutable bool collectStatistics_ = false;
+#endif
+#ifdef LOGI_ENABLE_TRACE
+  mutable int64_t recordingBegin_ = 0;
+#endif
 };
 
 } // namespace logi
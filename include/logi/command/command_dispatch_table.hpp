@@ -0,0 +1,317 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_COMMAND_COMMAND_DISPATCH_TABLE_HPP
+#define LOGI_COMMAND_COMMAND_DISPATCH_TABLE_HPP
+
+#include "logi/base/common.hpp"
+
+namespace logi {
+
+/**
+ * @brief Compact table of the device level functions used to record command buffers. Unlike vk::DispatchLoaderDynamic
+ *        it only holds the entry points used by CommandBufferImpl, with the most frequently recorded commands laid
+ *        out first so that they share cache lines. Can be passed to vulkan-hpp in place of the dispatcher. When
+ *        LOGI_STATIC_DISPATCH is defined (LOGI_DISPATCH=static), the frequently recorded core commands are statically
+ *        linked calls instead of function pointers, while extension commands still use loaded function pointers.
+ */
+class CommandDispatchTable {
+ public:
+  /**
+   * @brief Initialize table with null entry points.
+   */
+  CommandDispatchTable() = default;
+
+  /**
+   * @brief Copy entry points from the given device dispatcher.
+   *
+   * @param dispatcher  Device dispatcher.
+   */
+  explicit CommandDispatchTable(const vk::DispatchLoaderDynamic& dispatcher);
+
+  /**
+   * @brief Header version the table was compiled with (required by vulkan-hpp dispatch checks).
+   */
+  uint32_t getVkHeaderVersion() const {
+    return VK_HEADER_VERSION;
+  }
+
+  // region Frequently recorded commands
+
+#ifdef LOGI_STATIC_DISPATCH
+  // Core commands are called directly through the Vulkan loader's exported entry points.
+
+  void vkCmdDraw(VkCommandBuffer commandBuffer, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex,
+                 uint32_t firstInstance) const {
+    ::vkCmdDraw(commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+  }
+
+  void vkCmdDrawIndexed(VkCommandBuffer commandBuffer, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex,
+                        int32_t vertexOffset, uint32_t firstInstance) const {
+    ::vkCmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+  }
+
+  void vkCmdDrawIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, uint32_t drawCount,
+                         uint32_t stride) const {
+    ::vkCmdDrawIndirect(commandBuffer, buffer, offset, drawCount, stride);
+  }
+
+  void vkCmdDrawIndexedIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, uint32_t drawCount,
+                                uint32_t stride) const {
+    ::vkCmdDrawIndexedIndirect(commandBuffer, buffer, offset, drawCount, stride);
+  }
+
+  void vkCmdDispatch(VkCommandBuffer commandBuffer, uint32_t groupCountX, uint32_t groupCountY,
+                     uint32_t groupCountZ) const {
+    ::vkCmdDispatch(commandBuffer, groupCountX, groupCountY, groupCountZ);
+  }
+
+  void vkCmdDispatchIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset) const {
+    ::vkCmdDispatchIndirect(commandBuffer, buffer, offset);
+  }
+
+  void vkCmdBindPipeline(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindPoint,
+                         VkPipeline pipeline) const {
+    ::vkCmdBindPipeline(commandBuffer, pipelineBindPoint, pipeline);
+  }
+
+  void vkCmdBindDescriptorSets(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindPoint,
+                               VkPipelineLayout layout, uint32_t firstSet, uint32_t descriptorSetCount,
+                               const VkDescriptorSet* pDescriptorSets, uint32_t dynamicOffsetCount,
+                               const uint32_t* pDynamicOffsets) const {
+    ::vkCmdBindDescriptorSets(commandBuffer, pipelineBindPoint, layout, firstSet, descriptorSetCount, pDescriptorSets,
+                              dynamicOffsetCount, pDynamicOffsets);
+  }
+
+  void vkCmdBindVertexBuffers(VkCommandBuffer commandBuffer, uint32_t firstBinding, uint32_t bindingCount,
+                              const VkBuffer* pBuffers, const VkDeviceSize* pOffsets) const {
+    ::vkCmdBindVertexBuffers(commandBuffer, firstBinding, bindingCount, pBuffers, pOffsets);
+  }
+
+  void vkCmdBindIndexBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset,
+                            VkIndexType indexType) const {
+    ::vkCmdBindIndexBuffer(commandBuffer, buffer, offset, indexType);
+  }
+
+  void vkCmdPushConstants(VkCommandBuffer commandBuffer, VkPipelineLayout layout, VkShaderStageFlags stageFlags,
+                          uint32_t offset, uint32_t size, const void* pValues) const {
+    ::vkCmdPushConstants(commandBuffer, layout, stageFlags, offset, size, pValues);
+  }
+
+  void vkCmdSetViewport(VkCommandBuffer commandBuffer, uint32_t firstViewport, uint32_t viewportCount,
+                        const VkViewport* pViewports) const {
+    ::vkCmdSetViewport(commandBuffer, firstViewport, viewportCount, pViewports);
+  }
+
+  void vkCmdSetScissor(VkCommandBuffer commandBuffer, uint32_t firstScissor, uint32_t scissorCount,
+                       const VkRect2D* pScissors) const {
+    ::vkCmdSetScissor(commandBuffer, firstScissor, scissorCount, pScissors);
+  }
+
+  void vkCmdSetLineWidth(VkCommandBuffer commandBuffer, float lineWidth) const {
+    ::vkCmdSetLineWidth(commandBuffer, lineWidth);
+  }
+
+  void vkCmdSetDepthBias(VkCommandBuffer commandBuffer, float depthBiasConstantFactor, float depthBiasClamp,
+                         float depthBiasSlopeFactor) const {
+    ::vkCmdSetDepthBias(commandBuffer, depthBiasConstantFactor, depthBiasClamp, depthBiasSlopeFactor);
+  }
+
+  void vkCmdSetBlendConstants(VkCommandBuffer commandBuffer, const float blendConstants[4]) const {
+    ::vkCmdSetBlendConstants(commandBuffer, blendConstants);
+  }
+
+  void vkCmdSetDepthBounds(VkCommandBuffer commandBuffer, float minDepthBounds, float maxDepthBounds) const {
+    ::vkCmdSetDepthBounds(commandBuffer, minDepthBounds, maxDepthBounds);
+  }
+
+  void vkCmdSetStencilCompareMask(VkCommandBuffer commandBuffer, VkStencilFaceFlags faceMask,
+                                  uint32_t compareMask) const {
+    ::vkCmdSetStencilCompareMask(commandBuffer, faceMask, compareMask);
+  }
+
+  void vkCmdSetStencilWriteMask(VkCommandBuffer commandBuffer, VkStencilFaceFlags faceMask, uint32_t writeMask) const {
+    ::vkCmdSetStencilWriteMask(commandBuffer, faceMask, writeMask);
+  }
+
+  void vkCmdSetStencilReference(VkCommandBuffer commandBuffer, VkStencilFaceFlags faceMask, uint32_t reference) const {
+    ::vkCmdSetStencilReference(commandBuffer, faceMask, reference);
+  }
+
+  void vkCmdPipelineBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStageMask,
+                            VkPipelineStageFlags dstStageMask, VkDependencyFlags dependencyFlags,
+                            uint32_t memoryBarrierCount, const VkMemoryBarrier* pMemoryBarriers,
+                            uint32_t bufferMemoryBarrierCount, const VkBufferMemoryBarrier* pBufferMemoryBarriers,
+                            uint32_t imageMemoryBarrierCount, const VkImageMemoryBarrier* pImageMemoryBarriers) const {
+    ::vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, dependencyFlags, memoryBarrierCount,
+                           pMemoryBarriers, bufferMemoryBarrierCount, pBufferMemoryBarriers, imageMemoryBarrierCount,
+                           pImageMemoryBarriers);
+  }
+
+  void vkCmdBeginRenderPass(VkCommandBuffer commandBuffer, const VkRenderPassBeginInfo* pRenderPassBegin,
+                            VkSubpassContents contents) const {
+    ::vkCmdBeginRenderPass(commandBuffer, pRenderPassBegin, contents);
+  }
+
+  void vkCmdNextSubpass(VkCommandBuffer commandBuffer, VkSubpassContents contents) const {
+    ::vkCmdNextSubpass(commandBuffer, contents);
+  }
+
+  void vkCmdEndRenderPass(VkCommandBuffer commandBuffer) const {
+    ::vkCmdEndRenderPass(commandBuffer);
+  }
+
+  void vkCmdExecuteCommands(VkCommandBuffer commandBuffer, uint32_t commandBufferCount,
+                            const VkCommandBuffer* pCommandBuffers) const {
+    ::vkCmdExecuteCommands(commandBuffer, commandBufferCount, pCommandBuffers);
+  }
+
+  VkResult vkBeginCommandBuffer(VkCommandBuffer commandBuffer, const VkCommandBufferBeginInfo* pBeginInfo) const {
+    return ::vkBeginCommandBuffer(commandBuffer, pBeginInfo);
+  }
+
+  VkResult vkEndCommandBuffer(VkCommandBuffer commandBuffer) const {
+    return ::vkEndCommandBuffer(commandBuffer);
+  }
+
+  VkResult vkResetCommandBuffer(VkCommandBuffer commandBuffer, VkCommandBufferResetFlags flags) const {
+    return ::vkResetCommandBuffer(commandBuffer, flags);
+  }
+#else
+  PFN_vkCmdDraw vkCmdDraw = nullptr;
+  PFN_vkCmdDrawIndexed vkCmdDrawIndexed = nullptr;
+  PFN_vkCmdDrawIndirect vkCmdDrawIndirect = nullptr;
+  PFN_vkCmdDrawIndexedIndirect vkCmdDrawIndexedIndirect = nullptr;
+  PFN_vkCmdDispatch vkCmdDispatch = nullptr;
+  PFN_vkCmdDispatchIndirect vkCmdDispatchIndirect = nullptr;
+  PFN_vkCmdBindPipeline vkCmdBindPipeline = nullptr;
+  PFN_vkCmdBindDescriptorSets vkCmdBindDescriptorSets = nullptr;
+  PFN_vkCmdBindVertexBuffers vkCmdBindVertexBuffers = nullptr;
+  PFN_vkCmdBindIndexBuffer vkCmdBindIndexBuffer = nullptr;
+  PFN_vkCmdPushConstants vkCmdPushConstants = nullptr;
+  PFN_vkCmdSetViewport vkCmdSetViewport = nullptr;
+  PFN_vkCmdSetScissor vkCmdSetScissor = nullptr;
+  PFN_vkCmdSetLineWidth vkCmdSetLineWidth = nullptr;
+  PFN_vkCmdSetDepthBias vkCmdSetDepthBias = nullptr;
+  PFN_vkCmdSetBlendConstants vkCmdSetBlendConstants = nullptr;
+  PFN_vkCmdSetDepthBounds vkCmdSetDepthBounds = nullptr;
+  PFN_vkCmdSetStencilCompareMask vkCmdSetStencilCompareMask = nullptr;
+  PFN_vkCmdSetStencilWriteMask vkCmdSetStencilWriteMask = nullptr;
+  PFN_vkCmdSetStencilReference vkCmdSetStencilReference = nullptr;
+  PFN_vkCmdPipelineBarrier vkCmdPipelineBarrier = nullptr;
+  PFN_vkCmdBeginRenderPass vkCmdBeginRenderPass = nullptr;
+  PFN_vkCmdNextSubpass vkCmdNextSubpass = nullptr;
+  PFN_vkCmdEndRenderPass vkCmdEndRenderPass = nullptr;
+  PFN_vkCmdExecuteCommands vkCmdExecuteCommands = nullptr;
+  PFN_vkBeginCommandBuffer vkBeginCommandBuffer = nullptr;
+  PFN_vkEndCommandBuffer vkEndCommandBuffer = nullptr;
+  PFN_vkResetCommandBuffer vkResetCommandBuffer = nullptr;
+#endif
+
+  // endregion
+
+  // region Other commands
+
+  PFN_vkCmdBeginConditionalRenderingEXT vkCmdBeginConditionalRenderingEXT = nullptr;
+  PFN_vkCmdBeginDebugUtilsLabelEXT vkCmdBeginDebugUtilsLabelEXT = nullptr;
+  PFN_vkCmdBeginQuery vkCmdBeginQuery = nullptr;
+  PFN_vkCmdBeginQueryIndexedEXT vkCmdBeginQueryIndexedEXT = nullptr;
+  PFN_vkCmdBeginRenderPass2 vkCmdBeginRenderPass2 = nullptr;
+  PFN_vkCmdBeginRenderPass2KHR vkCmdBeginRenderPass2KHR = nullptr;
+  PFN_vkCmdBeginTransformFeedbackEXT vkCmdBeginTransformFeedbackEXT = nullptr;
+  PFN_vkCmdBindPipelineShaderGroupNV vkCmdBindPipelineShaderGroupNV = nullptr;
+  PFN_vkCmdBindShadingRateImageNV vkCmdBindShadingRateImageNV = nullptr;
+  PFN_vkCmdBindTransformFeedbackBuffersEXT vkCmdBindTransformFeedbackBuffersEXT = nullptr;
+  PFN_vkCmdBlitImage vkCmdBlitImage = nullptr;
+  PFN_vkCmdBuildAccelerationStructureNV vkCmdBuildAccelerationStructureNV = nullptr;
+  PFN_vkCmdBuildAccelerationStructuresIndirectKHR vkCmdBuildAccelerationStructuresIndirectKHR = nullptr;
+  PFN_vkCmdBuildAccelerationStructuresKHR vkCmdBuildAccelerationStructuresKHR = nullptr;
+  PFN_vkCmdClearAttachments vkCmdClearAttachments = nullptr;
+  PFN_vkCmdClearColorImage vkCmdClearColorImage = nullptr;
+  PFN_vkCmdClearDepthStencilImage vkCmdClearDepthStencilImage = nullptr;
+  PFN_vkCmdCopyAccelerationStructureKHR vkCmdCopyAccelerationStructureKHR = nullptr;
+  PFN_vkCmdCopyAccelerationStructureNV vkCmdCopyAccelerationStructureNV = nullptr;
+  PFN_vkCmdCopyAccelerationStructureToMemoryKHR vkCmdCopyAccelerationStructureToMemoryKHR = nullptr;
+  PFN_vkCmdCopyBuffer vkCmdCopyBuffer = nullptr;
+  PFN_vkCmdCopyBufferToImage vkCmdCopyBufferToImage = nullptr;
+  PFN_vkCmdCopyImage vkCmdCopyImage = nullptr;
+  PFN_vkCmdCopyImageToBuffer vkCmdCopyImageToBuffer = nullptr;
+  PFN_vkCmdCopyMemoryToAccelerationStructureKHR vkCmdCopyMemoryToAccelerationStructureKHR = nullptr;
+  PFN_vkCmdCopyQueryPoolResults vkCmdCopyQueryPoolResults = nullptr;
+  PFN_vkCmdDebugMarkerBeginEXT vkCmdDebugMarkerBeginEXT = nullptr;
+  PFN_vkCmdDebugMarkerEndEXT vkCmdDebugMarkerEndEXT = nullptr;
+  PFN_vkCmdDebugMarkerInsertEXT vkCmdDebugMarkerInsertEXT = nullptr;
+  PFN_vkCmdDispatchBase vkCmdDispatchBase = nullptr;
+  PFN_vkCmdDispatchBaseKHR vkCmdDispatchBaseKHR = nullptr;
+  PFN_vkCmdDrawIndexedIndirectCount vkCmdDrawIndexedIndirectCount = nullptr;
+  PFN_vkCmdDrawIndexedIndirectCountAMD vkCmdDrawIndexedIndirectCountAMD = nullptr;
+  PFN_vkCmdDrawIndexedIndirectCountKHR vkCmdDrawIndexedIndirectCountKHR = nullptr;
+  PFN_vkCmdDrawIndirectByteCountEXT vkCmdDrawIndirectByteCountEXT = nullptr;
+  PFN_vkCmdDrawIndirectCount vkCmdDrawIndirectCount = nullptr;
+  PFN_vkCmdDrawIndirectCountAMD vkCmdDrawIndirectCountAMD = nullptr;
+  PFN_vkCmdDrawIndirectCountKHR vkCmdDrawIndirectCountKHR = nullptr;
+  PFN_vkCmdDrawMeshTasksIndirectCountNV vkCmdDrawMeshTasksIndirectCountNV = nullptr;
+  PFN_vkCmdDrawMeshTasksIndirectNV vkCmdDrawMeshTasksIndirectNV = nullptr;
+  PFN_vkCmdDrawMeshTasksNV vkCmdDrawMeshTasksNV = nullptr;
+  PFN_vkCmdEndConditionalRenderingEXT vkCmdEndConditionalRenderingEXT = nullptr;
+  PFN_vkCmdEndDebugUtilsLabelEXT vkCmdEndDebugUtilsLabelEXT = nullptr;
+  PFN_vkCmdEndQuery vkCmdEndQuery = nullptr;
+  PFN_vkCmdEndQueryIndexedEXT vkCmdEndQueryIndexedEXT = nullptr;
+  PFN_vkCmdEndRenderPass2 vkCmdEndRenderPass2 = nullptr;
+  PFN_vkCmdEndRenderPass2KHR vkCmdEndRenderPass2KHR = nullptr;
+  PFN_vkCmdEndTransformFeedbackEXT vkCmdEndTransformFeedbackEXT = nullptr;
+  PFN_vkCmdExecuteGeneratedCommandsNV vkCmdExecuteGeneratedCommandsNV = nullptr;
+  PFN_vkCmdFillBuffer vkCmdFillBuffer = nullptr;
+  PFN_vkCmdInsertDebugUtilsLabelEXT vkCmdInsertDebugUtilsLabelEXT = nullptr;
+  PFN_vkCmdNextSubpass2 vkCmdNextSubpass2 = nullptr;
+  PFN_vkCmdNextSubpass2KHR vkCmdNextSubpass2KHR = nullptr;
+  PFN_vkCmdPreprocessGeneratedCommandsNV vkCmdPreprocessGeneratedCommandsNV = nullptr;
+  PFN_vkCmdProcessCommandsNVX vkCmdProcessCommandsNVX = nullptr;
+  PFN_vkCmdPushDescriptorSetKHR vkCmdPushDescriptorSetKHR = nullptr;
+  PFN_vkCmdPushDescriptorSetWithTemplateKHR vkCmdPushDescriptorSetWithTemplateKHR = nullptr;
+  PFN_vkCmdReserveSpaceForCommandsNVX vkCmdReserveSpaceForCommandsNVX = nullptr;
+  PFN_vkCmdResetEvent vkCmdResetEvent = nullptr;
+  PFN_vkCmdResetQueryPool vkCmdResetQueryPool = nullptr;
+  PFN_vkCmdResolveImage vkCmdResolveImage = nullptr;
+  PFN_vkCmdSetCheckpointNV vkCmdSetCheckpointNV = nullptr;
+  PFN_vkCmdSetCoarseSampleOrderNV vkCmdSetCoarseSampleOrderNV = nullptr;
+  PFN_vkCmdSetDeviceMask vkCmdSetDeviceMask = nullptr;
+  PFN_vkCmdSetDeviceMaskKHR vkCmdSetDeviceMaskKHR = nullptr;
+  PFN_vkCmdSetDiscardRectangleEXT vkCmdSetDiscardRectangleEXT = nullptr;
+  PFN_vkCmdSetEvent vkCmdSetEvent = nullptr;
+  PFN_vkCmdSetExclusiveScissorNV vkCmdSetExclusiveScissorNV = nullptr;
+  PFN_vkCmdSetRayTracingPipelineStackSizeKHR vkCmdSetRayTracingPipelineStackSizeKHR = nullptr;
+  PFN_vkCmdSetSampleLocationsEXT vkCmdSetSampleLocationsEXT = nullptr;
+  PFN_vkCmdSetViewportShadingRatePaletteNV vkCmdSetViewportShadingRatePaletteNV = nullptr;
+  PFN_vkCmdSetViewportWScalingNV vkCmdSetViewportWScalingNV = nullptr;
+  PFN_vkCmdTraceRaysIndirectKHR vkCmdTraceRaysIndirectKHR = nullptr;
+  PFN_vkCmdTraceRaysKHR vkCmdTraceRaysKHR = nullptr;
+  PFN_vkCmdTraceRaysNV vkCmdTraceRaysNV = nullptr;
+  PFN_vkCmdUpdateBuffer vkCmdUpdateBuffer = nullptr;
+  PFN_vkCmdWaitEvents vkCmdWaitEvents = nullptr;
+  PFN_vkCmdWriteAccelerationStructuresPropertiesKHR vkCmdWriteAccelerationStructuresPropertiesKHR = nullptr;
+  PFN_vkCmdWriteAccelerationStructuresPropertiesNV vkCmdWriteAccelerationStructuresPropertiesNV = nullptr;
+  PFN_vkCmdWriteBufferMarkerAMD vkCmdWriteBufferMarkerAMD = nullptr;
+  PFN_vkCmdWriteTimestamp vkCmdWriteTimestamp = nullptr;
+
+  // endregion
+};
+
+} // namespace logi
+
+#endif // LOGI_COMMAND_COMMAND_DISPATCH_TABLE_HPP
@@ -0,0 +1,657 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_COMMAND_COMMAND_LIST_HPP
+#define LOGI_COMMAND_COMMAND_LIST_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "logi/base/common.hpp"
+#include "logi/command/command_statistics.hpp"
+
+namespace logi {
+
+class CommandDispatchTable;
+
+/**
+ * @brief Type of a command recorded in CommandList.
+ */
+enum class CommandType : uint32_t {
+  eBindPipeline,
+  eBindDescriptorSets,
+  eBindVertexBuffers,
+  eBindIndexBuffer,
+  ePushConstants,
+  eSetViewport,
+  eSetScissor,
+  eSetLineWidth,
+  eSetDepthBias,
+  eSetBlendConstants,
+  eSetDepthBounds,
+  eSetStencilCompareMask,
+  eSetStencilWriteMask,
+  eSetStencilReference,
+  eDraw,
+  eDrawIndexed,
+  eDrawIndirect,
+  eDrawIndexedIndirect,
+  eDispatch,
+  eDispatchIndirect,
+  eCopyBuffer,
+  eCopyImage,
+  eCopyBufferToImage,
+  eCopyImageToBuffer,
+  eFillBuffer,
+  ePipelineBarrier,
+  eBeginRenderPass,
+  eNextSubpass,
+  eEndRenderPass,
+  eExecuteCommands,
+  eResetQueryPool,
+  eBeginQuery,
+  eEndQuery,
+  eWriteTimestamp
+};
+
+/**
+ * @brief Recorded command stream that is independent of any VkCommandBuffer. Commands are stored in a single linear
+ *        byte buffer as tagged records holding the same arguments as the corresponding CommandBuffer functions, with
+ *        array arguments stored inline after the record. Recording does not touch Vulkan, so a command list can be
+ *        recorded on any thread without command pool synchronization. Clearing the list keeps its capacity, so
+ *        recording a command list that is reused every frame does not allocate once the buffer has grown.
+ *
+ *        Recorded commands can be inspected with the command iterators (e.g. for analysis passes) and replayed into
+ *        any number of command buffers. The pNext chains of recorded structures are not recorded.
+ */
+class CommandList {
+ public:
+  /**
+   * @brief Reference to an array stored inline in a command record.
+   */
+  template <typename T>
+  struct ArrayRef {
+    uint32_t offset;
+    uint32_t count;
+  };
+
+  /**
+   * @brief Header of each command record.
+   */
+  struct Header {
+    CommandType type;
+    uint32_t size;
+  };
+
+  // region Command Records
+
+  struct BindPipeline {
+    static constexpr CommandType kType = CommandType::eBindPipeline;
+    vk::PipelineBindPoint pipelineBindPoint;
+    vk::Pipeline pipeline;
+  };
+
+  struct BindDescriptorSets {
+    static constexpr CommandType kType = CommandType::eBindDescriptorSets;
+    vk::PipelineBindPoint pipelineBindPoint;
+    vk::PipelineLayout layout;
+    uint32_t firstSet;
+    ArrayRef<vk::DescriptorSet> descriptorSets;
+    ArrayRef<uint32_t> dynamicOffsets;
+  };
+
+  struct BindVertexBuffers {
+    static constexpr CommandType kType = CommandType::eBindVertexBuffers;
+    uint32_t firstBinding;
+    ArrayRef<vk::Buffer> buffers;
+    ArrayRef<vk::DeviceSize> offsets;
+  };
+
+  struct BindIndexBuffer {
+    static constexpr CommandType kType = CommandType::eBindIndexBuffer;
+    vk::Buffer buffer;
+    vk::DeviceSize offset;
+    vk::IndexType indexType;
+  };
+
+  struct PushConstants {
+    static constexpr CommandType kType = CommandType::ePushConstants;
+    vk::PipelineLayout layout;
+    vk::ShaderStageFlags stageFlags;
+    uint32_t offset;
+    ArrayRef<std::byte> values;
+  };
+
+  struct SetViewport {
+    static constexpr CommandType kType = CommandType::eSetViewport;
+    uint32_t firstViewport;
+    ArrayRef<vk::Viewport> viewports;
+  };
+
+  struct SetScissor {
+    static constexpr CommandType kType = CommandType::eSetScissor;
+    uint32_t firstScissor;
+    ArrayRef<vk::Rect2D> scissors;
+  };
+
+  struct SetLineWidth {
+    static constexpr CommandType kType = CommandType::eSetLineWidth;
+    float lineWidth;
+  };
+
+  struct SetDepthBias {
+    static constexpr CommandType kType = CommandType::eSetDepthBias;
+    float depthBiasConstantFactor;
+    float depthBiasClamp;
+    float depthBiasSlopeFactor;
+  };
+
+  struct SetBlendConstants {
+    static constexpr CommandType kType = CommandType::eSetBlendConstants;
+    float blendConstants[4];
+  };
+
+  struct SetDepthBounds {
+    static constexpr CommandType kType = CommandType::eSetDepthBounds;
+    float minDepthBounds;
+    float maxDepthBounds;
+  };
+
+  struct SetStencilCompareMask {
+    static constexpr CommandType kType = CommandType::eSetStencilCompareMask;
+    vk::StencilFaceFlags faceMask;
+    uint32_t compareMask;
+  };
+
+  struct SetStencilWriteMask {
+    static constexpr CommandType kType = CommandType::eSetStencilWriteMask;
+    vk::StencilFaceFlags faceMask;
+    uint32_t writeMask;
+  };
+
+  struct SetStencilReference {
+    static constexpr CommandType kType = CommandType::eSetStencilReference;
+    vk::StencilFaceFlags faceMask;
+    uint32_t reference;
+  };
+
+  struct Draw {
+    static constexpr CommandType kType = CommandType::eDraw;
+    uint32_t vertexCount;
+    uint32_t instanceCount;
+    uint32_t firstVertex;
+    uint32_t firstInstance;
+  };
+
+  struct DrawIndexed {
+    static constexpr CommandType kType = CommandType::eDrawIndexed;
+    uint32_t indexCount;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t vertexOffset;
+    uint32_t firstInstance;
+  };
+
+  struct DrawIndirect {
+    static constexpr CommandType kType = CommandType::eDrawIndirect;
+    vk::Buffer buffer;
+    vk::DeviceSize offset;
+    uint32_t drawCount;
+    uint32_t stride;
+  };
+
+  struct DrawIndexedIndirect {
+    static constexpr CommandType kType = CommandType::eDrawIndexedIndirect;
+    vk::Buffer buffer;
+    vk::DeviceSize offset;
+    uint32_t drawCount;
+    uint32_t stride;
+  };
+
+  struct Dispatch {
+    static constexpr CommandType kType = CommandType::eDispatch;
+    uint32_t groupCountX;
+    uint32_t groupCountY;
+    uint32_t groupCountZ;
+  };
+
+  struct DispatchIndirect {
+    static constexpr CommandType kType = CommandType::eDispatchIndirect;
+    vk::Buffer buffer;
+    vk::DeviceSize offset;
+  };
+
+  struct CopyBuffer {
+    static constexpr CommandType kType = CommandType::eCopyBuffer;
+    vk::Buffer srcBuffer;
+    vk::Buffer dstBuffer;
+    ArrayRef<vk::BufferCopy> regions;
+  };
+
+  struct CopyImage {
+    static constexpr CommandType kType = CommandType::eCopyImage;
+    vk::Image srcImage;
+    vk::ImageLayout srcImageLayout;
+    vk::Image dstImage;
+    vk::ImageLayout dstImageLayout;
+    ArrayRef<vk::ImageCopy> regions;
+  };
+
+  struct CopyBufferToImage {
+    static constexpr CommandType kType = CommandType::eCopyBufferToImage;
+    vk::Buffer srcBuffer;
+    vk::Image dstImage;
+    vk::ImageLayout dstImageLayout;
+    ArrayRef<vk::BufferImageCopy> regions;
+  };
+
+  struct CopyImageToBuffer {
+    static constexpr CommandType kType = CommandType::eCopyImageToBuffer;
+    vk::Image srcImage;
+    vk::ImageLayout srcImageLayout;
+    vk::Buffer dstBuffer;
+    ArrayRef<vk::BufferImageCopy> regions;
+  };
+
+  struct FillBuffer {
+    static constexpr CommandType kType = CommandType::eFillBuffer;
+    vk::Buffer dstBuffer;
+    vk::DeviceSize dstOffset;
+    vk::DeviceSize size;
+    uint32_t data;
+  };
+
+  struct PipelineBarrier {
+    static constexpr CommandType kType = CommandType::ePipelineBarrier;
+    vk::PipelineStageFlags srcStageMask;
+    vk::PipelineStageFlags dstStageMask;
+    vk::DependencyFlags dependencyFlags;
+    ArrayRef<vk::MemoryBarrier> memoryBarriers;
+    ArrayRef<vk::BufferMemoryBarrier> bufferMemoryBarriers;
+    ArrayRef<vk::ImageMemoryBarrier> imageMemoryBarriers;
+  };
+
+  struct BeginRenderPass {
+    static constexpr CommandType kType = CommandType::eBeginRenderPass;
+    vk::RenderPass renderPass;
+    vk::Framebuffer framebuffer;
+    vk::Rect2D renderArea;
+    ArrayRef<vk::ClearValue> clearValues;
+    vk::SubpassContents contents;
+  };
+
+  struct NextSubpass {
+    static constexpr CommandType kType = CommandType::eNextSubpass;
+    vk::SubpassContents contents;
+  };
+
+  struct EndRenderPass {
+    static constexpr CommandType kType = CommandType::eEndRenderPass;
+  };
+
+  struct ExecuteCommands {
+    static constexpr CommandType kType = CommandType::eExecuteCommands;
+    ArrayRef<vk::CommandBuffer> commandBuffers;
+  };
+
+  struct ResetQueryPool {
+    static constexpr CommandType kType = CommandType::eResetQueryPool;
+    vk::QueryPool queryPool;
+    uint32_t firstQuery;
+    uint32_t queryCount;
+  };
+
+  struct BeginQuery {
+    static constexpr CommandType kType = CommandType::eBeginQuery;
+    vk::QueryPool queryPool;
+    uint32_t query;
+    vk::QueryControlFlags flags;
+  };
+
+  struct EndQuery {
+    static constexpr CommandType kType = CommandType::eEndQuery;
+    vk::QueryPool queryPool;
+    uint32_t query;
+  };
+
+  struct WriteTimestamp {
+    static constexpr CommandType kType = CommandType::eWriteTimestamp;
+    vk::PipelineStageFlagBits pipelineStage;
+    vk::QueryPool queryPool;
+    uint32_t query;
+  };
+
+  // endregion
+
+  /**
+   * @brief View of a single recorded command.
+   */
+  class Command {
+   public:
+    explicit Command(const Header* header) : header_(header) {}
+
+    CommandType type() const {
+      return header_->type;
+    }
+
+    /**
+     * @brief Size of the record in bytes, including the header and inline arrays.
+     */
+    uint32_t size() const {
+      return header_->size;
+    }
+
+    /**
+     * @brief Access command arguments. T must match the type of the command.
+     */
+    template <typename T>
+    const T& get() const {
+      assert(T::kType == header_->type);
+      return *reinterpret_cast<const T*>(header_ + 1);
+    }
+
+    /**
+     * @brief Access array argument of the command.
+     */
+    template <typename T>
+    const T* data(const ArrayRef<T>& array) const {
+      return reinterpret_cast<const T*>(reinterpret_cast<const std::byte*>(header_) + array.offset);
+    }
+
+   private:
+    const Header* header_;
+  };
+
+  /**
+   * @brief Forward iterator over recorded commands.
+   */
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Command;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Command*;
+    using reference = Command;
+
+    explicit const_iterator(const std::byte* position) : position_(position) {}
+
+    Command operator*() const {
+      return Command(reinterpret_cast<const Header*>(position_));
+    }
+
+    const_iterator& operator++() {
+      position_ += reinterpret_cast<const Header*>(position_)->size;
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      return position_ == other.position_;
+    }
+
+    bool operator!=(const const_iterator& other) const {
+      return position_ != other.position_;
+    }
+
+   private:
+    const std::byte* position_;
+  };
+
+  /**
+   * @brief Alignment of command records and inline arrays.
+   */
+  static constexpr size_t kAlignment = 8u;
+
+  /**
+   * @brief Create empty command list.
+   *
+   * @param capacity  Initial capacity in bytes.
+   */
+  explicit CommandList(size_t capacity = 0u);
+
+  // region Recording
+
+  void bindPipeline(vk::PipelineBindPoint pipelineBindPoint, vk::Pipeline pipeline);
+
+  void bindDescriptorSets(vk::PipelineBindPoint pipelineBindPoint, vk::PipelineLayout layout, uint32_t firstSet,
+                          vk::ArrayProxy<const vk::DescriptorSet> descriptorSets,
+                          vk::ArrayProxy<const uint32_t> dynamicOffsets = {});
+
+  void bindVertexBuffers(uint32_t firstBinding, vk::ArrayProxy<const vk::Buffer> buffers,
+                         vk::ArrayProxy<const vk::DeviceSize> offsets);
+
+  void bindIndexBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType indexType);
+
+  template <typename T>
+  void pushConstants(vk::PipelineLayout layout, vk::ShaderStageFlags stageFlags, uint32_t offset,
+                     vk::ArrayProxy<const T> values) {
+    static_assert(std::is_standard_layout<T>::value, "Push constant values must be standard layout types.");
+    size_t record = beginCommand(PushConstants {layout, stageFlags, offset, {}});
+    at<PushConstants>(record).values = appendArray(
+      record, reinterpret_cast<const std::byte*>(values.data()), static_cast<size_t>(values.size()) * sizeof(T));
+  }
+
+  void setViewport(uint32_t firstViewport, vk::ArrayProxy<const vk::Viewport> viewports);
+
+  void setScissor(uint32_t firstScissor, vk::ArrayProxy<const vk::Rect2D> scissors);
+
+  void setLineWidth(float lineWidth);
+
+  void setDepthBias(float depthBiasConstantFactor, float depthBiasClamp, float depthBiasSlopeFactor);
+
+  void setBlendConstants(const float blendConstants[4]);
+
+  void setDepthBounds(float minDepthBounds, float maxDepthBounds);
+
+  void setStencilCompareMask(vk::StencilFaceFlags faceMask, uint32_t compareMask);
+
+  void setStencilWriteMask(vk::StencilFaceFlags faceMask, uint32_t writeMask);
+
+  void setStencilReference(vk::StencilFaceFlags faceMask, uint32_t reference);
+
+  void draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance);
+
+  void drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset,
+                   uint32_t firstInstance);
+
+  void drawIndirect(vk::Buffer buffer, vk::DeviceSize offset, uint32_t drawCount, uint32_t stride);
+
+  void drawIndexedIndirect(vk::Buffer buffer, vk::DeviceSize offset, uint32_t drawCount, uint32_t stride);
+
+  void dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
+
+  void dispatchIndirect(vk::Buffer buffer, vk::DeviceSize offset);
+
+  void copyBuffer(vk::Buffer srcBuffer, vk::Buffer dstBuffer, vk::ArrayProxy<const vk::BufferCopy> regions);
+
+  void copyImage(vk::Image srcImage, vk::ImageLayout srcImageLayout, vk::Image dstImage, vk::ImageLayout dstImageLayout,
+                 vk::ArrayProxy<const vk::ImageCopy> regions);
+
+  void copyBufferToImage(vk::Buffer srcBuffer, vk::Image dstImage, vk::ImageLayout dstImageLayout,
+                         vk::ArrayProxy<const vk::BufferImageCopy> regions);
+
+  void copyImageToBuffer(vk::Image srcImage, vk::ImageLayout srcImageLayout, vk::Buffer dstBuffer,
+                         vk::ArrayProxy<const vk::BufferImageCopy> regions);
+
+  void fillBuffer(vk::Buffer dstBuffer, vk::DeviceSize dstOffset, vk::DeviceSize size, uint32_t data);
+
+  void pipelineBarrier(const vk::PipelineStageFlags& srcStageMask, const vk::PipelineStageFlags& dstStageMask,
+                       const vk::DependencyFlags& dependencyFlags,
+                       vk::ArrayProxy<const vk::MemoryBarrier> memoryBarriers,
+                       vk::ArrayProxy<const vk::BufferMemoryBarrier> bufferMemoryBarriers,
+                       vk::ArrayProxy<const vk::ImageMemoryBarrier> imageMemoryBarriers);
+
+  void beginRenderPass(const vk::RenderPassBeginInfo& renderPassBegin, vk::SubpassContents contents);
+
+  void nextSubpass(vk::SubpassContents contents);
+
+  void endRenderPass();
+
+  void executeCommands(vk::ArrayProxy<const vk::CommandBuffer> commandBuffers);
+
+  void resetQueryPool(vk::QueryPool queryPool, uint32_t firstQuery, uint32_t queryCount);
+
+  void beginQuery(vk::QueryPool queryPool, uint32_t query, const vk::QueryControlFlags& flags);
+
+  void endQuery(vk::QueryPool queryPool, uint32_t query);
+
+  void writeTimestamp(vk::PipelineStageFlagBits pipelineStage, vk::QueryPool queryPool, uint32_t query);
+
+  /**
+   * @brief Append all commands of another command list.
+   */
+  void append(const CommandList& other);
+
+  // endregion
+
+  // region Replay
+
+  /**
+   * @brief Record all commands into the given command buffer. The command list is not modified and can be replayed
+   *        into any number of command buffers.
+   *
+   * @param commandBuffer Command buffer in the recording state.
+   * @param dispatch      Dispatch table of the device that owns the command buffer.
+   */
+  void replay(vk::CommandBuffer commandBuffer, const CommandDispatchTable& dispatch) const;
+
+  // endregion
+
+  // region Inspection
+
+  const_iterator begin() const;
+
+  const_iterator end() const;
+
+  /**
+   * @brief Number of recorded commands.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Check if there are no recorded commands.
+   */
+  bool empty() const;
+
+  /**
+   * @brief Size of the recorded command stream in bytes.
+   */
+  size_t byteSize() const;
+
+  /**
+   * @brief Number of bytes the command stream can hold without reallocating.
+   */
+  size_t capacity() const;
+
+  /**
+   * @brief Counters of the recorded commands (see CommandStatistics), added to the statistics of the command buffers
+   *        the list is replayed into. Commands of executed secondary command buffers are not included.
+   */
+  const CommandStatistics& getStatistics() const;
+
+  /**
+   * @brief Remove all commands, keeping the allocated capacity.
+   */
+  void clear();
+
+  // endregion
+
+ private:
+  /**
+   * @brief Append command record and return its offset in the stream.
+   */
+  template <typename T>
+  size_t beginCommand(const T& command) {
+    static_assert(std::is_standard_layout<T>::value, "Command records must be standard layout types.");
+    static_assert(alignof(T) <= kAlignment, "Command record alignment exceeds stream alignment.");
+
+    size_t record = data_.size();
+    size_t size = alignSize(sizeof(Header) + sizeof(T));
+    data_.resize(record + size);
+
+    Header header {T::kType, static_cast<uint32_t>(size)};
+    std::memcpy(data_.data() + record, &header, sizeof(Header));
+    new (data_.data() + record + sizeof(Header)) T(command);
+    commandCount_++;
+
+    return record;
+  }
+
+  /**
+   * @brief Append array to the last command record and return the reference to it.
+   */
+  template <typename T>
+  ArrayRef<T> appendArray(size_t record, const T* values, size_t count) {
+    // Vulkan structures are C layout compatible and are copied bitwise.
+    static_assert(std::is_standard_layout<T>::value, "Command arrays must be standard layout types.");
+
+    size_t offset = data_.size() - record;
+    size_t size = alignSize(count * sizeof(T));
+    if (size > 0u) {
+      data_.resize(data_.size() + size);
+      std::memcpy(data_.data() + record + offset, values, count * sizeof(T));
+      reinterpret_cast<Header*>(data_.data() + record)->size += static_cast<uint32_t>(size);
+    }
+
+    return ArrayRef<T> {static_cast<uint32_t>(offset), static_cast<uint32_t>(count)};
+  }
+
+  template <typename T>
+  ArrayRef<T> appendArray(size_t record, const vk::ArrayProxy<const T>& values) {
+    return appendArray(record, values.data(), static_cast<size_t>(values.size()));
+  }
+
+  template <typename T>
+  T& at(size_t record) {
+    return *reinterpret_cast<T*>(data_.data() + record + sizeof(Header));
+  }
+
+  /**
+   * @brief Clear the pNext chains of the structures of the array. Chains belong to the caller and would dangle by the
+   *        time the list is replayed.
+   */
+  template <typename T>
+  void clearNext(size_t record, const ArrayRef<T>& array) {
+    T* values = reinterpret_cast<T*>(data_.data() + record + array.offset);
+    for (uint32_t i = 0u; i < array.count; i++) {
+      values[i].pNext = nullptr;
+    }
+  }
+
+  static constexpr size_t alignSize(size_t size) {
+    return (size + kAlignment - 1u) / kAlignment * kAlignment;
+  }
+
+  std::vector<std::byte> data_;
+  size_t commandCount_;
+  CommandStatistics statistics_;
+};
+
+} // namespace logi
+
+#endif // LOGI_COMMAND_COMMAND_LIST_HPP
@@ -91,6 +91,18 @@ class CommandPool : public Handle<CommandPoolImpl> {
 
   const vk::DispatchLoaderDynamic& getDispatcher() const;
 
+  /**
+   * @brief Enable or disable command statistics of command buffers allocated from the pool. Takes effect the next time a
+   *        command buffer begins recording. Statistics are enabled by default, but are only collected when Logi is built
+   *        with LOGI_COMMAND_STATISTICS.
+   */
+  void setCommandStatistics(bool enabled) const;
+
+  /**
+   * @brief Check whether command buffers allocated from the pool collect command statistics.
+   */
+  bool isCommandStatisticsEnabled() const;
+
   void destroy() const;
 
   operator const vk::CommandPool&() const;
@@ -20,6 +20,7 @@
 #define LOGI_COMMAND_COMMAND_POOL_IMPL_HPP
 
 #include "logi/base/common.hpp"
+#include <atomic>
 #include <optional>
 #include "logi/base/vulkan_object.hpp"
 #include "logi/queue/queue_family_impl.hpp"
@@ -74,6 +75,10 @@ class CommandPoolImpl : public VulkanObject,
 
   const vk::DispatchLoaderDynamic& getDispatcher() const;
 
+  void setCommandStatistics(bool enabled) const;
+
+  bool isCommandStatisticsEnabled() const;
+
   void destroy() const;
 
   operator const vk::CommandPool&() const;
@@ -87,6 +92,7 @@ class CommandPoolImpl : public VulkanObject,
   QueueFamilyImpl& queueFamily_;
   std::optional<vk::AllocationCallbacks> allocator_;
   vk::CommandPool vkCommandPool_;
+  mutable std::atomic<bool> commandStatisticsEnabled_ {true};
 };
 
 } // namespace logi
@@ -0,0 +1,176 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_COMMAND_COMMAND_STATE_CACHE_HPP
+#define LOGI_COMMAND_COMMAND_STATE_CACHE_HPP
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "logi/base/common.hpp"
+
+namespace logi {
+
+/**
+ * @brief Counters of a CommandStateCache.
+ */
+struct StateCacheStatistics {
+  /**
+   * Number of bind and dynamic state commands checked against the cache.
+   */
+  uint64_t filteredCalls = 0u;
+
+  /**
+   * Number of commands that were dropped because they matched the current state.
+   */
+  uint64_t elidedCalls = 0u;
+
+  /**
+   * Number of dropped bindPipeline commands.
+   */
+  uint64_t elidedPipelineBinds = 0u;
+
+  /**
+   * Number of dropped bindDescriptorSets commands.
+   */
+  uint64_t elidedDescriptorSetBinds = 0u;
+
+  /**
+   * Number of dropped bindVertexBuffers and bindIndexBuffer commands.
+   */
+  uint64_t elidedBufferBinds = 0u;
+
+  /**
+   * Number of dropped dynamic state commands (setViewport, setScissor, setLineWidth, ...).
+   */
+  uint64_t elidedDynamicStates = 0u;
+};
+
+/**
+ * @brief Shadow copy of the bind and dynamic state of a command buffer. Each command is first passed to the cache, which
+ *        reports whether it changes the state. Commands that would set the state to its current value can be dropped.
+ *
+ *        The cache is conservative: state that is not known is never assumed. Binding a different graphics pipeline
+ *        forgets the dynamic state, as pipelines that do not declare it dynamic overwrite it. Binding descriptor sets
+ *        with a different pipeline layout forgets the other descriptor sets of the bind point. The owner must
+ *        invalidate the cache whenever the state becomes undefined or is changed by commands that bypass it.
+ */
+class CommandStateCache {
+ public:
+  /**
+   * @brief   Arguments of the following methods match the commands of the same name.
+   *
+   * @return  True if the command changes the state and must be recorded.
+   */
+  bool bindPipeline(vk::PipelineBindPoint pipelineBindPoint, vk::Pipeline pipeline);
+
+  bool bindDescriptorSets(vk::PipelineBindPoint pipelineBindPoint, vk::PipelineLayout layout, uint32_t firstSet,
+                          vk::ArrayProxy<const vk::DescriptorSet> descriptorSets,
+                          vk::ArrayProxy<const uint32_t> dynamicOffsets);
+
+  bool bindVertexBuffers(uint32_t firstBinding, vk::ArrayProxy<const vk::Buffer> buffers,
+                         vk::ArrayProxy<const vk::DeviceSize> offsets);
+
+  bool bindIndexBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType indexType);
+
+  bool setViewport(uint32_t firstViewport, vk::ArrayProxy<const vk::Viewport> viewports);
+
+  bool setScissor(uint32_t firstScissor, vk::ArrayProxy<const vk::Rect2D> scissors);
+
+  bool setLineWidth(float lineWidth);
+
+  bool setDepthBias(float depthBiasConstantFactor, float depthBiasClamp, float depthBiasSlopeFactor);
+
+  bool setBlendConstants(const float blendConstants[4]);
+
+  bool setDepthBounds(float minDepthBounds, float maxDepthBounds);
+
+  bool setStencilCompareMask(vk::StencilFaceFlags faceMask, uint32_t compareMask);
+
+  bool setStencilWriteMask(vk::StencilFaceFlags faceMask, uint32_t writeMask);
+
+  bool setStencilReference(vk::StencilFaceFlags faceMask, uint32_t reference);
+
+  /**
+   * @brief Forget the pipeline and descriptor sets bound to the bind point.
+   */
+  void invalidateBindPoint(vk::PipelineBindPoint pipelineBindPoint);
+
+  /**
+   * @brief Forget all state. Statistics are kept.
+   */
+  void invalidate();
+
+  const StateCacheStatistics& getStatistics() const;
+
+ private:
+  struct DescriptorSetBinding {
+    vk::DescriptorSet descriptorSet;
+    uint32_t firstSet = 0u;
+    uint32_t setCount = 0u;
+    std::vector<uint32_t> dynamicOffsets;
+  };
+
+  struct IndexBufferBinding {
+    vk::Buffer buffer;
+    vk::DeviceSize offset = 0u;
+    vk::IndexType indexType = vk::IndexType::eUint16;
+  };
+
+  struct BindPointState {
+    vk::Pipeline pipeline;
+    vk::PipelineLayout layout;
+    std::vector<std::optional<DescriptorSetBinding>> descriptorSets;
+  };
+
+  struct DynamicState {
+    std::vector<std::optional<vk::Viewport>> viewports;
+    std::vector<std::optional<vk::Rect2D>> scissors;
+    std::optional<float> lineWidth;
+    std::optional<std::array<float, 3>> depthBias;
+    std::optional<std::array<float, 4>> blendConstants;
+    std::optional<std::array<float, 2>> depthBounds;
+    std::array<std::optional<uint32_t>, 2> stencilCompareMask;
+    std::array<std::optional<uint32_t>, 2> stencilWriteMask;
+    std::array<std::optional<uint32_t>, 2> stencilReference;
+  };
+
+  /**
+   * @brief Index of the bind point state.
+   */
+  static size_t getBindPointIndex(vk::PipelineBindPoint pipelineBindPoint);
+
+  /**
+   * @brief Update per face stencil state.
+   */
+  bool setStencilState(std::array<std::optional<uint32_t>, 2>& state, vk::StencilFaceFlags faceMask, uint32_t value);
+
+  bool elide(uint64_t& counter);
+
+  std::array<BindPointState, 3u> bindPoints_;
+  std::vector<std::optional<std::pair<vk::Buffer, vk::DeviceSize>>> vertexBuffers_;
+  std::optional<IndexBufferBinding> indexBuffer_;
+  DynamicState dynamicState_;
+  StateCacheStatistics statistics_;
+};
+
+} // namespace logi
+
+#endif // LOGI_COMMAND_COMMAND_STATE_CACHE_HPP
@@ -0,0 +1,117 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_COMMAND_COMMAND_STATISTICS_HPP
+#define LOGI_COMMAND_COMMAND_STATISTICS_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include "logi/base/common.hpp"
+
+namespace logi {
+
+/**
+ * @brief Counters of recorded commands. Collected per command buffer when LOGI_ENABLE_COMMAND_STATISTICS is defined and
+ *        aggregated per queue submit and per frame (see Queue::getLastSubmitStatistics). Commands recorded into
+ *        secondary command buffers are counted by the secondary command buffers and added to the primary command
+ *        buffer that executes them.
+ */
+struct CommandStatistics {
+  CommandStatistics& operator+=(const CommandStatistics& other);
+
+  /**
+   * Number of command buffer recordings the statistics cover.
+   */
+  uint64_t commandBuffers = 0u;
+
+  /**
+   * Number of draw commands, including indirect and mesh task draws.
+   */
+  uint64_t draws = 0u;
+
+  /**
+   * Number of dispatch and trace rays commands.
+   */
+  uint64_t dispatches = 0u;
+
+  /**
+   * Number of pipelineBarrier and waitEvents commands.
+   */
+  uint64_t barrierCommands = 0u;
+
+  /**
+   * Number of memory, buffer and image barriers of the barrier commands.
+   */
+  uint64_t barriers = 0u;
+
+  /**
+   * Number of bindDescriptorSets and push descriptor commands.
+   */
+  uint64_t descriptorSetBinds = 0u;
+
+  /**
+   * Number of bindPipeline commands.
+   */
+  uint64_t pipelineBinds = 0u;
+
+  /**
+   * Number of copy, blit, resolve, update and fill commands.
+   */
+  uint64_t copies = 0u;
+
+  /**
+   * Number of bytes written by buffer copies, updates and fills. Copies that involve images are not included, as their
+   * texel size is not known to the command buffer.
+   */
+  uint64_t copyBytes = 0u;
+};
+
+CommandStatistics operator+(CommandStatistics lhs, const CommandStatistics& rhs);
+
+/**
+ * @brief Statistics of the command buffers of a logical device, looked up by their Vulkan handles when the command
+ *        buffers are submitted or executed by a primary command buffer. Thread safe.
+ */
+class CommandStatisticsRegistry {
+ public:
+  /**
+   * @brief Register the statistics of the command buffer. The statistics must outlive the registration.
+   */
+  void add(const vk::CommandBuffer& commandBuffer, const CommandStatistics& statistics);
+
+  void remove(const vk::CommandBuffer& commandBuffer);
+
+  /**
+   * @brief Add the statistics of the given command buffers. Unregistered command buffers are skipped.
+   */
+  void accumulate(const vk::ArrayProxy<const vk::CommandBuffer>& commandBuffers, CommandStatistics& statistics) const;
+
+  /**
+   * @brief Add the statistics of the command buffers of the given submits.
+   */
+  void accumulate(const vk::ArrayProxy<const vk::SubmitInfo>& submits, CommandStatistics& statistics) const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_map<VkCommandBuffer, const CommandStatistics*> statistics_;
+};
+
+} // namespace logi
+
+#endif // LOGI_COMMAND_COMMAND_STATISTICS_HPP
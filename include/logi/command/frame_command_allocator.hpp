@@ -0,0 +1,147 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_COMMAND_FRAME_COMMAND_ALLOCATOR_HPP
+#define LOGI_COMMAND_FRAME_COMMAND_ALLOCATOR_HPP
+
+#include <array>
+#include <vector>
+#include "logi/base/common.hpp"
+#include "logi/command/command_buffer.hpp"
+#include "logi/command/command_pool.hpp"
+#include "logi/synchronization/fence.hpp"
+#include "logi/synchronization/semaphore.hpp"
+
+namespace logi {
+
+class QueueFamily;
+
+/**
+ * @brief Ring of transient command pools, one per frame in flight. Command buffers are handed out linearly from the pool
+ *        of the current frame and are never freed individually. When a frame is reused, the allocator waits for the
+ *        fence or timeline semaphore value its commands were submitted with and recycles all of its command buffers at
+ *        once with vkResetCommandPool. Once the pools have grown to the steady state, acquiring a command buffer is O(1)
+ *        and does not allocate.
+ *
+ *        Like the command pools it owns, the allocator must be externally synchronized.
+ */
+class FrameCommandAllocator {
+ public:
+  FrameCommandAllocator() = default;
+
+  /**
+   * @brief Create a command pool for each frame in flight.
+   *
+   * @param queueFamily     Queue family of the command pools.
+   * @param framesInFlight  Number of frames that may be recorded or executed at the same time.
+   * @param flags           Command pool create flags.
+   *
+   * @throws  IllegalInvocation If framesInFlight is zero.
+   */
+  FrameCommandAllocator(const QueueFamily& queueFamily, uint32_t framesInFlight,
+                        const vk::CommandPoolCreateFlags& flags = vk::CommandPoolCreateFlagBits::eTransient);
+
+  /**
+   * @brief Use the given command pools, one per frame in flight. The allocator takes ownership of the pools and
+   *        destroys them in destroy().
+   *
+   * @param commandPools  Command pools of the frames.
+   *
+   * @throws  IllegalInvocation If commandPools is empty.
+   */
+  explicit FrameCommandAllocator(std::vector<CommandPool> commandPools);
+
+  /**
+   * @brief   Advance to the next frame. Waits until the commands recorded when the frame was last used have retired,
+   *          resets the frame's command pool and rewinds its command buffers. Does nothing if the allocator has no
+   *          frames (default constructed or destroyed).
+   *
+   * @return  Index of the frame.
+   */
+  uint32_t beginFrame();
+
+  /**
+   * @brief   Acquire command buffer from the pool of the current frame. The command buffer is in the initial state and
+   *          is valid until the frame is reused.
+   *
+   * @param   level Command buffer level.
+   * @return  Command buffer.
+   *
+   * @throws  IllegalInvocation If the allocator has no frames.
+   */
+  CommandBuffer allocateCommandBuffer(vk::CommandBufferLevel level = vk::CommandBufferLevel::ePrimary);
+
+  /**
+   * @brief Mark the current frame as submitted with the given fence. The frame is recycled after the fence is signaled.
+   *        Does nothing if the allocator has no frames.
+   */
+  void endFrame(const Fence& fence);
+
+  /**
+   * @brief Mark the current frame as submitted with the given timeline semaphore signal value. The frame is recycled after
+   *        the semaphore reaches the value. Does nothing if the allocator has no frames.
+   */
+  void endFrame(const Semaphore& timelineSemaphore, uint64_t value);
+
+  /**
+   * @brief Index of the current frame.
+   */
+  uint32_t getFrameIndex() const;
+
+  /**
+   * @brief Number of frames in flight.
+   */
+  uint32_t getFramesInFlight() const;
+
+  /**
+   * @brief Command pool of the given frame.
+   */
+  const CommandPool& getCommandPool(uint32_t frameIndex) const;
+
+  /**
+   * @brief Number of command buffers owned by all frames.
+   */
+  size_t getCommandBufferCount() const;
+
+  /**
+   * @brief Destroy command pools of all frames. The caller must ensure that the GPU is no longer using them.
+   */
+  void destroy();
+
+ private:
+  struct Frame {
+    CommandPool commandPool;
+    std::array<std::vector<CommandBuffer>, 2u> commandBuffers;
+    std::array<size_t, 2u> usedCommandBuffers {};
+    Fence fence;
+    Semaphore timelineSemaphore;
+    uint64_t timelineValue = 0u;
+  };
+
+  /**
+   * @brief Wait until the commands recorded in the frame have retired.
+   */
+  static void waitRetired(Frame& frame);
+
+  std::vector<Frame> frames_;
+  uint32_t frameIndex_ = 0u;
+};
+
+} // namespace logi
+
+#endif // LOGI_COMMAND_FRAME_COMMAND_ALLOCATOR_HPP
@@ -0,0 +1,160 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_COMMAND_PARALLEL_COMMAND_RECORDER_HPP
+#define LOGI_COMMAND_PARALLEL_COMMAND_RECORDER_HPP
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "logi/base/common.hpp"
+#include "logi/command/command_buffer.hpp"
+#include "logi/command/frame_command_allocator.hpp"
+
+namespace logi {
+
+class QueueFamily;
+
+/**
+ * @brief Records a render pass on multiple threads. The draw list is split into contiguous ranges, one per thread. Each
+ *        thread records its range into a secondary command buffer allocated from its own FrameCommandAllocator, so
+ *        no command pool is ever used by more than one thread. The primary command buffer executes the secondary
+ *        command buffers in range order, which preserves the submission order of the draws.
+ *
+ *        The calling thread records the first range, the remaining ranges are recorded by threadCount - 1 worker
+ *        threads owned by the recorder. The recorder itself must be externally synchronized.
+ */
+class ParallelCommandRecorder {
+ public:
+  /**
+   * @brief Records draws [begin, end) of the draw list into the given secondary command buffer. The command buffer is
+   *        already in the recording state and inherits the render pass, subpass and framebuffer.
+   */
+  using RecordFunction = std::function<void(const CommandBuffer& commandBuffer, size_t begin, size_t end)>;
+
+  ParallelCommandRecorder() = default;
+
+  /**
+   * @brief Create command pools and start worker threads.
+   *
+   * @param queueFamily     Queue family of the command pools.
+   * @param threadCount     Number of recording threads, including the calling thread.
+   * @param framesInFlight  Number of frames in flight of each thread's FrameCommandAllocator.
+   */
+  ParallelCommandRecorder(const QueueFamily& queueFamily, uint32_t threadCount, uint32_t framesInFlight = 1u);
+
+  ParallelCommandRecorder(const ParallelCommandRecorder&) = delete;
+
+  ParallelCommandRecorder& operator=(const ParallelCommandRecorder&) = delete;
+
+  ~ParallelCommandRecorder();
+
+  /**
+   * @brief   Advance all threads to the next frame. See FrameCommandAllocator::beginFrame.
+   *
+   * @return  Index of the frame.
+   */
+  uint32_t beginFrame();
+
+  /**
+   * @brief Mark the current frame as submitted with the given fence. See FrameCommandAllocator::endFrame.
+   */
+  void endFrame(const Fence& fence);
+
+  /**
+   * @brief Mark the current frame as submitted with the given timeline semaphore signal value. See
+   *        FrameCommandAllocator::endFrame.
+   */
+  void endFrame(const Semaphore& timelineSemaphore, uint64_t value);
+
+  /**
+   * @brief   Record draws of the subpass into secondary command buffers in parallel.
+   *
+   * @param   inheritanceInfo Render pass, subpass and framebuffer inherited by the secondary command buffers.
+   * @param   drawCount       Number of draws in the draw list.
+   * @param   record          Function that records a range of draws.
+   * @return  Secondary command buffers in draw list order.
+   */
+  std::vector<CommandBuffer> recordSecondary(const vk::CommandBufferInheritanceInfo& inheritanceInfo, size_t drawCount,
+                                             const RecordFunction& record);
+
+  /**
+   * @brief Begin the render pass in the primary command buffer, record its first subpass in parallel with
+   *        recordSecondary, execute the secondary command buffers and end the render pass.
+   *
+   * @param primaryCommandBuffer  Primary command buffer in the recording state.
+   * @param renderPassBegin       Render pass begin info.
+   * @param drawCount             Number of draws in the draw list.
+   * @param record                Function that records a range of draws.
+   */
+  void recordRenderPass(const CommandBuffer& primaryCommandBuffer, const vk::RenderPassBeginInfo& renderPassBegin,
+                        size_t drawCount, const RecordFunction& record);
+
+  /**
+   * @brief Number of recording threads, including the calling thread.
+   */
+  uint32_t getThreadCount() const;
+
+  /**
+   * @brief Stop worker threads and destroy command pools. The caller must ensure that the GPU is no longer using them.
+   */
+  void destroy();
+
+ private:
+  struct Task {
+    vk::CommandBufferInheritanceInfo inheritanceInfo;
+    const RecordFunction* record = nullptr;
+    size_t begin = 0u;
+    size_t end = 0u;
+    CommandBuffer commandBuffer;
+  };
+
+  /**
+   * @brief Record the task with the allocator of the given thread.
+   */
+  void execute(size_t threadIndex, Task& task);
+
+  /**
+   * @brief Worker thread loop.
+   */
+  void work(size_t threadIndex);
+
+  /**
+   * @brief Stop and join worker threads.
+   */
+  void stopWorkers();
+
+  std::vector<FrameCommandAllocator> allocators_;
+  std::vector<Task> tasks_;
+  std::vector<std::thread> workers_;
+
+  std::mutex mutex_;
+  std::condition_variable workAvailable_;
+  std::condition_variable workDone_;
+  uint64_t generation_ = 0u;
+  size_t pendingTasks_ = 0u;
+  bool stopping_ = false;
+  std::exception_ptr error_;
+};
+
+} // namespace logi
+
+#endif // LOGI_COMMAND_PARALLEL_COMMAND_RECORDER_HPP
@@ -47,7 +47,7 @@ class DescriptorPoolImpl : public VulkanObject,
   vk::ResultValueType<void>::type freeDescriptorSets(const std::vector<size_t>& descriptorSetIds);
 
   vk::ResultValueType<void>::type
-    reset(const vk::DescriptorPoolResetFlags& flags = vk::DescriptorPoolResetFlags()) const;
+    reset(const vk::DescriptorPoolResetFlags& flags = vk::DescriptorPoolResetFlags());
 
   // endregion
 
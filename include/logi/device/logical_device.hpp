@@ -88,6 +88,11 @@ class LogicalDevice : public Handle<LogicalDeviceImpl> {
    */
   void destroyBuffer(const Buffer& buffer) const;
 
+  /**
+   * @brief Destroy the given buffers at once.
+   */
+  void destroyBuffers(const std::vector<Buffer>& buffers) const;
+
   /**
    * @brief Reference: <a href="https://www.khronos.org/registry/vulkan/specs/1.2-extensions/man/html/vkCreateImage.html">vkCreateImage</a>
    */
@@ -98,6 +103,11 @@ class LogicalDevice : public Handle<LogicalDeviceImpl> {
    */
   void destroyImage(const Image& image) const;
 
+  /**
+   * @brief Destroy the given images at once.
+   */
+  void destroyImages(const std::vector<Image>& images) const;
+
   /**
    * @brief Reference: <a href="https://www.khronos.org/registry/vulkan/specs/1.2-extensions/man/html/vkCreateSampler.html">vkCreateSampler</a>
    */
@@ -310,7 +320,7 @@ class LogicalDevice : public Handle<LogicalDeviceImpl> {
   /**
    * @brief Reference: <a href="https://www.khronos.org/registry/vulkan/specs/1.2-extensions/man/html/vkWaitSemaphores.html">vkWaitSemaphores</a>
    */
-  void waitSemaphores(const vk::SemaphoreWaitInfo& waitInfo, uint64_t timeout) const;
+  vk::Result waitSemaphores(const vk::SemaphoreWaitInfo& waitInfo, uint64_t timeout) const;
 
   /**
    * @brief Reference: <a href="https://www.khronos.org/registry/vulkan/specs/1.2-extensions/man/html/vkCreateDeferredOperationKHR.html">vkCreateDeferredOperationKHR</a>
@@ -577,11 +587,78 @@ class LogicalDevice : public Handle<LogicalDeviceImpl> {
 
   const vk::DispatchLoaderDynamic& getDispatcher() const;
 
+  /**
+   * @brief Defer destruction of the given object until the GPU has passed the given value. The handle is kept alive by
+   *        the queue and destroyed by collectDeferredDestructions once its retire value has completed. Objects that were
+   *        already destroyed in the meantime (e.g. together with their parent) are skipped.
+   *
+   * @tparam  HandleType  Type of the destroyed handle. Must provide destroy().
+   * @param   handle      Handle of the object that is destroyed.
+   * @param   retireValue Timeline semaphore value or frame index after which the object is no longer in use.
+   */
+  template <typename HandleType>
+  void destroyDeferred(const HandleType& handle, uint64_t retireValue) const;
+
+  /**
+   * @brief   Destroy all deferred objects whose retire value is less than or equal to the given value.
+   *
+   * @param   completedValue  Last timeline semaphore value or frame index completed by the GPU.
+   * @return  Number of destroyed objects.
+   */
+  size_t collectDeferredDestructions(uint64_t completedValue) const;
+
+  /**
+   * @brief   Destroy all deferred objects whose retire value has been reached by the given timeline semaphore.
+   *
+   * @param   timeline  Timeline semaphore that is signaled as the GPU work completes.
+   * @return  Number of destroyed objects.
+   */
+  size_t collectDeferredDestructions(const Semaphore& timeline) const;
+
+  /**
+   * @brief   Destroy all deferred objects. The caller must ensure that the GPU is no longer using them (e.g. waitIdle).
+   *
+   * @return  Number of destroyed objects.
+   */
+  size_t flushDeferredDestructions() const;
+
+  /**
+   * @brief Number of objects waiting for deferred destruction.
+   */
+  size_t pendingDeferredDestructions() const;
+
+  /**
+   * @brief   Retrieve live counts, churn rates and lifetime histograms of the objects owned by the device and its
+   *          children. Rates are computed relative to the previous call. Requires LOGI_ENABLE_OBJECT_STATISTICS
+   *          (LOGI_OBJECT_STATISTICS CMake option), otherwise an empty snapshot is returned.
+   *
+   * @return  Statistics snapshot.
+   */
+  ObjectStatistics getObjectStatistics() const;
+
+  /**
+   * @brief   Trace recorder of the device. Logi records queue submits and presents, fence and semaphore waits,
+   *          swapchain image acquisition and command buffer recording into it when built with LOGI_ENABLE_TRACE
+   *          (LOGI_TRACE CMake option). Recording is off until TraceRecorder::start is called.
+   *
+   * @return  Trace recorder.
+   */
+  TraceRecorder& getTraceRecorder() const;
+
   void destroy() const;
 
   operator const vk::Device&() const;
 };
 
+template <typename HandleType>
+void LogicalDevice::destroyDeferred(const HandleType& handle, uint64_t retireValue) const {
+  object_->deferDestruction(retireValue, [handle]() {
+    if (handle) {
+      handle.destroy();
+    }
+  });
+}
+
 template <typename T>
 vk::ResultValueType<void>::type
     LogicalDevice::writeAccelerationStructuresPropertiesKHR(const vk::ArrayProxy<const vk::AccelerationStructureKHR> &accelerationStructures,
@@ -20,14 +20,22 @@
 #define LOGI_DEVICE_LOGICAL_DEVICE_IMPL_HPP
 
 #include "logi/base/common.hpp"
+#include <atomic>
+#include <mutex>
 #include <optional>
+#include <unordered_map>
+#include "logi/base/deferred_destruction_queue.hpp"
+#include "logi/base/trace_recorder.hpp"
 #include "logi/base/vulkan_object.hpp"
+#include "logi/command/command_dispatch_table.hpp"
+#include "logi/command/command_statistics.hpp"
 
 namespace logi {
 
 class VulkanInstanceImpl;
 class PhysicalDeviceImpl;
 class QueueFamilyImpl;
+class CommandBufferImpl;
 class SwapchainKHRImpl;
 class ShaderModuleImpl;
 class PipelineCacheImpl;
@@ -107,11 +115,27 @@ class LogicalDeviceImpl : public VulkanObject,
 
   void destroyBuffer(size_t id);
 
+  /**
+   * @brief Destroy the buffer with the given identifier only if it is the given Vulkan buffer. Buffer handles may be
+   *        owned by another composite (e.g. VMABuffer), whose identifiers can match buffers of this device.
+   */
+  void destroyBuffer(size_t id, const vk::Buffer& vkBuffer);
+
+  void destroyBuffers(const std::vector<size_t>& ids, const std::vector<vk::Buffer>& vkBuffers);
+
   const std::shared_ptr<ImageImpl>& createImage(const vk::ImageCreateInfo& createInfo,
                                                 const std::optional<vk::AllocationCallbacks>& allocator = {});
 
   void destroyImage(size_t id);
 
+  /**
+   * @brief Destroy the image with the given identifier only if it is the given Vulkan image. Image handles may be owned
+   *        by another composite (e.g. VMAImage or SwapchainImage), whose identifiers can match images of this device.
+   */
+  void destroyImage(size_t id, const vk::Image& vkImage);
+
+  void destroyImages(const std::vector<size_t>& ids, const std::vector<vk::Image>& vkImages);
+
   const std::shared_ptr<SamplerImpl>& createSampler(const vk::SamplerCreateInfo& createInfo,
                                                     const std::optional<vk::AllocationCallbacks>& allocator = {});
 
@@ -228,7 +252,7 @@ class LogicalDeviceImpl : public VulkanObject,
 
   void destroySemaphore(size_t id);
 
-  void waitSemaphores(const vk::SemaphoreWaitInfo& waitInfo, uint64_t timeout) const;
+  vk::Result waitSemaphores(const vk::SemaphoreWaitInfo& waitInfo, uint64_t timeout) const;
 
   const std::shared_ptr<DeferredOperationKHRImpl>& 
     createDeferredOperationKHR(const std::optional<vk::AllocationCallbacks>& allocator = {});
@@ -371,6 +395,42 @@ class LogicalDeviceImpl : public VulkanObject,
 
   const vk::DispatchLoaderDynamic& getDispatcher() const;
 
+  const CommandDispatchTable& getCommandDispatchTable() const;
+
+  void deferDestruction(uint64_t retireValue, std::function<void()> destroy) const;
+
+  size_t collectDeferredDestructions(uint64_t completedValue) const;
+
+  size_t flushDeferredDestructions() const;
+
+  size_t pendingDeferredDestructions() const;
+
+  void registerTrackedCommandBuffer(const vk::CommandBuffer& vkCommandBuffer,
+                                    const CommandBufferImpl& commandBuffer) const;
+
+  void unregisterTrackedCommandBuffer(const vk::CommandBuffer& vkCommandBuffer) const;
+
+  const CommandBufferImpl* findTrackedCommandBuffer(const vk::CommandBuffer& vkCommandBuffer) const;
+
+  bool hasTrackedCommandBuffers() const;
+
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+  void registerStatisticsCommandBuffer(const vk::CommandBuffer& vkCommandBuffer,
+                                       const CommandStatistics& statistics) const;
+
+  void unregisterStatisticsCommandBuffer(const vk::CommandBuffer& vkCommandBuffer) const;
+
+  void accumulateCommandStatistics(const vk::ArrayProxy<const vk::SubmitInfo>& submits,
+                                   CommandStatistics& statistics) const;
+
+  void accumulateCommandStatistics(const vk::ArrayProxy<const vk::CommandBuffer>& commandBuffers,
+                                   CommandStatistics& statistics) const;
+#endif
+
+  ObjectStatistics getObjectStatistics() const;
+
+  TraceRecorder& getTraceRecorder() const;
+
   void destroy() const;
 
   operator const vk::Device&() const;
@@ -385,6 +445,19 @@ class LogicalDeviceImpl : public VulkanObject,
   std::optional<vk::AllocationCallbacks> allocator_;
   vk::Device vkDevice_;
   vk::DispatchLoaderDynamic dispatcher_;
+  CommandDispatchTable commandDispatchTable_;
+  mutable DeferredDestructionQueue deferredDestructions_;
+  mutable TraceRecorder traceRecorder_;
+  mutable std::mutex trackedCommandBuffersMutex_;
+  mutable std::unordered_map<VkCommandBuffer, const CommandBufferImpl*> trackedCommandBuffers_;
+  mutable std::atomic<size_t> trackedCommandBufferCount_ {0u};
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+  mutable CommandStatisticsRegistry commandStatistics_;
+#endif
+#ifdef LOGI_ENABLE_OBJECT_STATISTICS
+  mutable std::mutex statisticsMutex_;
+  mutable ObjectRateTracker rateTracker_;
+#endif
 };
 
 template <typename T>
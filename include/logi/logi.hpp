@@ -21,9 +21,18 @@
 
 #include "logi/base/exception.hpp"
 #include "logi/base/handle.hpp"
+#include "logi/base/result.hpp"
+#include "logi/base/trace_recorder.hpp"
 #include "logi/base/vulkan_object.hpp"
+#include "logi/command/barrier_batcher.hpp"
 #include "logi/command/command_buffer.hpp"
+#include "logi/command/command_dispatch_table.hpp"
+#include "logi/command/command_list.hpp"
 #include "logi/command/command_pool.hpp"
+#include "logi/command/command_statistics.hpp"
+#include "logi/command/command_state_cache.hpp"
+#include "logi/command/frame_command_allocator.hpp"
+#include "logi/command/parallel_command_recorder.hpp"
 #include "logi/descriptor/descriptor_pool.hpp"
 #include "logi/descriptor/descriptor_set.hpp"
 #include "logi/descriptor/descriptor_update_template.hpp"
@@ -51,18 +60,29 @@
 #include "logi/program/descriptor_set_layout.hpp"
 #include "logi/program/pipeline_cache.hpp"
 #include "logi/program/pipeline_layout.hpp"
+#include "logi/program/push_constant_block.hpp"
 #include "logi/program/shader_module.hpp"
+#include "logi/query/gpu_profiler.hpp"
+#include "logi/query/gpu_timing.hpp"
 #include "logi/query/query_pool.hpp"
+#include "logi/query/query_results.hpp"
+#include "logi/query/query_service.hpp"
+#include "logi/queue/async_queue.hpp"
 #include "logi/queue/queue.hpp"
 #include "logi/queue/queue_family.hpp"
+#include "logi/queue/submit_batcher.hpp"
 #include "logi/render_pass/framebuffer.hpp"
 #include "logi/render_pass/render_pass.hpp"
+#include "logi/render_graph/render_graph.hpp"
+#include "logi/render_graph/render_graph_plan.hpp"
 #include "logi/surface/surface_khr.hpp"
 #include "logi/swapchain/swapchain_image.hpp"
 #include "logi/swapchain/swapchain_khr.hpp"
 #include "logi/synchronization/event.hpp"
 #include "logi/synchronization/fence.hpp"
+#include "logi/synchronization/gpu_future.hpp"
 #include "logi/synchronization/semaphore.hpp"
+#include "logi/synchronization/resource_state.hpp"
 #include "logi/synchronization/deferred_operation_khr.hpp"
 
 #endif // LOGI_LOGI_HPP
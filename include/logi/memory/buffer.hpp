@@ -101,12 +101,35 @@ class Buffer : public Handle<BufferImpl> {
    */
   void destroyBufferView(const BufferView& bufferView) const;
 
+  /**
+   * @brief Enable tracking of the access state of the buffer ranges. Command buffers use the tracked state in
+   *        CommandBuffer::transition to record minimal barriers.
+   *
+   * @param size  Size of the buffer.
+   */
+  void enableStateTracking(vk::DeviceSize size) const;
+
+  /**
+   * @brief Tracked state of the buffer or nullptr if state tracking is not enabled.
+   */
+  const std::shared_ptr<SharedBufferState>& getTrackedState() const;
+
   VulkanInstance getInstance() const;
 
   PhysicalDevice getPhysicalDevice() const;
 
   LogicalDevice getLogicalDevice() const;
 
+  /**
+   * @brief Non-owning variants of the parent accessors. Do not touch reference counts and are intended for recording
+   *        hot paths.
+   */
+  HandleRef<VulkanInstance> getInstanceRef() const;
+
+  HandleRef<PhysicalDevice> getPhysicalDeviceRef() const;
+
+  HandleRef<LogicalDevice> getLogicalDeviceRef() const;
+
   const vk::DispatchLoaderDynamic& getDispatcher() const;
 
   void destroy() const;
@@ -22,6 +22,7 @@
 #include <optional>
 #include <vk_mem_alloc.h>
 #include "logi/base/vulkan_object.hpp"
+#include "logi/synchronization/resource_state.hpp"
 #include "logi/structures/extension.hpp"
 
 namespace logi {
@@ -72,6 +73,10 @@ class BufferImpl : public VulkanObject,
 
   void destroyBufferView(size_t id);
 
+  void enableStateTracking(vk::DeviceSize size);
+
+  const std::shared_ptr<SharedBufferState>& getTrackedState() const;
+
   VulkanInstanceImpl& getInstance() const;
 
   PhysicalDeviceImpl& getPhysicalDevice() const;
@@ -92,6 +97,7 @@ class BufferImpl : public VulkanObject,
   LogicalDeviceImpl& logicalDevice_;
   vk::Buffer vkBuffer_;
   std::optional<vk::AllocationCallbacks> allocator_;
+  std::shared_ptr<SharedBufferState> trackedState_;
 };
 
 }; // namespace logi
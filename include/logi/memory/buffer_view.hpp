@@ -45,6 +45,18 @@ class BufferView : public Handle<BufferViewImpl> {
 
   Buffer getBuffer() const;
 
+  /**
+   * @brief Non-owning variants of the parent accessors. Do not touch reference counts and are intended for recording
+   *        hot paths.
+   */
+  HandleRef<VulkanInstance> getInstanceRef() const;
+
+  HandleRef<PhysicalDevice> getPhysicalDeviceRef() const;
+
+  HandleRef<LogicalDevice> getLogicalDeviceRef() const;
+
+  HandleRef<Buffer> getBufferRef() const;
+
   const vk::DispatchLoaderDynamic& getDispatcher() const;
 
   void destroy() const;
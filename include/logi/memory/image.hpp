@@ -116,12 +116,39 @@ class Image : public Handle<ImageImpl> {
    */
   void destroyImageView(const ImageView& image) const;
 
+  /**
+   * @brief Enable tracking of the layout and access state of each mip level and array layer. Command buffers use the
+   *        tracked state in CommandBuffer::transition to record minimal barriers.
+   *
+   * @param aspectMask    Aspects of the image. Depth and stencil aspects are tracked together.
+   * @param mipLevels     Number of mip levels of the image.
+   * @param arrayLayers   Number of array layers of the image.
+   * @param currentLayout Current layout of all subresources.
+   */
+  void enableStateTracking(const vk::ImageAspectFlags& aspectMask, uint32_t mipLevels, uint32_t arrayLayers,
+                           vk::ImageLayout currentLayout = vk::ImageLayout::eUndefined) const;
+
+  /**
+   * @brief Tracked state of the image or nullptr if state tracking is not enabled.
+   */
+  const std::shared_ptr<SharedImageState>& getTrackedState() const;
+
   VulkanInstance getInstance() const;
 
   PhysicalDevice getPhysicalDevice() const;
 
   LogicalDevice getLogicalDevice() const;
 
+  /**
+   * @brief Non-owning variants of the parent accessors. Do not touch reference counts and are intended for recording
+   *        hot paths.
+   */
+  HandleRef<VulkanInstance> getInstanceRef() const;
+
+  HandleRef<PhysicalDevice> getPhysicalDeviceRef() const;
+
+  HandleRef<LogicalDevice> getLogicalDeviceRef() const;
+
   const vk::DispatchLoaderDynamic& getDispatcher() const;
 
   void destroy() const;
@@ -22,6 +22,7 @@
 #include <optional>
 #include <variant>
 #include "logi/base/vulkan_object.hpp"
+#include "logi/synchronization/resource_state.hpp"
 #include "logi/structures/extension.hpp"
 
 namespace logi {
@@ -84,6 +85,11 @@ class ImageImpl : public VulkanObject,
 
   void destroyImageView(size_t id);
 
+  void enableStateTracking(const vk::ImageAspectFlags& aspectMask, uint32_t mipLevels, uint32_t arrayLayers,
+                           vk::ImageLayout currentLayout = vk::ImageLayout::eUndefined);
+
+  const std::shared_ptr<SharedImageState>& getTrackedState() const;
+
   VulkanInstanceImpl& getInstance() const;
 
   PhysicalDeviceImpl& getPhysicalDevice() const;
@@ -105,6 +111,7 @@ class ImageImpl : public VulkanObject,
   LogicalDeviceImpl& logicalDevice_;
   vk::Image vkImage_;
   std::optional<vk::AllocationCallbacks> allocator_;
+  std::shared_ptr<SharedImageState> trackedState_;
 };
 
 } // namespace logi
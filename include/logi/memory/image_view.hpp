@@ -56,6 +56,18 @@ class ImageView : public Handle<ImageViewImpl> {
 
   Image getImage() const;
 
+  /**
+   * @brief Non-owning variants of the parent accessors. Do not touch reference counts and are intended for recording
+   *        hot paths.
+   */
+  HandleRef<VulkanInstance> getInstanceRef() const;
+
+  HandleRef<PhysicalDevice> getPhysicalDeviceRef() const;
+
+  HandleRef<LogicalDevice> getLogicalDeviceRef() const;
+
+  HandleRef<Image> getImageRef() const;
+
   const vk::DispatchLoaderDynamic& getDispatcher() const;
 
   void destroy() const;
@@ -46,11 +46,21 @@ class MemoryAllocator : public Handle<MemoryAllocatorImpl> {
 
   void destroyBuffer(const VMABuffer& buffer);
 
+  /**
+   * @brief Destroy the given buffers at once. Memory of all buffers is freed with a single VMA call.
+   */
+  void destroyBuffers(const std::vector<VMABuffer>& buffers);
+
   VMAImage createImage(const vk::ImageCreateInfo& imageCreateInfo, const VmaAllocationCreateInfo& allocationCreateInfo,
                        const std::optional<vk::AllocationCallbacks>& allocator = {});
 
   void destroyImage(const VMAImage& image);
 
+  /**
+   * @brief Destroy the given images at once. Memory of all images is freed with a single VMA call.
+   */
+  void destroyImages(const std::vector<VMAImage>& images);
+
   VMAAccelerationStructureNV
     createAccelerationStructureNV(const vk::AccelerationStructureCreateInfoNV& accelerationStructureCreateInfo,
                                   const VmaAllocationCreateInfo& allocationCreateInfo,
@@ -51,12 +51,16 @@ class MemoryAllocatorImpl : public VulkanObject,
 
   void destroyBuffer(size_t id);
 
+  void destroyBuffers(const std::vector<size_t>& ids);
+
   const std::shared_ptr<VMAImageImpl>& createImage(const vk::ImageCreateInfo& imageCreateInfo,
                                                    const VmaAllocationCreateInfo& allocationCreateInfo,
                                                    const std::optional<vk::AllocationCallbacks>& allocator = {});
 
   void destroyImage(size_t id);
 
+  void destroyImages(const std::vector<size_t>& ids);
+
   const std::shared_ptr<VMAAccelerationStructureNVImpl>&
     createAccelerationStructureNV(const vk::AccelerationStructureCreateInfoNV& accelerationStructureCreateInfo,
                                   const VmaAllocationCreateInfo& allocationCreateInfo,
@@ -41,7 +41,7 @@ class VMAAccelerationStructureNV : public AccelerationStructureNV {
 
   explicit VMAAccelerationStructureNV(const AccelerationStructureNV& accelerationStructure);
 
-  void* mapMemory() const;
+  vk::ResultValueType<void*>::type mapMemory() const;
 
   void unmapMemory() const;
 
@@ -31,7 +31,7 @@ class VMAAccelerationStructureNVImpl : public AccelerationStructureNVImpl {
                                  const VmaAllocationCreateInfo& allocationCreateInfo,
                                  const std::optional<vk::AllocationCallbacks>& allocator = {});
 
-  void* mapMemory() const;
+  vk::ResultValueType<void*>::type mapMemory() const;
 
   void unmapMemory() const;
 
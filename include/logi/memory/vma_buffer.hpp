@@ -40,13 +40,19 @@ class VMABuffer : public Buffer {
 
   explicit VMABuffer(const Buffer& buffer);
 
-  void* mapMemory() const;
+  vk::ResultValueType<void*>::type mapMemory() const;
 
   void unmapMemory() const;
 
+  /**
+   * @brief Make device writes to the given range visible to the host. Required before reading mapped memory that is
+   *        not host coherent.
+   */
+  void invalidate(vk::DeviceSize offset = 0u, vk::DeviceSize size = VK_WHOLE_SIZE) const;
+
   size_t size() const;
 
-  void writeToBuffer(const void* data, size_t size, size_t offset = 0) const;
+  vk::ResultValueType<void>::type writeToBuffer(const void* data, size_t size, size_t offset = 0) const;
 
   bool isMappable() const;
 
@@ -31,13 +31,15 @@ class VMABufferImpl : public BufferImpl {
                 const VmaAllocationCreateInfo& allocationCreateInfo,
                 const std::optional<vk::AllocationCallbacks>& allocator = {});
 
-  void* mapMemory() const;
+  vk::ResultValueType<void*>::type mapMemory() const;
 
   void unmapMemory() const;
 
+  void invalidate(vk::DeviceSize offset, vk::DeviceSize size) const;
+
   size_t size() const;
 
-  void writeToBuffer(const void* data, size_t size, size_t offset = 0) const;
+  vk::ResultValueType<void>::type writeToBuffer(const void* data, size_t size, size_t offset = 0) const;
 
   bool isMappable() const;
 
@@ -45,6 +47,14 @@ class VMABufferImpl : public BufferImpl {
 
   MemoryAllocatorImpl& getMemoryAllocator() const;
 
+  /**
+   * @brief   Transfer ownership of the memory allocation to the caller. The allocation is then no longer freed together
+   *          with the buffer, which allows bulk destruction to free the allocations of many buffers at once.
+   *
+   * @return  Memory allocation.
+   */
+  VmaAllocation releaseAllocation();
+
   void destroy() const override;
 
  protected:
@@ -40,13 +40,13 @@ class VMAImage : public Image {
 
   explicit VMAImage(const Image& image);
 
-  void* mapMemory() const;
+  vk::ResultValueType<void*>::type mapMemory() const;
 
   void unmapMemory() const;
 
   size_t size() const;
 
-  void writeToImage(const void* data, size_t size, size_t offset = 0) const;
+  vk::ResultValueType<void>::type writeToImage(const void* data, size_t size, size_t offset = 0) const;
 
   bool isMappable() const;
 
@@ -32,13 +32,13 @@ class VMAImageImpl : public ImageImpl {
                const VmaAllocationCreateInfo& allocationCreateInfo,
                const std::optional<vk::AllocationCallbacks>& allocator = {});
 
-  void* mapMemory() const;
+  vk::ResultValueType<void*>::type mapMemory() const;
 
   void unmapMemory() const;
 
   size_t size() const;
 
-  void writeToImage(const void* data, size_t size, size_t offset = 0) const;
+  vk::ResultValueType<void>::type writeToImage(const void* data, size_t size, size_t offset = 0) const;
 
   bool isMappable() const;
 
@@ -46,6 +46,14 @@ class VMAImageImpl : public ImageImpl {
 
   MemoryAllocatorImpl& getMemoryAllocator() const;
 
+  /**
+   * @brief   Transfer ownership of the memory allocation to the caller. The allocation is then no longer freed together
+   *          with the image, which allows bulk destruction to free the allocations of many images at once.
+   *
+   * @return  Memory allocation.
+   */
+  VmaAllocation releaseAllocation();
+
   void destroy() const override;
 
  protected:
@@ -0,0 +1,186 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_PROGRAM_PUSH_CONSTANT_BLOCK_HPP
+#define LOGI_PROGRAM_PUSH_CONSTANT_BLOCK_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "logi/base/common.hpp"
+#include "logi/base/exception.hpp"
+
+namespace logi {
+
+/**
+ * @brief Member of a push constant block.
+ */
+struct PushConstantMember {
+  PushConstantMember(std::string name, uint32_t offset, uint32_t size);
+
+  std::string name;
+  uint32_t offset;
+  uint32_t size;
+};
+
+/**
+ * @brief Layout of the push constant block shared by the stages of a pipeline. Holds offsets and sizes of the members and
+ *        the push constant ranges of the pipeline layout.
+ *
+ *        vkCmdPushConstants requires the stage flags to match exactly the stages of all ranges that overlap the updated
+ *        bytes. The block therefore precomputes the segments of the block in which the set of stages does not change.
+ *        An update is split into one call per segment, and bytes that are not used by any stage are skipped.
+ */
+class PushConstantBlock {
+ public:
+  PushConstantBlock() = default;
+
+  /**
+   * @param members Members of the block.
+   * @param ranges  Push constant ranges of the pipeline layout (see reflectPushConstants).
+   */
+  PushConstantBlock(std::vector<PushConstantMember> members, const std::vector<vk::PushConstantRange>& ranges);
+
+  /**
+   * @brief   Index of the member with the given name.
+   * @throws  IllegalInvocation If the block has no member with the given name.
+   */
+  uint32_t getMemberIndex(const std::string& name) const;
+
+  const PushConstantMember& getMember(uint32_t index) const;
+
+  const std::vector<PushConstantMember>& getMembers() const;
+
+  /**
+   * @brief Push constant ranges of the pipeline layout.
+   */
+  const std::vector<vk::PushConstantRange>& getRanges() const;
+
+  /**
+   * @brief Disjoint segments of the block, sorted by offset. All bytes of a segment are used by the same stages.
+   */
+  const std::vector<vk::PushConstantRange>& getSegments() const;
+
+  /**
+   * @brief Size of the block in bytes, i.e. the end of the last range.
+   */
+  uint32_t getSize() const;
+
+  /**
+   * @brief Invoke function(stageFlags, offset, size) for each part of the given range that is used by the same stages.
+   */
+  template <typename Function>
+  void forEachSegment(uint32_t offset, uint32_t size, Function&& function) const {
+    uint32_t end = offset + size;
+    for (const vk::PushConstantRange& segment : segments_) {
+      if (segment.offset >= end) {
+        break;
+      }
+
+      uint32_t segmentEnd = segment.offset + segment.size;
+      if (segmentEnd > offset) {
+        uint32_t begin = std::max(offset, segment.offset);
+        function(segment.stageFlags, begin, std::min(end, segmentEnd) - begin);
+      }
+    }
+  }
+
+ private:
+  std::vector<PushConstantMember> members_;
+  std::unordered_map<std::string, uint32_t> memberIndices_;
+  std::vector<vk::PushConstantRange> ranges_;
+  std::vector<vk::PushConstantRange> segments_;
+  uint32_t size_ = 0u;
+};
+
+/**
+ * @brief CPU copy of a push constant block. Members are written into the copy and the bytes written since the last
+ *        push are pushed together with CommandBuffer::pushConstants, which packs them into as few vkCmdPushConstants
+ *        calls as the ranges of the pipeline layout allow. The block must outlive the data.
+ */
+class PushConstantData {
+ public:
+  PushConstantData() = default;
+
+  explicit PushConstantData(const PushConstantBlock& block);
+
+  /**
+   * @brief   Write the value to the member with the given index.
+   * @throws  IllegalInvocation If the value is larger than the member.
+   */
+  template <typename T>
+  void set(uint32_t memberIndex, const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Push constant values must be trivially copyable.");
+    const PushConstantMember& member = block_->getMember(memberIndex);
+    if (sizeof(T) > member.size) {
+      throw IllegalInvocation("Value is larger than push constant member \"" + member.name + "\".");
+    }
+
+    write(member.offset, sizeof(T), &value);
+  }
+
+  template <typename T>
+  void set(const std::string& memberName, const T& value) {
+    set(block_->getMemberIndex(memberName), value);
+  }
+
+  /**
+   * @brief Write raw bytes at the given offset of the block. The written range is widened to multiples of 4 bytes
+   *        (clamped to the block size) as required by vkCmdPushConstants.
+   */
+  void write(uint32_t offset, uint32_t size, const void* data);
+
+  /**
+   * @brief Mark all bytes as written, e.g. after binding a pipeline with a different layout.
+   */
+  void markDirty();
+
+  /**
+   * @brief Forget written bytes. Called after they were pushed.
+   */
+  void clearDirty();
+
+  bool isDirty() const;
+
+  /**
+   * @brief Offset of the first written byte, rounded down to a multiple of 4.
+   */
+  uint32_t getDirtyOffset() const;
+
+  /**
+   * @brief Size of the range spanning all written bytes, rounded up to a multiple of 4 unless clamped to the block.
+   */
+  uint32_t getDirtySize() const;
+
+  const PushConstantBlock& getBlock() const;
+
+  const uint8_t* getData() const;
+
+ private:
+  const PushConstantBlock* block_ = nullptr;
+  std::vector<uint8_t> data_;
+  uint32_t dirtyBegin_ = 0u;
+  uint32_t dirtyEnd_ = 0u;
+};
+
+} // namespace logi
+
+#endif // LOGI_PROGRAM_PUSH_CONSTANT_BLOCK_HPP
@@ -79,6 +79,14 @@ std::vector<DescriptorSetReflectionInfo> reflectDescriptorSets(const std::vector
 
 std::vector<PushConstantReflectionInfo> reflectPushConstants(const std::vector<ShaderStage>& stages);
 
+/**
+ * @brief Build the push constant block of the stages. Members are merged by name, ranges are the ones returned by
+ *        reflectPushConstants, so the block matches a pipeline layout created with them.
+ *
+ * @throws ReflectionError If the stages declare a member with the same name at different offsets or sizes.
+ */
+PushConstantBlock reflectPushConstantBlock(const std::vector<ShaderStage>& stages);
+
 } // namespace logi
 
 #endif // LOGI_PROGRAM_SHADER_MODULE_HPP
@@ -24,6 +24,7 @@
 #include <spirv_cross.hpp>
 #include "logi/base/common.hpp"
 #include "logi/base/vulkan_object.hpp"
+#include "logi/program/push_constant_block.hpp"
 
 namespace logi {
 
@@ -71,11 +72,13 @@ struct VertexAttributeReflectionInfo {
 };
 
 struct PushConstantReflectionInfo {
-  PushConstantReflectionInfo(const vk::ShaderStageFlags& stages, uint32_t offset, uint32_t size);
+  PushConstantReflectionInfo(const vk::ShaderStageFlags& stages, uint32_t offset, uint32_t size,
+                             std::vector<PushConstantMember> members = {});
 
   vk::ShaderStageFlags stages;
   uint32_t offset;
   uint32_t size;
+  std::vector<PushConstantMember> members;
 
   explicit operator vk::PushConstantRange() const {
     return vk::PushConstantRange(stages, offset, size);
@@ -0,0 +1,247 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_QUERY_GPU_PROFILER_HPP
+#define LOGI_QUERY_GPU_PROFILER_HPP
+
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "logi/base/common.hpp"
+#include "logi/command/command_buffer.hpp"
+#include "logi/device/logical_device.hpp"
+#include "logi/query/gpu_timing.hpp"
+#include "logi/query/query_pool.hpp"
+
+namespace logi {
+
+class QueueFamily;
+
+/**
+ * @brief Timing of a profiler zone.
+ */
+struct GpuZoneResult {
+  /**
+   * Name of the zone.
+   */
+  std::string name;
+
+  /**
+   * Duration of the zone in milliseconds.
+   */
+  double milliseconds = 0.0;
+
+  /**
+   * Raw GPU timestamps of the beginning and the end of the zone.
+   */
+  uint64_t beginTimestamp = 0u;
+  uint64_t endTimestamp = 0u;
+
+  /**
+   * Beginning and end of the zone on the host clock (std::chrono::steady_clock) in nanoseconds. Only valid when the
+   * profiler is calibrated.
+   */
+  int64_t beginHostNanoseconds = 0;
+  int64_t endHostNanoseconds = 0;
+};
+
+/**
+ * @brief GPU profiler built on timestamp queries. Each frame in flight owns a timestamp query pool. Zones write a
+ *        timestamp at their beginning and end into the pool of the current frame. When a frame is reused, beginFrame
+ *        reads its results back without waiting, resets the pool on the host and adds the zone durations to rolling
+ *        per-zone statistics, so results become available framesInFlight frames after they were recorded.
+ *
+ *        Host query reset requires the hostQueryReset feature (Vulkan 1.2 or VK_EXT_host_query_reset). When the device
+ *        has VK_EXT_calibrated_timestamps enabled and supports the CLOCK_MONOTONIC time domain, zone timings are also
+ *        converted to host time. Otherwise only durations are reported.
+ *
+ *        beginZone and endZone may be called from multiple threads. All other functions must be externally
+ *        synchronized.
+ */
+class GpuProfiler {
+ public:
+  static constexpr uint32_t kInvalidZone = ~0u;
+
+  /**
+   * @brief Ends the zone when it goes out of scope. The command buffer must still be in the recording state.
+   */
+  class ScopedZone {
+   public:
+    ScopedZone() = default;
+
+    ScopedZone(GpuProfiler& profiler, const CommandBuffer& commandBuffer, uint32_t zone,
+               vk::PipelineStageFlagBits endStage);
+
+    ScopedZone(const ScopedZone&) = delete;
+
+    ScopedZone& operator=(const ScopedZone&) = delete;
+
+    ScopedZone(ScopedZone&& other) noexcept;
+
+    ScopedZone& operator=(ScopedZone&& other) noexcept;
+
+    ~ScopedZone();
+
+    /**
+     * @brief End the zone before the scope ends.
+     */
+    void end();
+
+   private:
+    GpuProfiler* profiler_ = nullptr;
+    CommandBuffer commandBuffer_;
+    uint32_t zone_ = kInvalidZone;
+    vk::PipelineStageFlagBits endStage_ = vk::PipelineStageFlagBits::eBottomOfPipe;
+  };
+
+  GpuProfiler() = default;
+
+  /**
+   * @brief Create a timestamp query pool for each frame in flight.
+   *
+   * @param queueFamily       Queue family the profiled command buffers are submitted to.
+   * @param framesInFlight    Number of frames that may be recorded or executed at the same time.
+   * @param maxZonesPerFrame  Maximum number of zones per frame. Further zones are dropped.
+   * @param statisticsWindow  Number of samples of the rolling zone statistics.
+   *
+   * @throws  IllegalInvocation If framesInFlight is zero.
+   */
+  GpuProfiler(const QueueFamily& queueFamily, uint32_t framesInFlight, uint32_t maxZonesPerFrame = 256u,
+              size_t statisticsWindow = 64u);
+
+  GpuProfiler(const GpuProfiler&) = delete;
+
+  GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+  /**
+   * @brief   Advance to the next frame. Reads back the results of the frame recorded when the frame was last used,
+   *          resets its query pool and recalibrates the clocks. The commands recorded when the frame was last used must
+   *          have retired, e.g. call after FrameCommandAllocator::beginFrame of the same frame.
+   *
+   * @return  Index of the frame.
+   */
+  uint32_t beginFrame();
+
+  /**
+   * @brief   Write the beginning timestamp of a zone.
+   *
+   * @param   commandBuffer Command buffer in the recording state.
+   * @param   name          Name of the zone. Zones with the same name share statistics.
+   * @param   stage         Pipeline stage of the timestamp.
+   * @return  Zone index or kInvalidZone if the profiler is not supported or the frame is full.
+   */
+  uint32_t beginZone(const CommandBuffer& commandBuffer, const std::string& name,
+                     vk::PipelineStageFlagBits stage = vk::PipelineStageFlagBits::eTopOfPipe);
+
+  /**
+   * @brief Write the end timestamp of a zone. The command buffer may differ from the one the zone began in, as long as
+   *        both are submitted in the same frame.
+   */
+  void endZone(const CommandBuffer& commandBuffer, uint32_t zone,
+               vk::PipelineStageFlagBits stage = vk::PipelineStageFlagBits::eBottomOfPipe);
+
+  /**
+   * @brief Begin a zone that ends when the returned object goes out of scope.
+   */
+  ScopedZone scopedZone(const CommandBuffer& commandBuffer, const std::string& name,
+                        vk::PipelineStageFlagBits beginStage = vk::PipelineStageFlagBits::eTopOfPipe,
+                        vk::PipelineStageFlagBits endStage = vk::PipelineStageFlagBits::eBottomOfPipe);
+
+  /**
+   * @brief   Sample the device and host clocks at the same moment with vkGetCalibratedTimestampsEXT.
+   *
+   * @return  True if the clocks were calibrated.
+   */
+  bool calibrate();
+
+  /**
+   * @brief Check whether the queue family supports timestamps.
+   */
+  bool isSupported() const;
+
+  /**
+   * @brief Check whether zone timings are converted to host time.
+   */
+  bool isCalibrated() const;
+
+  const GpuClockCalibration& getClockCalibration() const;
+
+  /**
+   * @brief Zones of the frame read back by the last beginFrame, in the order they began.
+   */
+  const std::vector<GpuZoneResult>& getFrameResults() const;
+
+  /**
+   * @brief Rolling statistics of the zone with the given name or nullptr if the zone has no results yet.
+   */
+  const GpuZoneStatistics* getZoneStatistics(const std::string& name) const;
+
+  /**
+   * @brief Rolling statistics of all zones.
+   */
+  const std::unordered_map<std::string, GpuZoneStatistics>& getZoneStatistics() const;
+
+  /**
+   * @brief Number of zones that were dropped because the frame was full or their results were not available.
+   */
+  uint64_t getDroppedZoneCount() const;
+
+  uint32_t getFrameIndex() const;
+
+  uint32_t getFramesInFlight() const;
+
+  /**
+   * @brief Destroy the query pools. The caller must ensure that the GPU is no longer using them.
+   */
+  void destroy();
+
+ private:
+  struct Frame {
+    QueryPool queryPool;
+    std::vector<std::string> zoneNames;
+    uint32_t zoneCount = 0u;
+  };
+
+  /**
+   * @brief Read back the results of the frame and reset its queries.
+   */
+  void resolve(Frame& frame);
+
+  /**
+   * @brief Reset queries of the frame on the host.
+   */
+  void reset(Frame& frame, uint32_t queryCount) const;
+
+  LogicalDevice logicalDevice_;
+  std::vector<Frame> frames_;
+  uint32_t frameIndex_ = 0u;
+  uint32_t maxZonesPerFrame_ = 0u;
+  size_t statisticsWindow_ = 64u;
+  std::atomic<uint32_t> zoneCount_ {0u};
+  std::atomic<uint64_t> droppedZones_ {0u};
+  GpuClockCalibration calibration_;
+  bool supported_ = false;
+  bool calibrationSupported_ = false;
+  std::vector<GpuZoneResult> frameResults_;
+  std::unordered_map<std::string, GpuZoneStatistics> zoneStatistics_;
+};
+
+} // namespace logi
+
+#endif // LOGI_QUERY_GPU_PROFILER_HPP
@@ -0,0 +1,133 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_QUERY_GPU_TIMING_HPP
+#define LOGI_QUERY_GPU_TIMING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace logi {
+
+/**
+ * @brief Converts GPU timestamps to nanoseconds. Timestamps only have timestampValidBits significant bits and wrap
+ *        around, so differences are computed modulo 2^timestampValidBits. After calibrate is called with a pair of
+ *        timestamps sampled at the same moment (see vkGetCalibratedTimestampsEXT), GPU timestamps can also be converted
+ *        to the host clock.
+ */
+class GpuClockCalibration {
+ public:
+  GpuClockCalibration() = default;
+
+  /**
+   * @param timestampPeriod     Nanoseconds per timestamp tick (VkPhysicalDeviceLimits::timestampPeriod).
+   * @param timestampValidBits  Number of valid timestamp bits of the queue family.
+   */
+  GpuClockCalibration(float timestampPeriod, uint32_t timestampValidBits);
+
+  /**
+   * @brief Set the GPU timestamp that corresponds to the given host time.
+   *
+   * @param gpuTimestamp      Timestamp of the device time domain.
+   * @param hostNanoseconds   Host time in nanoseconds.
+   * @param maxDeviation      Maximum deviation of the sampled timestamps in nanoseconds.
+   */
+  void calibrate(uint64_t gpuTimestamp, uint64_t hostNanoseconds, uint64_t maxDeviation = 0u);
+
+  /**
+   * @brief Check whether calibrate has been called.
+   */
+  bool isCalibrated() const;
+
+  /**
+   * @brief Maximum deviation of the last calibration in nanoseconds.
+   */
+  uint64_t getMaxDeviation() const;
+
+  /**
+   * @brief Number of ticks from begin to end, taking wrap around of the valid bits into account.
+   */
+  uint64_t elapsedTicks(uint64_t begin, uint64_t end) const;
+
+  /**
+   * @brief Convert ticks to nanoseconds.
+   */
+  double toNanoseconds(uint64_t ticks) const;
+
+  /**
+   * @brief   Convert a GPU timestamp to host time. The timestamp may precede the calibration point by up to half of the
+   *          timestamp range.
+   *
+   * @return  Host time in nanoseconds. Only meaningful when isCalibrated.
+   */
+  int64_t toHostNanoseconds(uint64_t gpuTimestamp) const;
+
+ private:
+  double timestampPeriod_ = 1.0;
+  uint64_t mask_ = ~uint64_t(0u);
+  uint64_t gpuTimestamp_ = 0u;
+  uint64_t hostNanoseconds_ = 0u;
+  uint64_t maxDeviation_ = 0u;
+  bool calibrated_ = false;
+};
+
+/**
+ * @brief Rolling statistics of a profiler zone over the last windowSize samples.
+ */
+class GpuZoneStatistics {
+ public:
+  explicit GpuZoneStatistics(size_t windowSize = 64u);
+
+  /**
+   * @brief Add a duration sample in milliseconds. Replaces the oldest sample once the window is full.
+   */
+  void addSample(double milliseconds);
+
+  /**
+   * @brief Number of samples in the window.
+   */
+  size_t getSampleCount() const;
+
+  /**
+   * @brief Number of samples added since the statistics were created.
+   */
+  uint64_t getTotalSampleCount() const;
+
+  /**
+   * @brief Most recent sample.
+   */
+  double getLast() const;
+
+  double getAverage() const;
+
+  double getMin() const;
+
+  double getMax() const;
+
+ private:
+  std::vector<double> samples_;
+  size_t windowSize_;
+  size_t next_ = 0u;
+  uint64_t totalSamples_ = 0u;
+  double sum_ = 0.0;
+};
+
+} // namespace logi
+
+#endif // LOGI_QUERY_GPU_TIMING_HPP
@@ -0,0 +1,146 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_QUERY_QUERY_RESULTS_HPP
+#define LOGI_QUERY_QUERY_RESULTS_HPP
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "logi/base/common.hpp"
+
+namespace logi {
+
+/**
+ * @brief Counters of a pipeline statistics query. Counters that were not queried are zero.
+ */
+struct PipelineStatistics {
+  PipelineStatistics& operator+=(const PipelineStatistics& other);
+
+  uint64_t inputAssemblyVertices = 0u;
+  uint64_t inputAssemblyPrimitives = 0u;
+  uint64_t vertexShaderInvocations = 0u;
+  uint64_t geometryShaderInvocations = 0u;
+  uint64_t geometryShaderPrimitives = 0u;
+  uint64_t clippingInvocations = 0u;
+  uint64_t clippingPrimitives = 0u;
+  uint64_t fragmentShaderInvocations = 0u;
+  uint64_t tessellationControlShaderPatches = 0u;
+  uint64_t tessellationEvaluationShaderInvocations = 0u;
+  uint64_t computeShaderInvocations = 0u;
+};
+
+/**
+ * @brief Number of values a pipeline statistics query with the given flags writes.
+ */
+uint32_t getPipelineStatisticCount(const vk::QueryPipelineStatisticFlags& flags);
+
+/**
+ * @brief   Unpack the values written by a pipeline statistics query. Values are ordered by increasing flag bit.
+ *
+ * @param   flags   Pipeline statistics of the query pool.
+ * @param   values  getPipelineStatisticCount(flags) values.
+ * @return  Pipeline statistics.
+ */
+PipelineStatistics unpackPipelineStatistics(const vk::QueryPipelineStatisticFlags& flags, const uint64_t* values);
+
+/**
+ * @brief Pipeline statistics of the last windowSize frames of a pass.
+ */
+class PipelineStatisticsHistory {
+ public:
+  explicit PipelineStatisticsHistory(size_t windowSize = 64u);
+
+  /**
+   * @brief Add statistics of a frame. Replaces the oldest sample once the window is full.
+   */
+  void addSample(const PipelineStatistics& statistics);
+
+  /**
+   * @brief Number of samples in the window.
+   */
+  size_t getSampleCount() const;
+
+  /**
+   * @brief Most recent sample.
+   */
+  PipelineStatistics getLast() const;
+
+  /**
+   * @brief Average of the samples in the window, rounded down.
+   */
+  PipelineStatistics getAverage() const;
+
+ private:
+  std::vector<PipelineStatistics> samples_;
+  size_t windowSize_;
+  size_t next_ = 0u;
+};
+
+/**
+ * @brief Latest occlusion query result of each object. Results arrive a few frames after they were recorded, so
+ *        visibility decisions are conservative: objects without a recent result are treated as visible.
+ */
+class OcclusionCache {
+ public:
+  /**
+   * @brief Store the result of an occlusion query.
+   *
+   * @param objectId  Application defined object identifier.
+   * @param samples   Number of samples that passed the depth and stencil tests.
+   * @param frame     Frame number the query was recorded in.
+   */
+  void update(uint64_t objectId, uint64_t samples, uint64_t frame);
+
+  /**
+   * @brief Latest number of passed samples of the object.
+   */
+  std::optional<uint64_t> getSamples(uint64_t objectId) const;
+
+  /**
+   * @brief   Check whether the object should be considered visible.
+   *
+   * @param   objectId      Application defined object identifier.
+   * @param   currentFrame  Number of the current frame.
+   * @param   maxAge        Maximum number of frames since the result was recorded.
+   * @return  False only if a result recorded at most maxAge frames ago reports no passed samples.
+   */
+  bool isVisible(uint64_t objectId, uint64_t currentFrame, uint64_t maxAge) const;
+
+  /**
+   * @brief Remove results recorded before the given frame.
+   */
+  void evict(uint64_t frame);
+
+  size_t size() const;
+
+  void clear();
+
+ private:
+  struct Entry {
+    uint64_t samples;
+    uint64_t frame;
+  };
+
+  std::unordered_map<uint64_t, Entry> entries_;
+};
+
+} // namespace logi
+
+#endif // LOGI_QUERY_QUERY_RESULTS_HPP
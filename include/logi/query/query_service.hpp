@@ -0,0 +1,178 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_QUERY_QUERY_SERVICE_HPP
+#define LOGI_QUERY_QUERY_SERVICE_HPP
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "logi/base/common.hpp"
+#include "logi/command/command_buffer.hpp"
+#include "logi/memory/memory_allocator.hpp"
+#include "logi/memory/vma_buffer.hpp"
+#include "logi/query/query_pool.hpp"
+#include "logi/query/query_results.hpp"
+
+namespace logi {
+
+/**
+ * @brief Hands out pipeline statistics and occlusion queries per frame and resolves them without stalling. Each frame
+ *        in flight owns a query pool of each type and a persistently mapped readback buffer. resolve records
+ *        vkCmdCopyQueryPoolResults of the frame's queries into the readback buffer. When the frame is reused,
+ *        beginFrame reads the buffer, adds the pipeline statistics to per-pass rolling statistics, stores the occlusion
+ *        results in the occlusion cache and resets the queries on the host.
+ *
+ *        Host query reset requires the hostQueryReset feature (Vulkan 1.2 or VK_EXT_host_query_reset) and pipeline
+ *        statistics require the pipelineStatisticsQuery feature. The service must be externally synchronized.
+ */
+class QueryService {
+ public:
+  static constexpr uint32_t kInvalidQuery = ~0u;
+
+  QueryService() = default;
+
+  /**
+   * @brief Create query pools and readback buffers for each frame in flight.
+   *
+   * @param memoryAllocator                 Allocator of the readback buffers.
+   * @param framesInFlight                  Number of frames that may be recorded or executed at the same time.
+   * @param maxPipelineStatisticsQueries    Maximum number of pipeline statistics queries per frame.
+   * @param maxOcclusionQueries             Maximum number of occlusion queries per frame.
+   * @param pipelineStatistics              Counters of the pipeline statistics queries. Empty disables them.
+   * @param statisticsWindow                Number of frames of the per-pass rolling statistics.
+   *
+   * @throws  IllegalInvocation If framesInFlight is zero.
+   */
+  QueryService(const MemoryAllocator& memoryAllocator, uint32_t framesInFlight,
+               uint32_t maxPipelineStatisticsQueries = 64u, uint32_t maxOcclusionQueries = 1024u,
+               const vk::QueryPipelineStatisticFlags& pipelineStatistics =
+                 vk::QueryPipelineStatisticFlagBits::eInputAssemblyVertices |
+                 vk::QueryPipelineStatisticFlagBits::eVertexShaderInvocations |
+                 vk::QueryPipelineStatisticFlagBits::eFragmentShaderInvocations |
+                 vk::QueryPipelineStatisticFlagBits::eComputeShaderInvocations,
+               size_t statisticsWindow = 64u);
+
+  QueryService(const QueryService&) = delete;
+
+  QueryService& operator=(const QueryService&) = delete;
+
+  /**
+   * @brief   Advance to the next frame and collect the results of the frame recorded when the frame was last used.
+   *          The commands recorded when the frame was last used must have retired, e.g. call after
+   *          FrameCommandAllocator::beginFrame of the same frame.
+   *
+   * @return  Index of the frame.
+   */
+  uint32_t beginFrame();
+
+  /**
+   * @brief   Begin a pipeline statistics query of a pass. Passes with the same name share statistics.
+   *
+   * @return  Query index or kInvalidQuery if pipeline statistics are disabled or the frame is full.
+   */
+  uint32_t beginPipelineStatistics(const CommandBuffer& commandBuffer, const std::string& passName);
+
+  void endPipelineStatistics(const CommandBuffer& commandBuffer, uint32_t query);
+
+  /**
+   * @brief   Begin an occlusion query of an object.
+   *
+   * @param   commandBuffer Command buffer in the recording state, inside of a render pass.
+   * @param   objectId      Application defined object identifier.
+   * @param   precise       Count the exact number of passed samples instead of only reporting whether any passed.
+   * @return  Query index or kInvalidQuery if the frame is full.
+   */
+  uint32_t beginOcclusion(const CommandBuffer& commandBuffer, uint64_t objectId, bool precise = false);
+
+  void endOcclusion(const CommandBuffer& commandBuffer, uint32_t query);
+
+  /**
+   * @brief Copy results of the queries of the current frame into its readback buffer. Record once per frame, outside of
+   *        a render pass and after all queries of the frame have ended.
+   */
+  void resolve(const CommandBuffer& commandBuffer);
+
+  /**
+   * @brief Rolling pipeline statistics of the pass with the given name or nullptr if the pass has no results yet.
+   */
+  const PipelineStatisticsHistory* getPassStatistics(const std::string& passName) const;
+
+  /**
+   * @brief Rolling pipeline statistics of all passes.
+   */
+  const std::unordered_map<std::string, PipelineStatisticsHistory>& getPassStatistics() const;
+
+  const OcclusionCache& getOcclusionCache() const;
+
+  /**
+   * @brief Check whether the object should be drawn, based on its occlusion result of the last 2 * framesInFlight
+   *        frames. Objects without a result are visible.
+   */
+  bool isVisible(uint64_t objectId) const;
+
+  /**
+   * @brief Number of frames started with beginFrame.
+   */
+  uint64_t getFrameNumber() const;
+
+  uint32_t getFrameIndex() const;
+
+  uint32_t getFramesInFlight() const;
+
+  /**
+   * @brief Destroy query pools and readback buffers. The caller must ensure that the GPU is no longer using them.
+   */
+  void destroy();
+
+ private:
+  struct Frame {
+    QueryPool pipelineStatisticsPool;
+    QueryPool occlusionPool;
+    VMABuffer readbackBuffer;
+    const uint64_t* readback = nullptr;
+    std::vector<std::string> passNames;
+    std::vector<uint64_t> objectIds;
+    uint64_t frameNumber = 0u;
+    bool resolved = false;
+  };
+
+  /**
+   * @brief Collect results of the frame and reset its queries.
+   */
+  void collect(Frame& frame);
+
+  vk::DeviceSize getPipelineStatisticsStride() const;
+
+  vk::DeviceSize getOcclusionOffset() const;
+
+  MemoryAllocator memoryAllocator_;
+  std::vector<Frame> frames_;
+  uint32_t frameIndex_ = 0u;
+  uint64_t frameNumber_ = 0u;
+  uint32_t maxPipelineStatisticsQueries_ = 0u;
+  uint32_t maxOcclusionQueries_ = 0u;
+  vk::QueryPipelineStatisticFlags pipelineStatistics_;
+  size_t statisticsWindow_ = 64u;
+  std::unordered_map<std::string, PipelineStatisticsHistory> passStatistics_;
+  OcclusionCache occlusionCache_;
+};
+
+} // namespace logi
+
+#endif // LOGI_QUERY_QUERY_SERVICE_HPP
@@ -0,0 +1,205 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_QUEUE_ASYNC_QUEUE_HPP
+#define LOGI_QUEUE_ASYNC_QUEUE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "logi/base/common.hpp"
+#include "logi/base/mpsc_ring.hpp"
+#include "logi/queue/queue.hpp"
+#include "logi/queue/submit_batch_list.hpp"
+
+namespace logi {
+
+/**
+ * @brief Completion token of an operation enqueued to an AsyncQueue. The operation is complete once the submission
+ *        thread has executed it, which does not imply that the GPU has finished the submitted work.
+ */
+class AsyncQueueToken {
+ public:
+  AsyncQueueToken() = default;
+
+  /**
+   * @brief Check if the token belongs to an enqueued operation.
+   */
+  bool isValid() const;
+
+  /**
+   * @brief Check if the submission thread has executed the operation.
+   */
+  bool isComplete() const;
+
+  /**
+   * @brief   Result of the operation.
+   *
+   * @return  vk::Result::eNotReady until the operation is complete.
+   */
+  vk::Result getResult() const;
+
+ private:
+  friend class AsyncQueue;
+
+  struct State {
+    std::atomic<bool> complete {false};
+    vk::Result result = vk::Result::eNotReady;
+    std::exception_ptr exception;
+  };
+
+  explicit AsyncQueueToken(std::shared_ptr<State> state);
+
+  std::shared_ptr<State> state_;
+};
+
+/**
+ * @brief Asynchronous queue mode. A dedicated submission thread owns the queue and performs all submits and presents.
+ *        Producers push operations into a lock-free MPSC ring and receive completion tokens, so they neither contend
+ *        for the queue nor block on presentation. Operations are executed in the order in which they were pushed.
+ *        Submit and present arrays are copied, so they may be released as soon as the call returns.
+ *
+ *        When the ring is full, producers yield until the submission thread frees a slot. While the AsyncQueue
+ *        exists, the queue must only be used through it (see execute for other queue commands).
+ *
+ *        All functions except destroy are thread safe.
+ */
+class AsyncQueue {
+ public:
+  /**
+   * @brief Queue function executed on the submission thread.
+   */
+  using QueueFunction = std::function<vk::Result(const Queue& queue)>;
+
+  AsyncQueue() = default;
+
+  /**
+   * @brief Start the submission thread.
+   *
+   * @param queue     Queue owned by the submission thread.
+   * @param capacity  Maximum number of pending operations. Rounded up to a power of two.
+   */
+  explicit AsyncQueue(const Queue& queue, size_t capacity = 256u);
+
+  AsyncQueue(const AsyncQueue&) = delete;
+
+  AsyncQueue& operator=(const AsyncQueue&) = delete;
+
+  ~AsyncQueue();
+
+  /**
+   * @brief Enqueue Queue::submit. Only vk::TimelineSemaphoreSubmitInfo is supported in the pNext chain of the submits.
+   */
+  AsyncQueueToken submit(const vk::ArrayProxy<const vk::SubmitInfo>& submits, vk::Fence fence = {});
+
+  /**
+   * @brief Enqueue Queue::presentKHR. Results of the individual swapchains (pResults) and pNext extensions are not
+   *        supported. Result of the present (e.g. vk::Result::eSuboptimalKHR) is the result of the token.
+   */
+  AsyncQueueToken presentKHR(const vk::PresentInfoKHR& presentInfo);
+
+  /**
+   * @brief Enqueue a function that uses the queue (e.g. Queue::bindSparse or debug labels) on the submission thread.
+   */
+  AsyncQueueToken execute(QueueFunction function);
+
+  /**
+   * @brief   Block until the submission thread executed the operation. With exceptions enabled, the exception thrown by
+   *          the operation is rethrown.
+   *
+   * @return  Result of the operation.
+   */
+  vk::Result wait(const AsyncQueueToken& token) const;
+
+  /**
+   * @brief Block until all operations enqueued before the call are executed.
+   */
+  void drain();
+
+  /**
+   * @brief Execute Queue::waitIdle on the submission thread and wait for it.
+   */
+  vk::Result waitIdle();
+
+  /**
+   * @brief Number of operations that were enqueued but not yet executed.
+   */
+  size_t getPendingCount() const;
+
+  const Queue& getQueue() const;
+
+  /**
+   * @brief Execute the pending operations and stop the submission thread.
+   */
+  void destroy();
+
+ private:
+  enum class OperationType { eSubmit, ePresent, eExecute };
+
+  struct Operation {
+    OperationType type = OperationType::eExecute;
+    std::shared_ptr<AsyncQueueToken::State> state;
+
+    SubmitBatchList submits;
+    vk::Fence fence;
+
+    vk::PresentInfoKHR presentInfo;
+    std::vector<vk::Semaphore> waitSemaphores;
+    std::vector<vk::SwapchainKHR> swapchains;
+    std::vector<uint32_t> imageIndices;
+
+    QueueFunction function;
+  };
+
+  /**
+   * @brief Push the operation to the ring and wake the submission thread.
+   */
+  AsyncQueueToken push(Operation&& operation);
+
+  /**
+   * @brief Execute the operation on the queue and complete its token.
+   */
+  void execute(Operation& operation);
+
+  /**
+   * @brief Submission thread loop.
+   */
+  void work();
+
+  Queue queue_;
+  std::unique_ptr<MpscRing<Operation>> ring_;
+  std::thread worker_;
+
+  std::atomic<size_t> pendingCount_ {0u};
+  std::atomic<bool> sleeping_ {false};
+  std::atomic<bool> stopping_ {false};
+  std::mutex workMutex_;
+  std::condition_variable workAvailable_;
+
+  mutable std::mutex completionMutex_;
+  mutable std::condition_variable completed_;
+};
+
+} // namespace logi
+
+#endif // LOGI_QUEUE_ASYNC_QUEUE_HPP
@@ -89,8 +89,67 @@ class Queue : public Handle<QueueImpl> {
 
   QueueFamily getQueueFamily() const;
 
+  /**
+   * @brief Non-owning variants of the parent accessors. Do not touch reference counts and are intended for submission
+   *        hot paths.
+   */
+  HandleRef<VulkanInstance> getInstanceRef() const;
+
+  HandleRef<PhysicalDevice> getPhysicalDeviceRef() const;
+
+  HandleRef<LogicalDevice> getLogicalDeviceRef() const;
+
+  HandleRef<QueueFamily> getQueueFamilyRef() const;
+
   const vk::DispatchLoaderDynamic& getDispatcher() const;
 
+  /**
+   * @brief Command statistics of the command buffers of the last successful submit. Empty unless Logi is built with
+   *        LOGI_COMMAND_STATISTICS.
+   */
+  CommandStatistics getLastSubmitStatistics() const;
+
+  /**
+   * @brief Command statistics accumulated over all submits since the last call to endStatisticsFrame.
+   */
+  CommandStatistics getFrameStatistics() const;
+
+  /**
+   * @brief   End the statistics frame. Call once per frame, for example after presenting.
+   *
+   * @return  Command statistics accumulated during the frame.
+   */
+  CommandStatistics endStatisticsFrame() const;
+
+  /**
+   * @brief   Submit and signal the timeline semaphore of the queue once all submitted batches complete. The timeline
+   *          semaphore is created on first use and requires the timelineSemaphore feature.
+   *
+   * @return  Future that becomes ready when the GPU has executed the submits.
+   */
+  vk::ResultValueType<GpuFuture>::type submitFuture(const vk::ArrayProxy<const vk::SubmitInfo>& submits,
+                                                    vk::Fence fence = {}) const;
+
+  /**
+   * @brief   Submit command buffers that wait for the given futures and signal the timeline semaphore of the queue.
+   *
+   * @param   commandBuffers  Submitted command buffers.
+   * @param   waitFutures     Futures whose submissions must complete before the given stages execute.
+   * @param   waitStages      Stages of the command buffers that wait for the futures.
+   * @param   fence           Fence signaled when the submit completes.
+   * @return  Future that becomes ready when the GPU has executed the command buffers.
+   */
+  vk::ResultValueType<GpuFuture>::type
+    submitFuture(const vk::ArrayProxy<const vk::CommandBuffer>& commandBuffers,
+                 const std::vector<GpuFuture>& waitFutures = {},
+                 vk::PipelineStageFlags waitStages = vk::PipelineStageFlagBits::eAllCommands,
+                 vk::Fence fence = {}) const;
+
+  /**
+   * @brief Execute the continuations (see GpuFuture::then) of the submissions of this queue that have completed.
+   */
+  void pollGpuFutures() const;
+
   operator const vk::Queue&() const;
 
   void destroy() const;
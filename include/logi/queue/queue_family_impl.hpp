@@ -19,6 +19,7 @@
 #ifndef LOGI_QUEUE_QUEUE_FAMILY_IMPL_HPP
 #define LOGI_QUEUE_QUEUE_FAMILY_IMPL_HPP
 
+#include <mutex>
 #include <optional>
 #include "logi/base/vulkan_object.hpp"
 #include "logi/structures/extension.hpp"
@@ -30,6 +31,8 @@ class PhysicalDeviceImpl;
 class LogicalDeviceImpl;
 class QueueImpl;
 class CommandPoolImpl;
+class CommandBufferImpl;
+struct ResourceBarriers;
 
 class QueueFamilyImpl : public VulkanObject,
                         public std::enable_shared_from_this<QueueFamilyImpl>,
@@ -54,6 +57,11 @@ class QueueFamilyImpl : public VulkanObject,
 
   void destroyQueue(size_t id);
 
+  void recordPreambleCommandBuffer(std::shared_ptr<CommandBufferImpl>& commandBuffer,
+                                   const ResourceBarriers& barriers);
+
+  void freePreambleCommandBuffer(const std::shared_ptr<CommandBufferImpl>& commandBuffer);
+
   VulkanInstanceImpl& getInstance() const;
 
   PhysicalDeviceImpl& getPhysicalDevice() const;
@@ -77,6 +85,8 @@ class QueueFamilyImpl : public VulkanObject,
   LogicalDeviceImpl& logicalDevice_;
   uint32_t queueFamilyIndex_;
   uint32_t queueCount_;
+  std::mutex preambleMutex_;
+  std::shared_ptr<CommandPoolImpl> preamblePool_;
 };
 
 } // namespace logi
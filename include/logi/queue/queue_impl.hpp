@@ -19,7 +19,10 @@
 #ifndef LOGI_QUEUE_QUEUE_IMPL_HPP
 #define LOGI_QUEUE_QUEUE_IMPL_HPP
 
+#include <mutex>
 #include "logi/base/vulkan_object.hpp"
+#include "logi/command/command_statistics.hpp"
+#include "logi/synchronization/gpu_future.hpp"
 
 namespace logi {
 
@@ -66,6 +69,23 @@ class QueueImpl : public VulkanObject, public std::enable_shared_from_this<Queue
 
   const vk::DispatchLoaderDynamic& getDispatcher() const;
 
+  CommandStatistics getLastSubmitStatistics() const;
+
+  CommandStatistics getFrameStatistics() const;
+
+  CommandStatistics endStatisticsFrame() const;
+
+  vk::ResultValueType<GpuFuture>::type submitFuture(const vk::ArrayProxy<const vk::SubmitInfo>& submits,
+                                                    vk::Fence fence = {}) const;
+
+  vk::ResultValueType<GpuFuture>::type
+    submitFuture(const vk::ArrayProxy<const vk::CommandBuffer>& commandBuffers,
+                 const std::vector<GpuFuture>& waitFutures = {},
+                 vk::PipelineStageFlags waitStages = vk::PipelineStageFlagBits::eAllCommands,
+                 vk::Fence fence = {}) const;
+
+  void pollGpuFutures() const;
+
   operator const vk::Queue&() const;
 
   void destroy() const;
@@ -76,8 +96,29 @@ class QueueImpl : public VulkanObject, public std::enable_shared_from_this<Queue
   // endregion
 
  private:
+  void recordSubmitStatistics(const vk::ArrayProxy<const vk::SubmitInfo>& submits) const;
+
+  /**
+   * @brief Timeline of the queue, created on first use. Caller must hold timelineMutex_.
+   */
+  const std::shared_ptr<GpuTimeline>& acquireGpuTimeline() const;
+
+  /**
+   * @brief Submit batches whose last signal operation signals the timeline value. Caller must hold timelineMutex_.
+   */
+  vk::ResultValueType<GpuFuture>::type submitTimeline(const std::vector<vk::SubmitInfo>& submits, vk::Fence fence,
+                                                      const std::shared_ptr<GpuTimeline>& timeline,
+                                                      uint64_t signalValue) const;
+
   QueueFamilyImpl& queueFamily_;
   vk::Queue vkQueue_;
+  mutable std::mutex timelineMutex_;
+  mutable std::shared_ptr<GpuTimeline> timeline_;
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+  mutable std::mutex statisticsMutex_;
+  mutable CommandStatistics lastSubmitStatistics_;
+  mutable CommandStatistics frameStatistics_;
+#endif
 };
 
 } // namespace logi
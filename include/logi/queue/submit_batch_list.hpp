@@ -0,0 +1,120 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_QUEUE_SUBMIT_BATCH_LIST_HPP
+#define LOGI_QUEUE_SUBMIT_BATCH_LIST_HPP
+
+#include <cstdint>
+#include <vector>
+#include "logi/base/common.hpp"
+
+namespace logi {
+
+/**
+ * @brief Counters of a SubmitBatcher.
+ */
+struct SubmitBatchStatistics {
+  /**
+   * Number of submits that were enqueued.
+   */
+  uint64_t enqueuedSubmits = 0u;
+
+  /**
+   * Number of enqueued submits that were merged into the previous batch.
+   */
+  uint64_t mergedSubmits = 0u;
+
+  /**
+   * Number of vkQueueSubmit calls issued by the flushes.
+   */
+  uint64_t flushes = 0u;
+};
+
+/**
+ * @brief Copies of vk::SubmitInfo batches that are submitted together by a single vkQueueSubmit. Batches keep their
+ *        order, wait and signal semaphores and timeline semaphore values, so the combined submit behaves like the
+ *        individual submits. A batch without wait semaphores is merged into the previous batch if that batch only
+ *        contains command buffers, which does not change the semantics of either batch.
+ *
+ *        Only vk::TimelineSemaphoreSubmitInfo is supported in the pNext chain of the batches.
+ */
+class SubmitBatchList {
+ public:
+  /**
+   * @brief Append a copy of the submit info. The arrays it points to may be released after the call.
+   */
+  void add(const vk::SubmitInfo& submitInfo);
+
+  /**
+   * @brief Append a batch of command buffers with binary semaphores.
+   */
+  void add(const vk::ArrayProxy<const vk::CommandBuffer>& commandBuffers,
+           const vk::ArrayProxy<const vk::Semaphore>& waitSemaphores = {},
+           const vk::ArrayProxy<const vk::PipelineStageFlags>& waitStages = {},
+           const vk::ArrayProxy<const vk::Semaphore>& signalSemaphores = {});
+
+  /**
+   * @brief Number of batches.
+   */
+  size_t size() const;
+
+  bool empty() const;
+
+  /**
+   * @brief   Build the submit infos of the batches.
+   *
+   * @return  Submit infos that point into the list. Valid until the list is modified.
+   */
+  const std::vector<vk::SubmitInfo>& build();
+
+  /**
+   * @brief Remove all batches. Keeps allocated memory for the next batches.
+   */
+  void clear();
+
+  /**
+   * @brief Counters of the batches added since the list was created.
+   */
+  const SubmitBatchStatistics& getStatistics() const;
+
+ private:
+  struct Batch {
+    std::vector<vk::Semaphore> waitSemaphores;
+    std::vector<vk::PipelineStageFlags> waitStages;
+    std::vector<vk::CommandBuffer> commandBuffers;
+    std::vector<vk::Semaphore> signalSemaphores;
+    std::vector<uint64_t> waitValues;
+    std::vector<uint64_t> signalValues;
+    bool timeline = false;
+  };
+
+  /**
+   * @brief Batch the next submit is merged into, or a new batch.
+   */
+  Batch& nextBatch(bool mergeable);
+
+  std::vector<Batch> batches_;
+  size_t batchCount_ = 0u;
+  std::vector<vk::SubmitInfo> submitInfos_;
+  std::vector<vk::TimelineSemaphoreSubmitInfo> timelineInfos_;
+  SubmitBatchStatistics statistics_;
+};
+
+} // namespace logi
+
+#endif // LOGI_QUEUE_SUBMIT_BATCH_LIST_HPP
@@ -0,0 +1,92 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_QUEUE_SUBMIT_BATCHER_HPP
+#define LOGI_QUEUE_SUBMIT_BATCHER_HPP
+
+#include <mutex>
+#include "logi/base/common.hpp"
+#include "logi/queue/queue.hpp"
+#include "logi/queue/submit_batch_list.hpp"
+
+namespace logi {
+
+/**
+ * @brief Collects submits from multiple producers and submits them to the queue with a single vkQueueSubmit per flush.
+ *        Submits are executed in the order in which they were enqueued and keep their semaphores, so enqueuing and
+ *        flushing is equivalent to calling Queue::submit for each submit. Nothing is submitted until flush is called,
+ *        so producers that depend on the completion of their work (fence waits, presentation) must flush first.
+ *
+ *        All functions are thread safe. Queue access by other submitters must still be externally synchronized with
+ *        flush.
+ */
+class SubmitBatcher {
+ public:
+  SubmitBatcher() = default;
+
+  explicit SubmitBatcher(const Queue& queue);
+
+  SubmitBatcher(const SubmitBatcher&) = delete;
+
+  SubmitBatcher& operator=(const SubmitBatcher&) = delete;
+
+  /**
+   * @brief Enqueue a copy of the submit info. Only vk::TimelineSemaphoreSubmitInfo is supported in its pNext chain.
+   */
+  void enqueue(const vk::SubmitInfo& submitInfo);
+
+  /**
+   * @brief Enqueue command buffers with binary wait and signal semaphores.
+   */
+  void enqueue(const vk::ArrayProxy<const vk::CommandBuffer>& commandBuffers,
+               const vk::ArrayProxy<const vk::Semaphore>& waitSemaphores = {},
+               const vk::ArrayProxy<const vk::PipelineStageFlags>& waitStages = {},
+               const vk::ArrayProxy<const vk::Semaphore>& signalSemaphores = {});
+
+  /**
+   * @brief Submit all enqueued submits with a single vkQueueSubmit. Does nothing when there are no enqueued submits and
+   *        no fence is given.
+   *
+   * @param fence Fence signaled when all flushed submits complete.
+   */
+  vk::ResultValueType<void>::type flush(vk::Fence fence = {});
+
+  /**
+   * @brief Number of batches that will be submitted by the next flush.
+   */
+  size_t getPendingBatchCount() const;
+
+  SubmitBatchStatistics getStatistics() const;
+
+  const Queue& getQueue() const;
+
+  /**
+   * @brief Drop the enqueued submits and release the queue.
+   */
+  void destroy();
+
+ private:
+  Queue queue_;
+  mutable std::mutex mutex_;
+  SubmitBatchList batches_;
+  uint64_t flushes_ = 0u;
+};
+
+} // namespace logi
+
+#endif // LOGI_QUEUE_SUBMIT_BATCHER_HPP
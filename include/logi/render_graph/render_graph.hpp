@@ -0,0 +1,286 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_RENDER_GRAPH_RENDER_GRAPH_HPP
+#define LOGI_RENDER_GRAPH_RENDER_GRAPH_HPP
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <vk_mem_alloc.h>
+#include "logi/base/common.hpp"
+#include "logi/command/command_buffer.hpp"
+#include "logi/device/logical_device.hpp"
+#include "logi/memory/buffer.hpp"
+#include "logi/memory/image.hpp"
+#include "logi/memory/image_view.hpp"
+#include "logi/memory/memory_allocator.hpp"
+#include "logi/render_graph/render_graph_plan.hpp"
+#include "logi/render_pass/framebuffer.hpp"
+#include "logi/render_pass/render_pass.hpp"
+
+namespace logi {
+
+class RenderGraph;
+
+/**
+ * @brief Records the commands of a pass. Graphics passes are called inside of the render pass created by the graph.
+ */
+using RenderGraphExecuteFunction = std::function<void(const CommandBuffer& commandBuffer, const RenderGraph& graph)>;
+
+/**
+ * @brief Declares the accesses of a render graph pass.
+ */
+class RenderGraphPassBuilder {
+ public:
+  RenderGraphPassBuilder(RenderGraph& graph, uint32_t pass);
+
+  /**
+   * @brief Declare a read of the image subresource range or the whole buffer.
+   */
+  RenderGraphPassBuilder& read(RenderGraphResource resource, ResourceUsage usage,
+                               const vk::ImageSubresourceRange& range = RenderGraphAccess().imageRange);
+
+  /**
+   * @brief Declare a write of the image subresource range or the whole buffer.
+   */
+  RenderGraphPassBuilder& write(RenderGraphResource resource, ResourceUsage usage,
+                                const vk::ImageSubresourceRange& range = RenderGraphAccess().imageRange);
+
+  /**
+   * @brief Declare an access of the buffer range.
+   */
+  RenderGraphPassBuilder& access(RenderGraphResource resource, ResourceUsage usage, vk::DeviceSize offset,
+                                 vk::DeviceSize size);
+
+  /**
+   * @brief Add color attachment of the render pass of the pass.
+   */
+  RenderGraphPassBuilder& addColorAttachment(RenderGraphResource resource,
+                                             vk::AttachmentLoadOp loadOp = vk::AttachmentLoadOp::eLoad,
+                                             const vk::ClearValue& clearValue = {},
+                                             vk::AttachmentStoreOp storeOp = vk::AttachmentStoreOp::eStore);
+
+  /**
+   * @brief Set depth stencil attachment of the render pass of the pass.
+   *
+   * @param readOnly  If true, the attachment is used in the read-only layout and may be sampled in the same pass.
+   */
+  RenderGraphPassBuilder& setDepthStencilAttachment(RenderGraphResource resource,
+                                                    vk::AttachmentLoadOp loadOp = vk::AttachmentLoadOp::eLoad,
+                                                    const vk::ClearValue& clearValue = {},
+                                                    vk::AttachmentStoreOp storeOp = vk::AttachmentStoreOp::eStore,
+                                                    bool readOnly = false);
+
+  /**
+   * @brief Mark the pass as having side effects invisible to the graph, which prevents it from being culled.
+   */
+  RenderGraphPassBuilder& setSideEffects(bool sideEffects = true);
+
+  /**
+   * @brief Index of the pass in declaration order.
+   */
+  uint32_t getIndex() const;
+
+ private:
+  RenderGraphPassDescription& description() const;
+
+  RenderGraph* graph_;
+  uint32_t pass_;
+};
+
+/**
+ * @brief Frame graph built on top of render passes, framebuffers and the memory allocator.
+ *
+ *        Each frame, resources and passes are declared after reset() and the graph is executed into a command buffer.
+ *        The graph culls passes that do not contribute to imported resources or side effects. It orders the rest and
+ *        records the barriers between them, computed with the resource state trackers (see ResourceUsage). Graphics
+ *        passes are executed inside of single subpass render passes created by the graph. Transient resources with
+ *        disjoint lifetimes are bound to the same VMA allocation.
+ *
+ *        Compilation is cached. It is repeated only when the declared topology (resources, accesses and attachments)
+ *        differs from the previous compilation. Imported resource handles and clear values may change every frame.
+ *
+ *        Resources owned by the graph are recreated when the topology changes, and they are destroyed by destroy().
+ *        The caller must ensure that the GPU is no longer using them. Framebuffers are cached per set of attachment
+ *        views and are destroyed once one of their views is destroyed, e.g. when the swapchain is recreated. The graph
+ *        must be externally synchronized.
+ */
+class RenderGraph {
+ public:
+  RenderGraph() = default;
+
+  RenderGraph(const LogicalDevice& logicalDevice, const MemoryAllocator& memoryAllocator);
+
+  RenderGraph(const RenderGraph&) = delete;
+
+  RenderGraph& operator=(const RenderGraph&) = delete;
+
+  /**
+   * @brief Clear declared resources and passes. Compiled state is kept for the next compilation.
+   */
+  void reset();
+
+  /**
+   * @brief Declare a transient image owned by the graph. Contents of transient resources are undefined at their first
+   *        use in each execution.
+   */
+  RenderGraphResource createImage(const std::string& name, const RenderGraphImageInfo& info);
+
+  /**
+   * @brief Declare a transient buffer owned by the graph.
+   */
+  RenderGraphResource createBuffer(const std::string& name, const RenderGraphBufferInfo& info);
+
+  /**
+   * @brief Declare an image owned outside of the graph.
+   *
+   * @param name          Name of the resource.
+   * @param image         Imported image.
+   * @param imageView     View of the whole image used as an attachment.
+   * @param info          Description of the image. Usage is ignored.
+   * @param initialAccess Last access of the image before the graph executes. For swapchain images use the stage of
+   *                      the acquire semaphore wait and the undefined layout.
+   * @param finalUsage    Usage to which the image is transitioned after the graph executes.
+   */
+  RenderGraphResource importImage(const std::string& name, const Image& image, const ImageView& imageView,
+                                  const RenderGraphImageInfo& info, const ResourceAccess& initialAccess = {},
+                                  const std::optional<ResourceUsage>& finalUsage = {});
+
+  /**
+   * @brief Declare a buffer owned outside of the graph.
+   */
+  RenderGraphResource importBuffer(const std::string& name, const Buffer& buffer, vk::DeviceSize size,
+                                   const ResourceAccess& initialAccess = {},
+                                   const std::optional<ResourceUsage>& finalUsage = {});
+
+  /**
+   * @brief Declare a pass. Passes are declared in the order in which their accesses are meant to happen.
+   */
+  RenderGraphPassBuilder addPass(const std::string& name, RenderGraphExecuteFunction execute);
+
+  /**
+   * @brief   Compile the graph unless the topology is unchanged since the previous compilation.
+   *
+   * @return  True if the graph was recompiled.
+   */
+  bool compile();
+
+  /**
+   * @brief Compile the graph if needed and record all passes and barriers into the command buffer, which must be in the
+   *        recording state and outside of a render pass.
+   */
+  void execute(const CommandBuffer& commandBuffer);
+
+  /**
+   * @brief Image of the resource in the current frame.
+   */
+  vk::Image getImage(RenderGraphResource resource) const;
+
+  /**
+   * @brief View of the whole image of the resource in the current frame.
+   */
+  const ImageView& getImageView(RenderGraphResource resource) const;
+
+  /**
+   * @brief Buffer of the resource in the current frame.
+   */
+  vk::Buffer getBuffer(RenderGraphResource resource) const;
+
+  /**
+   * @brief Render pass of the graphics pass, for creating compatible pipelines. Available after compilation.
+   */
+  const RenderPass& getRenderPass(uint32_t pass) const;
+
+  const RenderGraphPlan& getPlan() const;
+
+  /**
+   * @brief Number of compilations, including the first one.
+   */
+  size_t getCompileCount() const;
+
+  /**
+   * @brief Destroy resources owned by the graph.
+   */
+  void destroy();
+
+ private:
+  friend class RenderGraphPassBuilder;
+
+  struct Pass {
+    RenderGraphExecuteFunction execute;
+  };
+
+  struct PhysicalResource {
+    Image image;
+    ImageView imageView;
+    Buffer buffer;
+  };
+
+  struct CachedFramebuffer {
+    std::vector<ImageView> attachments;
+    Framebuffer framebuffer;
+  };
+
+  struct GraphicsPass {
+    RenderPass renderPass;
+    vk::Extent2D extent;
+    std::vector<CachedFramebuffer> framebuffers;
+  };
+
+  RenderGraphResource addResource(RenderGraphResourceDescription description, PhysicalResource physicalResource);
+
+  void createResources();
+
+  void createRenderPasses();
+
+  void destroyResources();
+
+  const Framebuffer& getFramebuffer(GraphicsPass& graphicsPass, const RenderGraphPassDescription& pass);
+
+  void recordBarriers(const CommandBuffer& commandBuffer, const RenderGraphBarriers& barriers);
+
+  const PhysicalResource& getPhysicalResource(RenderGraphResource resource) const;
+
+  LogicalDevice logicalDevice_;
+  MemoryAllocator memoryAllocator_;
+
+  std::vector<RenderGraphResourceDescription> resources_;
+  std::vector<PhysicalResource> importedResources_;
+  std::vector<RenderGraphPassDescription> passes_;
+  std::vector<Pass> passFunctions_;
+
+  std::vector<RenderGraphResourceDescription> compiledResources_;
+  std::vector<RenderGraphPassDescription> compiledPasses_;
+  bool compiled_ = false;
+  size_t compileCount_ = 0u;
+  RenderGraphPlan plan_;
+  std::vector<PhysicalResource> transientResources_;
+  std::vector<VmaAllocation> allocations_;
+  std::vector<GraphicsPass> graphicsPasses_;
+
+  std::vector<vk::ImageMemoryBarrier> imageBarriers_;
+  std::vector<vk::BufferMemoryBarrier> bufferBarriers_;
+  std::vector<vk::ClearValue> clearValues_;
+};
+
+} // namespace logi
+
+#endif // LOGI_RENDER_GRAPH_RENDER_GRAPH_HPP
@@ -0,0 +1,299 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_RENDER_GRAPH_RENDER_GRAPH_PLAN_HPP
+#define LOGI_RENDER_GRAPH_RENDER_GRAPH_PLAN_HPP
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+#include "logi/base/common.hpp"
+#include "logi/synchronization/resource_state.hpp"
+
+namespace logi {
+
+/**
+ * @brief Handle of a virtual render graph resource. Handles are indices of the resources in declaration order.
+ */
+struct RenderGraphResource {
+  static constexpr uint32_t kInvalidIndex = ~0u;
+
+  explicit operator bool() const {
+    return index != kInvalidIndex;
+  }
+
+  uint32_t index = kInvalidIndex;
+};
+
+enum class RenderGraphResourceType { eImage, eBuffer };
+
+/**
+ * @brief Description of a render graph image.
+ */
+struct RenderGraphImageInfo {
+  bool operator==(const RenderGraphImageInfo& other) const;
+
+  bool operator!=(const RenderGraphImageInfo& other) const {
+    return !(*this == other);
+  }
+
+  vk::Format format = vk::Format::eUndefined;
+  vk::Extent3D extent = vk::Extent3D(1u, 1u, 1u);
+  vk::ImageType imageType = vk::ImageType::e2D;
+  uint32_t mipLevels = 1u;
+  uint32_t arrayLayers = 1u;
+  vk::SampleCountFlagBits samples = vk::SampleCountFlagBits::e1;
+  vk::ImageAspectFlags aspectMask = vk::ImageAspectFlagBits::eColor;
+  /**
+   * Usage flags in addition to the flags derived from the accesses of the passes.
+   */
+  vk::ImageUsageFlags usage;
+};
+
+/**
+ * @brief Description of a render graph buffer.
+ */
+struct RenderGraphBufferInfo {
+  bool operator==(const RenderGraphBufferInfo& other) const;
+
+  bool operator!=(const RenderGraphBufferInfo& other) const {
+    return !(*this == other);
+  }
+
+  vk::DeviceSize size = 0u;
+  /**
+   * Usage flags in addition to the flags derived from the accesses of the passes.
+   */
+  vk::BufferUsageFlags usage;
+};
+
+/**
+ * @brief Description of a virtual render graph resource.
+ */
+struct RenderGraphResourceDescription {
+  bool operator==(const RenderGraphResourceDescription& other) const;
+
+  bool operator!=(const RenderGraphResourceDescription& other) const {
+    return !(*this == other);
+  }
+
+  std::string name;
+  RenderGraphResourceType type = RenderGraphResourceType::eImage;
+  RenderGraphImageInfo image;
+  RenderGraphBufferInfo buffer;
+  /**
+   * Imported resources are owned outside of the graph. They are never culled or aliased.
+   */
+  bool imported = false;
+  /**
+   * Last access of an imported resource before the graph executes.
+   */
+  ResourceAccess initialAccess;
+  /**
+   * Usage to which an imported resource is transitioned after the graph executes.
+   */
+  std::optional<ResourceUsage> finalUsage;
+};
+
+/**
+ * @brief Access of a pass to a resource. Whether the access reads or writes the resource is determined by the usage.
+ */
+struct RenderGraphAccess {
+  bool operator==(const RenderGraphAccess& other) const;
+
+  RenderGraphResource resource;
+  ResourceUsage usage = ResourceUsage::eGeneral;
+  vk::ImageSubresourceRange imageRange = vk::ImageSubresourceRange({}, 0u, VK_REMAINING_MIP_LEVELS, 0u,
+                                                                   VK_REMAINING_ARRAY_LAYERS);
+  vk::DeviceSize offset = 0u;
+  vk::DeviceSize size = VK_WHOLE_SIZE;
+};
+
+/**
+ * @brief Render pass attachment of a graphics pass.
+ */
+struct RenderGraphAttachment {
+  RenderGraphResource resource;
+  vk::AttachmentLoadOp loadOp = vk::AttachmentLoadOp::eLoad;
+  vk::AttachmentStoreOp storeOp = vk::AttachmentStoreOp::eStore;
+  /**
+   * Depth stencil attachment is used in the read-only layout.
+   */
+  bool readOnly = false;
+  /**
+   * Clear value used with vk::AttachmentLoadOp::eClear. It is not a part of the graph topology.
+   */
+  vk::ClearValue clearValue;
+};
+
+/**
+ * @brief Description of a render graph pass. Passes with attachments are graphics passes, which are executed inside of
+ *        a render pass created by the graph. Attachments are also listed in accesses.
+ */
+struct RenderGraphPassDescription {
+  bool isGraphics() const {
+    return !colorAttachments.empty() || depthStencilAttachment.has_value();
+  }
+
+  /**
+   * @brief Compare passes ignoring clear values.
+   */
+  bool hasSameTopology(const RenderGraphPassDescription& other) const;
+
+  std::string name;
+  std::vector<RenderGraphAccess> accesses;
+  std::vector<RenderGraphAttachment> colorAttachments;
+  std::optional<RenderGraphAttachment> depthStencilAttachment;
+  /**
+   * Passes with side effects are never culled.
+   */
+  bool sideEffects = false;
+};
+
+/**
+ * @brief Barriers recorded before a pass. Image and buffer handles of the barriers are resolved at execution, the
+ *        resource of each barrier is stored in imageResources and bufferResources.
+ */
+struct RenderGraphBarriers {
+  bool empty() const {
+    return barriers.empty();
+  }
+
+  ResourceBarriers barriers;
+  std::vector<uint32_t> imageResources;
+  std::vector<uint32_t> bufferResources;
+};
+
+struct RenderGraphScheduledPass {
+  /**
+   * Index of the pass in declaration order.
+   */
+  uint32_t pass = 0u;
+  RenderGraphBarriers barriers;
+};
+
+/**
+ * @brief Range of scheduled passes that use a resource.
+ */
+struct RenderGraphLifetime {
+  static constexpr uint32_t kUnused = ~0u;
+
+  bool used() const {
+    return firstPass != kUnused;
+  }
+
+  bool overlaps(const RenderGraphLifetime& other) const {
+    return firstPass <= other.lastPass && other.firstPass <= lastPass;
+  }
+
+  uint32_t firstPass = kUnused;
+  uint32_t lastPass = kUnused;
+};
+
+/**
+ * @brief Memory shared by transient resources with disjoint lifetimes.
+ */
+struct RenderGraphAliasSlot {
+  RenderGraphResourceType type = RenderGraphResourceType::eImage;
+  /**
+   * Resources in the order of their lifetimes.
+   */
+  std::vector<uint32_t> resources;
+  vk::MemoryRequirements memoryRequirements;
+};
+
+/**
+ * @brief Device independent part of render graph compilation. Culls passes that do not contribute to imported resources
+ *        or side effects, orders the remaining passes, computes resource lifetimes, assigns transient resources to
+ *        alias slots and computes the barriers recorded before each pass.
+ */
+class RenderGraphPlan {
+ public:
+  /**
+   * @brief Returns memory requirements of the transient resource. Called after the usage of the resource is known.
+   */
+  using MemoryRequirementsFunction = std::function<vk::MemoryRequirements(uint32_t resource)>;
+
+  /**
+   * @brief Compile the graph.
+   *
+   * @param resources             Resource descriptions.
+   * @param passes                Pass descriptions in declaration order.
+   * @param getMemoryRequirements Returns memory requirements of used transient resources.
+   */
+  void compile(const std::vector<RenderGraphResourceDescription>& resources,
+               const std::vector<RenderGraphPassDescription>& passes,
+               const MemoryRequirementsFunction& getMemoryRequirements);
+
+  /**
+   * @brief Passes in execution order. Culled passes are omitted.
+   */
+  const std::vector<RenderGraphScheduledPass>& getPasses() const;
+
+  /**
+   * @brief Barriers recorded after the last pass, which transition imported resources to their final usage.
+   */
+  const RenderGraphBarriers& getFinalBarriers() const;
+
+  size_t getCulledPassCount() const;
+
+  const RenderGraphLifetime& getLifetime(uint32_t resource) const;
+
+  vk::ImageUsageFlags getImageUsage(uint32_t resource) const;
+
+  vk::BufferUsageFlags getBufferUsage(uint32_t resource) const;
+
+  const std::vector<RenderGraphAliasSlot>& getAliasSlots() const;
+
+  /**
+   * @brief Alias slot of the transient resource or kNoAliasSlot for imported and unused resources.
+   */
+  uint32_t getAliasSlot(uint32_t resource) const;
+
+  static constexpr uint32_t kNoAliasSlot = ~0u;
+
+ private:
+  void cull(const std::vector<RenderGraphResourceDescription>& resources,
+            const std::vector<RenderGraphPassDescription>& passes, std::vector<bool>& needed) const;
+
+  void schedule(const std::vector<RenderGraphResourceDescription>& resources,
+                const std::vector<RenderGraphPassDescription>& passes, const std::vector<bool>& needed);
+
+  void computeUsage(const std::vector<RenderGraphResourceDescription>& resources,
+                    const std::vector<RenderGraphPassDescription>& passes);
+
+  void assignAliasSlots(const std::vector<RenderGraphResourceDescription>& resources,
+                        const MemoryRequirementsFunction& getMemoryRequirements);
+
+  void computeBarriers(const std::vector<RenderGraphResourceDescription>& resources,
+                       const std::vector<RenderGraphPassDescription>& passes);
+
+  std::vector<RenderGraphScheduledPass> passes_;
+  RenderGraphBarriers finalBarriers_;
+  size_t culledPassCount_ = 0u;
+  std::vector<RenderGraphLifetime> lifetimes_;
+  std::vector<vk::ImageUsageFlags> imageUsage_;
+  std::vector<vk::BufferUsageFlags> bufferUsage_;
+  std::vector<RenderGraphAliasSlot> aliasSlots_;
+  std::vector<uint32_t> resourceAliasSlots_;
+};
+
+} // namespace logi
+
+#endif // LOGI_RENDER_GRAPH_RENDER_GRAPH_PLAN_HPP
@@ -0,0 +1,166 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_SYNCHRONIZATION_GPU_FUTURE_HPP
+#define LOGI_SYNCHRONIZATION_GPU_FUTURE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "logi/base/common.hpp"
+#include "logi/base/deferred_destruction_queue.hpp"
+
+namespace logi {
+
+/**
+ * @brief Timeline semaphore of a queue together with the continuations that wait for its values. Signal values are
+ *        allocated in increasing order and must be submitted in the order of allocation. Continuations are executed on
+ *        the thread that polls the timeline, outside of the internal locks.
+ */
+class GpuTimeline {
+ public:
+  /**
+   * @brief Reads the current counter value of the timeline semaphore.
+   */
+  using CounterSource = std::function<uint64_t()>;
+
+  /**
+   * @brief Waits on semaphores of the same logical device as the timeline semaphore (see vkWaitSemaphores).
+   */
+  using WaitFunction = std::function<vk::Result(const vk::SemaphoreWaitInfo& waitInfo, uint64_t timeout)>;
+
+  /**
+   * @param semaphore     Timeline semaphore.
+   * @param counterSource Reads the counter of the semaphore.
+   * @param waitFunction  Waits on the semaphore and other semaphores of its logical device.
+   */
+  GpuTimeline(const vk::Semaphore& semaphore, CounterSource counterSource, WaitFunction waitFunction);
+
+  GpuTimeline(const GpuTimeline&) = delete;
+
+  GpuTimeline& operator=(const GpuTimeline&) = delete;
+
+  /**
+   * @brief Allocate the next signal value.
+   */
+  uint64_t allocateValue();
+
+  /**
+   * @brief   Read the counter of the semaphore and execute the continuations of the completed values.
+   *
+   * @return  Last completed value.
+   */
+  uint64_t poll();
+
+  /**
+   * @brief Check if the value was completed. Polls the semaphore only if the last read value is lower.
+   */
+  bool isComplete(uint64_t value);
+
+  /**
+   * @brief Execute the callback once the value is completed. Executed immediately if it is already completed.
+   */
+  void then(uint64_t value, std::function<void()> callback);
+
+  /**
+   * @brief Number of continuations that wait for values that were not completed at the last poll.
+   */
+  size_t getPendingContinuationCount() const;
+
+  /**
+   * @brief   Execute all pending continuations regardless of their values, e.g. when the timeline is released.
+   *
+   * @return  Number of executed continuations.
+   */
+  size_t flush();
+
+  /**
+   * @brief Wait on the semaphores of the wait info, which must belong to the logical device of this timeline.
+   */
+  vk::Result wait(const vk::SemaphoreWaitInfo& waitInfo, uint64_t timeout) const;
+
+  const vk::Semaphore& getSemaphore() const;
+
+ private:
+  vk::Semaphore semaphore_;
+  CounterSource counterSource_;
+  WaitFunction waitFunction_;
+  std::atomic<uint64_t> lastValue_ {0u};
+  std::atomic<uint64_t> completedValue_ {0u};
+  DeferredDestructionQueue continuations_;
+};
+
+/**
+ * @brief Result of a queue submission that becomes ready when the GPU has executed it. Backed by the timeline
+ *        semaphore of the queue the work was submitted to (see Queue::submitFuture). A future may also combine multiple
+ *        submissions (see whenAll). Default constructed future does not refer to any submission and is always ready.
+ */
+class GpuFuture {
+ public:
+  GpuFuture() = default;
+
+  GpuFuture(std::shared_ptr<GpuTimeline> timeline, uint64_t value);
+
+  /**
+   * @brief Future that becomes ready when all of the given futures are ready.
+   */
+  static GpuFuture whenAll(const std::vector<GpuFuture>& futures);
+
+  /**
+   * @brief Check if the future refers to a submission.
+   */
+  bool isValid() const;
+
+  /**
+   * @brief Check if the GPU has executed the submission. Does not block.
+   */
+  bool isReady() const;
+
+  /**
+   * @brief   Block until the GPU has executed the submission or the timeout expires.
+   *
+   * @param   timeout Timeout in nanoseconds.
+   * @return  vk::Result::eSuccess if the future is ready, otherwise vk::Result::eTimeout.
+   */
+  vk::Result wait(uint64_t timeout = UINT64_MAX) const;
+
+  /**
+   * @brief Execute the callback once the future is ready. The callback is executed by the thread that polls one of the
+   *        timelines of the future (isReady, wait or Queue::pollGpuFutures), or immediately if the future is ready.
+   */
+  void then(std::function<void()> callback) const;
+
+  /**
+   * @brief Append the timeline semaphores and values of the future, e.g. to wait for it in a submit.
+   */
+  void appendWaitSemaphores(std::vector<vk::Semaphore>& semaphores, std::vector<uint64_t>& values) const;
+
+ private:
+  struct TimelinePoint {
+    std::shared_ptr<GpuTimeline> timeline;
+    uint64_t value = 0u;
+  };
+
+  std::vector<TimelinePoint> points_;
+};
+
+} // namespace logi
+
+#endif // LOGI_SYNCHRONIZATION_GPU_FUTURE_HPP
@@ -0,0 +1,295 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGI_SYNCHRONIZATION_RESOURCE_STATE_HPP
+#define LOGI_SYNCHRONIZATION_RESOURCE_STATE_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "logi/base/common.hpp"
+
+namespace logi {
+
+/**
+ * @brief Common ways in which commands use an image or a buffer. Each usage maps to the pipeline stages, access types
+ *        and image layout of the access (see getResourceAccess).
+ */
+enum class ResourceUsage {
+  eTransferSrc,
+  eTransferDst,
+  eVertexBuffer,
+  eIndexBuffer,
+  eIndirectBuffer,
+  eUniformBuffer,
+  eVertexShaderRead,
+  eFragmentShaderRead,
+  eComputeShaderRead,
+  eComputeShaderWrite,
+  eComputeShaderReadWrite,
+  eColorAttachment,
+  eDepthStencilAttachment,
+  eDepthStencilRead,
+  eHostRead,
+  eHostWrite,
+  eGeneral,
+  ePresent
+};
+
+/**
+ * @brief Pipeline stages, access types and image layout of a resource access. The layout is ignored for buffers.
+ */
+struct ResourceAccess {
+  vk::PipelineStageFlags stageMask;
+  vk::AccessFlags accessMask;
+  vk::ImageLayout layout = vk::ImageLayout::eUndefined;
+
+  bool operator==(const ResourceAccess& other) const;
+
+  bool operator!=(const ResourceAccess& other) const;
+};
+
+/**
+ * @brief Retrieve the access of the given usage.
+ */
+ResourceAccess getResourceAccess(ResourceUsage usage);
+
+/**
+ * @brief Synchronization state of an image subresource or a buffer range.
+ */
+struct ResourceState {
+  /**
+   * Current image layout.
+   */
+  vk::ImageLayout layout = vk::ImageLayout::eUndefined;
+
+  /**
+   * Stages and access types of the last write that may still need to be made visible.
+   */
+  vk::PipelineStageFlags writeStageMask;
+  vk::AccessFlags writeAccessMask;
+
+  /**
+   * Stages that read the resource since the last write. Later writes must wait for them.
+   */
+  vk::PipelineStageFlags readStageMask;
+
+  /**
+   * Stages and access types to which the last write was already made visible.
+   */
+  vk::PipelineStageFlags visibleStageMask;
+  vk::AccessFlags visibleAccessMask;
+
+  bool operator==(const ResourceState& other) const;
+
+  bool operator!=(const ResourceState& other) const;
+};
+
+/**
+ * @brief State of an image subresource or a buffer range as seen by a state tracker. Trackers of command buffers start
+ *        with unknown states and remember the first access to each subresource, which is reconciled with the actual
+ *        state of the resource when the command buffer is submitted.
+ */
+struct SubresourceState {
+  ResourceState state;
+
+  /**
+   * Access that the subresource was first used with. Reads that follow the first read in the same layout are folded
+   * into it, because they do not need barriers within the command buffer.
+   */
+  ResourceAccess firstAccess;
+
+  /**
+   * True if the state is known (the subresource was accessed).
+   */
+  bool known = false;
+
+  /**
+   * True while the subresource was only read in the layout of the first access.
+   */
+  bool firstAccessOpen = false;
+
+  bool operator==(const SubresourceState& other) const;
+
+  bool operator!=(const SubresourceState& other) const;
+};
+
+/**
+ * @brief Barriers that synchronize a set of resource accesses. Recorded with a single vkCmdPipelineBarrier.
+ */
+struct ResourceBarriers {
+  vk::PipelineStageFlags srcStageMask;
+  vk::PipelineStageFlags dstStageMask;
+  std::vector<vk::BufferMemoryBarrier> bufferBarriers;
+  std::vector<vk::ImageMemoryBarrier> imageBarriers;
+
+  /**
+   * @brief Check if no barriers are required.
+   */
+  bool empty() const;
+
+  void clear();
+};
+
+/**
+ * @brief Tracks the state of each mip level and array layer of an image. Aspects of a subresource are tracked
+ *        together.
+ */
+class ImageState {
+ public:
+  ImageState() = default;
+
+  /**
+   * @brief Create tracker with unknown states (used by command buffers).
+   */
+  ImageState(vk::Image image, vk::ImageAspectFlags aspectMask, uint32_t mipLevels, uint32_t arrayLayers);
+
+  /**
+   * @brief Create tracker in which all subresources are in the given layout and were not accessed yet.
+   */
+  ImageState(vk::Image image, vk::ImageAspectFlags aspectMask, uint32_t mipLevels, uint32_t arrayLayers,
+             vk::ImageLayout layout);
+
+  /**
+   * @brief   Access the subresource range with the given access and append the required barriers. Barriers of
+   *          neighbouring subresources with the same state are merged.
+   *
+   * @param   range           Subresource range. The aspect mask of the range is ignored.
+   * @param   access          New access.
+   * @param   discardContents Transition from the undefined layout (contents of the range are not preserved).
+   * @param   barriers        Barriers to which the required barriers are appended.
+   */
+  void transition(const vk::ImageSubresourceRange& range, const ResourceAccess& access, bool discardContents,
+                  ResourceBarriers& barriers);
+
+  /**
+   * @brief Synchronize this state with the first accesses of the given command buffer state, append the required
+   *        barriers and advance the state to the state after the command buffer.
+   */
+  void reconcile(const ImageState& commandBufferState, ResourceBarriers& barriers);
+
+  /**
+   * @brief Retrieve state of the subresource or nullptr if the state is unknown.
+   */
+  const SubresourceState* getSubresourceState(uint32_t mipLevel, uint32_t arrayLayer) const;
+
+  vk::Image getImage() const;
+
+  vk::ImageAspectFlags getAspectMask() const;
+
+  uint32_t getMipLevels() const;
+
+  uint32_t getArrayLayers() const;
+
+ private:
+  size_t index(uint32_t mipLevel, uint32_t arrayLayer) const;
+
+  vk::Image image_;
+  vk::ImageAspectFlags aspectMask_;
+  uint32_t mipLevels_ = 0u;
+  uint32_t arrayLayers_ = 0u;
+  std::vector<SubresourceState> subresources_;
+};
+
+/**
+ * @brief Tracks the state of ranges of a buffer. Ranges with the same state are merged.
+ */
+class BufferState {
+ public:
+  BufferState() = default;
+
+  /**
+   * @brief Create tracker with unknown states (used by command buffers).
+   */
+  BufferState(vk::Buffer buffer, vk::DeviceSize size);
+
+  /**
+   * @brief Create tracker of a buffer that was not accessed yet.
+   */
+  BufferState(vk::Buffer buffer, vk::DeviceSize size, bool known);
+
+  /**
+   * @brief Access the buffer range with the given access and append the required barriers.
+   */
+  void transition(vk::DeviceSize offset, vk::DeviceSize size, const ResourceAccess& access,
+                  ResourceBarriers& barriers);
+
+  /**
+   * @brief Synchronize this state with the first accesses of the given command buffer state, append the required
+   *        barriers and advance the state to the state after the command buffer.
+   */
+  void reconcile(const BufferState& commandBufferState, ResourceBarriers& barriers);
+
+  /**
+   * @brief Retrieve state at the given offset or nullptr if the state is unknown.
+   */
+  const SubresourceState* getSubresourceState(vk::DeviceSize offset) const;
+
+  /**
+   * @brief Number of ranges with distinct states.
+   */
+  size_t getRangeCount() const;
+
+  vk::Buffer getBuffer() const;
+
+  vk::DeviceSize getSize() const;
+
+ private:
+  struct Range {
+    vk::DeviceSize offset;
+    vk::DeviceSize size;
+    SubresourceState state;
+  };
+
+  /**
+   * @brief Split ranges so that [offset, offset + size) starts and ends at range boundaries and return the index of
+   *        the first range inside of it.
+   */
+  size_t split(vk::DeviceSize offset, vk::DeviceSize size);
+
+  /**
+   * @brief Merge neighbouring ranges with the same state.
+   */
+  void merge();
+
+  vk::Buffer buffer_;
+  vk::DeviceSize size_ = 0u;
+  std::vector<Range> ranges_;
+};
+
+/**
+ * @brief State of a resource shared by all command buffers that use it. Guarded by a mutex, because command buffers
+ *        may be submitted from multiple threads.
+ */
+template <typename State>
+struct SharedResourceState {
+  template <typename... Args>
+  explicit SharedResourceState(Args&&... args) : state(std::forward<Args>(args)...) {}
+
+  std::mutex mutex;
+  State state;
+};
+
+using SharedImageState = SharedResourceState<ImageState>;
+
+using SharedBufferState = SharedResourceState<BufferState>;
+
+} // namespace logi
+
+#endif // LOGI_SYNCHRONIZATION_RESOURCE_STATE_HPP
@@ -0,0 +1,75 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/base/deferred_destruction_queue.hpp"
+
+namespace logi {
+
+void DeferredDestructionQueue::enqueue(uint64_t retireValue, std::function<void()> destroy) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  pending_.emplace(retireValue, std::move(destroy));
+}
+
+size_t DeferredDestructionQueue::collect(uint64_t completedValue) {
+  std::vector<std::function<void()>> retired;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    retired = take(pending_.upper_bound(completedValue));
+  }
+
+  // Executed outside of the lock so that callbacks may enqueue further destructions.
+  for (const std::function<void()>& destroy : retired) {
+    destroy();
+  }
+
+  return retired.size();
+}
+
+size_t DeferredDestructionQueue::flush() {
+  std::vector<std::function<void()>> retired;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    retired = take(pending_.end());
+  }
+
+  for (const std::function<void()>& destroy : retired) {
+    destroy();
+  }
+
+  return retired.size();
+}
+
+size_t DeferredDestructionQueue::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pending_.size();
+}
+
+std::vector<std::function<void()>>
+  DeferredDestructionQueue::take(std::multimap<uint64_t, std::function<void()>>::iterator end) {
+  std::vector<std::function<void()>> retired;
+  for (auto it = pending_.begin(); it != end; ++it) {
+    retired.emplace_back(std::move(it->second));
+  }
+  pending_.erase(pending_.begin(), end);
+
+  return retired;
+}
+
+} // namespace logi
@@ -0,0 +1,99 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/base/object_pool.hpp"
+#include <algorithm>
+#include <new>
+
+namespace logi {
+
+ObjectPool::ObjectPool(size_t blocksPerSlab)
+  : blocksPerSlab_(blocksPerSlab), blockSize_(0u), blockAlignment_(0u), allocatedBlocks_(0u), freeList_(nullptr) {}
+
+ObjectPool::~ObjectPool() {
+  for (void* slab : slabs_) {
+    ::operator delete(slab, std::align_val_t(blockAlignment_));
+  }
+}
+
+void* ObjectPool::allocate(size_t size, size_t alignment) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // First allocation determines the block layout.
+  if (blockSize_ == 0u) {
+    blockAlignment_ = std::max(alignment, alignof(FreeBlock));
+    blockSize_ = std::max(size, sizeof(FreeBlock));
+    blockSize_ = (blockSize_ + blockAlignment_ - 1u) / blockAlignment_ * blockAlignment_;
+  }
+
+  if (!fits(size, alignment)) {
+    return ::operator new(size, std::align_val_t(alignment));
+  }
+
+  if (freeList_ == nullptr) {
+    allocateSlab();
+  }
+
+  FreeBlock* block = freeList_;
+  freeList_ = block->next;
+  allocatedBlocks_++;
+
+  return block;
+}
+
+void ObjectPool::deallocate(void* pointer, size_t size, size_t alignment) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (!fits(size, alignment)) {
+    ::operator delete(pointer, std::align_val_t(alignment));
+    return;
+  }
+
+  auto* block = static_cast<FreeBlock*>(pointer);
+  block->next = freeList_;
+  freeList_ = block;
+  allocatedBlocks_--;
+}
+
+size_t ObjectPool::allocatedBlocks() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return allocatedBlocks_;
+}
+
+size_t ObjectPool::capacity() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return slabs_.size() * blocksPerSlab_;
+}
+
+bool ObjectPool::fits(size_t size, size_t alignment) const {
+  return size <= blockSize_ && alignment <= blockAlignment_;
+}
+
+void ObjectPool::allocateSlab() {
+  auto* slab = static_cast<std::byte*>(::operator new(blockSize_ * blocksPerSlab_, std::align_val_t(blockAlignment_)));
+  slabs_.emplace_back(slab);
+
+  // Chain blocks in address order so that consecutive allocations are adjacent.
+  for (size_t i = blocksPerSlab_; i > 0u; i--) {
+    auto* block = reinterpret_cast<FreeBlock*>(slab + (i - 1u) * blockSize_);
+    block->next = freeList_;
+    freeList_ = block;
+  }
+}
+
+} // namespace logi
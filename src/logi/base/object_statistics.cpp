@@ -0,0 +1,113 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/base/object_statistics.hpp"
+#include <sstream>
+
+namespace logi {
+
+const ObjectTypeStatistics* ObjectStatistics::find(const std::string& typeName) const {
+  for (const ObjectTypeStatistics& type : types) {
+    if (type.typeName == typeName) {
+      return &type;
+    }
+  }
+
+  return nullptr;
+}
+
+std::string ObjectStatistics::toJson() const {
+  std::ostringstream json;
+  json << "{\"interval\":" << interval << ",\"ageBucketBoundsMs\":[";
+  for (size_t i = 0u; i < kObjectAgeBucketBounds.size(); i++) {
+    json << (i > 0u ? "," : "") << kObjectAgeBucketBounds[i];
+  }
+  json << "],\"types\":[";
+
+  for (size_t i = 0u; i < types.size(); i++) {
+    const ObjectTypeStatistics& type = types[i];
+    json << (i > 0u ? "," : "") << "{\"type\":\"" << type.typeName << "\",\"live\":" << type.liveCount
+         << ",\"peak\":" << type.peakCount << ",\"created\":" << type.createdCount
+         << ",\"destroyed\":" << type.destroyedCount << ",\"createRate\":" << type.createRate
+         << ",\"destroyRate\":" << type.destroyRate << ",\"ageHistogram\":[";
+    for (size_t bucket = 0u; bucket < type.ageHistogram.size(); bucket++) {
+      json << (bucket > 0u ? "," : "") << type.ageHistogram[bucket];
+    }
+    json << "]}";
+  }
+
+  json << "]}";
+  return json.str();
+}
+
+void ObjectCounters::recordCreate() {
+  size_t live = liveCount_.fetch_add(1u, std::memory_order_relaxed) + 1u;
+  createdCount_.fetch_add(1u, std::memory_order_relaxed);
+
+  size_t peak = peakCount_.load(std::memory_order_relaxed);
+  while (live > peak && !peakCount_.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+  }
+}
+
+void ObjectCounters::recordDestroy(std::chrono::steady_clock::duration age) {
+  liveCount_.fetch_sub(1u, std::memory_order_relaxed);
+  destroyedCount_.fetch_add(1u, std::memory_order_relaxed);
+
+  double ageMs = std::chrono::duration<double, std::milli>(age).count();
+  size_t bucket = 0u;
+  while (bucket < kObjectAgeBucketBounds.size() && ageMs >= kObjectAgeBucketBounds[bucket]) {
+    bucket++;
+  }
+  ageHistogram_[bucket].fetch_add(1u, std::memory_order_relaxed);
+}
+
+void ObjectCounters::accumulate(ObjectTypeStatistics& statistics) const {
+  statistics.liveCount += liveCount_.load(std::memory_order_relaxed);
+  statistics.peakCount += peakCount_.load(std::memory_order_relaxed);
+  statistics.createdCount += createdCount_.load(std::memory_order_relaxed);
+  statistics.destroyedCount += destroyedCount_.load(std::memory_order_relaxed);
+
+  for (size_t i = 0u; i < kObjectAgeBucketCount; i++) {
+    statistics.ageHistogram[i] += ageHistogram_[i].load(std::memory_order_relaxed);
+  }
+}
+
+ObjectRateTracker::ObjectRateTracker() : previousTime_(std::chrono::steady_clock::now()) {}
+
+void ObjectRateTracker::update(ObjectStatistics& statistics) {
+  update(statistics, std::chrono::steady_clock::now());
+}
+
+void ObjectRateTracker::update(ObjectStatistics& statistics, std::chrono::steady_clock::time_point time) {
+  statistics.interval = std::chrono::duration<double>(time - previousTime_).count();
+  previousTime_ = time;
+
+  for (ObjectTypeStatistics& type : statistics.types) {
+    std::pair<uint64_t, uint64_t>& previous = previousTotals_[type.typeName];
+
+    // Totals of nested types drop when their parent is destroyed, such intervals report zero rate.
+    if (statistics.interval > 0.0 && type.createdCount >= previous.first && type.destroyedCount >= previous.second) {
+      type.createRate = static_cast<double>(type.createdCount - previous.first) / statistics.interval;
+      type.destroyRate = static_cast<double>(type.destroyedCount - previous.second) / statistics.interval;
+    }
+
+    previous = {type.createdCount, type.destroyedCount};
+  }
+}
+
+} // namespace logi
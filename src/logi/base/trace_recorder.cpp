@@ -0,0 +1,231 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/base/trace_recorder.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+namespace logi {
+
+namespace {
+
+std::atomic<uint32_t> nextThreadTrack {TraceRecorder::kGpuTrack + 1u};
+
+void appendEscaped(std::string& json, const std::string& value) {
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        json += "\\\"";
+        break;
+      case '\\':
+        json += "\\\\";
+        break;
+      case '\n':
+        json += "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20u) {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+          json += escaped;
+        } else {
+          json += c;
+        }
+    }
+  }
+}
+
+// Chrome trace timestamps are in microseconds.
+void appendMicroseconds(std::string& json, int64_t nanoseconds) {
+  auto magnitude = static_cast<long long>(std::llabs(nanoseconds));
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%s%lld.%03lld", nanoseconds < 0 ? "-" : "", magnitude / 1000, magnitude % 1000);
+  json += buffer;
+}
+
+} // namespace
+
+TraceRecorder::TraceRecorder(size_t capacity) : capacity_(std::max<size_t>(capacity, 1u)) {}
+
+void TraceRecorder::start() {
+  recording_.store(true, std::memory_order_release);
+}
+
+void TraceRecorder::stop() {
+  recording_.store(false, std::memory_order_release);
+}
+
+bool TraceRecorder::isRecording() const {
+  return recording_.load(std::memory_order_acquire);
+}
+
+void TraceRecorder::setCapacity(size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = std::max<size_t>(capacity, 1u);
+  events_.clear();
+  events_.shrink_to_fit();
+  next_ = 0u;
+  overwritten_ = 0u;
+}
+
+size_t TraceRecorder::getCapacity() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return capacity_;
+}
+
+void TraceRecorder::recordComplete(std::string_view name, const char* category, int64_t begin, int64_t end) {
+  recordComplete(name, category, begin, end, getThreadTrack());
+}
+
+void TraceRecorder::recordComplete(std::string_view name, const char* category, int64_t begin, int64_t end,
+                                   uint32_t track) {
+  if (!isRecording()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  TraceEvent& event = nextEvent();
+  event.name.assign(name.data(), name.size());
+  event.category = category;
+  event.phase = 'X';
+  event.timestamp = begin;
+  event.duration = end - begin;
+  event.track = track;
+}
+
+void TraceRecorder::recordInstant(std::string_view name, const char* category, int64_t timestamp) {
+  if (!isRecording()) {
+    return;
+  }
+
+  uint32_t track = getThreadTrack();
+  std::lock_guard<std::mutex> lock(mutex_);
+  TraceEvent& event = nextEvent();
+  event.name.assign(name.data(), name.size());
+  event.category = category;
+  event.phase = 'i';
+  event.timestamp = timestamp;
+  event.duration = 0;
+  event.track = track;
+}
+
+std::vector<TraceEvent> TraceRecorder::getEvents() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<TraceEvent> events;
+  events.reserve(events_.size());
+
+  // Once the ring buffer has wrapped around, the oldest event is the one that is overwritten next.
+  size_t first = events_.size() < capacity_ ? 0u : next_;
+  for (size_t i = 0u; i < events_.size(); i++) {
+    events.emplace_back(events_[(first + i) % events_.size()]);
+  }
+
+  return events;
+}
+
+uint64_t TraceRecorder::getOverwrittenEventCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return overwritten_;
+}
+
+void TraceRecorder::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  events_.clear();
+  next_ = 0u;
+  overwritten_ = 0u;
+}
+
+std::string TraceRecorder::exportChromeTrace() const {
+  std::vector<TraceEvent> events = getEvents();
+
+  std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+  json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"GPU\"}}";
+
+  for (const TraceEvent& event : events) {
+    json += ",\n{\"name\":\"";
+    appendEscaped(json, event.name);
+    json += "\",\"cat\":\"";
+    appendEscaped(json, event.category);
+    json += "\",\"ph\":\"";
+    json += event.phase;
+    json += "\",\"ts\":";
+    appendMicroseconds(json, event.timestamp);
+    if (event.phase == 'X') {
+      json += ",\"dur\":";
+      appendMicroseconds(json, event.duration);
+    } else {
+      json += ",\"s\":\"t\"";
+    }
+    json += ",\"pid\":1,\"tid\":";
+    json += std::to_string(event.track);
+    json += "}";
+  }
+
+  json += "\n]}\n";
+  return json;
+}
+
+bool TraceRecorder::writeChromeTrace(const std::string& path) const {
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+
+  file << exportChromeTrace();
+  return static_cast<bool>(file);
+}
+
+int64_t TraceRecorder::now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+uint32_t TraceRecorder::getThreadTrack() {
+  thread_local uint32_t track = nextThreadTrack.fetch_add(1u, std::memory_order_relaxed);
+  return track;
+}
+
+TraceEvent& TraceRecorder::nextEvent() {
+  if (events_.size() < capacity_) {
+    next_ = (next_ + 1u) % capacity_;
+    return events_.emplace_back();
+  }
+
+  overwritten_++;
+  TraceEvent& event = events_[next_];
+  next_ = (next_ + 1u) % capacity_;
+  return event;
+}
+
+TraceScope::TraceScope(TraceRecorder& recorder, const char* name, const char* category)
+  : recorder_(recorder.isRecording() ? &recorder : nullptr), name_(name), category_(category) {
+  if (recorder_ != nullptr) {
+    begin_ = TraceRecorder::now();
+  }
+}
+
+TraceScope::~TraceScope() {
+  if (recorder_ != nullptr) {
+    recorder_->recordComplete(name_, category_, begin_, TraceRecorder::now());
+  }
+}
+
+} // namespace logi
@@ -20,14 +20,12 @@
 
 namespace logi {
 
-size_t generateUniqueId() {
-  static std::atomic<size_t> idGenerator = 0u;
-
-  return idGenerator++;
+VulkanObject::VulkanObject(bool valid) : id_(0u), valid_(valid) {
+#ifdef LOGI_ENABLE_OBJECT_STATISTICS
+  creationTime_ = std::chrono::steady_clock::now();
+#endif
 }
 
-VulkanObject::VulkanObject(bool valid) : id_(generateUniqueId()), valid_(valid) {}
-
 void VulkanObject::free() {
   valid_.store(false, std::memory_order::memory_order_relaxed);
 }
@@ -48,4 +46,10 @@ bool VulkanObject::valid() const {
   return valid_.load(std::memory_order::memory_order_relaxed);
 }
 
+#ifdef LOGI_ENABLE_OBJECT_STATISTICS
+std::chrono::steady_clock::time_point VulkanObject::creationTime() const {
+  return creationTime_;
+}
+#endif
+
 } // namespace logi
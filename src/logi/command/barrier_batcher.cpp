@@ -0,0 +1,234 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/command/barrier_batcher.hpp"
+#include <limits>
+#include "logi/command/command_dispatch_table.hpp"
+
+namespace logi {
+
+namespace {
+
+bool rangesOverlap(uint64_t base0, uint64_t count0, uint64_t base1, uint64_t count1, uint64_t remaining) {
+  uint64_t end0 = (count0 == remaining) ? std::numeric_limits<uint64_t>::max() : base0 + count0;
+  uint64_t end1 = (count1 == remaining) ? std::numeric_limits<uint64_t>::max() : base1 + count1;
+  return base0 < end1 && base1 < end0;
+}
+
+bool overlaps(const vk::BufferMemoryBarrier& lhs, const vk::BufferMemoryBarrier& rhs) {
+  return lhs.buffer == rhs.buffer && rangesOverlap(lhs.offset, lhs.size, rhs.offset, rhs.size, VK_WHOLE_SIZE);
+}
+
+bool overlaps(const vk::ImageMemoryBarrier& lhs, const vk::ImageMemoryBarrier& rhs) {
+  const vk::ImageSubresourceRange& lhsRange = lhs.subresourceRange;
+  const vk::ImageSubresourceRange& rhsRange = rhs.subresourceRange;
+
+  return lhs.image == rhs.image && (lhsRange.aspectMask & rhsRange.aspectMask) &&
+         rangesOverlap(lhsRange.baseMipLevel, lhsRange.levelCount, rhsRange.baseMipLevel, rhsRange.levelCount,
+                       VK_REMAINING_MIP_LEVELS) &&
+         rangesOverlap(lhsRange.baseArrayLayer, lhsRange.layerCount, rhsRange.baseArrayLayer, rhsRange.layerCount,
+                       VK_REMAINING_ARRAY_LAYERS);
+}
+
+template <typename T>
+bool isOwnershipTransfer(const T& barrier) {
+  return barrier.srcQueueFamilyIndex != barrier.dstQueueFamilyIndex;
+}
+
+/**
+ * @brief Check if the barrier can be merged into the pending barrier of the same buffer.
+ */
+bool canMerge(const vk::BufferMemoryBarrier& pending, const vk::BufferMemoryBarrier& barrier) {
+  return pending.buffer == barrier.buffer && pending.offset == barrier.offset && pending.size == barrier.size &&
+         !isOwnershipTransfer(pending) && !isOwnershipTransfer(barrier);
+}
+
+/**
+ * @brief Check if the barrier can be merged into the pending barrier of the same image. The barrier must either
+ *        continue from the layout the pending barrier transitions to or discard the contents.
+ */
+bool canMerge(const vk::ImageMemoryBarrier& pending, const vk::ImageMemoryBarrier& barrier) {
+  return pending.image == barrier.image && pending.subresourceRange == barrier.subresourceRange &&
+         !isOwnershipTransfer(pending) && !isOwnershipTransfer(barrier) &&
+         (barrier.oldLayout == pending.newLayout || barrier.oldLayout == vk::ImageLayout::eUndefined);
+}
+
+} // namespace
+
+BarrierBatcher::BarrierBatcher(vk::CommandBuffer commandBuffer, const CommandDispatchTable& dispatch)
+  : commandBuffer_(commandBuffer), dispatch_(dispatch), pending_(false) {}
+
+void BarrierBatcher::add(const vk::PipelineStageFlags& srcStageMask, const vk::PipelineStageFlags& dstStageMask,
+                         const vk::DependencyFlags& dependencyFlags,
+                         vk::ArrayProxy<const vk::MemoryBarrier> memoryBarriers,
+                         vk::ArrayProxy<const vk::BufferMemoryBarrier> bufferMemoryBarriers,
+                         vk::ArrayProxy<const vk::ImageMemoryBarrier> imageMemoryBarriers) {
+  if (!isCompatible(dependencyFlags, bufferMemoryBarriers, imageMemoryBarriers)) {
+    flush();
+  }
+
+  if (!pending_) {
+    dependencyFlags_ = dependencyFlags;
+    pending_ = true;
+  }
+
+  srcStageMask_ |= srcStageMask;
+  dstStageMask_ |= dstStageMask;
+
+  // Barriers of the same call are never merged with each other.
+  size_t pendingBufferBarriers = bufferMemoryBarriers_.size();
+  size_t pendingImageBarriers = imageMemoryBarriers_.size();
+
+  for (const vk::MemoryBarrier& barrier : memoryBarriers) {
+    addMemoryBarrier(barrier);
+  }
+  for (const vk::BufferMemoryBarrier& barrier : bufferMemoryBarriers) {
+    addBufferMemoryBarrier(barrier, pendingBufferBarriers);
+  }
+  for (const vk::ImageMemoryBarrier& barrier : imageMemoryBarriers) {
+    addImageMemoryBarrier(barrier, pendingImageBarriers);
+  }
+
+  statistics_.batchedCalls++;
+  statistics_.batchedBarriers += memoryBarriers.size() + bufferMemoryBarriers.size() + imageMemoryBarriers.size();
+}
+
+void BarrierBatcher::flush() {
+  if (!pending_) {
+    return;
+  }
+
+  commandBuffer_.pipelineBarrier(srcStageMask_, dstStageMask_, dependencyFlags_,
+                                 static_cast<uint32_t>(memoryBarriers_.size()), memoryBarriers_.data(),
+                                 static_cast<uint32_t>(bufferMemoryBarriers_.size()), bufferMemoryBarriers_.data(),
+                                 static_cast<uint32_t>(imageMemoryBarriers_.size()), imageMemoryBarriers_.data(),
+                                 dispatch_);
+  statistics_.flushes++;
+  clear();
+}
+
+void BarrierBatcher::clear() {
+  pending_ = false;
+  srcStageMask_ = vk::PipelineStageFlags();
+  dstStageMask_ = vk::PipelineStageFlags();
+  dependencyFlags_ = vk::DependencyFlags();
+  memoryBarriers_.clear();
+  bufferMemoryBarriers_.clear();
+  imageMemoryBarriers_.clear();
+}
+
+const vk::PipelineStageFlags& BarrierBatcher::getSrcStageMask() const {
+  return srcStageMask_;
+}
+
+const vk::PipelineStageFlags& BarrierBatcher::getDstStageMask() const {
+  return dstStageMask_;
+}
+
+const std::vector<vk::MemoryBarrier>& BarrierBatcher::getMemoryBarriers() const {
+  return memoryBarriers_;
+}
+
+const std::vector<vk::BufferMemoryBarrier>& BarrierBatcher::getBufferMemoryBarriers() const {
+  return bufferMemoryBarriers_;
+}
+
+const std::vector<vk::ImageMemoryBarrier>& BarrierBatcher::getImageMemoryBarriers() const {
+  return imageMemoryBarriers_;
+}
+
+const BarrierBatchStatistics& BarrierBatcher::getStatistics() const {
+  return statistics_;
+}
+
+bool BarrierBatcher::isCompatible(const vk::DependencyFlags& dependencyFlags,
+                                  const vk::ArrayProxy<const vk::BufferMemoryBarrier>& bufferMemoryBarriers,
+                                  const vk::ArrayProxy<const vk::ImageMemoryBarrier>& imageMemoryBarriers) const {
+  if (!pending_) {
+    return true;
+  }
+  if (dependencyFlags != dependencyFlags_) {
+    return false;
+  }
+
+  for (const vk::BufferMemoryBarrier& barrier : bufferMemoryBarriers) {
+    for (const vk::BufferMemoryBarrier& pending : bufferMemoryBarriers_) {
+      if (overlaps(pending, barrier) && !canMerge(pending, barrier)) {
+        return false;
+      }
+    }
+  }
+
+  for (const vk::ImageMemoryBarrier& barrier : imageMemoryBarriers) {
+    for (const vk::ImageMemoryBarrier& pending : imageMemoryBarriers_) {
+      if (overlaps(pending, barrier) && !canMerge(pending, barrier)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+void BarrierBatcher::addMemoryBarrier(const vk::MemoryBarrier& barrier) {
+  if (memoryBarriers_.empty()) {
+    memoryBarriers_.emplace_back(barrier.srcAccessMask, barrier.dstAccessMask);
+    return;
+  }
+
+  memoryBarriers_[0].srcAccessMask |= barrier.srcAccessMask;
+  memoryBarriers_[0].dstAccessMask |= barrier.dstAccessMask;
+  statistics_.mergedBarriers++;
+}
+
+void BarrierBatcher::addBufferMemoryBarrier(const vk::BufferMemoryBarrier& barrier, size_t pendingCount) {
+  for (size_t i = 0u; i < pendingCount; i++) {
+    vk::BufferMemoryBarrier& pending = bufferMemoryBarriers_[i];
+
+    if (canMerge(pending, barrier)) {
+      pending.srcAccessMask |= barrier.srcAccessMask;
+      pending.dstAccessMask |= barrier.dstAccessMask;
+      statistics_.mergedBarriers++;
+      return;
+    }
+  }
+
+  bufferMemoryBarriers_.emplace_back(barrier);
+}
+
+void BarrierBatcher::addImageMemoryBarrier(const vk::ImageMemoryBarrier& barrier, size_t pendingCount) {
+  for (size_t i = 0u; i < pendingCount; i++) {
+    vk::ImageMemoryBarrier& pending = imageMemoryBarriers_[i];
+
+    if (canMerge(pending, barrier)) {
+      // Collapse chained layout transitions into a single transition.
+      if (barrier.oldLayout == vk::ImageLayout::eUndefined) {
+        pending.oldLayout = vk::ImageLayout::eUndefined;
+      }
+      pending.newLayout = barrier.newLayout;
+      pending.srcAccessMask |= barrier.srcAccessMask;
+      pending.dstAccessMask |= barrier.dstAccessMask;
+      statistics_.mergedBarriers++;
+      return;
+    }
+  }
+
+  imageMemoryBarriers_.emplace_back(barrier);
+}
+
+} // namespace logi
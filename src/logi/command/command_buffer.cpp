@@ -23,6 +23,8 @@
 #include "logi/device/physical_device_impl.hpp"
 #include "logi/instance/vulkan_instance.hpp"
 #include "logi/instance/vulkan_instance_impl.hpp"
+#include "logi/memory/buffer.hpp"
+#include "logi/memory/image.hpp"
 #include "logi/queue/queue_family.hpp"
 #include "logi/queue/queue_family_impl.hpp"
 
@@ -195,6 +197,28 @@ void CommandBuffer::pipelineBarrier(const vk::PipelineStageFlags& srcStageMask,
                            imageMemoryBarriers);
 }
 
+void CommandBuffer::pushConstants(vk::PipelineLayout layout, vk::ShaderStageFlags stageFlags, uint32_t offset,
+                                  uint32_t size, const void* values) const {
+  object_->pushConstants(layout, stageFlags, offset, size, values);
+}
+
+void CommandBuffer::pushConstants(vk::PipelineLayout layout, const PushConstantBlock& block, uint32_t offset,
+                                  uint32_t size, const void* values) const {
+  object_->pushConstants(layout, block, offset, size, values);
+}
+
+void CommandBuffer::pushConstants(vk::PipelineLayout layout, PushConstantData& data) const {
+  if (data.isDirty()) {
+    object_->pushConstants(layout, data.getBlock(), data.getDirtyOffset(), data.getDirtySize(),
+                           data.getData() + data.getDirtyOffset());
+    data.clearDirty();
+  }
+}
+
+void CommandBuffer::recordCommandList(const CommandList& commandList) const {
+  object_->recordCommandList(commandList);
+}
+
 vk::ResultValueType<void>::type CommandBuffer::reset(const vk::CommandBufferResetFlags& flags) const {
   return object_->reset(flags);
 }
@@ -586,10 +610,72 @@ CommandPool CommandBuffer::getCommandPool() const {
   return CommandPool(object_->getCommandPool().shared_from_this());
 }
 
+HandleRef<VulkanInstance> CommandBuffer::getInstanceRef() const {
+  return HandleRef<VulkanInstance>(object_->getInstance());
+}
+
+HandleRef<PhysicalDevice> CommandBuffer::getPhysicalDeviceRef() const {
+  return HandleRef<PhysicalDevice>(object_->getPhysicalDevice());
+}
+
+HandleRef<LogicalDevice> CommandBuffer::getLogicalDeviceRef() const {
+  return HandleRef<LogicalDevice>(object_->getLogicalDevice());
+}
+
+HandleRef<QueueFamily> CommandBuffer::getQueueFamilyRef() const {
+  return HandleRef<QueueFamily>(object_->getQueueFamily());
+}
+
+HandleRef<CommandPool> CommandBuffer::getCommandPoolRef() const {
+  return HandleRef<CommandPool>(object_->getCommandPool());
+}
+
 const vk::DispatchLoaderDynamic& CommandBuffer::getDispatcher() const {
   return object_->getDispatcher();
 }
 
+void CommandBuffer::setBarrierBatching(bool enabled) const {
+  object_->setBarrierBatching(enabled);
+}
+
+bool CommandBuffer::isBarrierBatchingEnabled() const {
+  return object_->isBarrierBatchingEnabled();
+}
+
+void CommandBuffer::flushBarriers() const {
+  object_->flushBarriers();
+}
+
+const BarrierBatchStatistics& CommandBuffer::getBarrierBatchStatistics() const {
+  return object_->getBarrierBatchStatistics();
+}
+
+void CommandBuffer::setRedundantStateFiltering(bool enabled) const {
+  object_->setRedundantStateFiltering(enabled);
+}
+
+bool CommandBuffer::isRedundantStateFilteringEnabled() const {
+  return object_->isRedundantStateFilteringEnabled();
+}
+
+const StateCacheStatistics& CommandBuffer::getStateCacheStatistics() const {
+  return object_->getStateCacheStatistics();
+}
+
+CommandStatistics CommandBuffer::getStatistics() const {
+  return object_->getStatistics();
+}
+
+void CommandBuffer::transition(const Image& image, ResourceUsage usage, const vk::ImageSubresourceRange& range,
+                               bool discardContents) const {
+  object_->transition(image.getTrackedState(), usage, range, discardContents);
+}
+
+void CommandBuffer::transition(const Buffer& buffer, ResourceUsage usage, vk::DeviceSize offset,
+                               vk::DeviceSize size) const {
+  object_->transition(buffer.getTrackedState(), usage, offset, size);
+}
+
 void CommandBuffer::destroy() const {
   if (object_) {
     object_->destroy();
@@ -17,178 +17,281 @@
  */
 
 #include "logi/command/command_buffer_impl.hpp"
+#include "logi/base/exception.hpp"
 #include "logi/command/command_pool_impl.hpp"
+#include "logi/device/logical_device_impl.hpp"
 #include "logi/queue/queue_family_impl.hpp"
 
 namespace logi {
 
 CommandBufferImpl::CommandBufferImpl(CommandPoolImpl& commandPool, const vk::CommandBuffer& vkCommandBuffer)
-  : commandPool_(commandPool), vkCommandBuffer_(vkCommandBuffer) {}
+  : commandPool_(commandPool), dispatcher_(commandPool.getDispatcher()),
+    commandDispatch_(commandPool.getLogicalDevice().getCommandDispatchTable()), vkCommandBuffer_(vkCommandBuffer),
+    barrierBatcher_(vkCommandBuffer, commandDispatch_), batchBarriers_(false), filterRedundantState_(false) {
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+  commandPool.getLogicalDevice().registerStatisticsCommandBuffer(vkCommandBuffer_, statistics_);
+#endif
+}
 
 // region Vulkan Definitions
 
 vk::ResultValueType<void>::type CommandBufferImpl::begin(const vk::CommandBufferBeginInfo& beginInfo) const {
-  return vkCommandBuffer_.begin(beginInfo, getDispatcher());
+  barrierBatcher_.clear();
+  stateCache_.invalidate();
+  clearResourceStates();
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+  collectStatistics_ = commandPool_.isCommandStatisticsEnabled();
+  statistics_ = CommandStatistics();
+  statistics_.commandBuffers = collectStatistics_ ? 1u : 0u;
+#endif
+#ifdef LOGI_ENABLE_TRACE
+  recordingBegin_ = TraceRecorder::now();
+#endif
+  return vkCommandBuffer_.begin(beginInfo, commandDispatch_);
 }
 
 void CommandBufferImpl::beginQuery(vk::QueryPool queryPool, uint32_t query, const vk::QueryControlFlags& flags) const {
-  vkCommandBuffer_.beginQuery(queryPool, query, flags, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.beginQuery(queryPool, query, flags, commandDispatch_);
 }
 
 void CommandBufferImpl::beginRenderPass(const vk::RenderPassBeginInfo& renderPassBegin,
                                         vk::SubpassContents contents) const {
-  vkCommandBuffer_.beginRenderPass(renderPassBegin, contents, getDispatcher());
+  flushBarriers();
+  invalidateStateCache();
+  vkCommandBuffer_.beginRenderPass(renderPassBegin, contents, commandDispatch_);
 }
 
 void CommandBufferImpl::beginRenderPass2(const vk::RenderPassBeginInfo& renderPassBegin,
                                         vk::SubpassContents contents) const {
-  vkCommandBuffer_.beginRenderPass2(renderPassBegin, contents, getDispatcher());
+  flushBarriers();
+  invalidateStateCache();
+  vkCommandBuffer_.beginRenderPass2(renderPassBegin, contents, commandDispatch_);
 }
 
 void CommandBufferImpl::bindDescriptorSets(vk::PipelineBindPoint pipelineBindPoint, vk::PipelineLayout layout,
                                            uint32_t firstSet, vk::ArrayProxy<const vk::DescriptorSet> descriptorSets,
                                            vk::ArrayProxy<const uint32_t> dynamicOffsets = {}) const {
+  if (filterRedundantState_ &&
+      !stateCache_.bindDescriptorSets(pipelineBindPoint, layout, firstSet, descriptorSets, dynamicOffsets)) {
+    return;
+  }
+
+  countCommand(&CommandStatistics::descriptorSetBinds);
   vkCommandBuffer_.bindDescriptorSets(pipelineBindPoint, layout, firstSet, descriptorSets, dynamicOffsets,
-                                      getDispatcher());
+                                      commandDispatch_);
 }
 
 void CommandBufferImpl::bindIndexBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType indexType) const {
-  vkCommandBuffer_.bindIndexBuffer(buffer, offset, indexType, getDispatcher());
+  if (filterRedundantState_ && !stateCache_.bindIndexBuffer(buffer, offset, indexType)) {
+    return;
+  }
+
+  vkCommandBuffer_.bindIndexBuffer(buffer, offset, indexType, commandDispatch_);
 }
 
 void CommandBufferImpl::bindPipeline(vk::PipelineBindPoint pipelineBindPoint, vk::Pipeline pipeline) const {
-  vkCommandBuffer_.bindPipeline(pipelineBindPoint, pipeline, getDispatcher());
+  if (filterRedundantState_ && !stateCache_.bindPipeline(pipelineBindPoint, pipeline)) {
+    return;
+  }
+
+  countCommand(&CommandStatistics::pipelineBinds);
+  vkCommandBuffer_.bindPipeline(pipelineBindPoint, pipeline, commandDispatch_);
 }
 
 void CommandBufferImpl::bindVertexBuffers(uint32_t firstBinding, vk::ArrayProxy<const vk::Buffer> buffers,
                                           vk::ArrayProxy<const vk::DeviceSize> offsets) const {
-  vkCommandBuffer_.bindVertexBuffers(firstBinding, buffers, offsets, getDispatcher());
+  if (filterRedundantState_ && !stateCache_.bindVertexBuffers(firstBinding, buffers, offsets)) {
+    return;
+  }
+
+  vkCommandBuffer_.bindVertexBuffers(firstBinding, buffers, offsets, commandDispatch_);
 }
 
 void CommandBufferImpl::blitImage(vk::Image srcImage, vk::ImageLayout srcImageLayout, vk::Image dstImage,
                                   vk::ImageLayout dstImageLayout, vk::ArrayProxy<const vk::ImageBlit> regions,
                                   vk::Filter filter) const {
-  vkCommandBuffer_.blitImage(srcImage, srcImageLayout, dstImage, dstImageLayout, regions, filter, getDispatcher());
+  flushBarriers();
+  countCommand(&CommandStatistics::copies);
+  vkCommandBuffer_.blitImage(srcImage, srcImageLayout, dstImage, dstImageLayout, regions, filter, commandDispatch_);
 }
 
 void CommandBufferImpl::clearAttachments(vk::ArrayProxy<const vk::ClearAttachment> attachments,
                                          vk::ArrayProxy<const vk::ClearRect> rects) const {
-  vkCommandBuffer_.clearAttachments(attachments, rects, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.clearAttachments(attachments, rects, commandDispatch_);
 }
 
 void CommandBufferImpl::clearColorImage(vk::Image image, vk::ImageLayout imageLayout, const vk::ClearColorValue& color,
                                         vk::ArrayProxy<const vk::ImageSubresourceRange> ranges) const {
-  vkCommandBuffer_.clearColorImage(image, imageLayout, color, ranges, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.clearColorImage(image, imageLayout, color, ranges, commandDispatch_);
 }
 
 void CommandBufferImpl::clearDepthStencilImage(vk::Image image, vk::ImageLayout imageLayout,
                                                const vk::ClearDepthStencilValue& depthStencil,
                                                vk::ArrayProxy<const vk::ImageSubresourceRange> ranges) const {
-  vkCommandBuffer_.clearDepthStencilImage(image, imageLayout, depthStencil, ranges, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.clearDepthStencilImage(image, imageLayout, depthStencil, ranges, commandDispatch_);
 }
 
 void CommandBufferImpl::copyBuffer(vk::Buffer srcBuffer, vk::Buffer dstBuffer,
                                    vk::ArrayProxy<const vk::BufferCopy> regions) const {
-  vkCommandBuffer_.copyBuffer(srcBuffer, dstBuffer, regions, getDispatcher());
+  flushBarriers();
+  countCommand(&CommandStatistics::copies);
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+  for (const vk::BufferCopy& region : regions) {
+    countCommand(&CommandStatistics::copyBytes, region.size);
+  }
+#endif
+  vkCommandBuffer_.copyBuffer(srcBuffer, dstBuffer, regions, commandDispatch_);
 }
 
 void CommandBufferImpl::copyBufferToImage(vk::Buffer srcBuffer, vk::Image dstImage, vk::ImageLayout dstImageLayout,
                                           vk::ArrayProxy<const vk::BufferImageCopy> regions) const {
-  vkCommandBuffer_.copyBufferToImage(srcBuffer, dstImage, dstImageLayout, regions, getDispatcher());
+  flushBarriers();
+  countCommand(&CommandStatistics::copies);
+  vkCommandBuffer_.copyBufferToImage(srcBuffer, dstImage, dstImageLayout, regions, commandDispatch_);
 }
 
 void CommandBufferImpl::copyImage(vk::Image srcImage, vk::ImageLayout srcImageLayout, vk::Image dstImage,
                                   vk::ImageLayout dstImageLayout, vk::ArrayProxy<const vk::ImageCopy> regions) const {
-  vkCommandBuffer_.copyImage(srcImage, srcImageLayout, dstImage, dstImageLayout, regions, getDispatcher());
+  flushBarriers();
+  countCommand(&CommandStatistics::copies);
+  vkCommandBuffer_.copyImage(srcImage, srcImageLayout, dstImage, dstImageLayout, regions, commandDispatch_);
 }
 
 void CommandBufferImpl::copyImageToBuffer(vk::Image srcImage, vk::ImageLayout srcImageLayout, vk::Buffer dstBuffer,
                                           vk::ArrayProxy<const vk::BufferImageCopy> regions) const {
-  vkCommandBuffer_.copyImageToBuffer(srcImage, srcImageLayout, dstBuffer, regions, getDispatcher());
+  flushBarriers();
+  countCommand(&CommandStatistics::copies);
+  vkCommandBuffer_.copyImageToBuffer(srcImage, srcImageLayout, dstBuffer, regions, commandDispatch_);
 }
 
 void CommandBufferImpl::copyQueryPoolResults(vk::QueryPool queryPool, uint32_t firstQuery, uint32_t queryCount,
                                              vk::Buffer dstBuffer, vk::DeviceSize dstOffset, vk::DeviceSize stride,
                                              const vk::QueryResultFlags& flags) const {
+  flushBarriers();
+  countCommand(&CommandStatistics::copies);
   vkCommandBuffer_.copyQueryPoolResults(queryPool, firstQuery, queryCount, dstBuffer, dstOffset, stride, flags,
-                                        getDispatcher());
+                                        commandDispatch_);
 }
 
 void CommandBufferImpl::dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) const {
-  vkCommandBuffer_.dispatch(groupCountX, groupCountY, groupCountZ, getDispatcher());
+  flushBarriers();
+  countCommand(&CommandStatistics::dispatches);
+  vkCommandBuffer_.dispatch(groupCountX, groupCountY, groupCountZ, commandDispatch_);
 }
 
 void CommandBufferImpl::dispatchBase(uint32_t baseGroupX, uint32_t baseGroupY, uint32_t baseGroupZ,
                                      uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) const {
+  flushBarriers();
+  countCommand(&CommandStatistics::dispatches);
   vkCommandBuffer_.dispatchBase(baseGroupX, baseGroupY, baseGroupZ, groupCountX, groupCountY, groupCountZ,
-                                getDispatcher());
+                                commandDispatch_);
 }
 
 void CommandBufferImpl::dispatchIndirect(vk::Buffer buffer, vk::DeviceSize offset) const {
-  vkCommandBuffer_.dispatchIndirect(buffer, offset, getDispatcher());
+  flushBarriers();
+  countCommand(&CommandStatistics::dispatches);
+  vkCommandBuffer_.dispatchIndirect(buffer, offset, commandDispatch_);
 }
 
 void CommandBufferImpl::draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex,
                              uint32_t firstInstance) const {
-  vkCommandBuffer_.draw(vertexCount, instanceCount, firstVertex, firstInstance, getDispatcher());
+  flushBarriers();
+  countCommand(&CommandStatistics::draws);
+  vkCommandBuffer_.draw(vertexCount, instanceCount, firstVertex, firstInstance, commandDispatch_);
 }
 
 void CommandBufferImpl::drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex,
                                     int32_t vertexOffset, uint32_t firstInstance) const {
-  vkCommandBuffer_.drawIndexed(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance, getDispatcher());
+  flushBarriers();
+  countCommand(&CommandStatistics::draws);
+  vkCommandBuffer_.drawIndexed(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance, commandDispatch_);
 }
 
 void CommandBufferImpl::drawIndexedIndirect(vk::Buffer buffer, vk::DeviceSize offset, uint32_t drawCount,
                                             uint32_t stride) const {
-  vkCommandBuffer_.drawIndexedIndirect(buffer, offset, drawCount, stride, getDispatcher());
+  flushBarriers();
+  countCommand(&CommandStatistics::draws);
+  vkCommandBuffer_.drawIndexedIndirect(buffer, offset, drawCount, stride, commandDispatch_);
 }
 
 void CommandBufferImpl::drawIndexedIndirectCount(vk::Buffer buffer, vk::DeviceSize offset,
                                                  vk::Buffer countBuffer, vk::DeviceSize countBufferOffset,
                                                  uint32_t maxDrawCount, uint32_t stride) const {
+  flushBarriers();
+  countCommand(&CommandStatistics::draws);
   vkCommandBuffer_.drawIndexedIndirectCount(buffer, offset, countBuffer, countBufferOffset, maxDrawCount,
-                                            stride, getDispatcher());
+                                            stride, commandDispatch_);
 }
 
 void CommandBufferImpl::drawIndirectCount(vk::Buffer buffer, vk::DeviceSize offset, 
                                           vk::Buffer countBuffer, vk::DeviceSize countBufferOffset,
                                           uint32_t maxDrawCount, uint32_t stride) const {
+  flushBarriers();
+  countCommand(&CommandStatistics::draws);
   vkCommandBuffer_.drawIndirectCount(buffer, offset, countBuffer, countBufferOffset, maxDrawCount,
-                                     stride, getDispatcher());
+                                     stride, commandDispatch_);
 }
 
 void CommandBufferImpl::drawIndirect(vk::Buffer buffer, vk::DeviceSize offset, uint32_t drawCount,
                                      uint32_t stride) const {
-  vkCommandBuffer_.drawIndirect(buffer, offset, drawCount, stride, getDispatcher());
+  flushBarriers();
+  countCommand(&CommandStatistics::draws);
+  vkCommandBuffer_.drawIndirect(buffer, offset, drawCount, stride, commandDispatch_);
 }
 
 void CommandBufferImpl::endQuery(vk::QueryPool queryPool, uint32_t query) const {
-  vkCommandBuffer_.endQuery(queryPool, query, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.endQuery(queryPool, query, commandDispatch_);
 }
 
 void CommandBufferImpl::endRenderPass() const {
-  vkCommandBuffer_.endRenderPass(getDispatcher());
+  flushBarriers();
+  invalidateStateCache();
+  vkCommandBuffer_.endRenderPass(commandDispatch_);
 }
 
 void CommandBufferImpl::endRenderPass2(const vk::SubpassEndInfo& subpassEndInfo) const {
-  vkCommandBuffer_.endRenderPass2(subpassEndInfo, getDispatcher());
+  flushBarriers();
+  invalidateStateCache();
+  vkCommandBuffer_.endRenderPass2(subpassEndInfo, commandDispatch_);
 }
 
 void CommandBufferImpl::executeCommands(vk::ArrayProxy<const vk::CommandBuffer> commandBuffers) const {
-  vkCommandBuffer_.executeCommands(commandBuffers, getDispatcher());
+  flushBarriers();
+  invalidateStateCache();
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+  // Submits only list primary command buffers, so the work of the executed secondaries is counted here.
+  if (collectStatistics_) {
+    getLogicalDevice().accumulateCommandStatistics(commandBuffers, statistics_);
+  }
+#endif
+  vkCommandBuffer_.executeCommands(commandBuffers, commandDispatch_);
 }
 
 void CommandBufferImpl::fillBuffer(vk::Buffer dstBuffer, vk::DeviceSize dstOffset, vk::DeviceSize size,
                                    uint32_t data) const {
-  vkCommandBuffer_.fillBuffer(dstBuffer, dstOffset, size, data, getDispatcher());
+  flushBarriers();
+  countCommand(&CommandStatistics::copies);
+  if (size != VK_WHOLE_SIZE) {
+    countCommand(&CommandStatistics::copyBytes, size);
+  }
+  vkCommandBuffer_.fillBuffer(dstBuffer, dstOffset, size, data, commandDispatch_);
 }
 
 void CommandBufferImpl::nextSubpass(vk::SubpassContents contents) const {
-  vkCommandBuffer_.nextSubpass(contents, getDispatcher());
+  flushBarriers();
+  invalidateStateCache();
+  vkCommandBuffer_.nextSubpass(contents, commandDispatch_);
 }
 
 void CommandBufferImpl::nextSubpass2(vk::SubpassBeginInfo subpassBeginInfo, vk::SubpassEndInfo subpassEndInfo) const {
-  vkCommandBuffer_.nextSubpass2(subpassBeginInfo, subpassEndInfo, getDispatcher());
+  flushBarriers();
+  invalidateStateCache();
+  vkCommandBuffer_.nextSubpass2(subpassBeginInfo, subpassEndInfo, commandDispatch_);
 }
 
 void CommandBufferImpl::pipelineBarrier(const vk::PipelineStageFlags& srcStageMask, vk::PipelineStageFlags dstStageMask,
@@ -196,71 +299,165 @@ void CommandBufferImpl::pipelineBarrier(const vk::PipelineStageFlags& srcStageMa
                                         vk::ArrayProxy<const vk::MemoryBarrier> memoryBarriers,
                                         vk::ArrayProxy<const vk::BufferMemoryBarrier> bufferMemoryBarriers,
                                         vk::ArrayProxy<const vk::ImageMemoryBarrier> imageMemoryBarriers) const {
+  countBarriers(memoryBarriers.size() + bufferMemoryBarriers.size() + imageMemoryBarriers.size());
+
+  if (batchBarriers_) {
+    barrierBatcher_.add(srcStageMask, dstStageMask, dependencyFlags, memoryBarriers, bufferMemoryBarriers,
+                        imageMemoryBarriers);
+    return;
+  }
+
   vkCommandBuffer_.pipelineBarrier(srcStageMask, dstStageMask, dependencyFlags, memoryBarriers, bufferMemoryBarriers,
-                                   imageMemoryBarriers, getDispatcher());
+                                   imageMemoryBarriers, commandDispatch_);
+}
+
+void CommandBufferImpl::pushConstants(vk::PipelineLayout layout, vk::ShaderStageFlags stageFlags, uint32_t offset,
+                                      uint32_t size, const void* values) const {
+  vkCommandBuffer_.pushConstants(layout, stageFlags, offset, size, values, commandDispatch_);
+}
+
+void CommandBufferImpl::pushConstants(vk::PipelineLayout layout, const PushConstantBlock& block, uint32_t offset,
+                                      uint32_t size, const void* values) const {
+  const auto* bytes = static_cast<const uint8_t*>(values);
+  auto push = [&](vk::ShaderStageFlags stageFlags, uint32_t segmentOffset, uint32_t segmentSize) {
+    vkCommandBuffer_.pushConstants(layout, stageFlags, segmentOffset, segmentSize, bytes + (segmentOffset - offset),
+                                   commandDispatch_);
+  };
+
+  block.forEachSegment(offset, size, push);
+}
+
+void CommandBufferImpl::recordCommandList(const CommandList& commandList) const {
+  flushBarriers();
+  invalidateStateCache();
+  commandList.replay(vkCommandBuffer_, commandDispatch_);
+
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+  if (collectStatistics_) {
+    // Replayed commands bypass the recording functions that count them.
+    statistics_ += commandList.getStatistics();
+
+    for (CommandList::Command command : commandList) {
+      if (command.type() == CommandType::eExecuteCommands) {
+        const auto& args = command.get<CommandList::ExecuteCommands>();
+        getLogicalDevice().accumulateCommandStatistics(
+          vk::ArrayProxy<const vk::CommandBuffer>(args.commandBuffers.count, command.data(args.commandBuffers)),
+          statistics_);
+      }
+    }
+  }
+#endif
 }
 
 vk::ResultValueType<void>::type CommandBufferImpl::reset(const vk::CommandBufferResetFlags& flags) const {
-  return vkCommandBuffer_.reset(flags, getDispatcher());
+  barrierBatcher_.clear();
+  stateCache_.invalidate();
+  clearResourceStates();
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+  statistics_ = CommandStatistics();
+#endif
+  return vkCommandBuffer_.reset(flags, commandDispatch_);
 }
 
 void CommandBufferImpl::resetEvent(vk::Event event, const vk::PipelineStageFlags& stageMask) const {
-  vkCommandBuffer_.resetEvent(event, stageMask, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.resetEvent(event, stageMask, commandDispatch_);
 }
 
 void CommandBufferImpl::resetQueryPool(vk::QueryPool queryPool, uint32_t firstQuery, uint32_t queryCount) const {
-  vkCommandBuffer_.resetQueryPool(queryPool, firstQuery, queryCount, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.resetQueryPool(queryPool, firstQuery, queryCount, commandDispatch_);
 }
 
 void CommandBufferImpl::resolveImage(vk::Image srcImage, vk::ImageLayout srcImageLayout, vk::Image dstImage,
                                      vk::ImageLayout dstImageLayout,
                                      vk::ArrayProxy<const vk::ImageResolve> regions) const {
-  vkCommandBuffer_.resolveImage(srcImage, srcImageLayout, dstImage, dstImageLayout, regions, getDispatcher());
+  flushBarriers();
+  countCommand(&CommandStatistics::copies);
+  vkCommandBuffer_.resolveImage(srcImage, srcImageLayout, dstImage, dstImageLayout, regions, commandDispatch_);
 }
 
 void CommandBufferImpl::setBlendConstants(const float* blendConstants) const {
-  vkCommandBuffer_.setBlendConstants(blendConstants, getDispatcher());
+  if (filterRedundantState_ && !stateCache_.setBlendConstants(blendConstants)) {
+    return;
+  }
+
+  vkCommandBuffer_.setBlendConstants(blendConstants, commandDispatch_);
 }
 
 void CommandBufferImpl::setDepthBias(float depthBiasConstantFactor, float depthBiasClamp,
                                      float depthBiasSlopeFactor) const {
-  vkCommandBuffer_.setDepthBias(depthBiasConstantFactor, depthBiasClamp, depthBiasSlopeFactor, getDispatcher());
+  if (filterRedundantState_ &&
+      !stateCache_.setDepthBias(depthBiasConstantFactor, depthBiasClamp, depthBiasSlopeFactor)) {
+    return;
+  }
+
+  vkCommandBuffer_.setDepthBias(depthBiasConstantFactor, depthBiasClamp, depthBiasSlopeFactor, commandDispatch_);
 }
 
 void CommandBufferImpl::setDepthBounds(float minDepthBounds, float maxDepthBounds) const {
-  vkCommandBuffer_.setDepthBounds(minDepthBounds, maxDepthBounds, getDispatcher());
+  if (filterRedundantState_ && !stateCache_.setDepthBounds(minDepthBounds, maxDepthBounds)) {
+    return;
+  }
+
+  vkCommandBuffer_.setDepthBounds(minDepthBounds, maxDepthBounds, commandDispatch_);
 }
 
 void CommandBufferImpl::setDeviceMask(uint32_t deviceMask) const {
-  vkCommandBuffer_.setDeviceMask(deviceMask, getDispatcher());
+  vkCommandBuffer_.setDeviceMask(deviceMask, commandDispatch_);
 }
 
 void CommandBufferImpl::setEvent(vk::Event event, vk::PipelineStageFlags stageMask) const {
-  vkCommandBuffer_.setEvent(event, stageMask, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.setEvent(event, stageMask, commandDispatch_);
 }
 
 void CommandBufferImpl::setLineWidth(float lineWidth) const {
-  vkCommandBuffer_.setLineWidth(lineWidth, getDispatcher());
+  if (filterRedundantState_ && !stateCache_.setLineWidth(lineWidth)) {
+    return;
+  }
+
+  vkCommandBuffer_.setLineWidth(lineWidth, commandDispatch_);
 }
 
 void CommandBufferImpl::setScissor(uint32_t firstScissor, vk::ArrayProxy<const vk::Rect2D> scissors) const {
-  vkCommandBuffer_.setScissor(firstScissor, scissors, getDispatcher());
+  if (filterRedundantState_ && !stateCache_.setScissor(firstScissor, scissors)) {
+    return;
+  }
+
+  vkCommandBuffer_.setScissor(firstScissor, scissors, commandDispatch_);
 }
 
 void CommandBufferImpl::setStencilCompareMask(vk::StencilFaceFlags faceMask, uint32_t compareMask) const {
-  vkCommandBuffer_.setStencilCompareMask(faceMask, compareMask, getDispatcher());
+  if (filterRedundantState_ && !stateCache_.setStencilCompareMask(faceMask, compareMask)) {
+    return;
+  }
+
+  vkCommandBuffer_.setStencilCompareMask(faceMask, compareMask, commandDispatch_);
 }
 
 void CommandBufferImpl::setStencilReference(vk::StencilFaceFlags faceMask, uint32_t reference) const {
-  vkCommandBuffer_.setStencilReference(faceMask, reference, getDispatcher());
+  if (filterRedundantState_ && !stateCache_.setStencilReference(faceMask, reference)) {
+    return;
+  }
+
+  vkCommandBuffer_.setStencilReference(faceMask, reference, commandDispatch_);
 }
 
 void CommandBufferImpl::setStencilWriteMask(vk::StencilFaceFlags faceMask, uint32_t writeMask) const {
-  vkCommandBuffer_.setStencilWriteMask(faceMask, writeMask, getDispatcher());
+  if (filterRedundantState_ && !stateCache_.setStencilWriteMask(faceMask, writeMask)) {
+    return;
+  }
+
+  vkCommandBuffer_.setStencilWriteMask(faceMask, writeMask, commandDispatch_);
 }
 
 void CommandBufferImpl::setViewport(uint32_t firstViewport, vk::ArrayProxy<const vk::Viewport> viewports) const {
-  vkCommandBuffer_.setViewport(firstViewport, viewports, getDispatcher());
+  if (filterRedundantState_ && !stateCache_.setViewport(firstViewport, viewports)) {
+    return;
+  }
+
+  vkCommandBuffer_.setViewport(firstViewport, viewports, commandDispatch_);
 }
 
 void CommandBufferImpl::waitEvents(vk::ArrayProxy<const vk::Event> events, const vk::PipelineStageFlags& srcStageMask,
@@ -268,195 +465,238 @@ void CommandBufferImpl::waitEvents(vk::ArrayProxy<const vk::Event> events, const
                                    vk::ArrayProxy<const vk::MemoryBarrier> memoryBarriers,
                                    vk::ArrayProxy<const vk::BufferMemoryBarrier> bufferMemoryBarriers,
                                    vk::ArrayProxy<const vk::ImageMemoryBarrier> imageMemoryBarriers) const {
+  flushBarriers();
+  countBarriers(memoryBarriers.size() + bufferMemoryBarriers.size() + imageMemoryBarriers.size());
   vkCommandBuffer_.waitEvents(events, srcStageMask, dstStageMask, memoryBarriers, bufferMemoryBarriers,
-                              imageMemoryBarriers, getDispatcher());
+                              imageMemoryBarriers, commandDispatch_);
 }
 
 void CommandBufferImpl::writeTimestamp(vk::PipelineStageFlagBits pipelineStage, vk::QueryPool queryPool,
                                        uint32_t query) const {
-  vkCommandBuffer_.writeTimestamp(pipelineStage, queryPool, query, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.writeTimestamp(pipelineStage, queryPool, query, commandDispatch_);
 }
 
 vk::ResultValueType<void>::type CommandBufferImpl::end() const {
-  return vkCommandBuffer_.end(getDispatcher());
+  flushBarriers();
+#ifdef LOGI_ENABLE_TRACE
+  getLogicalDevice().getTraceRecorder().recordComplete("CommandBuffer", "record", recordingBegin_, TraceRecorder::now());
+#endif
+  return vkCommandBuffer_.end(commandDispatch_);
 }
 
 void CommandBufferImpl::beginRenderPass2KHR(const vk::RenderPassBeginInfo& renderPassBegin,
                                             const vk::SubpassBeginInfoKHR& subpassBeginInfo) const {
-  vkCommandBuffer_.beginRenderPass2KHR(renderPassBegin, subpassBeginInfo, getDispatcher());
+  flushBarriers();
+  invalidateStateCache();
+  vkCommandBuffer_.beginRenderPass2KHR(renderPassBegin, subpassBeginInfo, commandDispatch_);
 }
 
 void CommandBufferImpl::dispatchBaseKHR(uint32_t baseGroupX, uint32_t baseGroupY, uint32_t baseGroupZ,
                                         uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) const {
+  flushBarriers();
+  countCommand(&CommandStatistics::dispatches);
   vkCommandBuffer_.dispatchBaseKHR(baseGroupX, baseGroupY, baseGroupZ, groupCountX, groupCountY, groupCountZ,
-                                   getDispatcher());
+                                   commandDispatch_);
 }
 
 void CommandBufferImpl::drawIndexedIndirectCountKHR(vk::Buffer buffer, vk::DeviceSize offset, vk::Buffer countBuffer,
                                                     vk::DeviceSize countBufferOffset, uint32_t maxDrawCount,
                                                     uint32_t stride) const {
+  flushBarriers();
+  countCommand(&CommandStatistics::draws);
   vkCommandBuffer_.drawIndexedIndirectCountKHR(buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride,
-                                               getDispatcher());
+                                               commandDispatch_);
 }
 
 void CommandBufferImpl::drawIndirectCountKHR(vk::Buffer buffer, vk::DeviceSize offset, vk::Buffer countBuffer,
                                              vk::DeviceSize countBufferOffset, uint32_t maxDrawCount,
                                              uint32_t stride) const {
+  flushBarriers();
+  countCommand(&CommandStatistics::draws);
   vkCommandBuffer_.drawIndirectCountKHR(buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride,
-                                        getDispatcher());
+                                        commandDispatch_);
 }
 
 void CommandBufferImpl::endRenderPass2KHR(const vk::SubpassEndInfoKHR& subpassEndInfo) const {
-  vkCommandBuffer_.endRenderPass2KHR(subpassEndInfo, getDispatcher());
+  flushBarriers();
+  invalidateStateCache();
+  vkCommandBuffer_.endRenderPass2KHR(subpassEndInfo, commandDispatch_);
 }
 
 void CommandBufferImpl::nextSubpass2KHR(const vk::SubpassBeginInfoKHR& subpassBeginInfo,
                                         const vk::SubpassEndInfoKHR& subpassEndInfo) const {
-  vkCommandBuffer_.nextSubpass2KHR(subpassBeginInfo, subpassEndInfo, getDispatcher());
+  flushBarriers();
+  invalidateStateCache();
+  vkCommandBuffer_.nextSubpass2KHR(subpassBeginInfo, subpassEndInfo, commandDispatch_);
 }
 
 void CommandBufferImpl::pushDescriptorSetKHR(vk::PipelineBindPoint pipelineBindPoint, vk::PipelineLayout layout,
                                              uint32_t set,
                                              vk::ArrayProxy<const vk::WriteDescriptorSet> descriptorWrites) const {
-  vkCommandBuffer_.pushDescriptorSetKHR(pipelineBindPoint, layout, set, descriptorWrites, getDispatcher());
+  if (filterRedundantState_) {
+    stateCache_.invalidateBindPoint(pipelineBindPoint);
+  }
+  countCommand(&CommandStatistics::descriptorSetBinds);
+  vkCommandBuffer_.pushDescriptorSetKHR(pipelineBindPoint, layout, set, descriptorWrites, commandDispatch_);
 }
 
 void CommandBufferImpl::pushDescriptorSetWithTemplateKHR(vk::DescriptorUpdateTemplate descriptorUpdateTemplate,
                                                          vk::PipelineLayout layout, uint32_t set,
                                                          const void* pData) const {
-  vkCommandBuffer_.pushDescriptorSetWithTemplateKHR(descriptorUpdateTemplate, layout, set, pData, getDispatcher());
+  invalidateStateCache();
+  countCommand(&CommandStatistics::descriptorSetBinds);
+  vkCommandBuffer_.pushDescriptorSetWithTemplateKHR(descriptorUpdateTemplate, layout, set, pData, commandDispatch_);
 }
 
 void CommandBufferImpl::setDeviceMaskKHR(uint32_t deviceMask) const {
-  vkCommandBuffer_.setDeviceMaskKHR(deviceMask, getDispatcher());
+  vkCommandBuffer_.setDeviceMaskKHR(deviceMask, commandDispatch_);
 }
 
 void CommandBufferImpl::buildAccelerationStructuresKHR(const vk::ArrayProxy<const vk::AccelerationStructureBuildGeometryInfoKHR> buildGeometryInfos,
                                                        const vk::ArrayProxy<const vk::AccelerationStructureBuildRangeInfoKHR *const> buildRangeInfos) const {
-  vkCommandBuffer_.buildAccelerationStructuresKHR(buildGeometryInfos, buildRangeInfos, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.buildAccelerationStructuresKHR(buildGeometryInfos, buildRangeInfos, commandDispatch_);
 }
 
 void CommandBufferImpl::buildAccelerationStructuresIndirectKHR(const vk::ArrayProxy<const vk::AccelerationStructureBuildGeometryInfoKHR> buildGeometryInfos, 
                                                                const vk::ArrayProxy<const vk::DeviceAddress> indirectDeviceAddresses,
                                                                const vk::ArrayProxy<const uint32_t> indirectStrides, 
                                                                const vk::ArrayProxy<const uint32_t *const> maxPrimitiveCounts) const {
-  vkCommandBuffer_.buildAccelerationStructuresIndirectKHR(buildGeometryInfos, indirectDeviceAddresses, indirectStrides, maxPrimitiveCounts, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.buildAccelerationStructuresIndirectKHR(buildGeometryInfos, indirectDeviceAddresses, indirectStrides, maxPrimitiveCounts, commandDispatch_);
 }
 
 void CommandBufferImpl::copyAccelerationStructureKHR(const vk::CopyAccelerationStructureInfoKHR& copyAccelerationStructureInfo) const {
-  vkCommandBuffer_.copyAccelerationStructureKHR(copyAccelerationStructureInfo, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.copyAccelerationStructureKHR(copyAccelerationStructureInfo, commandDispatch_);
 }
 
 void CommandBufferImpl::copyAccelerationStructureToMemoryKHR(const vk::CopyAccelerationStructureToMemoryInfoKHR& copyAccelerationStructureToMemoryInfo) const {
-  vkCommandBuffer_.copyAccelerationStructureToMemoryKHR(copyAccelerationStructureToMemoryInfo, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.copyAccelerationStructureToMemoryKHR(copyAccelerationStructureToMemoryInfo, commandDispatch_);
 }              
 
 void CommandBufferImpl::copyMemoryToAccelerationStructureKHR(const vk::CopyMemoryToAccelerationStructureInfoKHR& copyMemoryToAccelerationStructureInfo) const {
-  vkCommandBuffer_.copyMemoryToAccelerationStructureKHR(copyMemoryToAccelerationStructureInfo, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.copyMemoryToAccelerationStructureKHR(copyMemoryToAccelerationStructureInfo, commandDispatch_);
 }                      
 
 void CommandBufferImpl::writeAccelerationStructuresPropertiesKHR(const vk::ArrayProxy<const vk::AccelerationStructureKHR> accelerationStructures,
                                                                  vk::QueryType queryType, vk::QueryPool queryPool, uint32_t firstQuery) const {
-  vkCommandBuffer_.writeAccelerationStructuresPropertiesKHR(accelerationStructures, queryType, queryPool, firstQuery, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.writeAccelerationStructuresPropertiesKHR(accelerationStructures, queryType, queryPool, firstQuery, commandDispatch_);
 }
 
 void CommandBufferImpl::traceRaysKHR(const vk::StridedDeviceAddressRegionKHR &raygenShaderBindingTable, const vk::StridedDeviceAddressRegionKHR &missShaderBindingTable,
                                      const vk::StridedDeviceAddressRegionKHR &hitShaderBindingTable, const vk::StridedDeviceAddressRegionKHR &callableShaderBindingTable,
                                      uint32_t width, uint32_t height, uint32_t depth) const {
+  flushBarriers();
+  countCommand(&CommandStatistics::dispatches);
   vkCommandBuffer_.traceRaysKHR(raygenShaderBindingTable, missShaderBindingTable,
                                 hitShaderBindingTable, callableShaderBindingTable,
-                                width, height, depth, getDispatcher());
+                                width, height, depth, commandDispatch_);
 }    
 
 void CommandBufferImpl::traceRaysIndirectKHR(const vk::StridedDeviceAddressRegionKHR &raygenShaderBindingTable, const vk::StridedDeviceAddressRegionKHR &missShaderBindingTable,
                                              const vk::StridedDeviceAddressRegionKHR &hitShaderBindingTable, const vk::StridedDeviceAddressRegionKHR &callableShaderBindingTable,
                                              vk::DeviceAddress indirectDeviceAddress) const {
+  flushBarriers();
+  countCommand(&CommandStatistics::dispatches);
   vkCommandBuffer_.traceRaysIndirectKHR(raygenShaderBindingTable, missShaderBindingTable,
                                         hitShaderBindingTable, callableShaderBindingTable,
-                                        indirectDeviceAddress, getDispatcher());
+                                        indirectDeviceAddress, commandDispatch_);
 }    
 
 void CommandBufferImpl::setRayTracingPipelineStackSizeKHR(uint32_t pipelineStackSize) const {
-  vkCommandBuffer_.setRayTracingPipelineStackSizeKHR(pipelineStackSize, getDispatcher());
+  vkCommandBuffer_.setRayTracingPipelineStackSizeKHR(pipelineStackSize, commandDispatch_);
 }
 
 void CommandBufferImpl::beginConditionalRenderingEXT(
   const vk::ConditionalRenderingBeginInfoEXT& conditionalRenderingBegin) const {
-  vkCommandBuffer_.beginConditionalRenderingEXT(conditionalRenderingBegin, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.beginConditionalRenderingEXT(conditionalRenderingBegin, commandDispatch_);
 }
 
 void CommandBufferImpl::beginDebugUtilsLabelEXT(const vk::DebugUtilsLabelEXT& labelInfo) const {
-  vkCommandBuffer_.beginDebugUtilsLabelEXT(labelInfo, getDispatcher());
+  vkCommandBuffer_.beginDebugUtilsLabelEXT(labelInfo, commandDispatch_);
 }
 
 void CommandBufferImpl::beginQueryIndexedEXT(vk::QueryPool queryPool, uint32_t query,
                                              const vk::QueryControlFlags& flags, uint32_t index) const {
-  vkCommandBuffer_.beginQueryIndexedEXT(queryPool, query, flags, index, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.beginQueryIndexedEXT(queryPool, query, flags, index, commandDispatch_);
 }
 
 void CommandBufferImpl::beginTransformFeedbackEXT(uint32_t firstCounterBuffer,
                                                   vk::ArrayProxy<const vk::Buffer> counterBuffers,
                                                   vk::ArrayProxy<const vk::DeviceSize> counterBufferOffsets) const {
-  vkCommandBuffer_.beginTransformFeedbackEXT(firstCounterBuffer, counterBuffers, counterBufferOffsets, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.beginTransformFeedbackEXT(firstCounterBuffer, counterBuffers, counterBufferOffsets, commandDispatch_);
 }
 
 void CommandBufferImpl::bindTransformFeedbackBuffersEXT(uint32_t firstBinding, vk::ArrayProxy<const vk::Buffer> buffers,
                                                         vk::ArrayProxy<const vk::DeviceSize> offsets,
                                                         vk::ArrayProxy<const vk::DeviceSize> sizes) const {
-  vkCommandBuffer_.bindTransformFeedbackBuffersEXT(firstBinding, buffers, offsets, sizes, getDispatcher());
+  vkCommandBuffer_.bindTransformFeedbackBuffersEXT(firstBinding, buffers, offsets, sizes, commandDispatch_);
 }
 
 void CommandBufferImpl::debugMarkerBeginEXT(const vk::DebugMarkerMarkerInfoEXT& markerInfo) const {
-  vkCommandBuffer_.debugMarkerBeginEXT(markerInfo, getDispatcher());
+  vkCommandBuffer_.debugMarkerBeginEXT(markerInfo, commandDispatch_);
 }
 
 void CommandBufferImpl::debugMarkerEndEXT() const {
-  vkCommandBuffer_.debugMarkerEndEXT(getDispatcher());
+  vkCommandBuffer_.debugMarkerEndEXT(commandDispatch_);
 }
 
 void CommandBufferImpl::debugMarkerInsertEXT(const vk::DebugMarkerMarkerInfoEXT& markerInfo) const {
-  vkCommandBuffer_.debugMarkerInsertEXT(markerInfo, getDispatcher());
+  vkCommandBuffer_.debugMarkerInsertEXT(markerInfo, commandDispatch_);
 }
 void CommandBufferImpl::drawIndirectByteCountEXT(uint32_t instanceCount, uint32_t firstInstance,
                                                  vk::Buffer counterBuffer, vk::DeviceSize counterBufferOffset,
                                                  uint32_t counterOffset, uint32_t vertexStride) const {
+  flushBarriers();
+  countCommand(&CommandStatistics::draws);
   vkCommandBuffer_.drawIndirectByteCountEXT(instanceCount, firstInstance, counterBuffer, counterBufferOffset,
-                                            counterOffset, vertexStride, getDispatcher());
+                                            counterOffset, vertexStride, commandDispatch_);
 }
 
 void CommandBufferImpl::endConditionalRenderingEXT() const {
-  vkCommandBuffer_.endConditionalRenderingEXT(getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.endConditionalRenderingEXT(commandDispatch_);
 }
 
 void CommandBufferImpl::endDebugUtilsLabelEXT() const {
-  vkCommandBuffer_.endDebugUtilsLabelEXT(getDispatcher());
+  vkCommandBuffer_.endDebugUtilsLabelEXT(commandDispatch_);
 }
 
 void CommandBufferImpl::endQueryIndexedEXT(vk::QueryPool queryPool, uint32_t query, uint32_t index) const {
-  vkCommandBuffer_.endQueryIndexedEXT(queryPool, query, index, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.endQueryIndexedEXT(queryPool, query, index, commandDispatch_);
 }
 
 void CommandBufferImpl::endTransformFeedbackEXT(uint32_t firstCounterBuffer,
                                                 vk::ArrayProxy<const vk::Buffer> counterBuffers,
                                                 vk::ArrayProxy<const vk::DeviceSize> counterBufferOffsets) const {
-  vkCommandBuffer_.endTransformFeedbackEXT(firstCounterBuffer, counterBuffers, counterBufferOffsets, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.endTransformFeedbackEXT(firstCounterBuffer, counterBuffers, counterBufferOffsets, commandDispatch_);
 }
 
 void CommandBufferImpl::insertDebugUtilsLabelEXT(const vk::DebugUtilsLabelEXT& labelInfo) const {
-  vkCommandBuffer_.insertDebugUtilsLabelEXT(labelInfo, getDispatcher());
+  vkCommandBuffer_.insertDebugUtilsLabelEXT(labelInfo, commandDispatch_);
 }
 
 void CommandBufferImpl::setDiscardRectangleEXT(uint32_t firstDiscardRectangle,
                                                vk::ArrayProxy<const vk::Rect2D> discardRectangles) const {
-  vkCommandBuffer_.setDiscardRectangleEXT(firstDiscardRectangle, discardRectangles, getDispatcher());
+  vkCommandBuffer_.setDiscardRectangleEXT(firstDiscardRectangle, discardRectangles, commandDispatch_);
 }
 
 void CommandBufferImpl::setSampleLocationsEXT(const vk::SampleLocationsInfoEXT& sampleLocationsInfo) const {
-  vkCommandBuffer_.setSampleLocationsEXT(sampleLocationsInfo, getDispatcher());
+  vkCommandBuffer_.setSampleLocationsEXT(sampleLocationsInfo, commandDispatch_);
 }
 
 void CommandBufferImpl::bindShadingRateImageNV(vk::ImageView imageView, vk::ImageLayout imageLayout) const {
-  vkCommandBuffer_.bindShadingRateImageNV(imageView, imageLayout, getDispatcher());
+  vkCommandBuffer_.bindShadingRateImageNV(imageView, imageLayout, commandDispatch_);
 }
 
 void CommandBufferImpl::buildAccelerationStructureNV(const vk::AccelerationStructureInfoNV& info,
@@ -464,54 +704,63 @@ void CommandBufferImpl::buildAccelerationStructureNV(const vk::AccelerationStruc
                                                      vk::Bool32 update, vk::AccelerationStructureNV dst,
                                                      vk::AccelerationStructureNV src, vk::Buffer scratch,
                                                      vk::DeviceSize scratchOffset) const {
+  flushBarriers();
   vkCommandBuffer_.buildAccelerationStructureNV(info, instanceData, instanceOffset, update, dst, src, scratch,
-                                                scratchOffset, getDispatcher());
+                                                scratchOffset, commandDispatch_);
 }
 
 void CommandBufferImpl::copyAccelerationStructureNV(vk::AccelerationStructureNV dst, vk::AccelerationStructureNV src,
                                                     vk::CopyAccelerationStructureModeNV mode) const {
-  vkCommandBuffer_.copyAccelerationStructureNV(dst, src, mode, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.copyAccelerationStructureNV(dst, src, mode, commandDispatch_);
 }
 
 void CommandBufferImpl::drawMeshTasksIndirectCountNV(vk::Buffer buffer, vk::DeviceSize offset, vk::Buffer countBuffer,
                                                      vk::DeviceSize countBufferOffset, uint32_t maxDrawCount,
                                                      uint32_t stride) const {
+  flushBarriers();
+  countCommand(&CommandStatistics::draws);
   vkCommandBuffer_.drawMeshTasksIndirectCountNV(buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride,
-                                                getDispatcher());
+                                                commandDispatch_);
 }
 
 void CommandBufferImpl::drawMeshTasksIndirectNV(vk::Buffer buffer, vk::DeviceSize offset, uint32_t drawCount,
                                                 uint32_t stride) const {
-  vkCommandBuffer_.drawMeshTasksIndirectNV(buffer, offset, drawCount, stride, getDispatcher());
+  flushBarriers();
+  countCommand(&CommandStatistics::draws);
+  vkCommandBuffer_.drawMeshTasksIndirectNV(buffer, offset, drawCount, stride, commandDispatch_);
 }
 
 void CommandBufferImpl::drawMeshTasksNV(uint32_t taskCount, uint32_t firstTask) const {
-  vkCommandBuffer_.drawMeshTasksNV(taskCount, firstTask, getDispatcher());
+  flushBarriers();
+  countCommand(&CommandStatistics::draws);
+  vkCommandBuffer_.drawMeshTasksNV(taskCount, firstTask, commandDispatch_);
 }
 
 void CommandBufferImpl::setCheckpointNV(const void* pCheckpointMarker) const {
-  vkCommandBuffer_.setCheckpointNV(pCheckpointMarker, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.setCheckpointNV(pCheckpointMarker, commandDispatch_);
 }
 
 void CommandBufferImpl::setCoarseSampleOrderNV(
   vk::CoarseSampleOrderTypeNV sampleOrderType,
   vk::ArrayProxy<const vk::CoarseSampleOrderCustomNV> customSampleOrders) const {
-  vkCommandBuffer_.setCoarseSampleOrderNV(sampleOrderType, customSampleOrders, getDispatcher());
+  vkCommandBuffer_.setCoarseSampleOrderNV(sampleOrderType, customSampleOrders, commandDispatch_);
 }
 
 void CommandBufferImpl::setExclusiveScissorNV(uint32_t firstExclusiveScissor,
                                               vk::ArrayProxy<const vk::Rect2D> exclusiveScissors) const {
-  vkCommandBuffer_.setExclusiveScissorNV(firstExclusiveScissor, exclusiveScissors, getDispatcher());
+  vkCommandBuffer_.setExclusiveScissorNV(firstExclusiveScissor, exclusiveScissors, commandDispatch_);
 }
 
 void CommandBufferImpl::setViewportShadingRatePaletteNV(
   uint32_t firstViewport, vk::ArrayProxy<const vk::ShadingRatePaletteNV> shadingRatePalettes) const {
-  vkCommandBuffer_.setViewportShadingRatePaletteNV(firstViewport, shadingRatePalettes, getDispatcher());
+  vkCommandBuffer_.setViewportShadingRatePaletteNV(firstViewport, shadingRatePalettes, commandDispatch_);
 }
 
 void CommandBufferImpl::setViewportWScalingNV(uint32_t firstViewport,
                                               vk::ArrayProxy<const vk::ViewportWScalingNV> viewportWScalings) const {
-  vkCommandBuffer_.setViewportWScalingNV(firstViewport, viewportWScalings, getDispatcher());
+  vkCommandBuffer_.setViewportWScalingNV(firstViewport, viewportWScalings, commandDispatch_);
 }
 
 void CommandBufferImpl::traceRaysNV(vk::Buffer raygenShaderBindingTableBuffer, vk::DeviceSize raygenShaderBindingOffset,
@@ -522,63 +771,74 @@ void CommandBufferImpl::traceRaysNV(vk::Buffer raygenShaderBindingTableBuffer, v
                                     vk::DeviceSize callableShaderBindingOffset,
                                     vk::DeviceSize callableShaderBindingStride, uint32_t width, uint32_t height,
                                     uint32_t depth) const {
+  flushBarriers();
+  countCommand(&CommandStatistics::dispatches);
   vkCommandBuffer_.traceRaysNV(raygenShaderBindingTableBuffer, raygenShaderBindingOffset, missShaderBindingTableBuffer,
                                missShaderBindingOffset, missShaderBindingStride, hitShaderBindingTableBuffer,
                                hitShaderBindingOffset, hitShaderBindingStride, callableShaderBindingTableBuffer,
                                callableShaderBindingOffset, callableShaderBindingStride, width, height, depth,
-                               getDispatcher());
+                               commandDispatch_);
 }
 
 void CommandBufferImpl::writeAccelerationStructuresPropertiesNV(
   vk::ArrayProxy<const vk::AccelerationStructureNV> accelerationStructures, vk::QueryType queryType,
   vk::QueryPool queryPool, uint32_t firstQuery) const {
+  flushBarriers();
   vkCommandBuffer_.writeAccelerationStructuresPropertiesNV(accelerationStructures, queryType, queryPool, firstQuery,
-                                                           getDispatcher());
+                                                           commandDispatch_);
 }
 
 void CommandBufferImpl::bindPipelineShaderGroupNV(vk::PipelineBindPoint pipelineBindPoint,
                                               vk::Pipeline pipeline, uint32_t groupIndex) const {
-  vkCommandBuffer_.bindPipelineShaderGroupNV(pipelineBindPoint, pipeline, groupIndex, getDispatcher());                                              
+  invalidateStateCache();
+  vkCommandBuffer_.bindPipelineShaderGroupNV(pipelineBindPoint, pipeline, groupIndex, commandDispatch_);                                              
 } 
 
 void CommandBufferImpl::preprocessGeneratedCommandsNV(const VkGeneratedCommandsInfoNV& generatedCommandsInfo) const {
-  vkCommandBuffer_.preprocessGeneratedCommandsNV(generatedCommandsInfo, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.preprocessGeneratedCommandsNV(generatedCommandsInfo, commandDispatch_);
 }
 
 void CommandBufferImpl::executeGeneratedCommandsNV(vk::Bool32 isPreprocessed, const VkGeneratedCommandsInfoNV& generatedCommandsInfo) const {
-  vkCommandBuffer_.executeGeneratedCommandsNV(isPreprocessed, generatedCommandsInfo, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.executeGeneratedCommandsNV(isPreprocessed, generatedCommandsInfo, commandDispatch_);
 }
 
 
 // Deprecated
 
 // void CommandBufferImpl::processCommandsNVX(const vk::CmdProcessCommandsInfoNVX& processCommandsInfo) const {
-//   vkCommandBuffer_.processCommandsNVX(processCommandsInfo, getDispatcher());
+//   vkCommandBuffer_.processCommandsNVX(processCommandsInfo, commandDispatch_);
 // }
 
 // void CommandBufferImpl::reserveSpaceForCommandsNVX(
 //   const vk::CmdReserveSpaceForCommandsInfoNVX& reserveSpaceInfo) const {
-//   vkCommandBuffer_.reserveSpaceForCommandsNVX(reserveSpaceInfo, getDispatcher());
+//   vkCommandBuffer_.reserveSpaceForCommandsNVX(reserveSpaceInfo, commandDispatch_);
 // }
 
 
 void CommandBufferImpl::drawIndexedIndirectCountAMD(vk::Buffer buffer, vk::DeviceSize offset, vk::Buffer countBuffer,
                                                     vk::DeviceSize countBufferOffset, uint32_t maxDrawCount,
                                                     uint32_t stride) const {
+  flushBarriers();
+  countCommand(&CommandStatistics::draws);
   vkCommandBuffer_.drawIndexedIndirectCountAMD(buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride,
-                                               getDispatcher());
+                                               commandDispatch_);
 }
 
 void CommandBufferImpl::drawIndirectCountAMD(vk::Buffer buffer, vk::DeviceSize offset, vk::Buffer countBuffer,
                                              vk::DeviceSize countBufferOffset, uint32_t maxDrawCount,
                                              uint32_t stride) const {
+  flushBarriers();
+  countCommand(&CommandStatistics::draws);
   vkCommandBuffer_.drawIndirectCountAMD(buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride,
-                                        getDispatcher());
+                                        commandDispatch_);
 }
 
 void CommandBufferImpl::writeBufferMarkerAMD(vk::PipelineStageFlagBits pipelineStage, vk::Buffer dstBuffer,
                                              vk::DeviceSize dstOffset, uint32_t marker) const {
-  vkCommandBuffer_.writeBufferMarkerAMD(pipelineStage, dstBuffer, dstOffset, marker, getDispatcher());
+  flushBarriers();
+  vkCommandBuffer_.writeBufferMarkerAMD(pipelineStage, dstBuffer, dstOffset, marker, commandDispatch_);
 }
 
 // endregion
@@ -606,7 +866,114 @@ CommandPoolImpl& CommandBufferImpl::getCommandPool() const {
 }
 
 const vk::DispatchLoaderDynamic& CommandBufferImpl::getDispatcher() const {
-  return commandPool_.getDispatcher();
+  return dispatcher_;
+}
+
+void CommandBufferImpl::setBarrierBatching(bool enabled) const {
+  if (!enabled) {
+    flushBarriers();
+  }
+
+  batchBarriers_ = enabled;
+}
+
+bool CommandBufferImpl::isBarrierBatchingEnabled() const {
+  return batchBarriers_;
+}
+
+void CommandBufferImpl::setRedundantStateFiltering(bool enabled) const {
+  // Commands recorded while filtering was disabled are not reflected in the cache.
+  stateCache_.invalidate();
+  filterRedundantState_ = enabled;
+}
+
+bool CommandBufferImpl::isRedundantStateFilteringEnabled() const {
+  return filterRedundantState_;
+}
+
+const StateCacheStatistics& CommandBufferImpl::getStateCacheStatistics() const {
+  return stateCache_.getStatistics();
+}
+
+const BarrierBatchStatistics& CommandBufferImpl::getBarrierBatchStatistics() const {
+  return barrierBatcher_.getStatistics();
+}
+
+void CommandBufferImpl::transition(const std::shared_ptr<SharedImageState>& image, ResourceUsage usage,
+                                   const vk::ImageSubresourceRange& range, bool discardContents) const {
+  if (!image) {
+    throw IllegalInvocation("State tracking is not enabled for the image.");
+  }
+
+  auto it = imageStates_.find(image.get());
+  if (it == imageStates_.end()) {
+    if (imageStates_.empty() && bufferStates_.empty()) {
+      getLogicalDevice().registerTrackedCommandBuffer(vkCommandBuffer_, *this);
+    }
+
+    // Dimensions of the shared state are immutable, hence they can be read without locking it.
+    const ImageState& sharedState = image->state;
+    ImageState localState(sharedState.getImage(), sharedState.getAspectMask(), sharedState.getMipLevels(),
+                          sharedState.getArrayLayers());
+    it = imageStates_.emplace(image.get(), std::make_pair(image, std::move(localState))).first;
+  }
+
+  transitionBarriers_.clear();
+  it->second.second.transition(range, getResourceAccess(usage), discardContents, transitionBarriers_);
+  recordTransitionBarriers();
+}
+
+void CommandBufferImpl::transition(const std::shared_ptr<SharedBufferState>& buffer, ResourceUsage usage,
+                                   vk::DeviceSize offset, vk::DeviceSize size) const {
+  if (!buffer) {
+    throw IllegalInvocation("State tracking is not enabled for the buffer.");
+  }
+
+  auto it = bufferStates_.find(buffer.get());
+  if (it == bufferStates_.end()) {
+    if (imageStates_.empty() && bufferStates_.empty()) {
+      getLogicalDevice().registerTrackedCommandBuffer(vkCommandBuffer_, *this);
+    }
+
+    const BufferState& sharedState = buffer->state;
+    BufferState localState(sharedState.getBuffer(), sharedState.getSize());
+    it = bufferStates_.emplace(buffer.get(), std::make_pair(buffer, std::move(localState))).first;
+  }
+
+  transitionBarriers_.clear();
+  it->second.second.transition(offset, size, getResourceAccess(usage), transitionBarriers_);
+  recordTransitionBarriers();
+}
+
+vk::CommandBuffer CommandBufferImpl::reconcileResourceStates() const {
+  ResourceBarriers barriers;
+
+  for (auto& entry : imageStates_) {
+    SharedImageState& sharedState = *entry.second.first;
+    std::lock_guard<std::mutex> lock(sharedState.mutex);
+    sharedState.state.reconcile(entry.second.second, barriers);
+  }
+
+  for (auto& entry : bufferStates_) {
+    SharedBufferState& sharedState = *entry.second.first;
+    std::lock_guard<std::mutex> lock(sharedState.mutex);
+    sharedState.state.reconcile(entry.second.second, barriers);
+  }
+
+  if (barriers.empty()) {
+    return {};
+  }
+
+  getQueueFamily().recordPreambleCommandBuffer(preamble_, barriers);
+  return *preamble_;
+}
+
+CommandStatistics CommandBufferImpl::getStatistics() const {
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+  return statistics_;
+#else
+  return CommandStatistics();
+#endif
 }
 
 void CommandBufferImpl::destroy() const {
@@ -617,7 +984,31 @@ CommandBufferImpl::operator const vk::CommandBuffer&() const {
   return vkCommandBuffer_;
 }
 
+void CommandBufferImpl::recordTransitionBarriers() const {
+  if (!transitionBarriers_.empty()) {
+    pipelineBarrier(transitionBarriers_.srcStageMask, transitionBarriers_.dstStageMask, {}, {},
+                    transitionBarriers_.bufferBarriers, transitionBarriers_.imageBarriers);
+  }
+}
+
+void CommandBufferImpl::clearResourceStates() const {
+  if (!imageStates_.empty() || !bufferStates_.empty()) {
+    getLogicalDevice().unregisterTrackedCommandBuffer(vkCommandBuffer_);
+    imageStates_.clear();
+    bufferStates_.clear();
+  }
+}
+
 void CommandBufferImpl::free() {
+  clearResourceStates();
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+  getLogicalDevice().unregisterStatisticsCommandBuffer(vkCommandBuffer_);
+#endif
+  if (preamble_) {
+    getQueueFamily().freePreambleCommandBuffer(preamble_);
+    preamble_.reset();
+  }
+
   vkCommandBuffer_ = nullptr;
   VulkanObject::free();
 }
@@ -0,0 +1,137 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/command/command_dispatch_table.hpp"
+
+namespace logi {
+
+CommandDispatchTable::CommandDispatchTable(const vk::DispatchLoaderDynamic& dispatcher) {
+#ifndef LOGI_STATIC_DISPATCH
+  vkCmdDraw = dispatcher.vkCmdDraw;
+  vkCmdDrawIndexed = dispatcher.vkCmdDrawIndexed;
+  vkCmdDrawIndirect = dispatcher.vkCmdDrawIndirect;
+  vkCmdDrawIndexedIndirect = dispatcher.vkCmdDrawIndexedIndirect;
+  vkCmdDispatch = dispatcher.vkCmdDispatch;
+  vkCmdDispatchIndirect = dispatcher.vkCmdDispatchIndirect;
+  vkCmdBindPipeline = dispatcher.vkCmdBindPipeline;
+  vkCmdBindDescriptorSets = dispatcher.vkCmdBindDescriptorSets;
+  vkCmdBindVertexBuffers = dispatcher.vkCmdBindVertexBuffers;
+  vkCmdBindIndexBuffer = dispatcher.vkCmdBindIndexBuffer;
+  vkCmdPushConstants = dispatcher.vkCmdPushConstants;
+  vkCmdSetViewport = dispatcher.vkCmdSetViewport;
+  vkCmdSetScissor = dispatcher.vkCmdSetScissor;
+  vkCmdSetLineWidth = dispatcher.vkCmdSetLineWidth;
+  vkCmdSetDepthBias = dispatcher.vkCmdSetDepthBias;
+  vkCmdSetBlendConstants = dispatcher.vkCmdSetBlendConstants;
+  vkCmdSetDepthBounds = dispatcher.vkCmdSetDepthBounds;
+  vkCmdSetStencilCompareMask = dispatcher.vkCmdSetStencilCompareMask;
+  vkCmdSetStencilWriteMask = dispatcher.vkCmdSetStencilWriteMask;
+  vkCmdSetStencilReference = dispatcher.vkCmdSetStencilReference;
+  vkCmdPipelineBarrier = dispatcher.vkCmdPipelineBarrier;
+  vkCmdBeginRenderPass = dispatcher.vkCmdBeginRenderPass;
+  vkCmdNextSubpass = dispatcher.vkCmdNextSubpass;
+  vkCmdEndRenderPass = dispatcher.vkCmdEndRenderPass;
+  vkCmdExecuteCommands = dispatcher.vkCmdExecuteCommands;
+  vkBeginCommandBuffer = dispatcher.vkBeginCommandBuffer;
+  vkEndCommandBuffer = dispatcher.vkEndCommandBuffer;
+  vkResetCommandBuffer = dispatcher.vkResetCommandBuffer;
+#endif
+  vkCmdBeginConditionalRenderingEXT = dispatcher.vkCmdBeginConditionalRenderingEXT;
+  vkCmdBeginDebugUtilsLabelEXT = dispatcher.vkCmdBeginDebugUtilsLabelEXT;
+  vkCmdBeginQuery = dispatcher.vkCmdBeginQuery;
+  vkCmdBeginQueryIndexedEXT = dispatcher.vkCmdBeginQueryIndexedEXT;
+  vkCmdBeginRenderPass2 = dispatcher.vkCmdBeginRenderPass2;
+  vkCmdBeginRenderPass2KHR = dispatcher.vkCmdBeginRenderPass2KHR;
+  vkCmdBeginTransformFeedbackEXT = dispatcher.vkCmdBeginTransformFeedbackEXT;
+  vkCmdBindPipelineShaderGroupNV = dispatcher.vkCmdBindPipelineShaderGroupNV;
+  vkCmdBindShadingRateImageNV = dispatcher.vkCmdBindShadingRateImageNV;
+  vkCmdBindTransformFeedbackBuffersEXT = dispatcher.vkCmdBindTransformFeedbackBuffersEXT;
+  vkCmdBlitImage = dispatcher.vkCmdBlitImage;
+  vkCmdBuildAccelerationStructureNV = dispatcher.vkCmdBuildAccelerationStructureNV;
+  vkCmdBuildAccelerationStructuresIndirectKHR = dispatcher.vkCmdBuildAccelerationStructuresIndirectKHR;
+  vkCmdBuildAccelerationStructuresKHR = dispatcher.vkCmdBuildAccelerationStructuresKHR;
+  vkCmdClearAttachments = dispatcher.vkCmdClearAttachments;
+  vkCmdClearColorImage = dispatcher.vkCmdClearColorImage;
+  vkCmdClearDepthStencilImage = dispatcher.vkCmdClearDepthStencilImage;
+  vkCmdCopyAccelerationStructureKHR = dispatcher.vkCmdCopyAccelerationStructureKHR;
+  vkCmdCopyAccelerationStructureNV = dispatcher.vkCmdCopyAccelerationStructureNV;
+  vkCmdCopyAccelerationStructureToMemoryKHR = dispatcher.vkCmdCopyAccelerationStructureToMemoryKHR;
+  vkCmdCopyBuffer = dispatcher.vkCmdCopyBuffer;
+  vkCmdCopyBufferToImage = dispatcher.vkCmdCopyBufferToImage;
+  vkCmdCopyImage = dispatcher.vkCmdCopyImage;
+  vkCmdCopyImageToBuffer = dispatcher.vkCmdCopyImageToBuffer;
+  vkCmdCopyMemoryToAccelerationStructureKHR = dispatcher.vkCmdCopyMemoryToAccelerationStructureKHR;
+  vkCmdCopyQueryPoolResults = dispatcher.vkCmdCopyQueryPoolResults;
+  vkCmdDebugMarkerBeginEXT = dispatcher.vkCmdDebugMarkerBeginEXT;
+  vkCmdDebugMarkerEndEXT = dispatcher.vkCmdDebugMarkerEndEXT;
+  vkCmdDebugMarkerInsertEXT = dispatcher.vkCmdDebugMarkerInsertEXT;
+  vkCmdDispatchBase = dispatcher.vkCmdDispatchBase;
+  vkCmdDispatchBaseKHR = dispatcher.vkCmdDispatchBaseKHR;
+  vkCmdDrawIndexedIndirectCount = dispatcher.vkCmdDrawIndexedIndirectCount;
+  vkCmdDrawIndexedIndirectCountAMD = dispatcher.vkCmdDrawIndexedIndirectCountAMD;
+  vkCmdDrawIndexedIndirectCountKHR = dispatcher.vkCmdDrawIndexedIndirectCountKHR;
+  vkCmdDrawIndirectByteCountEXT = dispatcher.vkCmdDrawIndirectByteCountEXT;
+  vkCmdDrawIndirectCount = dispatcher.vkCmdDrawIndirectCount;
+  vkCmdDrawIndirectCountAMD = dispatcher.vkCmdDrawIndirectCountAMD;
+  vkCmdDrawIndirectCountKHR = dispatcher.vkCmdDrawIndirectCountKHR;
+  vkCmdDrawMeshTasksIndirectCountNV = dispatcher.vkCmdDrawMeshTasksIndirectCountNV;
+  vkCmdDrawMeshTasksIndirectNV = dispatcher.vkCmdDrawMeshTasksIndirectNV;
+  vkCmdDrawMeshTasksNV = dispatcher.vkCmdDrawMeshTasksNV;
+  vkCmdEndConditionalRenderingEXT = dispatcher.vkCmdEndConditionalRenderingEXT;
+  vkCmdEndDebugUtilsLabelEXT = dispatcher.vkCmdEndDebugUtilsLabelEXT;
+  vkCmdEndQuery = dispatcher.vkCmdEndQuery;
+  vkCmdEndQueryIndexedEXT = dispatcher.vkCmdEndQueryIndexedEXT;
+  vkCmdEndRenderPass2 = dispatcher.vkCmdEndRenderPass2;
+  vkCmdEndRenderPass2KHR = dispatcher.vkCmdEndRenderPass2KHR;
+  vkCmdEndTransformFeedbackEXT = dispatcher.vkCmdEndTransformFeedbackEXT;
+  vkCmdExecuteGeneratedCommandsNV = dispatcher.vkCmdExecuteGeneratedCommandsNV;
+  vkCmdFillBuffer = dispatcher.vkCmdFillBuffer;
+  vkCmdInsertDebugUtilsLabelEXT = dispatcher.vkCmdInsertDebugUtilsLabelEXT;
+  vkCmdNextSubpass2 = dispatcher.vkCmdNextSubpass2;
+  vkCmdNextSubpass2KHR = dispatcher.vkCmdNextSubpass2KHR;
+  vkCmdPreprocessGeneratedCommandsNV = dispatcher.vkCmdPreprocessGeneratedCommandsNV;
+  vkCmdProcessCommandsNVX = dispatcher.vkCmdProcessCommandsNVX;
+  vkCmdPushDescriptorSetKHR = dispatcher.vkCmdPushDescriptorSetKHR;
+  vkCmdPushDescriptorSetWithTemplateKHR = dispatcher.vkCmdPushDescriptorSetWithTemplateKHR;
+  vkCmdReserveSpaceForCommandsNVX = dispatcher.vkCmdReserveSpaceForCommandsNVX;
+  vkCmdResetEvent = dispatcher.vkCmdResetEvent;
+  vkCmdResetQueryPool = dispatcher.vkCmdResetQueryPool;
+  vkCmdResolveImage = dispatcher.vkCmdResolveImage;
+  vkCmdSetCheckpointNV = dispatcher.vkCmdSetCheckpointNV;
+  vkCmdSetCoarseSampleOrderNV = dispatcher.vkCmdSetCoarseSampleOrderNV;
+  vkCmdSetDeviceMask = dispatcher.vkCmdSetDeviceMask;
+  vkCmdSetDeviceMaskKHR = dispatcher.vkCmdSetDeviceMaskKHR;
+  vkCmdSetDiscardRectangleEXT = dispatcher.vkCmdSetDiscardRectangleEXT;
+  vkCmdSetEvent = dispatcher.vkCmdSetEvent;
+  vkCmdSetExclusiveScissorNV = dispatcher.vkCmdSetExclusiveScissorNV;
+  vkCmdSetRayTracingPipelineStackSizeKHR = dispatcher.vkCmdSetRayTracingPipelineStackSizeKHR;
+  vkCmdSetSampleLocationsEXT = dispatcher.vkCmdSetSampleLocationsEXT;
+  vkCmdSetViewportShadingRatePaletteNV = dispatcher.vkCmdSetViewportShadingRatePaletteNV;
+  vkCmdSetViewportWScalingNV = dispatcher.vkCmdSetViewportWScalingNV;
+  vkCmdTraceRaysIndirectKHR = dispatcher.vkCmdTraceRaysIndirectKHR;
+  vkCmdTraceRaysKHR = dispatcher.vkCmdTraceRaysKHR;
+  vkCmdTraceRaysNV = dispatcher.vkCmdTraceRaysNV;
+  vkCmdUpdateBuffer = dispatcher.vkCmdUpdateBuffer;
+  vkCmdWaitEvents = dispatcher.vkCmdWaitEvents;
+  vkCmdWriteAccelerationStructuresPropertiesKHR = dispatcher.vkCmdWriteAccelerationStructuresPropertiesKHR;
+  vkCmdWriteAccelerationStructuresPropertiesNV = dispatcher.vkCmdWriteAccelerationStructuresPropertiesNV;
+  vkCmdWriteBufferMarkerAMD = dispatcher.vkCmdWriteBufferMarkerAMD;
+  vkCmdWriteTimestamp = dispatcher.vkCmdWriteTimestamp;
+}
+
+} // namespace logi
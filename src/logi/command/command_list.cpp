@@ -0,0 +1,474 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/command/command_list.hpp"
+#include "logi/command/command_dispatch_table.hpp"
+
+namespace logi {
+
+CommandList::CommandList(size_t capacity) : commandCount_(0u) {
+  data_.reserve(capacity);
+}
+
+// region Recording
+
+void CommandList::bindPipeline(vk::PipelineBindPoint pipelineBindPoint, vk::Pipeline pipeline) {
+  beginCommand(BindPipeline {pipelineBindPoint, pipeline});
+  statistics_.pipelineBinds++;
+}
+
+void CommandList::bindDescriptorSets(vk::PipelineBindPoint pipelineBindPoint, vk::PipelineLayout layout,
+                                     uint32_t firstSet, vk::ArrayProxy<const vk::DescriptorSet> descriptorSets,
+                                     vk::ArrayProxy<const uint32_t> dynamicOffsets) {
+  size_t record = beginCommand(BindDescriptorSets {pipelineBindPoint, layout, firstSet, {}, {}});
+  statistics_.descriptorSetBinds++;
+  ArrayRef<vk::DescriptorSet> sets = appendArray(record, descriptorSets);
+  ArrayRef<uint32_t> offsets = appendArray(record, dynamicOffsets);
+
+  auto& command = at<BindDescriptorSets>(record);
+  command.descriptorSets = sets;
+  command.dynamicOffsets = offsets;
+}
+
+void CommandList::bindVertexBuffers(uint32_t firstBinding, vk::ArrayProxy<const vk::Buffer> buffers,
+                                    vk::ArrayProxy<const vk::DeviceSize> offsets) {
+  size_t record = beginCommand(BindVertexBuffers {firstBinding, {}, {}});
+  ArrayRef<vk::Buffer> bufferArray = appendArray(record, buffers);
+  ArrayRef<vk::DeviceSize> offsetArray = appendArray(record, offsets);
+
+  auto& command = at<BindVertexBuffers>(record);
+  command.buffers = bufferArray;
+  command.offsets = offsetArray;
+}
+
+void CommandList::bindIndexBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType indexType) {
+  beginCommand(BindIndexBuffer {buffer, offset, indexType});
+}
+
+void CommandList::setViewport(uint32_t firstViewport, vk::ArrayProxy<const vk::Viewport> viewports) {
+  size_t record = beginCommand(SetViewport {firstViewport, {}});
+  ArrayRef<vk::Viewport> viewportArray = appendArray(record, viewports);
+  at<SetViewport>(record).viewports = viewportArray;
+}
+
+void CommandList::setScissor(uint32_t firstScissor, vk::ArrayProxy<const vk::Rect2D> scissors) {
+  size_t record = beginCommand(SetScissor {firstScissor, {}});
+  ArrayRef<vk::Rect2D> scissorArray = appendArray(record, scissors);
+  at<SetScissor>(record).scissors = scissorArray;
+}
+
+void CommandList::setLineWidth(float lineWidth) {
+  beginCommand(SetLineWidth {lineWidth});
+}
+
+void CommandList::setDepthBias(float depthBiasConstantFactor, float depthBiasClamp, float depthBiasSlopeFactor) {
+  beginCommand(SetDepthBias {depthBiasConstantFactor, depthBiasClamp, depthBiasSlopeFactor});
+}
+
+void CommandList::setBlendConstants(const float blendConstants[4]) {
+  beginCommand(SetBlendConstants {{blendConstants[0], blendConstants[1], blendConstants[2], blendConstants[3]}});
+}
+
+void CommandList::setDepthBounds(float minDepthBounds, float maxDepthBounds) {
+  beginCommand(SetDepthBounds {minDepthBounds, maxDepthBounds});
+}
+
+void CommandList::setStencilCompareMask(vk::StencilFaceFlags faceMask, uint32_t compareMask) {
+  beginCommand(SetStencilCompareMask {faceMask, compareMask});
+}
+
+void CommandList::setStencilWriteMask(vk::StencilFaceFlags faceMask, uint32_t writeMask) {
+  beginCommand(SetStencilWriteMask {faceMask, writeMask});
+}
+
+void CommandList::setStencilReference(vk::StencilFaceFlags faceMask, uint32_t reference) {
+  beginCommand(SetStencilReference {faceMask, reference});
+}
+
+void CommandList::draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) {
+  beginCommand(Draw {vertexCount, instanceCount, firstVertex, firstInstance});
+  statistics_.draws++;
+}
+
+void CommandList::drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset,
+                              uint32_t firstInstance) {
+  beginCommand(DrawIndexed {indexCount, instanceCount, firstIndex, vertexOffset, firstInstance});
+  statistics_.draws++;
+}
+
+void CommandList::drawIndirect(vk::Buffer buffer, vk::DeviceSize offset, uint32_t drawCount, uint32_t stride) {
+  beginCommand(DrawIndirect {buffer, offset, drawCount, stride});
+  statistics_.draws++;
+}
+
+void CommandList::drawIndexedIndirect(vk::Buffer buffer, vk::DeviceSize offset, uint32_t drawCount, uint32_t stride) {
+  beginCommand(DrawIndexedIndirect {buffer, offset, drawCount, stride});
+  statistics_.draws++;
+}
+
+void CommandList::dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {
+  beginCommand(Dispatch {groupCountX, groupCountY, groupCountZ});
+  statistics_.dispatches++;
+}
+
+void CommandList::dispatchIndirect(vk::Buffer buffer, vk::DeviceSize offset) {
+  beginCommand(DispatchIndirect {buffer, offset});
+  statistics_.dispatches++;
+}
+
+void CommandList::copyBuffer(vk::Buffer srcBuffer, vk::Buffer dstBuffer, vk::ArrayProxy<const vk::BufferCopy> regions) {
+  size_t record = beginCommand(CopyBuffer {srcBuffer, dstBuffer, {}});
+  statistics_.copies++;
+  for (const vk::BufferCopy& region : regions) {
+    statistics_.copyBytes += region.size;
+  }
+  ArrayRef<vk::BufferCopy> regionArray = appendArray(record, regions);
+  at<CopyBuffer>(record).regions = regionArray;
+}
+
+void CommandList::copyImage(vk::Image srcImage, vk::ImageLayout srcImageLayout, vk::Image dstImage,
+                            vk::ImageLayout dstImageLayout, vk::ArrayProxy<const vk::ImageCopy> regions) {
+  size_t record = beginCommand(CopyImage {srcImage, srcImageLayout, dstImage, dstImageLayout, {}});
+  statistics_.copies++;
+  ArrayRef<vk::ImageCopy> regionArray = appendArray(record, regions);
+  at<CopyImage>(record).regions = regionArray;
+}
+
+void CommandList::copyBufferToImage(vk::Buffer srcBuffer, vk::Image dstImage, vk::ImageLayout dstImageLayout,
+                                    vk::ArrayProxy<const vk::BufferImageCopy> regions) {
+  size_t record = beginCommand(CopyBufferToImage {srcBuffer, dstImage, dstImageLayout, {}});
+  statistics_.copies++;
+  ArrayRef<vk::BufferImageCopy> regionArray = appendArray(record, regions);
+  at<CopyBufferToImage>(record).regions = regionArray;
+}
+
+void CommandList::copyImageToBuffer(vk::Image srcImage, vk::ImageLayout srcImageLayout, vk::Buffer dstBuffer,
+                                    vk::ArrayProxy<const vk::BufferImageCopy> regions) {
+  size_t record = beginCommand(CopyImageToBuffer {srcImage, srcImageLayout, dstBuffer, {}});
+  statistics_.copies++;
+  ArrayRef<vk::BufferImageCopy> regionArray = appendArray(record, regions);
+  at<CopyImageToBuffer>(record).regions = regionArray;
+}
+
+void CommandList::fillBuffer(vk::Buffer dstBuffer, vk::DeviceSize dstOffset, vk::DeviceSize size, uint32_t data) {
+  beginCommand(FillBuffer {dstBuffer, dstOffset, size, data});
+  statistics_.copies++;
+  if (size != VK_WHOLE_SIZE) {
+    statistics_.copyBytes += size;
+  }
+}
+
+void CommandList::pipelineBarrier(const vk::PipelineStageFlags& srcStageMask,
+                                  const vk::PipelineStageFlags& dstStageMask,
+                                  const vk::DependencyFlags& dependencyFlags,
+                                  vk::ArrayProxy<const vk::MemoryBarrier> memoryBarriers,
+                                  vk::ArrayProxy<const vk::BufferMemoryBarrier> bufferMemoryBarriers,
+                                  vk::ArrayProxy<const vk::ImageMemoryBarrier> imageMemoryBarriers) {
+  size_t record = beginCommand(PipelineBarrier {srcStageMask, dstStageMask, dependencyFlags, {}, {}, {}});
+  statistics_.barrierCommands++;
+  statistics_.barriers += memoryBarriers.size() + bufferMemoryBarriers.size() + imageMemoryBarriers.size();
+  ArrayRef<vk::MemoryBarrier> memory = appendArray(record, memoryBarriers);
+  ArrayRef<vk::BufferMemoryBarrier> buffer = appendArray(record, bufferMemoryBarriers);
+  ArrayRef<vk::ImageMemoryBarrier> image = appendArray(record, imageMemoryBarriers);
+  clearNext(record, memory);
+  clearNext(record, buffer);
+  clearNext(record, image);
+
+  auto& command = at<PipelineBarrier>(record);
+  command.memoryBarriers = memory;
+  command.bufferMemoryBarriers = buffer;
+  command.imageMemoryBarriers = image;
+}
+
+void CommandList::beginRenderPass(const vk::RenderPassBeginInfo& renderPassBegin, vk::SubpassContents contents) {
+  size_t record = beginCommand(
+    BeginRenderPass {renderPassBegin.renderPass, renderPassBegin.framebuffer, renderPassBegin.renderArea, {}, contents});
+  ArrayRef<vk::ClearValue> clearValues =
+    appendArray(record, renderPassBegin.pClearValues, renderPassBegin.clearValueCount);
+  at<BeginRenderPass>(record).clearValues = clearValues;
+}
+
+void CommandList::nextSubpass(vk::SubpassContents contents) {
+  beginCommand(NextSubpass {contents});
+}
+
+void CommandList::endRenderPass() {
+  beginCommand(EndRenderPass {});
+}
+
+void CommandList::executeCommands(vk::ArrayProxy<const vk::CommandBuffer> commandBuffers) {
+  size_t record = beginCommand(ExecuteCommands {});
+  ArrayRef<vk::CommandBuffer> commandBufferArray = appendArray(record, commandBuffers);
+  at<ExecuteCommands>(record).commandBuffers = commandBufferArray;
+}
+
+void CommandList::resetQueryPool(vk::QueryPool queryPool, uint32_t firstQuery, uint32_t queryCount) {
+  beginCommand(ResetQueryPool {queryPool, firstQuery, queryCount});
+}
+
+void CommandList::beginQuery(vk::QueryPool queryPool, uint32_t query, const vk::QueryControlFlags& flags) {
+  beginCommand(BeginQuery {queryPool, query, flags});
+}
+
+void CommandList::endQuery(vk::QueryPool queryPool, uint32_t query) {
+  beginCommand(EndQuery {queryPool, query});
+}
+
+void CommandList::writeTimestamp(vk::PipelineStageFlagBits pipelineStage, vk::QueryPool queryPool, uint32_t query) {
+  beginCommand(WriteTimestamp {pipelineStage, queryPool, query});
+}
+
+void CommandList::append(const CommandList& other) {
+  data_.insert(data_.end(), other.data_.begin(), other.data_.end());
+  commandCount_ += other.commandCount_;
+  statistics_ += other.statistics_;
+}
+
+// endregion
+
+// region Replay
+
+void CommandList::replay(vk::CommandBuffer commandBuffer, const CommandDispatchTable& dispatch) const {
+  for (Command command : *this) {
+    switch (command.type()) {
+      case CommandType::eBindPipeline: {
+        const auto& args = command.get<BindPipeline>();
+        commandBuffer.bindPipeline(args.pipelineBindPoint, args.pipeline, dispatch);
+        break;
+      }
+      case CommandType::eBindDescriptorSets: {
+        const auto& args = command.get<BindDescriptorSets>();
+        commandBuffer.bindDescriptorSets(args.pipelineBindPoint, args.layout, args.firstSet,
+                                         args.descriptorSets.count, command.data(args.descriptorSets),
+                                         args.dynamicOffsets.count, command.data(args.dynamicOffsets), dispatch);
+        break;
+      }
+      case CommandType::eBindVertexBuffers: {
+        const auto& args = command.get<BindVertexBuffers>();
+        commandBuffer.bindVertexBuffers(args.firstBinding, args.buffers.count, command.data(args.buffers),
+                                        command.data(args.offsets), dispatch);
+        break;
+      }
+      case CommandType::eBindIndexBuffer: {
+        const auto& args = command.get<BindIndexBuffer>();
+        commandBuffer.bindIndexBuffer(args.buffer, args.offset, args.indexType, dispatch);
+        break;
+      }
+      case CommandType::ePushConstants: {
+        const auto& args = command.get<PushConstants>();
+        commandBuffer.pushConstants(args.layout, args.stageFlags, args.offset, args.values.count,
+                                    command.data(args.values), dispatch);
+        break;
+      }
+      case CommandType::eSetViewport: {
+        const auto& args = command.get<SetViewport>();
+        commandBuffer.setViewport(args.firstViewport, args.viewports.count, command.data(args.viewports), dispatch);
+        break;
+      }
+      case CommandType::eSetScissor: {
+        const auto& args = command.get<SetScissor>();
+        commandBuffer.setScissor(args.firstScissor, args.scissors.count, command.data(args.scissors), dispatch);
+        break;
+      }
+      case CommandType::eSetLineWidth: {
+        commandBuffer.setLineWidth(command.get<SetLineWidth>().lineWidth, dispatch);
+        break;
+      }
+      case CommandType::eSetDepthBias: {
+        const auto& args = command.get<SetDepthBias>();
+        commandBuffer.setDepthBias(args.depthBiasConstantFactor, args.depthBiasClamp, args.depthBiasSlopeFactor,
+                                   dispatch);
+        break;
+      }
+      case CommandType::eSetBlendConstants: {
+        commandBuffer.setBlendConstants(command.get<SetBlendConstants>().blendConstants, dispatch);
+        break;
+      }
+      case CommandType::eSetDepthBounds: {
+        const auto& args = command.get<SetDepthBounds>();
+        commandBuffer.setDepthBounds(args.minDepthBounds, args.maxDepthBounds, dispatch);
+        break;
+      }
+      case CommandType::eSetStencilCompareMask: {
+        const auto& args = command.get<SetStencilCompareMask>();
+        commandBuffer.setStencilCompareMask(args.faceMask, args.compareMask, dispatch);
+        break;
+      }
+      case CommandType::eSetStencilWriteMask: {
+        const auto& args = command.get<SetStencilWriteMask>();
+        commandBuffer.setStencilWriteMask(args.faceMask, args.writeMask, dispatch);
+        break;
+      }
+      case CommandType::eSetStencilReference: {
+        const auto& args = command.get<SetStencilReference>();
+        commandBuffer.setStencilReference(args.faceMask, args.reference, dispatch);
+        break;
+      }
+      case CommandType::eDraw: {
+        const auto& args = command.get<Draw>();
+        commandBuffer.draw(args.vertexCount, args.instanceCount, args.firstVertex, args.firstInstance, dispatch);
+        break;
+      }
+      case CommandType::eDrawIndexed: {
+        const auto& args = command.get<DrawIndexed>();
+        commandBuffer.drawIndexed(args.indexCount, args.instanceCount, args.firstIndex, args.vertexOffset,
+                                  args.firstInstance, dispatch);
+        break;
+      }
+      case CommandType::eDrawIndirect: {
+        const auto& args = command.get<DrawIndirect>();
+        commandBuffer.drawIndirect(args.buffer, args.offset, args.drawCount, args.stride, dispatch);
+        break;
+      }
+      case CommandType::eDrawIndexedIndirect: {
+        const auto& args = command.get<DrawIndexedIndirect>();
+        commandBuffer.drawIndexedIndirect(args.buffer, args.offset, args.drawCount, args.stride, dispatch);
+        break;
+      }
+      case CommandType::eDispatch: {
+        const auto& args = command.get<Dispatch>();
+        commandBuffer.dispatch(args.groupCountX, args.groupCountY, args.groupCountZ, dispatch);
+        break;
+      }
+      case CommandType::eDispatchIndirect: {
+        const auto& args = command.get<DispatchIndirect>();
+        commandBuffer.dispatchIndirect(args.buffer, args.offset, dispatch);
+        break;
+      }
+      case CommandType::eCopyBuffer: {
+        const auto& args = command.get<CopyBuffer>();
+        commandBuffer.copyBuffer(args.srcBuffer, args.dstBuffer, args.regions.count, command.data(args.regions),
+                                 dispatch);
+        break;
+      }
+      case CommandType::eCopyImage: {
+        const auto& args = command.get<CopyImage>();
+        commandBuffer.copyImage(args.srcImage, args.srcImageLayout, args.dstImage, args.dstImageLayout,
+                                args.regions.count, command.data(args.regions), dispatch);
+        break;
+      }
+      case CommandType::eCopyBufferToImage: {
+        const auto& args = command.get<CopyBufferToImage>();
+        commandBuffer.copyBufferToImage(args.srcBuffer, args.dstImage, args.dstImageLayout, args.regions.count,
+                                        command.data(args.regions), dispatch);
+        break;
+      }
+      case CommandType::eCopyImageToBuffer: {
+        const auto& args = command.get<CopyImageToBuffer>();
+        commandBuffer.copyImageToBuffer(args.srcImage, args.srcImageLayout, args.dstBuffer, args.regions.count,
+                                        command.data(args.regions), dispatch);
+        break;
+      }
+      case CommandType::eFillBuffer: {
+        const auto& args = command.get<FillBuffer>();
+        commandBuffer.fillBuffer(args.dstBuffer, args.dstOffset, args.size, args.data, dispatch);
+        break;
+      }
+      case CommandType::ePipelineBarrier: {
+        const auto& args = command.get<PipelineBarrier>();
+        commandBuffer.pipelineBarrier(args.srcStageMask, args.dstStageMask, args.dependencyFlags,
+                                      args.memoryBarriers.count, command.data(args.memoryBarriers),
+                                      args.bufferMemoryBarriers.count, command.data(args.bufferMemoryBarriers),
+                                      args.imageMemoryBarriers.count, command.data(args.imageMemoryBarriers), dispatch);
+        break;
+      }
+      case CommandType::eBeginRenderPass: {
+        const auto& args = command.get<BeginRenderPass>();
+        vk::RenderPassBeginInfo beginInfo(args.renderPass, args.framebuffer, args.renderArea, args.clearValues.count,
+                                          command.data(args.clearValues));
+        commandBuffer.beginRenderPass(&beginInfo, args.contents, dispatch);
+        break;
+      }
+      case CommandType::eNextSubpass: {
+        commandBuffer.nextSubpass(command.get<NextSubpass>().contents, dispatch);
+        break;
+      }
+      case CommandType::eEndRenderPass: {
+        commandBuffer.endRenderPass(dispatch);
+        break;
+      }
+      case CommandType::eExecuteCommands: {
+        const auto& args = command.get<ExecuteCommands>();
+        commandBuffer.executeCommands(args.commandBuffers.count, command.data(args.commandBuffers), dispatch);
+        break;
+      }
+      case CommandType::eResetQueryPool: {
+        const auto& args = command.get<ResetQueryPool>();
+        commandBuffer.resetQueryPool(args.queryPool, args.firstQuery, args.queryCount, dispatch);
+        break;
+      }
+      case CommandType::eBeginQuery: {
+        const auto& args = command.get<BeginQuery>();
+        commandBuffer.beginQuery(args.queryPool, args.query, args.flags, dispatch);
+        break;
+      }
+      case CommandType::eEndQuery: {
+        const auto& args = command.get<EndQuery>();
+        commandBuffer.endQuery(args.queryPool, args.query, dispatch);
+        break;
+      }
+      case CommandType::eWriteTimestamp: {
+        const auto& args = command.get<WriteTimestamp>();
+        commandBuffer.writeTimestamp(args.pipelineStage, args.queryPool, args.query, dispatch);
+        break;
+      }
+    }
+  }
+}
+
+// endregion
+
+// region Inspection
+
+CommandList::const_iterator CommandList::begin() const {
+  return const_iterator(data_.data());
+}
+
+CommandList::const_iterator CommandList::end() const {
+  return const_iterator(data_.data() + data_.size());
+}
+
+size_t CommandList::size() const {
+  return commandCount_;
+}
+
+bool CommandList::empty() const {
+  return commandCount_ == 0u;
+}
+
+size_t CommandList::byteSize() const {
+  return data_.size();
+}
+
+const CommandStatistics& CommandList::getStatistics() const {
+  return statistics_;
+}
+
+size_t CommandList::capacity() const {
+  return data_.capacity();
+}
+
+void CommandList::clear() {
+  data_.clear();
+  commandCount_ = 0u;
+  statistics_ = CommandStatistics();
+}
+
+// endregion
+
+} // namespace logi
@@ -90,6 +90,14 @@ const vk::DispatchLoaderDynamic& CommandPool::getDispatcher() const {
   return object_->getDispatcher();
 }
 
+void CommandPool::setCommandStatistics(bool enabled) const {
+  object_->setCommandStatistics(enabled);
+}
+
+bool CommandPool::isCommandStatisticsEnabled() const {
+  return object_->isCommandStatisticsEnabled();
+}
+
 void CommandPool::destroy() const {
   if (object_) {
     object_->destroy();
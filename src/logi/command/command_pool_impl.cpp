@@ -17,6 +17,7 @@
  */
 
 #include "logi/command/command_pool_impl.hpp"
+#include "logi/base/result.hpp"
 #include "logi/command/command_buffer_impl.hpp"
 #include "logi/device/logical_device_impl.hpp"
 
@@ -62,7 +63,7 @@ std::shared_ptr<CommandBufferImpl>
   allocateInfo.pNext = next;
 
   return VulkanObjectComposite<CommandBufferImpl>::createObject(*this,
-                                                                vkDevice.allocateCommandBuffers(allocateInfo)[0]);
+                                                                vkDevice.allocateCommandBuffers(allocateInfo, getDispatcher())[0]);
 }
 
 void CommandPoolImpl::freeCommandBuffers(const std::vector<size_t>& cmdBufferIds) {
@@ -81,7 +82,11 @@ void CommandPoolImpl::freeCommandBuffers(const std::vector<size_t>& cmdBufferIds
 
 vk::ResultValueType<void>::type CommandPoolImpl::reset(const vk::CommandPoolResetFlags& flags) const {
   auto vkDevice = static_cast<vk::Device>(getLogicalDevice());
-  vkDevice.resetCommandPool(vkCommandPool_, flags, getDispatcher());
+  vk::Result result =
+    static_cast<vk::Result>(getDispatcher().vkResetCommandPool(static_cast<VkDevice>(vkDevice),
+                                                               static_cast<VkCommandPool>(vkCommandPool_),
+                                                               static_cast<VkCommandPoolResetFlags>(flags)));
+  return checkResult(result, "logi::CommandPoolImpl::reset");
 }
 
 void CommandPoolImpl::trim(const vk::CommandPoolTrimFlags& flags) const {
@@ -118,6 +123,14 @@ const vk::DispatchLoaderDynamic& CommandPoolImpl::getDispatcher() const {
   return queueFamily_.getDispatcher();
 }
 
+void CommandPoolImpl::setCommandStatistics(bool enabled) const {
+  commandStatisticsEnabled_.store(enabled, std::memory_order_relaxed);
+}
+
+bool CommandPoolImpl::isCommandStatisticsEnabled() const {
+  return commandStatisticsEnabled_.load(std::memory_order_relaxed);
+}
+
 void CommandPoolImpl::destroy() const {
   queueFamily_.destroyCommandPool(id());
 }
@@ -0,0 +1,270 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/command/command_state_cache.hpp"
+#include <algorithm>
+
+namespace logi {
+
+namespace {
+
+/**
+ * @brief   Compare the values with the cached range of state and update it.
+ *
+ * @return  True if any of the values differs from the cached state.
+ */
+template <typename T>
+bool updateRange(std::vector<std::optional<T>>& state, uint32_t first, vk::ArrayProxy<const T> values) {
+  bool changed = first + values.size() > state.size();
+  for (uint32_t i = 0u; !changed && i < values.size(); i++) {
+    changed = !state[first + i] || !(*state[first + i] == values.data()[i]);
+  }
+
+  if (changed) {
+    if (first + values.size() > state.size()) {
+      state.resize(first + values.size());
+    }
+    for (uint32_t i = 0u; i < values.size(); i++) {
+      state[first + i] = values.data()[i];
+    }
+  }
+
+  return changed;
+}
+
+template <typename T>
+bool updateValue(std::optional<T>& state, const T& value) {
+  if (state && *state == value) {
+    return false;
+  }
+
+  state = value;
+  return true;
+}
+
+} // namespace
+
+bool CommandStateCache::bindPipeline(vk::PipelineBindPoint pipelineBindPoint, vk::Pipeline pipeline) {
+  statistics_.filteredCalls++;
+  BindPointState& state = bindPoints_[getBindPointIndex(pipelineBindPoint)];
+
+  if (pipeline && state.pipeline == pipeline) {
+    return elide(statistics_.elidedPipelineBinds);
+  }
+
+  state.pipeline = pipeline;
+
+  // Static state of the new pipeline replaces the dynamic state, and it is not known which state is static.
+  if (pipelineBindPoint == vk::PipelineBindPoint::eGraphics) {
+    dynamicState_ = DynamicState();
+  }
+
+  return true;
+}
+
+bool CommandStateCache::bindDescriptorSets(vk::PipelineBindPoint pipelineBindPoint, vk::PipelineLayout layout,
+                                           uint32_t firstSet, vk::ArrayProxy<const vk::DescriptorSet> descriptorSets,
+                                           vk::ArrayProxy<const uint32_t> dynamicOffsets) {
+  statistics_.filteredCalls++;
+  BindPointState& state = bindPoints_[getBindPointIndex(pipelineBindPoint)];
+  auto setCount = static_cast<uint32_t>(descriptorSets.size());
+
+  // Dynamic offsets can not be attributed to individual sets, hence a bind with dynamic offsets is redundant only if it
+  // repeats the bind that produced the current state.
+  auto matches = [&](const std::optional<DescriptorSetBinding>& binding, uint32_t i) {
+    if (!binding || !(binding->descriptorSet == descriptorSets.data()[i])) {
+      return false;
+    }
+    if (dynamicOffsets.size() == 0u) {
+      return binding->dynamicOffsets.empty();
+    }
+
+    return binding->firstSet == firstSet && binding->setCount == setCount &&
+           std::equal(dynamicOffsets.begin(), dynamicOffsets.end(), binding->dynamicOffsets.begin(),
+                      binding->dynamicOffsets.end());
+  };
+
+  bool redundant = layout && state.layout == layout && firstSet + setCount <= state.descriptorSets.size();
+  for (uint32_t i = 0u; redundant && i < setCount; i++) {
+    redundant = matches(state.descriptorSets[firstSet + i], i);
+  }
+
+  if (redundant) {
+    return elide(statistics_.elidedDescriptorSetBinds);
+  }
+
+  // Compatibility of the layouts is not known, so sets bound with a different layout are forgotten.
+  if (!(state.layout == layout)) {
+    state.layout = layout;
+    state.descriptorSets.clear();
+  }
+  if (firstSet + setCount > state.descriptorSets.size()) {
+    state.descriptorSets.resize(firstSet + setCount);
+  }
+
+  for (uint32_t i = 0u; i < setCount; i++) {
+    std::optional<DescriptorSetBinding>& binding = state.descriptorSets[firstSet + i];
+    if (!binding) {
+      binding.emplace();
+    }
+    binding->descriptorSet = descriptorSets.data()[i];
+    binding->firstSet = firstSet;
+    binding->setCount = setCount;
+    binding->dynamicOffsets.assign(dynamicOffsets.begin(), dynamicOffsets.end());
+  }
+
+  return true;
+}
+
+bool CommandStateCache::bindVertexBuffers(uint32_t firstBinding, vk::ArrayProxy<const vk::Buffer> buffers,
+                                          vk::ArrayProxy<const vk::DeviceSize> offsets) {
+  statistics_.filteredCalls++;
+  uint32_t count = std::min(buffers.size(), offsets.size());
+
+  bool changed = firstBinding + count > vertexBuffers_.size();
+  for (uint32_t i = 0u; !changed && i < count; i++) {
+    const auto& binding = vertexBuffers_[firstBinding + i];
+    changed = !binding || !(binding->first == buffers.data()[i]) || binding->second != offsets.data()[i];
+  }
+
+  if (!changed) {
+    return elide(statistics_.elidedBufferBinds);
+  }
+
+  if (firstBinding + count > vertexBuffers_.size()) {
+    vertexBuffers_.resize(firstBinding + count);
+  }
+  for (uint32_t i = 0u; i < count; i++) {
+    vertexBuffers_[firstBinding + i] = std::make_pair(buffers.data()[i], offsets.data()[i]);
+  }
+
+  return true;
+}
+
+bool CommandStateCache::bindIndexBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType indexType) {
+  statistics_.filteredCalls++;
+
+  if (indexBuffer_ && indexBuffer_->buffer == buffer && indexBuffer_->offset == offset &&
+      indexBuffer_->indexType == indexType) {
+    return elide(statistics_.elidedBufferBinds);
+  }
+
+  indexBuffer_ = IndexBufferBinding {buffer, offset, indexType};
+  return true;
+}
+
+bool CommandStateCache::setViewport(uint32_t firstViewport, vk::ArrayProxy<const vk::Viewport> viewports) {
+  statistics_.filteredCalls++;
+  return updateRange(dynamicState_.viewports, firstViewport, viewports) || elide(statistics_.elidedDynamicStates);
+}
+
+bool CommandStateCache::setScissor(uint32_t firstScissor, vk::ArrayProxy<const vk::Rect2D> scissors) {
+  statistics_.filteredCalls++;
+  return updateRange(dynamicState_.scissors, firstScissor, scissors) || elide(statistics_.elidedDynamicStates);
+}
+
+bool CommandStateCache::setLineWidth(float lineWidth) {
+  statistics_.filteredCalls++;
+  return updateValue(dynamicState_.lineWidth, lineWidth) || elide(statistics_.elidedDynamicStates);
+}
+
+bool CommandStateCache::setDepthBias(float depthBiasConstantFactor, float depthBiasClamp, float depthBiasSlopeFactor) {
+  statistics_.filteredCalls++;
+  return updateValue(dynamicState_.depthBias, {depthBiasConstantFactor, depthBiasClamp, depthBiasSlopeFactor}) ||
+         elide(statistics_.elidedDynamicStates);
+}
+
+bool CommandStateCache::setBlendConstants(const float blendConstants[4]) {
+  statistics_.filteredCalls++;
+  return updateValue(dynamicState_.blendConstants,
+                     {blendConstants[0], blendConstants[1], blendConstants[2], blendConstants[3]}) ||
+         elide(statistics_.elidedDynamicStates);
+}
+
+bool CommandStateCache::setDepthBounds(float minDepthBounds, float maxDepthBounds) {
+  statistics_.filteredCalls++;
+  return updateValue(dynamicState_.depthBounds, {minDepthBounds, maxDepthBounds}) || elide(statistics_.elidedDynamicStates);
+}
+
+bool CommandStateCache::setStencilCompareMask(vk::StencilFaceFlags faceMask, uint32_t compareMask) {
+  return setStencilState(dynamicState_.stencilCompareMask, faceMask, compareMask);
+}
+
+bool CommandStateCache::setStencilWriteMask(vk::StencilFaceFlags faceMask, uint32_t writeMask) {
+  return setStencilState(dynamicState_.stencilWriteMask, faceMask, writeMask);
+}
+
+bool CommandStateCache::setStencilReference(vk::StencilFaceFlags faceMask, uint32_t reference) {
+  return setStencilState(dynamicState_.stencilReference, faceMask, reference);
+}
+
+void CommandStateCache::invalidateBindPoint(vk::PipelineBindPoint pipelineBindPoint) {
+  bindPoints_[getBindPointIndex(pipelineBindPoint)] = BindPointState();
+}
+
+void CommandStateCache::invalidate() {
+  for (BindPointState& state : bindPoints_) {
+    state = BindPointState();
+  }
+  vertexBuffers_.clear();
+  indexBuffer_.reset();
+  dynamicState_ = DynamicState();
+}
+
+const StateCacheStatistics& CommandStateCache::getStatistics() const {
+  return statistics_;
+}
+
+size_t CommandStateCache::getBindPointIndex(vk::PipelineBindPoint pipelineBindPoint) {
+  switch (pipelineBindPoint) {
+    case vk::PipelineBindPoint::eGraphics:
+      return 0u;
+    case vk::PipelineBindPoint::eCompute:
+      return 1u;
+    default:
+      return 2u;
+  }
+}
+
+bool CommandStateCache::setStencilState(std::array<std::optional<uint32_t>, 2>& state, vk::StencilFaceFlags faceMask,
+                                        uint32_t value) {
+  statistics_.filteredCalls++;
+  bool front = static_cast<bool>(faceMask & vk::StencilFaceFlagBits::eFront);
+  bool back = static_cast<bool>(faceMask & vk::StencilFaceFlagBits::eBack);
+
+  if ((!front || state[0] == value) && (!back || state[1] == value)) {
+    return elide(statistics_.elidedDynamicStates);
+  }
+
+  if (front) {
+    state[0] = value;
+  }
+  if (back) {
+    state[1] = value;
+  }
+
+  return true;
+}
+
+bool CommandStateCache::elide(uint64_t& counter) {
+  statistics_.elidedCalls++;
+  counter++;
+  return false;
+}
+
+} // namespace logi
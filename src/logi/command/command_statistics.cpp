@@ -0,0 +1,70 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/command/command_statistics.hpp"
+
+namespace logi {
+
+CommandStatistics& CommandStatistics::operator+=(const CommandStatistics& other) {
+  commandBuffers += other.commandBuffers;
+  draws += other.draws;
+  dispatches += other.dispatches;
+  barrierCommands += other.barrierCommands;
+  barriers += other.barriers;
+  descriptorSetBinds += other.descriptorSetBinds;
+  pipelineBinds += other.pipelineBinds;
+  copies += other.copies;
+  copyBytes += other.copyBytes;
+  return *this;
+}
+
+CommandStatistics operator+(CommandStatistics lhs, const CommandStatistics& rhs) {
+  lhs += rhs;
+  return lhs;
+}
+
+void CommandStatisticsRegistry::add(const vk::CommandBuffer& commandBuffer, const CommandStatistics& statistics) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  statistics_[static_cast<VkCommandBuffer>(commandBuffer)] = &statistics;
+}
+
+void CommandStatisticsRegistry::remove(const vk::CommandBuffer& commandBuffer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  statistics_.erase(static_cast<VkCommandBuffer>(commandBuffer));
+}
+
+void CommandStatisticsRegistry::accumulate(const vk::ArrayProxy<const vk::CommandBuffer>& commandBuffers,
+                                           CommandStatistics& statistics) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  for (const vk::CommandBuffer& commandBuffer : commandBuffers) {
+    auto it = statistics_.find(static_cast<VkCommandBuffer>(commandBuffer));
+    if (it != statistics_.end()) {
+      statistics += *it->second;
+    }
+  }
+}
+
+void CommandStatisticsRegistry::accumulate(const vk::ArrayProxy<const vk::SubmitInfo>& submits,
+                                           CommandStatistics& statistics) const {
+  for (const vk::SubmitInfo& submit : submits) {
+    accumulate(vk::ArrayProxy<const vk::CommandBuffer>(submit.commandBufferCount, submit.pCommandBuffers), statistics);
+  }
+}
+
+} // namespace logi
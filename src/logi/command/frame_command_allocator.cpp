@@ -0,0 +1,154 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/command/frame_command_allocator.hpp"
+#include <limits>
+#include <utility>
+#include "logi/base/exception.hpp"
+#include "logi/device/logical_device.hpp"
+#include "logi/queue/queue_family.hpp"
+
+namespace logi {
+
+FrameCommandAllocator::FrameCommandAllocator(const QueueFamily& queueFamily, uint32_t framesInFlight,
+                                             const vk::CommandPoolCreateFlags& flags)
+  : frames_(framesInFlight), frameIndex_(framesInFlight - 1u) {
+  if (framesInFlight == 0u) {
+    throw IllegalInvocation("FrameCommandAllocator requires at least one frame in flight.");
+  }
+
+  for (Frame& frame : frames_) {
+    frame.commandPool = queueFamily.createCommandPool(flags);
+  }
+}
+
+FrameCommandAllocator::FrameCommandAllocator(std::vector<CommandPool> commandPools)
+  : frames_(commandPools.size()), frameIndex_(static_cast<uint32_t>(commandPools.size()) - 1u) {
+  if (commandPools.empty()) {
+    throw IllegalInvocation("FrameCommandAllocator requires at least one frame in flight.");
+  }
+
+  for (size_t i = 0u; i < frames_.size(); i++) {
+    frames_[i].commandPool = std::move(commandPools[i]);
+  }
+}
+
+uint32_t FrameCommandAllocator::beginFrame() {
+  if (frames_.empty()) {
+    return 0u;
+  }
+
+  frameIndex_ = (frameIndex_ + 1u) % static_cast<uint32_t>(frames_.size());
+  Frame& frame = frames_[frameIndex_];
+
+  waitRetired(frame);
+
+  // Recycle all command buffers of the frame at once.
+  if (frame.usedCommandBuffers[0] > 0u || frame.usedCommandBuffers[1] > 0u) {
+    frame.commandPool.reset();
+    frame.usedCommandBuffers = {};
+  }
+
+  return frameIndex_;
+}
+
+CommandBuffer FrameCommandAllocator::allocateCommandBuffer(vk::CommandBufferLevel level) {
+  if (frames_.empty()) {
+    throw IllegalInvocation("FrameCommandAllocator has no frames.");
+  }
+
+  Frame& frame = frames_[frameIndex_];
+  auto levelIndex = static_cast<size_t>(level);
+  std::vector<CommandBuffer>& commandBuffers = frame.commandBuffers[levelIndex];
+  size_t& used = frame.usedCommandBuffers[levelIndex];
+
+  // Pool only grows until it reaches the steady state of the frame.
+  if (used == commandBuffers.size()) {
+    commandBuffers.emplace_back(frame.commandPool.allocateCommandBuffer(level));
+  }
+
+  return commandBuffers[used++];
+}
+
+void FrameCommandAllocator::endFrame(const Fence& fence) {
+  if (frames_.empty()) {
+    return;
+  }
+
+  Frame& frame = frames_[frameIndex_];
+  frame.fence = fence;
+  frame.timelineSemaphore = Semaphore();
+}
+
+void FrameCommandAllocator::endFrame(const Semaphore& timelineSemaphore, uint64_t value) {
+  if (frames_.empty()) {
+    return;
+  }
+
+  Frame& frame = frames_[frameIndex_];
+  frame.fence = Fence();
+  frame.timelineSemaphore = timelineSemaphore;
+  frame.timelineValue = value;
+}
+
+uint32_t FrameCommandAllocator::getFrameIndex() const {
+  return frameIndex_;
+}
+
+uint32_t FrameCommandAllocator::getFramesInFlight() const {
+  return static_cast<uint32_t>(frames_.size());
+}
+
+const CommandPool& FrameCommandAllocator::getCommandPool(uint32_t frameIndex) const {
+  return frames_.at(frameIndex).commandPool;
+}
+
+size_t FrameCommandAllocator::getCommandBufferCount() const {
+  size_t count = 0u;
+  for (const Frame& frame : frames_) {
+    count += frame.commandBuffers[0].size() + frame.commandBuffers[1].size();
+  }
+
+  return count;
+}
+
+void FrameCommandAllocator::destroy() {
+  for (Frame& frame : frames_) {
+    if (frame.commandPool) {
+      frame.commandPool.destroy();
+    }
+  }
+
+  frames_.clear();
+  frameIndex_ = 0u;
+}
+
+void FrameCommandAllocator::waitRetired(Frame& frame) {
+  if (frame.fence) {
+    frame.fence.wait(std::numeric_limits<uint64_t>::max());
+  } else if (frame.timelineSemaphore) {
+    vk::SemaphoreWaitInfo waitInfo({}, 1u, &static_cast<const vk::Semaphore&>(frame.timelineSemaphore),
+                                   &frame.timelineValue);
+    frame.timelineSemaphore.getLogicalDevice().waitSemaphores(waitInfo, std::numeric_limits<uint64_t>::max());
+  }
+
+  frame.fence = Fence();
+  frame.timelineSemaphore = Semaphore();
+}
+
+} // namespace logi
@@ -0,0 +1,213 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/command/parallel_command_recorder.hpp"
+#include <algorithm>
+#include "logi/queue/queue_family.hpp"
+
+namespace logi {
+
+ParallelCommandRecorder::ParallelCommandRecorder(const QueueFamily& queueFamily, uint32_t threadCount,
+                                                 uint32_t framesInFlight)
+  : tasks_(std::max(threadCount, 1u)) {
+  allocators_.reserve(tasks_.size());
+  for (size_t i = 0u; i < tasks_.size(); i++) {
+    allocators_.emplace_back(queueFamily, framesInFlight);
+  }
+
+  // Calling thread records the first range.
+  workers_.reserve(tasks_.size() - 1u);
+  for (size_t i = 1u; i < tasks_.size(); i++) {
+    workers_.emplace_back(&ParallelCommandRecorder::work, this, i);
+  }
+}
+
+ParallelCommandRecorder::~ParallelCommandRecorder() {
+  stopWorkers();
+}
+
+uint32_t ParallelCommandRecorder::beginFrame() {
+  uint32_t frameIndex = 0u;
+  for (FrameCommandAllocator& allocator : allocators_) {
+    frameIndex = allocator.beginFrame();
+  }
+
+  return frameIndex;
+}
+
+void ParallelCommandRecorder::endFrame(const Fence& fence) {
+  for (FrameCommandAllocator& allocator : allocators_) {
+    allocator.endFrame(fence);
+  }
+}
+
+void ParallelCommandRecorder::endFrame(const Semaphore& timelineSemaphore, uint64_t value) {
+  for (FrameCommandAllocator& allocator : allocators_) {
+    allocator.endFrame(timelineSemaphore, value);
+  }
+}
+
+std::vector<CommandBuffer>
+  ParallelCommandRecorder::recordSecondary(const vk::CommandBufferInheritanceInfo& inheritanceInfo, size_t drawCount,
+                                           const RecordFunction& record) {
+  if (tasks_.empty()) {
+    return {};
+  }
+
+  size_t rangeSize = (drawCount + tasks_.size() - 1u) / tasks_.size();
+  for (size_t i = 0u; i < tasks_.size(); i++) {
+    Task& task = tasks_[i];
+    task.inheritanceInfo = inheritanceInfo;
+    task.record = &record;
+    task.begin = std::min(i * rangeSize, drawCount);
+    task.end = std::min(task.begin + rangeSize, drawCount);
+    task.commandBuffer = CommandBuffer();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    error_ = nullptr;
+    pendingTasks_ = workers_.size();
+    generation_++;
+  }
+  workAvailable_.notify_all();
+
+  std::exception_ptr error;
+  try {
+    execute(0u, tasks_[0]);
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    workDone_.wait(lock, [this]() { return pendingTasks_ == 0u; });
+    if (!error) {
+      error = error_;
+    }
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  std::vector<CommandBuffer> commandBuffers;
+  for (Task& task : tasks_) {
+    if (task.commandBuffer) {
+      commandBuffers.emplace_back(task.commandBuffer);
+    }
+    task.record = nullptr;
+  }
+
+  return commandBuffers;
+}
+
+void ParallelCommandRecorder::recordRenderPass(const CommandBuffer& primaryCommandBuffer,
+                                               const vk::RenderPassBeginInfo& renderPassBegin, size_t drawCount,
+                                               const RecordFunction& record) {
+  primaryCommandBuffer.beginRenderPass(renderPassBegin, vk::SubpassContents::eSecondaryCommandBuffers);
+
+  vk::CommandBufferInheritanceInfo inheritanceInfo(renderPassBegin.renderPass, 0u, renderPassBegin.framebuffer);
+  std::vector<CommandBuffer> secondaryCommandBuffers = recordSecondary(inheritanceInfo, drawCount, record);
+
+  if (!secondaryCommandBuffers.empty()) {
+    std::vector<vk::CommandBuffer> vkCommandBuffers;
+    vkCommandBuffers.reserve(secondaryCommandBuffers.size());
+    for (const CommandBuffer& commandBuffer : secondaryCommandBuffers) {
+      vkCommandBuffers.emplace_back(commandBuffer);
+    }
+
+    primaryCommandBuffer.executeCommands(vkCommandBuffers);
+  }
+
+  primaryCommandBuffer.endRenderPass();
+}
+
+uint32_t ParallelCommandRecorder::getThreadCount() const {
+  return static_cast<uint32_t>(tasks_.size());
+}
+
+void ParallelCommandRecorder::destroy() {
+  stopWorkers();
+
+  for (FrameCommandAllocator& allocator : allocators_) {
+    allocator.destroy();
+  }
+  allocators_.clear();
+  tasks_.clear();
+}
+
+void ParallelCommandRecorder::execute(size_t threadIndex, Task& task) {
+  if (task.begin == task.end) {
+    return;
+  }
+
+  task.commandBuffer = allocators_[threadIndex].allocateCommandBuffer(vk::CommandBufferLevel::eSecondary);
+  task.commandBuffer.begin(vk::CommandBufferBeginInfo(
+    vk::CommandBufferUsageFlagBits::eRenderPassContinue | vk::CommandBufferUsageFlagBits::eOneTimeSubmit,
+    &task.inheritanceInfo));
+  (*task.record)(task.commandBuffer, task.begin, task.end);
+  task.commandBuffer.end();
+}
+
+void ParallelCommandRecorder::work(size_t threadIndex) {
+  uint64_t generation = 0u;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      workAvailable_.wait(lock, [this, generation]() { return stopping_ || generation_ != generation; });
+      if (stopping_) {
+        return;
+      }
+      generation = generation_;
+    }
+
+    std::exception_ptr error;
+    try {
+      execute(threadIndex, tasks_[threadIndex]);
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (error && !error_) {
+        error_ = error;
+      }
+      if (--pendingTasks_ == 0u) {
+        workDone_.notify_one();
+      }
+    }
+  }
+}
+
+void ParallelCommandRecorder::stopWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  workAvailable_.notify_all();
+
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
+} // namespace logi
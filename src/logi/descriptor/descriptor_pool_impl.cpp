@@ -32,9 +32,12 @@ DescriptorPoolImpl::DescriptorPoolImpl(LogicalDeviceImpl& logicalDevice, const v
 
 // region Vulkan Declarations
 
-vk::ResultValueType<void>::type DescriptorPoolImpl::reset(const vk::DescriptorPoolResetFlags& flags) const {
+vk::ResultValueType<void>::type DescriptorPoolImpl::reset(const vk::DescriptorPoolResetFlags& flags) {
+  // Reset returns all descriptor sets to the pool at once.
+  VulkanObjectComposite<DescriptorSetImpl>::destroyAllObjects();
+
   auto vkDevice = static_cast<vk::Device>(logicalDevice_);
-  vkDevice.resetDescriptorPool(vkDescriptorPool_, flags, getDispatcher());
+  return vkDevice.resetDescriptorPool(vkDescriptorPool_, flags, getDispatcher());
 }
 
 std::vector<std::shared_ptr<DescriptorSetImpl>>
@@ -57,14 +60,19 @@ std::vector<std::shared_ptr<DescriptorSetImpl>>
 }
 
 vk::ResultValueType<void>::type DescriptorPoolImpl::freeDescriptorSets(const std::vector<size_t>& descriptorSetIds) {
+  std::vector<std::shared_ptr<DescriptorSetImpl>> descriptorSets =
+    VulkanObjectComposite<DescriptorSetImpl>::releaseObjects(descriptorSetIds);
   std::vector<vk::DescriptorSet> vkDescriptorSets;
-  vkDescriptorSets.reserve(descriptorSetIds.size());
+  vkDescriptorSets.reserve(descriptorSets.size());
+
+  // Collect VK handles and destroy logi descriptor sets.
+  for (const std::shared_ptr<DescriptorSetImpl>& descriptorSet : descriptorSets) {
+    vkDescriptorSets.emplace_back(static_cast<const vk::DescriptorSet&>(*descriptorSet));
+    VulkanObjectComposite<DescriptorSetImpl>::freeObject(*descriptorSet);
+  }
 
-  // Collect VK handles and destroy logi command buffers.
-  for (size_t id : descriptorSetIds) {
-    vkDescriptorSets.emplace_back(
-      static_cast<const vk::DescriptorSet&>(*VulkanObjectComposite<DescriptorSetImpl>::getObject(id).get()));
-    VulkanObjectComposite<DescriptorSetImpl>::destroyObject(id);
+  if (vkDescriptorSets.empty()) {
+    return vk::createResultValue(vk::Result::eSuccess, "logi::DescriptorPoolImpl::freeDescriptorSets");
   }
 
   auto vkDevice = static_cast<vk::Device>(logicalDevice_);
@@ -81,7 +81,22 @@ Buffer LogicalDevice::createBuffer(const vk::BufferCreateInfo& createInfo,
 }
 
 void LogicalDevice::destroyBuffer(const Buffer& buffer) const {
-  object_->destroyBuffer(buffer.id());
+  // Identifiers are unique only within a composite, e.g. a VMABuffer may share the identifier of a device buffer.
+  object_->destroyBuffer(buffer.id(), buffer);
+}
+
+void LogicalDevice::destroyBuffers(const std::vector<Buffer>& buffers) const {
+  std::vector<size_t> ids;
+  std::vector<vk::Buffer> vkBuffers;
+  ids.reserve(buffers.size());
+  vkBuffers.reserve(buffers.size());
+
+  for (const auto& buffer : buffers) {
+    ids.emplace_back(buffer.id());
+    vkBuffers.emplace_back(static_cast<const vk::Buffer&>(buffer));
+  }
+
+  object_->destroyBuffers(ids, vkBuffers);
 }
 
 Image LogicalDevice::createImage(const vk::ImageCreateInfo& createInfo,
@@ -90,7 +105,22 @@ Image LogicalDevice::createImage(const vk::ImageCreateInfo& createInfo,
 }
 
 void LogicalDevice::destroyImage(const Image& image) const {
-  object_->destroyImage(image.id());
+  // Identifiers are unique only within a composite, e.g. a VMAImage may share the identifier of a device image.
+  object_->destroyImage(image.id(), image);
+}
+
+void LogicalDevice::destroyImages(const std::vector<Image>& images) const {
+  std::vector<size_t> ids;
+  std::vector<vk::Image> vkImages;
+  ids.reserve(images.size());
+  vkImages.reserve(images.size());
+
+  for (const auto& image : images) {
+    ids.emplace_back(image.id());
+    vkImages.emplace_back(static_cast<const vk::Image&>(image));
+  }
+
+  object_->destroyImages(ids, vkImages);
 }
 
 Sampler LogicalDevice::createSampler(const vk::SamplerCreateInfo& createInfo,
@@ -277,8 +307,8 @@ void LogicalDevice::destroySemaphore(const Semaphore& semaphore) const {
   object_->destroySemaphore(semaphore.id());
 }
 
-void LogicalDevice::waitSemaphores(const vk::SemaphoreWaitInfo& waitInfo, uint64_t timeout) const {
-  object_->waitSemaphores(waitInfo, timeout);
+vk::Result LogicalDevice::waitSemaphores(const vk::SemaphoreWaitInfo& waitInfo, uint64_t timeout) const {
+  return object_->waitSemaphores(waitInfo, timeout);
 }
 
 DeferredOperationKHR 
@@ -516,6 +546,30 @@ const vk::DispatchLoaderDynamic& LogicalDevice::getDispatcher() const {
   return object_->getDispatcher();
 }
 
+size_t LogicalDevice::collectDeferredDestructions(uint64_t completedValue) const {
+  return object_->collectDeferredDestructions(completedValue);
+}
+
+size_t LogicalDevice::collectDeferredDestructions(const Semaphore& timeline) const {
+  return object_->collectDeferredDestructions(timeline.getCounterValue());
+}
+
+size_t LogicalDevice::flushDeferredDestructions() const {
+  return object_->flushDeferredDestructions();
+}
+
+size_t LogicalDevice::pendingDeferredDestructions() const {
+  return object_->pendingDeferredDestructions();
+}
+
+ObjectStatistics LogicalDevice::getObjectStatistics() const {
+  return object_->getObjectStatistics();
+}
+
+TraceRecorder& LogicalDevice::getTraceRecorder() const {
+  return object_->getTraceRecorder();
+}
+
 void LogicalDevice::destroy() const {
   if (object_) {
     object_->destroy();
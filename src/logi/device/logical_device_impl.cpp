@@ -17,19 +17,27 @@
  */
 
 #include "logi/device/logical_device_impl.hpp"
+#include "logi/base/result.hpp"
+#include "logi/command/command_buffer_impl.hpp"
 #include "logi/command/command_pool_impl.hpp"
 #include "logi/descriptor/descriptor_pool_impl.hpp"
+#include "logi/descriptor/descriptor_set_impl.hpp"
 #include "logi/descriptor/descriptor_update_template_impl.hpp"
 #include "logi/device/physical_device_impl.hpp"
 #include "logi/instance/vulkan_instance_impl.hpp"
 #include "logi/memory/acceleration_structure_nv_impl.hpp"
 #include "logi/memory/acceleration_structure_khr_impl.hpp"
 #include "logi/memory/buffer_impl.hpp"
+#include "logi/memory/buffer_view_impl.hpp"
 #include "logi/memory/device_memory_impl.hpp"
 #include "logi/memory/image_impl.hpp"
+#include "logi/memory/image_view_impl.hpp"
 #include "logi/memory/memory_allocator_impl.hpp"
 #include "logi/memory/sampler_impl.hpp"
 #include "logi/memory/sampler_ycbcr_conversion_impl.hpp"
+#include "logi/memory/vma_acceleration_structure_nv_impl.hpp"
+#include "logi/memory/vma_buffer_impl.hpp"
+#include "logi/memory/vma_image_impl.hpp"
 #include "logi/nvidia/indirect_commands_layout_nv_impl.hpp"
 // #include "logi/nvidia/object_table_nvx_impl.hpp"
 #include "logi/program/descriptor_set_layout_impl.hpp"
@@ -40,8 +48,10 @@
 #include "logi/program/validation_cache_ext_impl.hpp"
 #include "logi/query/query_pool_impl.hpp"
 #include "logi/queue/queue_family_impl.hpp"
+#include "logi/queue/queue_impl.hpp"
 #include "logi/render_pass/framebuffer_impl.hpp"
 #include "logi/render_pass/render_pass_impl.hpp"
+#include "logi/swapchain/swapchain_image_impl.hpp"
 #include "logi/swapchain/swapchain_khr_impl.hpp"
 #include "logi/synchronization/event_impl.hpp"
 #include "logi/synchronization/fence_impl.hpp"
@@ -50,6 +60,30 @@
 
 namespace logi {
 
+#ifdef LOGI_ENABLE_OBJECT_STATISTICS
+namespace {
+
+ObjectTypeStatistics& typeStatistics(ObjectStatistics& statistics, const char* typeName) {
+  for (ObjectTypeStatistics& type : statistics.types) {
+    if (type.typeName == typeName) {
+      return type;
+    }
+  }
+
+  statistics.types.emplace_back();
+  statistics.types.back().typeName = typeName;
+  return statistics.types.back();
+}
+
+template <typename T>
+void accumulateStatistics(ObjectStatistics& statistics, const char* typeName,
+                          const VulkanObjectComposite<T>& composite) {
+  composite.getObjectCounters().accumulate(typeStatistics(statistics, typeName));
+}
+
+} // namespace
+#endif
+
 LogicalDeviceImpl::LogicalDeviceImpl(PhysicalDeviceImpl& physicalDevice, const vk::DeviceCreateInfo& createInfo,
                                      const std::optional<vk::AllocationCallbacks>& allocator)
   : physicalDevice_(physicalDevice), allocator_(allocator) {
@@ -62,6 +96,7 @@ LogicalDeviceImpl::LogicalDeviceImpl(PhysicalDeviceImpl& physicalDevice, const v
   // Initialize device dispatcher.
   dispatcher_ = vk::DispatchLoaderDynamic(static_cast<VkInstance>(vkInstance), instanceDispatcher.vkGetInstanceProcAddr,
                                           static_cast<VkDevice>(vkDevice_), instanceDispatcher.vkGetDeviceProcAddr);
+  commandDispatchTable_ = CommandDispatchTable(dispatcher_);
 
   // Initialize queue families.
   for (uint32_t i = 0u; i < createInfo.queueCreateInfoCount; i++) {
@@ -101,6 +136,17 @@ void LogicalDeviceImpl::destroyBuffer(size_t id) {
   VulkanObjectComposite<BufferImpl>::destroyObject(id);
 }
 
+void LogicalDeviceImpl::destroyBuffer(size_t id, const vk::Buffer& vkBuffer) {
+  VulkanObjectComposite<BufferImpl>::destroyObjectIf(
+    id, [&vkBuffer](const BufferImpl& buffer) { return static_cast<const vk::Buffer&>(buffer) == vkBuffer; });
+}
+
+void LogicalDeviceImpl::destroyBuffers(const std::vector<size_t>& ids, const std::vector<vk::Buffer>& vkBuffers) {
+  VulkanObjectComposite<BufferImpl>::destroyObjectsIf(ids, [&vkBuffers](size_t i, const BufferImpl& buffer) {
+    return static_cast<const vk::Buffer&>(buffer) == vkBuffers[i];
+  });
+}
+
 const std::shared_ptr<ImageImpl>&
   LogicalDeviceImpl::createImage(const vk::ImageCreateInfo& createInfo,
                                  const std::optional<vk::AllocationCallbacks>& allocator) {
@@ -111,6 +157,17 @@ void LogicalDeviceImpl::destroyImage(size_t id) {
   VulkanObjectComposite<ImageImpl>::destroyObject(id);
 }
 
+void LogicalDeviceImpl::destroyImage(size_t id, const vk::Image& vkImage) {
+  VulkanObjectComposite<ImageImpl>::destroyObjectIf(
+    id, [&vkImage](const ImageImpl& image) { return static_cast<const vk::Image&>(image) == vkImage; });
+}
+
+void LogicalDeviceImpl::destroyImages(const std::vector<size_t>& ids, const std::vector<vk::Image>& vkImages) {
+  VulkanObjectComposite<ImageImpl>::destroyObjectsIf(ids, [&vkImages](size_t i, const ImageImpl& image) {
+    return static_cast<const vk::Image&>(image) == vkImages[i];
+  });
+}
+
 const std::shared_ptr<SamplerImpl>&
   LogicalDeviceImpl::createSampler(const vk::SamplerCreateInfo& createInfo,
                                    const std::optional<vk::AllocationCallbacks>& allocator) {
@@ -365,8 +422,12 @@ void LogicalDeviceImpl::destroySemaphore(size_t id) {
   VulkanObjectComposite<SemaphoreImpl>::destroyObject(id);
 }
 
-void LogicalDeviceImpl::waitSemaphores(const vk::SemaphoreWaitInfo& waitInfo, uint64_t timeout) const {
-  vkDevice_.waitSemaphores(waitInfo, timeout, getDispatcher());
+vk::Result LogicalDeviceImpl::waitSemaphores(const vk::SemaphoreWaitInfo& waitInfo, uint64_t timeout) const {
+#ifdef LOGI_ENABLE_TRACE
+  TraceScope traceScope(traceRecorder_, "vkWaitSemaphores", "wait");
+#endif
+  vk::Result result = vkDevice_.waitSemaphores(&waitInfo, timeout, getDispatcher());
+  return checkResult(result, "logi::LogicalDeviceImpl::waitSemaphores", {vk::Result::eSuccess, vk::Result::eTimeout});
 }
 
 const std::shared_ptr<DeferredOperationKHRImpl>&
@@ -499,17 +560,7 @@ void LogicalDeviceImpl::destroyIndirectCommandsLayoutNV(size_t id) {
 // }
 
 std::vector<std::shared_ptr<QueueFamilyImpl>> LogicalDeviceImpl::enumerateQueueFamilies() const {
-  std::unordered_map<size_t, std::shared_ptr<QueueFamilyImpl>> familiesMap =
-    VulkanObjectComposite<QueueFamilyImpl>::getHandles();
-
-  std::vector<std::shared_ptr<QueueFamilyImpl>> queueFamilies;
-  queueFamilies.reserve(familiesMap.size());
-
-  for (const auto& entry : familiesMap) {
-    queueFamilies.emplace_back(entry.second);
-  }
-
-  return queueFamilies;
+  return VulkanObjectComposite<QueueFamilyImpl>::getHandles();
 }
 
 void LogicalDeviceImpl::updateDescriptorSets(
@@ -622,6 +673,10 @@ const vk::DispatchLoaderDynamic& LogicalDeviceImpl::getDispatcher() const {
   return dispatcher_;
 }
 
+const CommandDispatchTable& LogicalDeviceImpl::getCommandDispatchTable() const {
+  return commandDispatchTable_;
+}
+
 void LogicalDeviceImpl::destroy() const {
   physicalDevice_.destroyLogicalDevice(id());
 }
@@ -630,7 +685,151 @@ LogicalDeviceImpl::operator const vk::Device&() const {
   return vkDevice_;
 }
 
+void LogicalDeviceImpl::deferDestruction(uint64_t retireValue, std::function<void()> destroy) const {
+  deferredDestructions_.enqueue(retireValue, std::move(destroy));
+}
+
+size_t LogicalDeviceImpl::collectDeferredDestructions(uint64_t completedValue) const {
+  return deferredDestructions_.collect(completedValue);
+}
+
+size_t LogicalDeviceImpl::flushDeferredDestructions() const {
+  return deferredDestructions_.flush();
+}
+
+size_t LogicalDeviceImpl::pendingDeferredDestructions() const {
+  return deferredDestructions_.size();
+}
+
+void LogicalDeviceImpl::registerTrackedCommandBuffer(const vk::CommandBuffer& vkCommandBuffer,
+                                                     const CommandBufferImpl& commandBuffer) const {
+  std::lock_guard<std::mutex> lock(trackedCommandBuffersMutex_);
+  trackedCommandBuffers_[static_cast<VkCommandBuffer>(vkCommandBuffer)] = &commandBuffer;
+  trackedCommandBufferCount_.store(trackedCommandBuffers_.size(), std::memory_order_release);
+}
+
+void LogicalDeviceImpl::unregisterTrackedCommandBuffer(const vk::CommandBuffer& vkCommandBuffer) const {
+  std::lock_guard<std::mutex> lock(trackedCommandBuffersMutex_);
+  trackedCommandBuffers_.erase(static_cast<VkCommandBuffer>(vkCommandBuffer));
+  trackedCommandBufferCount_.store(trackedCommandBuffers_.size(), std::memory_order_release);
+}
+
+const CommandBufferImpl*
+  LogicalDeviceImpl::findTrackedCommandBuffer(const vk::CommandBuffer& vkCommandBuffer) const {
+  std::lock_guard<std::mutex> lock(trackedCommandBuffersMutex_);
+  auto it = trackedCommandBuffers_.find(static_cast<VkCommandBuffer>(vkCommandBuffer));
+  return it != trackedCommandBuffers_.end() ? it->second : nullptr;
+}
+
+bool LogicalDeviceImpl::hasTrackedCommandBuffers() const {
+  return trackedCommandBufferCount_.load(std::memory_order_acquire) > 0u;
+}
+
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+void LogicalDeviceImpl::registerStatisticsCommandBuffer(const vk::CommandBuffer& vkCommandBuffer,
+                                                        const CommandStatistics& statistics) const {
+  commandStatistics_.add(vkCommandBuffer, statistics);
+}
+
+void LogicalDeviceImpl::unregisterStatisticsCommandBuffer(const vk::CommandBuffer& vkCommandBuffer) const {
+  commandStatistics_.remove(vkCommandBuffer);
+}
+
+void LogicalDeviceImpl::accumulateCommandStatistics(const vk::ArrayProxy<const vk::SubmitInfo>& submits,
+                                                    CommandStatistics& statistics) const {
+  commandStatistics_.accumulate(submits, statistics);
+}
+
+void LogicalDeviceImpl::accumulateCommandStatistics(const vk::ArrayProxy<const vk::CommandBuffer>& commandBuffers,
+                                                    CommandStatistics& statistics) const {
+  commandStatistics_.accumulate(commandBuffers, statistics);
+}
+#endif
+
+TraceRecorder& LogicalDeviceImpl::getTraceRecorder() const {
+  return traceRecorder_;
+}
+
+ObjectStatistics LogicalDeviceImpl::getObjectStatistics() const {
+  ObjectStatistics statistics;
+
+#ifdef LOGI_ENABLE_OBJECT_STATISTICS
+  accumulateStatistics<QueueFamilyImpl>(statistics, "QueueFamily", *this);
+  accumulateStatistics<BufferImpl>(statistics, "Buffer", *this);
+  accumulateStatistics<ImageImpl>(statistics, "Image", *this);
+  accumulateStatistics<MemoryAllocatorImpl>(statistics, "MemoryAllocator", *this);
+  accumulateStatistics<DeviceMemoryImpl>(statistics, "DeviceMemory", *this);
+  accumulateStatistics<SwapchainKHRImpl>(statistics, "SwapchainKHR", *this);
+  accumulateStatistics<SamplerImpl>(statistics, "Sampler", *this);
+  accumulateStatistics<SamplerYcbcrConversionImpl>(statistics, "SamplerYcbcrConversion", *this);
+  accumulateStatistics<QueryPoolImpl>(statistics, "QueryPool", *this);
+  accumulateStatistics<EventImpl>(statistics, "Event", *this);
+  accumulateStatistics<FenceImpl>(statistics, "Fence", *this);
+  accumulateStatistics<SemaphoreImpl>(statistics, "Semaphore", *this);
+  accumulateStatistics<DeferredOperationKHRImpl>(statistics, "DeferredOperationKHR", *this);
+  accumulateStatistics<ShaderModuleImpl>(statistics, "ShaderModule", *this);
+  accumulateStatistics<PipelineCacheImpl>(statistics, "PipelineCache", *this);
+  accumulateStatistics<DescriptorSetLayoutImpl>(statistics, "DescriptorSetLayout", *this);
+  accumulateStatistics<DescriptorPoolImpl>(statistics, "DescriptorPool", *this);
+  accumulateStatistics<DescriptorUpdateTemplateImpl>(statistics, "DescriptorUpdateTemplate", *this);
+  accumulateStatistics<PipelineLayoutImpl>(statistics, "PipelineLayout", *this);
+  accumulateStatistics<PipelineImpl>(statistics, "Pipeline", *this);
+  accumulateStatistics<RenderPassImpl>(statistics, "RenderPass", *this);
+  accumulateStatistics<FramebufferImpl>(statistics, "Framebuffer", *this);
+  accumulateStatistics<ValidationCacheEXTImpl>(statistics, "ValidationCacheEXT", *this);
+  accumulateStatistics<AccelerationStructureNVImpl>(statistics, "AccelerationStructureNV", *this);
+  accumulateStatistics<AccelerationStructureKHRImpl>(statistics, "AccelerationStructureKHR", *this);
+  accumulateStatistics<IndirectCommandsLayoutNVImpl>(statistics, "IndirectCommandsLayoutNV", *this);
+
+  // Objects owned by the device's children.
+  for (const auto& family : VulkanObjectComposite<QueueFamilyImpl>::getHandles()) {
+    accumulateStatistics<QueueImpl>(statistics, "Queue", *family);
+    accumulateStatistics<CommandPoolImpl>(statistics, "CommandPool", *family);
+
+    for (const auto& commandPool : family->VulkanObjectComposite<CommandPoolImpl>::getHandles()) {
+      accumulateStatistics<CommandBufferImpl>(statistics, "CommandBuffer", *commandPool);
+    }
+  }
+
+  for (const auto& descriptorPool : VulkanObjectComposite<DescriptorPoolImpl>::getHandles()) {
+    accumulateStatistics<DescriptorSetImpl>(statistics, "DescriptorSet", *descriptorPool);
+  }
+
+  for (const auto& buffer : VulkanObjectComposite<BufferImpl>::getHandles()) {
+    accumulateStatistics<BufferViewImpl>(statistics, "BufferView", *buffer);
+  }
+
+  for (const auto& image : VulkanObjectComposite<ImageImpl>::getHandles()) {
+    accumulateStatistics<ImageViewImpl>(statistics, "ImageView", *image);
+  }
+
+  for (const auto& memoryAllocator : VulkanObjectComposite<MemoryAllocatorImpl>::getHandles()) {
+    accumulateStatistics<VMABufferImpl>(statistics, "VMABuffer", *memoryAllocator);
+    accumulateStatistics<VMAImageImpl>(statistics, "VMAImage", *memoryAllocator);
+    accumulateStatistics<VMAAccelerationStructureNVImpl>(statistics, "VMAAccelerationStructureNV", *memoryAllocator);
+
+    for (const auto& buffer : memoryAllocator->VulkanObjectComposite<VMABufferImpl>::getHandles()) {
+      accumulateStatistics<BufferViewImpl>(statistics, "BufferView", *buffer);
+    }
+    for (const auto& image : memoryAllocator->VulkanObjectComposite<VMAImageImpl>::getHandles()) {
+      accumulateStatistics<ImageViewImpl>(statistics, "ImageView", *image);
+    }
+  }
+
+  for (const auto& swapchain : VulkanObjectComposite<SwapchainKHRImpl>::getHandles()) {
+    accumulateStatistics<SwapchainImageImpl>(statistics, "SwapchainImage", *swapchain);
+  }
+
+  std::lock_guard<std::mutex> lock(statisticsMutex_);
+  rateTracker_.update(statistics);
+#endif
+
+  return statistics;
+}
+
 void LogicalDeviceImpl::free() {
+  // Device destruction requires the device to be idle, hence all deferred destructions have retired.
+  deferredDestructions_.flush();
   VulkanObjectComposite<QueueFamilyImpl>::destroyAllObjects();
   VulkanObjectComposite<BufferImpl>::destroyAllObjects();
   VulkanObjectComposite<ImageImpl>::destroyAllObjects();
@@ -52,17 +52,7 @@ VulkanInstanceImpl::VulkanInstanceImpl(const vk::InstanceCreateInfo& createInfo,
 // region Sub-Handles
 
 std::vector<std::shared_ptr<PhysicalDeviceImpl>> VulkanInstanceImpl::enumeratePhysicalDevices() const {
-  const std::unordered_map<size_t, std::shared_ptr<PhysicalDeviceImpl>>& ownedDevices =
-    VulkanObjectComposite<PhysicalDeviceImpl>::getHandles();
-
-  std::vector<std::shared_ptr<PhysicalDeviceImpl>> devices;
-  devices.reserve(ownedDevices.size());
-
-  for (const auto& entry : ownedDevices) {
-    devices.emplace_back(entry.second);
-  }
-
-  return devices;
+  return VulkanObjectComposite<PhysicalDeviceImpl>::getHandles();
 }
 
 const std::shared_ptr<DebugReportCallbackEXTImpl>&
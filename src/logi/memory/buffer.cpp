@@ -86,6 +86,26 @@ LogicalDevice Buffer::getLogicalDevice() const {
   return LogicalDevice(object_->getLogicalDevice().shared_from_this());
 }
 
+HandleRef<VulkanInstance> Buffer::getInstanceRef() const {
+  return HandleRef<VulkanInstance>(object_->getInstance());
+}
+
+HandleRef<PhysicalDevice> Buffer::getPhysicalDeviceRef() const {
+  return HandleRef<PhysicalDevice>(object_->getPhysicalDevice());
+}
+
+HandleRef<LogicalDevice> Buffer::getLogicalDeviceRef() const {
+  return HandleRef<LogicalDevice>(object_->getLogicalDevice());
+}
+
+void Buffer::enableStateTracking(vk::DeviceSize size) const {
+  object_->enableStateTracking(size);
+}
+
+const std::shared_ptr<SharedBufferState>& Buffer::getTrackedState() const {
+  return object_->getTrackedState();
+}
+
 const vk::DispatchLoaderDynamic& Buffer::getDispatcher() const {
   return object_->getDispatcher();
 }
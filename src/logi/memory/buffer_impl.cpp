@@ -119,6 +119,14 @@ void BufferImpl::destroyBufferView(size_t id) {
   VulkanObjectComposite<BufferViewImpl>::destroyObject(id);
 }
 
+void BufferImpl::enableStateTracking(vk::DeviceSize size) {
+  trackedState_ = std::make_shared<SharedBufferState>(vkBuffer_, size, true);
+}
+
+const std::shared_ptr<SharedBufferState>& BufferImpl::getTrackedState() const {
+  return trackedState_;
+}
+
 VulkanInstanceImpl& BufferImpl::getInstance() const {
   return logicalDevice_.getInstance();
 }
@@ -41,6 +41,22 @@ Buffer BufferView::getBuffer() const {
   return Buffer(object_->getBuffer().shared_from_this());
 }
 
+HandleRef<VulkanInstance> BufferView::getInstanceRef() const {
+  return HandleRef<VulkanInstance>(object_->getInstance());
+}
+
+HandleRef<PhysicalDevice> BufferView::getPhysicalDeviceRef() const {
+  return HandleRef<PhysicalDevice>(object_->getPhysicalDevice());
+}
+
+HandleRef<LogicalDevice> BufferView::getLogicalDeviceRef() const {
+  return HandleRef<LogicalDevice>(object_->getLogicalDevice());
+}
+
+HandleRef<Buffer> BufferView::getBufferRef() const {
+  return HandleRef<Buffer>(object_->getBuffer());
+}
+
 const vk::DispatchLoaderDynamic& BufferView::getDispatcher() const {
   return object_->getDispatcher();
 }
@@ -17,6 +17,7 @@
  */
 
 #include "logi/memory/device_memory_impl.hpp"
+#include "logi/base/result.hpp"
 #include "logi/device/logical_device_impl.hpp"
 
 namespace logi {
@@ -38,7 +39,9 @@ vk::DeviceSize DeviceMemoryImpl::getCommitment() const {
 vk::ResultValueType<void*>::type DeviceMemoryImpl::mapMemory(vk::DeviceSize offset, vk::DeviceSize size,
                                                              const vk::MemoryMapFlags& flags) const {
   auto vkDevice = static_cast<vk::Device>(logicalDevice_);
-  return vkDevice.mapMemory(vkDeviceMemory_, offset, size, flags, getDispatcher());
+  void* mappedMemory = nullptr;
+  vk::Result result = vkDevice.mapMemory(vkDeviceMemory_, offset, size, flags, &mappedMemory, getDispatcher());
+  return checkResult(result, mappedMemory, "logi::DeviceMemoryImpl::mapMemory");
 }
 
 void DeviceMemoryImpl::unmapMemory() const {
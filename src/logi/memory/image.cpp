@@ -83,6 +83,27 @@ LogicalDevice Image::getLogicalDevice() const {
   return LogicalDevice(object_->getLogicalDevice().shared_from_this());
 }
 
+HandleRef<VulkanInstance> Image::getInstanceRef() const {
+  return HandleRef<VulkanInstance>(object_->getInstance());
+}
+
+HandleRef<PhysicalDevice> Image::getPhysicalDeviceRef() const {
+  return HandleRef<PhysicalDevice>(object_->getPhysicalDevice());
+}
+
+HandleRef<LogicalDevice> Image::getLogicalDeviceRef() const {
+  return HandleRef<LogicalDevice>(object_->getLogicalDevice());
+}
+
+void Image::enableStateTracking(const vk::ImageAspectFlags& aspectMask, uint32_t mipLevels, uint32_t arrayLayers,
+                                vk::ImageLayout currentLayout) const {
+  object_->enableStateTracking(aspectMask, mipLevels, arrayLayers, currentLayout);
+}
+
+const std::shared_ptr<SharedImageState>& Image::getTrackedState() const {
+  return object_->getTrackedState();
+}
+
 const vk::DispatchLoaderDynamic& Image::getDispatcher() const {
   return object_->getDispatcher();
 }
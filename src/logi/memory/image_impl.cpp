@@ -132,6 +132,15 @@ void ImageImpl::destroyImageView(size_t id) {
   VulkanObjectComposite<ImageViewImpl>::destroyObject(id);
 }
 
+void ImageImpl::enableStateTracking(const vk::ImageAspectFlags& aspectMask, uint32_t mipLevels, uint32_t arrayLayers,
+                                    vk::ImageLayout currentLayout) {
+  trackedState_ = std::make_shared<SharedImageState>(vkImage_, aspectMask, mipLevels, arrayLayers, currentLayout);
+}
+
+const std::shared_ptr<SharedImageState>& ImageImpl::getTrackedState() const {
+  return trackedState_;
+}
+
 VulkanInstanceImpl& ImageImpl::getInstance() const {
   return logicalDevice_.getInstance();
 }
@@ -46,6 +46,22 @@ Image ImageView::getImage() const {
   return Image(object_->getImage().shared_from_this());
 }
 
+HandleRef<VulkanInstance> ImageView::getInstanceRef() const {
+  return HandleRef<VulkanInstance>(object_->getInstance());
+}
+
+HandleRef<PhysicalDevice> ImageView::getPhysicalDeviceRef() const {
+  return HandleRef<PhysicalDevice>(object_->getPhysicalDevice());
+}
+
+HandleRef<LogicalDevice> ImageView::getLogicalDeviceRef() const {
+  return HandleRef<LogicalDevice>(object_->getLogicalDevice());
+}
+
+HandleRef<Image> ImageView::getImageRef() const {
+  return HandleRef<Image>(object_->getImage());
+}
+
 const vk::DispatchLoaderDynamic& ImageView::getDispatcher() const {
   return object_->getDispatcher();
 }
@@ -36,6 +36,17 @@ void MemoryAllocator::destroyBuffer(const VMABuffer& buffer) {
   object_->destroyBuffer(buffer.id());
 }
 
+void MemoryAllocator::destroyBuffers(const std::vector<VMABuffer>& buffers) {
+  std::vector<size_t> ids;
+  ids.reserve(buffers.size());
+
+  for (const auto& buffer : buffers) {
+    ids.emplace_back(buffer.id());
+  }
+
+  object_->destroyBuffers(ids);
+}
+
 VMAImage MemoryAllocator::createImage(const vk::ImageCreateInfo& imageCreateInfo,
                                       const VmaAllocationCreateInfo& allocationCreateInfo,
                                       const std::optional<vk::AllocationCallbacks>& allocator) {
@@ -46,6 +57,17 @@ void MemoryAllocator::destroyImage(const VMAImage& image) {
   object_->destroyImage(image.id());
 }
 
+void MemoryAllocator::destroyImages(const std::vector<VMAImage>& images) {
+  std::vector<size_t> ids;
+  ids.reserve(images.size());
+
+  for (const auto& image : images) {
+    ids.emplace_back(image.id());
+  }
+
+  object_->destroyImages(ids);
+}
+
 VMAAccelerationStructureNV MemoryAllocator::createAccelerationStructureNV(
   const vk::AccelerationStructureCreateInfoNV& accelerationStructureCreateInfo,
   const VmaAllocationCreateInfo& allocationCreateInfo, const std::optional<vk::AllocationCallbacks>& allocator) {
@@ -84,6 +84,22 @@ void MemoryAllocatorImpl::destroyBuffer(size_t id) {
   VulkanObjectComposite<VMABufferImpl>::destroyObject(id);
 }
 
+void MemoryAllocatorImpl::destroyBuffers(const std::vector<size_t>& ids) {
+  std::vector<std::shared_ptr<VMABufferImpl>> buffers = VulkanObjectComposite<VMABufferImpl>::releaseObjects(ids);
+  std::vector<VmaAllocation> allocations;
+  allocations.reserve(buffers.size());
+
+  // Destroy buffers first and then free all of their memory in a single call.
+  for (const std::shared_ptr<VMABufferImpl>& buffer : buffers) {
+    allocations.emplace_back(buffer->releaseAllocation());
+    VulkanObjectComposite<VMABufferImpl>::freeObject(*buffer);
+  }
+
+  if (!allocations.empty()) {
+    vmaFreeMemoryPages(vma_, allocations.size(), allocations.data());
+  }
+}
+
 const std::shared_ptr<VMAImageImpl>&
   MemoryAllocatorImpl::createImage(const vk::ImageCreateInfo& imageCreateInfo,
                                    const VmaAllocationCreateInfo& allocationCreateInfo,
@@ -95,6 +111,22 @@ void MemoryAllocatorImpl::destroyImage(size_t id) {
   VulkanObjectComposite<VMAImageImpl>::destroyObject(id);
 }
 
+void MemoryAllocatorImpl::destroyImages(const std::vector<size_t>& ids) {
+  std::vector<std::shared_ptr<VMAImageImpl>> images = VulkanObjectComposite<VMAImageImpl>::releaseObjects(ids);
+  std::vector<VmaAllocation> allocations;
+  allocations.reserve(images.size());
+
+  // Destroy images first and then free all of their memory in a single call.
+  for (const std::shared_ptr<VMAImageImpl>& image : images) {
+    allocations.emplace_back(image->releaseAllocation());
+    VulkanObjectComposite<VMAImageImpl>::freeObject(*image);
+  }
+
+  if (!allocations.empty()) {
+    vmaFreeMemoryPages(vma_, allocations.size(), allocations.data());
+  }
+}
+
 const std::shared_ptr<VMAAccelerationStructureNVImpl>& MemoryAllocatorImpl::createAccelerationStructureNV(
   const vk::AccelerationStructureCreateInfoNV& accelerationStructureCreateInfo,
   const VmaAllocationCreateInfo& allocationCreateInfo, const std::optional<vk::AllocationCallbacks>& allocator) {
@@ -32,7 +32,7 @@ VMAAccelerationStructureNV::VMAAccelerationStructureNV(const AccelerationStructu
   }
 }
 
-void* VMAAccelerationStructureNV::mapMemory() const {
+vk::ResultValueType<void*>::type VMAAccelerationStructureNV::mapMemory() const {
   return static_cast<VMAAccelerationStructureNVImpl*>(object_.get())->mapMemory();
 }
 
@@ -18,6 +18,7 @@
 
 #include "logi/memory/vma_acceleration_structure_nv_impl.hpp"
 #include <vk_mem_alloc.h>
+#include "logi/base/result.hpp"
 #include "logi/memory/memory_allocator_impl.hpp"
 
 namespace logi {
@@ -49,11 +50,12 @@ VMAAccelerationStructureNVImpl::VMAAccelerationStructureNVImpl(
   bindMemory(vk::DeviceMemory(allocationInfo_.deviceMemory), allocationInfo_.offset);
 }
 
-void* VMAAccelerationStructureNVImpl::mapMemory() const {
-  void* mappedMemory;
-  vmaMapMemory(static_cast<VmaAllocator>(memoryAllocator_), allocation_, &mappedMemory);
+vk::ResultValueType<void*>::type VMAAccelerationStructureNVImpl::mapMemory() const {
+  void* mappedMemory = nullptr;
+  auto result =
+    static_cast<vk::Result>(vmaMapMemory(static_cast<VmaAllocator>(memoryAllocator_), allocation_, &mappedMemory));
 
-  return mappedMemory;
+  return checkResult(result, mappedMemory, "logi::VMAAccelerationStructureNVImpl::mapMemory");
 }
 
 void VMAAccelerationStructureNVImpl::unmapMemory() const {
@@ -31,7 +31,7 @@ VMABuffer::VMABuffer(const Buffer& buffer) : Buffer(buffer) {
   }
 }
 
-void* VMABuffer::mapMemory() const {
+vk::ResultValueType<void*>::type VMABuffer::mapMemory() const {
   return static_cast<VMABufferImpl*>(object_.get())->mapMemory();
 }
 
@@ -39,12 +39,16 @@ void VMABuffer::unmapMemory() const {
   static_cast<VMABufferImpl*>(object_.get())->unmapMemory();
 }
 
+void VMABuffer::invalidate(vk::DeviceSize offset, vk::DeviceSize size) const {
+  static_cast<VMABufferImpl*>(object_.get())->invalidate(offset, size);
+}
+
 size_t VMABuffer::size() const {
   return static_cast<VMABufferImpl*>(object_.get())->size();
 }
 
-void VMABuffer::writeToBuffer(const void* data, size_t size, size_t offset) const {
-  static_cast<VMABufferImpl*>(object_.get())->writeToBuffer(data, size, offset);
+vk::ResultValueType<void>::type VMABuffer::writeToBuffer(const void* data, size_t size, size_t offset) const {
+  return static_cast<VMABufferImpl*>(object_.get())->writeToBuffer(data, size, offset);
 }
 
 bool VMABuffer::isMappable() const {
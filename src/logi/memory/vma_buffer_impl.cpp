@@ -17,6 +17,7 @@
  */
 #include "logi/memory/vma_buffer_impl.hpp"
 #include <vk_mem_alloc.h>
+#include "logi/base/result.hpp"
 #include "logi/memory/memory_allocator_impl.hpp"
 
 namespace logi {
@@ -47,25 +48,37 @@ VMABufferImpl::VMABufferImpl(MemoryAllocatorImpl& memoryAllocator, const vk::Buf
   size_ = bufferCreateInfo.size;
 }
 
-void* VMABufferImpl::mapMemory() const {
-  void* mappedMemory;
-  vmaMapMemory(static_cast<VmaAllocator>(memoryAllocator_), allocation_, &mappedMemory);
+vk::ResultValueType<void*>::type VMABufferImpl::mapMemory() const {
+  void* mappedMemory = nullptr;
+  auto result =
+    static_cast<vk::Result>(vmaMapMemory(static_cast<VmaAllocator>(memoryAllocator_), allocation_, &mappedMemory));
 
-  return mappedMemory;
+  return checkResult(result, mappedMemory, "logi::VMABufferImpl::mapMemory");
 }
 
 void VMABufferImpl::unmapMemory() const {
   vmaUnmapMemory(static_cast<VmaAllocator>(memoryAllocator_), allocation_);
 }
 
+void VMABufferImpl::invalidate(vk::DeviceSize offset, vk::DeviceSize size) const {
+  vmaInvalidateAllocation(static_cast<VmaAllocator>(memoryAllocator_), allocation_, offset, size);
+}
+
 size_t VMABufferImpl::size() const {
   return size_;
 }
 
-void VMABufferImpl::writeToBuffer(const void* data, size_t size, size_t offset) const {
-  std::byte* mappedMemory = reinterpret_cast<std::byte*>(mapMemory()) + offset;
-  std::memcpy(mappedMemory, data, size);
-  unmapMemory();
+vk::ResultValueType<void>::type VMABufferImpl::writeToBuffer(const void* data, size_t size, size_t offset) const {
+  void* mappedMemory = nullptr;
+  auto result =
+    static_cast<vk::Result>(vmaMapMemory(static_cast<VmaAllocator>(memoryAllocator_), allocation_, &mappedMemory));
+
+  if (result == vk::Result::eSuccess) {
+    std::memcpy(static_cast<std::byte*>(mappedMemory) + offset, data, size);
+    unmapMemory();
+  }
+
+  return checkResult(result, "logi::VMABufferImpl::writeToBuffer");
 }
 
 bool VMABufferImpl::isMappable() const {
@@ -84,10 +97,18 @@ void VMABufferImpl::destroy() const {
   memoryAllocator_.destroyBuffer(id());
 }
 
+VmaAllocation VMABufferImpl::releaseAllocation() {
+  VmaAllocation allocation = allocation_;
+  allocation_ = VK_NULL_HANDLE;
+  return allocation;
+}
+
 void VMABufferImpl::free() {
   BufferImpl::free();
-  // Free memory.
-  vmaFreeMemory(static_cast<VmaAllocator>(memoryAllocator_), allocation_);
+  // Free memory unless it was released for bulk destruction.
+  if (allocation_ != VK_NULL_HANDLE) {
+    vmaFreeMemory(static_cast<VmaAllocator>(memoryAllocator_), allocation_);
+  }
 }
 
 }
\ No newline at end of file
@@ -31,7 +31,7 @@ VMAImage::VMAImage(const Image& image) : Image(image) {
   }
 }
 
-void* VMAImage::mapMemory() const {
+vk::ResultValueType<void*>::type VMAImage::mapMemory() const {
   return static_cast<VMAImageImpl*>(object_.get())->mapMemory();
 }
 
@@ -43,8 +43,8 @@ size_t VMAImage::size() const {
   return static_cast<VMAImageImpl*>(object_.get())->size();
 }
 
-void VMAImage::writeToImage(const void* data, size_t size, size_t offset) const {
-  static_cast<VMAImageImpl*>(object_.get())->writeToImage(data, size, offset);
+vk::ResultValueType<void>::type VMAImage::writeToImage(const void* data, size_t size, size_t offset) const {
+  return static_cast<VMAImageImpl*>(object_.get())->writeToImage(data, size, offset);
 }
 
 bool VMAImage::isMappable() const {
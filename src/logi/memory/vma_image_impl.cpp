@@ -17,6 +17,7 @@
  */
 
 #include "logi/memory/vma_image_impl.hpp"
+#include "logi/base/result.hpp"
 #include "logi/memory/memory_allocator_impl.hpp"
 
 namespace logi {
@@ -45,11 +46,12 @@ VMAImageImpl::VMAImageImpl(MemoryAllocatorImpl& memoryAllocator, const vk::Image
   }
 }
 
-void* VMAImageImpl::mapMemory() const {
-  void* mappedMemory;
-  vmaMapMemory(static_cast<VmaAllocator>(memoryAllocator_), allocation_, &mappedMemory);
+vk::ResultValueType<void*>::type VMAImageImpl::mapMemory() const {
+  void* mappedMemory = nullptr;
+  auto result =
+    static_cast<vk::Result>(vmaMapMemory(static_cast<VmaAllocator>(memoryAllocator_), allocation_, &mappedMemory));
 
-  return mappedMemory;
+  return checkResult(result, mappedMemory, "logi::VMAImageImpl::mapMemory");
 }
 
 void VMAImageImpl::unmapMemory() const {
@@ -60,10 +62,17 @@ size_t VMAImageImpl::size() const {
   return allocationInfo_.size;
 }
 
-void VMAImageImpl::writeToImage(const void* data, size_t size, size_t offset) const {
-  std::byte* mappedMemory = reinterpret_cast<std::byte*>(mapMemory()) + offset;
-  std::memcpy(mappedMemory, data, size);
-  unmapMemory();
+vk::ResultValueType<void>::type VMAImageImpl::writeToImage(const void* data, size_t size, size_t offset) const {
+  void* mappedMemory = nullptr;
+  auto result =
+    static_cast<vk::Result>(vmaMapMemory(static_cast<VmaAllocator>(memoryAllocator_), allocation_, &mappedMemory));
+
+  if (result == vk::Result::eSuccess) {
+    std::memcpy(static_cast<std::byte*>(mappedMemory) + offset, data, size);
+    unmapMemory();
+  }
+
+  return checkResult(result, "logi::VMAImageImpl::writeToImage");
 }
 
 bool VMAImageImpl::isMappable() const {
@@ -82,10 +91,18 @@ void VMAImageImpl::destroy() const {
   memoryAllocator_.destroyImage(id());
 }
 
+VmaAllocation VMAImageImpl::releaseAllocation() {
+  VmaAllocation allocation = allocation_;
+  allocation_ = VK_NULL_HANDLE;
+  return allocation;
+}
+
 void VMAImageImpl::free() {
   ImageImpl::free();
-  // Free memory.
-  vmaFreeMemory(static_cast<VmaAllocator>(memoryAllocator_), allocation_);
+  // Free memory unless it was released for bulk destruction.
+  if (allocation_ != VK_NULL_HANDLE) {
+    vmaFreeMemory(static_cast<VmaAllocator>(memoryAllocator_), allocation_);
+  }
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,159 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/program/push_constant_block.hpp"
+#include <algorithm>
+
+namespace logi {
+
+// region PushConstantBlock
+
+PushConstantMember::PushConstantMember(std::string name, uint32_t offset, uint32_t size)
+  : name(std::move(name)), offset(offset), size(size) {}
+
+PushConstantBlock::PushConstantBlock(std::vector<PushConstantMember> members,
+                                     const std::vector<vk::PushConstantRange>& ranges)
+  : members_(std::move(members)), ranges_(ranges) {
+  for (uint32_t i = 0u; i < members_.size(); i++) {
+    memberIndices_.emplace(members_[i].name, i);
+  }
+
+  // Split the block at every range boundary.
+  std::vector<uint32_t> boundaries;
+  for (const vk::PushConstantRange& range : ranges_) {
+    boundaries.emplace_back(range.offset);
+    boundaries.emplace_back(range.offset + range.size);
+    size_ = std::max(size_, range.offset + range.size);
+  }
+  std::sort(boundaries.begin(), boundaries.end());
+  boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+  for (size_t i = 1u; i < boundaries.size(); i++) {
+    vk::ShaderStageFlags stages;
+    for (const vk::PushConstantRange& range : ranges_) {
+      if (range.offset <= boundaries[i - 1u] && range.offset + range.size >= boundaries[i]) {
+        stages |= range.stageFlags;
+      }
+    }
+
+    // Bytes that are not used by any stage may not be pushed.
+    if (!stages) {
+      continue;
+    }
+
+    // Merge with the previous segment if it is adjacent and used by the same stages.
+    if (!segments_.empty() && segments_.back().stageFlags == stages &&
+        segments_.back().offset + segments_.back().size == boundaries[i - 1u]) {
+      segments_.back().size += boundaries[i] - boundaries[i - 1u];
+    } else {
+      segments_.emplace_back(stages, boundaries[i - 1u], boundaries[i] - boundaries[i - 1u]);
+    }
+  }
+}
+
+uint32_t PushConstantBlock::getMemberIndex(const std::string& name) const {
+  auto it = memberIndices_.find(name);
+  if (it == memberIndices_.end()) {
+    throw IllegalInvocation("Push constant block has no member \"" + name + "\".");
+  }
+
+  return it->second;
+}
+
+const PushConstantMember& PushConstantBlock::getMember(uint32_t index) const {
+  return members_.at(index);
+}
+
+const std::vector<PushConstantMember>& PushConstantBlock::getMembers() const {
+  return members_;
+}
+
+const std::vector<vk::PushConstantRange>& PushConstantBlock::getRanges() const {
+  return ranges_;
+}
+
+const std::vector<vk::PushConstantRange>& PushConstantBlock::getSegments() const {
+  return segments_;
+}
+
+uint32_t PushConstantBlock::getSize() const {
+  return size_;
+}
+
+// endregion
+
+// region PushConstantData
+
+PushConstantData::PushConstantData(const PushConstantBlock& block) : block_(&block), data_(block.getSize(), 0u) {}
+
+void PushConstantData::write(uint32_t offset, uint32_t size, const void* data) {
+  if (offset + size > data_.size()) {
+    throw IllegalInvocation("Write is out of push constant block bounds.");
+  }
+
+  std::memcpy(data_.data() + offset, data, size);
+  if (size == 0u) {
+    return;
+  }
+
+  // vkCmdPushConstants requires offset and size to be multiples of 4, so the range is widened to whole words.
+  uint32_t begin = offset & ~3u;
+  uint32_t end = std::min((offset + size + 3u) & ~3u, static_cast<uint32_t>(data_.size()));
+
+  if (dirtyBegin_ == dirtyEnd_) {
+    dirtyBegin_ = begin;
+    dirtyEnd_ = end;
+  } else {
+    dirtyBegin_ = std::min(dirtyBegin_, begin);
+    dirtyEnd_ = std::max(dirtyEnd_, end);
+  }
+}
+
+void PushConstantData::markDirty() {
+  dirtyBegin_ = 0u;
+  dirtyEnd_ = static_cast<uint32_t>(data_.size());
+}
+
+void PushConstantData::clearDirty() {
+  dirtyBegin_ = 0u;
+  dirtyEnd_ = 0u;
+}
+
+bool PushConstantData::isDirty() const {
+  return dirtyBegin_ != dirtyEnd_;
+}
+
+uint32_t PushConstantData::getDirtyOffset() const {
+  return dirtyBegin_;
+}
+
+uint32_t PushConstantData::getDirtySize() const {
+  return dirtyEnd_ - dirtyBegin_;
+}
+
+const PushConstantBlock& PushConstantData::getBlock() const {
+  return *block_;
+}
+
+const uint8_t* PushConstantData::getData() const {
+  return data_.data();
+}
+
+// endregion
+
+} // namespace logi
@@ -17,6 +17,7 @@
  */
 
 #include "logi/program/shader_module.hpp"
+#include "logi/base/exception.hpp"
 #include "logi/device/logical_device_impl.hpp"
 #include "logi/device/physical_device_impl.hpp"
 #include "logi/instance/vulkan_instance.hpp"
@@ -154,4 +155,37 @@ std::vector<PushConstantReflectionInfo> reflectPushConstants(const std::vector<S
   return pushConstants;
 }
 
+PushConstantBlock reflectPushConstantBlock(const std::vector<ShaderStage>& stages) {
+  std::vector<PushConstantMember> members;
+
+  for (const auto& stage : stages) {
+    const std::optional<PushConstantReflectionInfo>& reflectionInfo =
+      stage.shader.getPushConstantReflectionInfo(stage.entryPoint);
+    if (!reflectionInfo) {
+      continue;
+    }
+
+    // Stages must declare the same block.
+    for (const PushConstantMember& member : reflectionInfo->members) {
+      auto it = std::find_if(members.begin(), members.end(),
+                             [&member](const PushConstantMember& other) { return other.name == member.name; });
+
+      if (it == members.end()) {
+        members.emplace_back(member);
+      } else if (it->offset != member.offset || it->size != member.size) {
+        throw ReflectionError("Push constant member '" + member.name + "' is declared differently by the stages.");
+      }
+    }
+  }
+
+  std::vector<PushConstantReflectionInfo> reflectedRanges = reflectPushConstants(stages);
+  std::vector<vk::PushConstantRange> ranges;
+  ranges.reserve(reflectedRanges.size());
+  for (const PushConstantReflectionInfo& range : reflectedRanges) {
+    ranges.emplace_back(static_cast<vk::PushConstantRange>(range));
+  }
+
+  return PushConstantBlock(std::move(members), ranges);
+}
+
 } // namespace logi
\ No newline at end of file
@@ -17,6 +17,7 @@
  */
 
 #include "logi/program/shader_module_impl.hpp"
+#include <limits>
 #include <numeric>
 #include <spirv_cross.hpp>
 #include <utility>
@@ -42,8 +43,8 @@ VertexAttributeReflectionInfo::VertexAttributeReflectionInfo(std::string name, u
   : name(std::move(name)), location(location), elementSize(elementSize), format(format) {}
 
 PushConstantReflectionInfo::PushConstantReflectionInfo(const vk::ShaderStageFlags& stages, uint32_t offset,
-                                                       uint32_t size)
-  : stages(stages), offset(offset), size(size) {}
+                                                       uint32_t size, std::vector<PushConstantMember> members)
+  : stages(stages), offset(offset), size(size), members(std::move(members)) {}
 
 EntryPointReflectionInfo::EntryPointReflectionInfo(std::string name, vk::ShaderStageFlagBits stage,
                                                    std::vector<DescriptorSetReflectionInfo> descriptorSets,
@@ -202,11 +203,9 @@ std::optional<PushConstantReflectionInfo> ShaderModuleImpl::reflectPushConstants
 
   if (!shaderResources.push_constant_buffers.empty()) {
     auto pushConstantBuffer = shaderResources.push_constant_buffers[0];
-    const std::string& name = compiler.get_name(pushConstantBuffer.id);
 
-    // Find the beginning and the end of the buffer.
-    // size_t bufferStart = std::numeric_limits<size_t>::max();
-    size_t bufferStart = 0u;
+    // Find the beginning and the end of the members used by the stage.
+    size_t bufferStart = std::numeric_limits<size_t>::max();
     size_t bufferEnd = 0u;
 
     for (const spirv_cross::BufferRange& constMemberRange : compiler.get_active_buffer_ranges(pushConstantBuffer.id)) {
@@ -214,7 +213,25 @@ std::optional<PushConstantReflectionInfo> ShaderModuleImpl::reflectPushConstants
       bufferEnd = std::max<size_t>(bufferEnd, constMemberRange.offset + constMemberRange.range);
     }
 
-    return std::make_optional<PushConstantReflectionInfo>(stage, bufferStart, bufferEnd - bufferStart);
+    // Push constant block is declared but not used.
+    if (bufferEnd == 0u) {
+      return {};
+    }
+
+    // Members of the block, including the ones that are not used by the stage.
+    const spirv_cross::SPIRType& type = compiler.get_type(pushConstantBuffer.base_type_id);
+    std::vector<PushConstantMember> members;
+    members.reserve(type.member_types.size());
+
+    for (uint32_t i = 0u; i < type.member_types.size(); i++) {
+      members.emplace_back(compiler.get_member_name(pushConstantBuffer.base_type_id, i),
+                           compiler.type_struct_member_offset(type, i),
+                           static_cast<uint32_t>(compiler.get_declared_struct_member_size(type, i)));
+    }
+
+    return std::make_optional<PushConstantReflectionInfo>(stage, static_cast<uint32_t>(bufferStart),
+                                                          static_cast<uint32_t>(bufferEnd - bufferStart),
+                                                          std::move(members));
   }
 
   return {};
@@ -0,0 +1,288 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/query/gpu_profiler.hpp"
+#include <algorithm>
+#include <array>
+#include "logi/base/exception.hpp"
+#include "logi/device/physical_device.hpp"
+#include "logi/queue/queue_family.hpp"
+
+namespace logi {
+
+// region ScopedZone
+
+GpuProfiler::ScopedZone::ScopedZone(GpuProfiler& profiler, const CommandBuffer& commandBuffer, uint32_t zone,
+                                    vk::PipelineStageFlagBits endStage)
+  : profiler_(&profiler), commandBuffer_(commandBuffer), zone_(zone), endStage_(endStage) {}
+
+GpuProfiler::ScopedZone::ScopedZone(ScopedZone&& other) noexcept
+  : profiler_(other.profiler_), commandBuffer_(std::move(other.commandBuffer_)), zone_(other.zone_),
+    endStage_(other.endStage_) {
+  other.profiler_ = nullptr;
+}
+
+GpuProfiler::ScopedZone& GpuProfiler::ScopedZone::operator=(ScopedZone&& other) noexcept {
+  if (this != &other) {
+    end();
+    profiler_ = other.profiler_;
+    commandBuffer_ = std::move(other.commandBuffer_);
+    zone_ = other.zone_;
+    endStage_ = other.endStage_;
+    other.profiler_ = nullptr;
+  }
+
+  return *this;
+}
+
+GpuProfiler::ScopedZone::~ScopedZone() {
+  end();
+}
+
+void GpuProfiler::ScopedZone::end() {
+  if (profiler_ != nullptr) {
+    profiler_->endZone(commandBuffer_, zone_, endStage_);
+    profiler_ = nullptr;
+  }
+}
+
+// endregion
+
+GpuProfiler::GpuProfiler(const QueueFamily& queueFamily, uint32_t framesInFlight, uint32_t maxZonesPerFrame,
+                         size_t statisticsWindow)
+  : frames_(framesInFlight), frameIndex_(framesInFlight - 1u), maxZonesPerFrame_(maxZonesPerFrame),
+    statisticsWindow_(statisticsWindow) {
+  if (framesInFlight == 0u) {
+    throw IllegalInvocation("GpuProfiler requires at least one frame in flight.");
+  }
+
+  logicalDevice_ = queueFamily.getLogicalDevice();
+  PhysicalDevice physicalDevice = queueFamily.getPhysicalDevice();
+  uint32_t timestampValidBits = physicalDevice.getQueueFamilyProperties()[queueFamily.getIndex()].timestampValidBits;
+  calibration_ = GpuClockCalibration(physicalDevice.getProperties().limits.timestampPeriod, timestampValidBits);
+  supported_ = timestampValidBits > 0u && maxZonesPerFrame > 0u;
+
+  if (!supported_) {
+    return;
+  }
+
+  // Each zone uses two queries, one for its beginning and one for its end.
+  vk::QueryPoolCreateInfo createInfo({}, vk::QueryType::eTimestamp, 2u * maxZonesPerFrame);
+  for (Frame& frame : frames_) {
+    frame.queryPool = logicalDevice_.createQueryPool(createInfo);
+    frame.zoneNames.resize(maxZonesPerFrame);
+    reset(frame, createInfo.queryCount);
+  }
+
+#if defined(__linux__) || defined(__ANDROID__)
+  // std::chrono::steady_clock is CLOCK_MONOTONIC on these platforms.
+  if (physicalDevice.getDispatcher().vkGetPhysicalDeviceCalibrateableTimeDomainsEXT != nullptr &&
+      logicalDevice_.getDispatcher().vkGetCalibratedTimestampsEXT != nullptr) {
+#ifdef VULKAN_HPP_NO_EXCEPTIONS
+    std::vector<vk::TimeDomainEXT> timeDomains = physicalDevice.getCalibrateableTimeDomainsEXT().value;
+#else
+    std::vector<vk::TimeDomainEXT> timeDomains = physicalDevice.getCalibrateableTimeDomainsEXT();
+#endif
+    auto hasDomain = [&timeDomains](vk::TimeDomainEXT domain) {
+      return std::find(timeDomains.begin(), timeDomains.end(), domain) != timeDomains.end();
+    };
+    calibrationSupported_ = hasDomain(vk::TimeDomainEXT::eDevice) && hasDomain(vk::TimeDomainEXT::eClockMonotonic);
+  }
+#endif
+
+  calibrate();
+}
+
+uint32_t GpuProfiler::beginFrame() {
+  if (frames_.empty()) {
+    return 0u;
+  }
+
+  frames_[frameIndex_].zoneCount = std::min(zoneCount_.exchange(0u), maxZonesPerFrame_);
+  frameIndex_ = (frameIndex_ + 1u) % static_cast<uint32_t>(frames_.size());
+
+  if (supported_) {
+    resolve(frames_[frameIndex_]);
+    calibrate();
+  }
+
+  return frameIndex_;
+}
+
+uint32_t GpuProfiler::beginZone(const CommandBuffer& commandBuffer, const std::string& name,
+                                vk::PipelineStageFlagBits stage) {
+  if (!supported_) {
+    return kInvalidZone;
+  }
+
+  uint32_t zone = zoneCount_.fetch_add(1u, std::memory_order_relaxed);
+  if (zone >= maxZonesPerFrame_) {
+    droppedZones_.fetch_add(1u, std::memory_order_relaxed);
+    return kInvalidZone;
+  }
+
+  Frame& frame = frames_[frameIndex_];
+  frame.zoneNames[zone] = name;
+  commandBuffer.writeTimestamp(stage, frame.queryPool, 2u * zone);
+  return zone;
+}
+
+void GpuProfiler::endZone(const CommandBuffer& commandBuffer, uint32_t zone, vk::PipelineStageFlagBits stage) {
+  if (zone == kInvalidZone) {
+    return;
+  }
+
+  commandBuffer.writeTimestamp(stage, frames_[frameIndex_].queryPool, 2u * zone + 1u);
+}
+
+GpuProfiler::ScopedZone GpuProfiler::scopedZone(const CommandBuffer& commandBuffer, const std::string& name,
+                                                vk::PipelineStageFlagBits beginStage,
+                                                vk::PipelineStageFlagBits endStage) {
+  return ScopedZone(*this, commandBuffer, beginZone(commandBuffer, name, beginStage), endStage);
+}
+
+bool GpuProfiler::calibrate() {
+  if (!calibrationSupported_) {
+    return false;
+  }
+
+  std::array<vk::CalibratedTimestampInfoEXT, 2u> timestampInfos = {
+    vk::CalibratedTimestampInfoEXT(vk::TimeDomainEXT::eDevice),
+    vk::CalibratedTimestampInfoEXT(vk::TimeDomainEXT::eClockMonotonic)};
+  std::array<uint64_t, 2u> timestamps {};
+
+#ifdef VULKAN_HPP_NO_EXCEPTIONS
+  vk::ResultValue<uint64_t> maxDeviation = logicalDevice_.getCalibratedTimestampsEXT(timestampInfos, timestamps);
+  if (maxDeviation.result != vk::Result::eSuccess) {
+    return false;
+  }
+  calibration_.calibrate(timestamps[0], timestamps[1], maxDeviation.value);
+#else
+  uint64_t maxDeviation = logicalDevice_.getCalibratedTimestampsEXT(timestampInfos, timestamps);
+  calibration_.calibrate(timestamps[0], timestamps[1], maxDeviation);
+#endif
+
+  return true;
+}
+
+bool GpuProfiler::isSupported() const {
+  return supported_;
+}
+
+bool GpuProfiler::isCalibrated() const {
+  return calibration_.isCalibrated();
+}
+
+const GpuClockCalibration& GpuProfiler::getClockCalibration() const {
+  return calibration_;
+}
+
+const std::vector<GpuZoneResult>& GpuProfiler::getFrameResults() const {
+  return frameResults_;
+}
+
+const GpuZoneStatistics* GpuProfiler::getZoneStatistics(const std::string& name) const {
+  auto it = zoneStatistics_.find(name);
+  return it != zoneStatistics_.end() ? &it->second : nullptr;
+}
+
+const std::unordered_map<std::string, GpuZoneStatistics>& GpuProfiler::getZoneStatistics() const {
+  return zoneStatistics_;
+}
+
+uint64_t GpuProfiler::getDroppedZoneCount() const {
+  return droppedZones_.load(std::memory_order_relaxed);
+}
+
+uint32_t GpuProfiler::getFrameIndex() const {
+  return frameIndex_;
+}
+
+uint32_t GpuProfiler::getFramesInFlight() const {
+  return static_cast<uint32_t>(frames_.size());
+}
+
+void GpuProfiler::destroy() {
+  for (Frame& frame : frames_) {
+    if (frame.queryPool) {
+      frame.queryPool.destroy();
+    }
+  }
+
+  frames_.clear();
+  frameIndex_ = 0u;
+  zoneCount_ = 0u;
+  supported_ = false;
+  frameResults_.clear();
+}
+
+void GpuProfiler::resolve(Frame& frame) {
+  frameResults_.clear();
+  if (frame.zoneCount == 0u) {
+    return;
+  }
+
+  // Value and availability of each query. Results of zones that were recorded but never submitted are not available.
+  uint32_t queryCount = 2u * frame.zoneCount;
+  std::vector<uint64_t> data(2u * queryCount);
+  frame.queryPool.getResults<uint64_t>(0u, queryCount, data, 2u * sizeof(uint64_t),
+                                       vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability);
+
+  for (uint32_t zone = 0u; zone < frame.zoneCount; zone++) {
+    const uint64_t* begin = &data[4u * zone];
+    const uint64_t* end = begin + 2u;
+    if (begin[1] == 0u || end[1] == 0u) {
+      droppedZones_.fetch_add(1u, std::memory_order_relaxed);
+      continue;
+    }
+
+    GpuZoneResult& result = frameResults_.emplace_back();
+    result.name = std::move(frame.zoneNames[zone]);
+    result.beginTimestamp = begin[0];
+    result.endTimestamp = end[0];
+    result.milliseconds = calibration_.toNanoseconds(calibration_.elapsedTicks(begin[0], end[0])) * 1e-6;
+    if (calibration_.isCalibrated()) {
+      result.beginHostNanoseconds = calibration_.toHostNanoseconds(begin[0]);
+      result.endHostNanoseconds = calibration_.toHostNanoseconds(end[0]);
+    }
+
+    zoneStatistics_.try_emplace(result.name, statisticsWindow_).first->second.addSample(result.milliseconds);
+  }
+
+  // Calibrated zones share the time base of the CPU events of the trace.
+  TraceRecorder& traceRecorder = logicalDevice_.getTraceRecorder();
+  if (calibration_.isCalibrated() && traceRecorder.isRecording()) {
+    for (const GpuZoneResult& result : frameResults_) {
+      traceRecorder.recordComplete(result.name, "gpu", result.beginHostNanoseconds, result.endHostNanoseconds,
+                                   TraceRecorder::kGpuTrack);
+    }
+  }
+
+  reset(frame, queryCount);
+  frame.zoneCount = 0u;
+}
+
+void GpuProfiler::reset(Frame& frame, uint32_t queryCount) const {
+  if (logicalDevice_.getDispatcher().vkResetQueryPool != nullptr) {
+    frame.queryPool.resetQueryPool(0u, queryCount);
+  } else {
+    frame.queryPool.resetQueryPoolEXT(0u, queryCount);
+  }
+}
+
+} // namespace logi
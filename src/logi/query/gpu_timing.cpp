@@ -0,0 +1,103 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/query/gpu_timing.hpp"
+#include <algorithm>
+
+namespace logi {
+
+GpuClockCalibration::GpuClockCalibration(float timestampPeriod, uint32_t timestampValidBits)
+  : timestampPeriod_(timestampPeriod),
+    mask_(timestampValidBits >= 64u ? ~uint64_t(0u) : (uint64_t(1u) << timestampValidBits) - 1u) {}
+
+void GpuClockCalibration::calibrate(uint64_t gpuTimestamp, uint64_t hostNanoseconds, uint64_t maxDeviation) {
+  gpuTimestamp_ = gpuTimestamp & mask_;
+  hostNanoseconds_ = hostNanoseconds;
+  maxDeviation_ = maxDeviation;
+  calibrated_ = true;
+}
+
+bool GpuClockCalibration::isCalibrated() const {
+  return calibrated_;
+}
+
+uint64_t GpuClockCalibration::getMaxDeviation() const {
+  return maxDeviation_;
+}
+
+uint64_t GpuClockCalibration::elapsedTicks(uint64_t begin, uint64_t end) const {
+  return (end - begin) & mask_;
+}
+
+double GpuClockCalibration::toNanoseconds(uint64_t ticks) const {
+  return static_cast<double>(ticks) * timestampPeriod_;
+}
+
+int64_t GpuClockCalibration::toHostNanoseconds(uint64_t gpuTimestamp) const {
+  // Interpret the wrapped difference as signed, so that timestamps written before the calibration map to earlier times.
+  uint64_t ticks = elapsedTicks(gpuTimestamp_, gpuTimestamp);
+  double offset = toNanoseconds(ticks);
+  if (ticks > (mask_ >> 1u)) {
+    offset = -toNanoseconds(elapsedTicks(gpuTimestamp, gpuTimestamp_));
+  }
+
+  return static_cast<int64_t>(hostNanoseconds_) + static_cast<int64_t>(offset);
+}
+
+GpuZoneStatistics::GpuZoneStatistics(size_t windowSize) : windowSize_(std::max<size_t>(windowSize, 1u)) {
+  samples_.reserve(windowSize_);
+}
+
+void GpuZoneStatistics::addSample(double milliseconds) {
+  if (samples_.size() < windowSize_) {
+    samples_.emplace_back(milliseconds);
+  } else {
+    sum_ -= samples_[next_];
+    samples_[next_] = milliseconds;
+  }
+
+  sum_ += milliseconds;
+  next_ = (next_ + 1u) % windowSize_;
+  totalSamples_++;
+}
+
+size_t GpuZoneStatistics::getSampleCount() const {
+  return samples_.size();
+}
+
+uint64_t GpuZoneStatistics::getTotalSampleCount() const {
+  return totalSamples_;
+}
+
+double GpuZoneStatistics::getLast() const {
+  return samples_.empty() ? 0.0 : samples_[(next_ + windowSize_ - 1u) % windowSize_];
+}
+
+double GpuZoneStatistics::getAverage() const {
+  return samples_.empty() ? 0.0 : sum_ / static_cast<double>(samples_.size());
+}
+
+double GpuZoneStatistics::getMin() const {
+  return samples_.empty() ? 0.0 : *std::min_element(samples_.begin(), samples_.end());
+}
+
+double GpuZoneStatistics::getMax() const {
+  return samples_.empty() ? 0.0 : *std::max_element(samples_.begin(), samples_.end());
+}
+
+} // namespace logi
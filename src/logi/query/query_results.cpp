@@ -0,0 +1,156 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/query/query_results.hpp"
+#include <algorithm>
+#include <array>
+
+namespace logi {
+
+namespace {
+
+using PipelineStatisticsCounter = uint64_t PipelineStatistics::*;
+
+// Counters in the order of their vk::QueryPipelineStatisticFlagBits.
+const std::array<std::pair<vk::QueryPipelineStatisticFlagBits, PipelineStatisticsCounter>, 11u> kPipelineStatistics = {{
+  {vk::QueryPipelineStatisticFlagBits::eInputAssemblyVertices, &PipelineStatistics::inputAssemblyVertices},
+  {vk::QueryPipelineStatisticFlagBits::eInputAssemblyPrimitives, &PipelineStatistics::inputAssemblyPrimitives},
+  {vk::QueryPipelineStatisticFlagBits::eVertexShaderInvocations, &PipelineStatistics::vertexShaderInvocations},
+  {vk::QueryPipelineStatisticFlagBits::eGeometryShaderInvocations, &PipelineStatistics::geometryShaderInvocations},
+  {vk::QueryPipelineStatisticFlagBits::eGeometryShaderPrimitives, &PipelineStatistics::geometryShaderPrimitives},
+  {vk::QueryPipelineStatisticFlagBits::eClippingInvocations, &PipelineStatistics::clippingInvocations},
+  {vk::QueryPipelineStatisticFlagBits::eClippingPrimitives, &PipelineStatistics::clippingPrimitives},
+  {vk::QueryPipelineStatisticFlagBits::eFragmentShaderInvocations, &PipelineStatistics::fragmentShaderInvocations},
+  {vk::QueryPipelineStatisticFlagBits::eTessellationControlShaderPatches,
+   &PipelineStatistics::tessellationControlShaderPatches},
+  {vk::QueryPipelineStatisticFlagBits::eTessellationEvaluationShaderInvocations,
+   &PipelineStatistics::tessellationEvaluationShaderInvocations},
+  {vk::QueryPipelineStatisticFlagBits::eComputeShaderInvocations, &PipelineStatistics::computeShaderInvocations},
+}};
+
+} // namespace
+
+PipelineStatistics& PipelineStatistics::operator+=(const PipelineStatistics& other) {
+  for (const auto& statistic : kPipelineStatistics) {
+    this->*statistic.second += other.*statistic.second;
+  }
+
+  return *this;
+}
+
+uint32_t getPipelineStatisticCount(const vk::QueryPipelineStatisticFlags& flags) {
+  uint32_t count = 0u;
+  for (const auto& statistic : kPipelineStatistics) {
+    if (flags & statistic.first) {
+      count++;
+    }
+  }
+
+  return count;
+}
+
+PipelineStatistics unpackPipelineStatistics(const vk::QueryPipelineStatisticFlags& flags, const uint64_t* values) {
+  PipelineStatistics statistics;
+  for (const auto& statistic : kPipelineStatistics) {
+    if (flags & statistic.first) {
+      statistics.*statistic.second = *values++;
+    }
+  }
+
+  return statistics;
+}
+
+PipelineStatisticsHistory::PipelineStatisticsHistory(size_t windowSize)
+  : windowSize_(std::max<size_t>(windowSize, 1u)) {
+  samples_.reserve(windowSize_);
+}
+
+void PipelineStatisticsHistory::addSample(const PipelineStatistics& statistics) {
+  if (samples_.size() < windowSize_) {
+    samples_.emplace_back(statistics);
+  } else {
+    samples_[next_] = statistics;
+  }
+
+  next_ = (next_ + 1u) % windowSize_;
+}
+
+size_t PipelineStatisticsHistory::getSampleCount() const {
+  return samples_.size();
+}
+
+PipelineStatistics PipelineStatisticsHistory::getLast() const {
+  return samples_.empty() ? PipelineStatistics() : samples_[(next_ + windowSize_ - 1u) % windowSize_];
+}
+
+PipelineStatistics PipelineStatisticsHistory::getAverage() const {
+  PipelineStatistics average;
+  if (samples_.empty()) {
+    return average;
+  }
+
+  for (const PipelineStatistics& sample : samples_) {
+    average += sample;
+  }
+
+  for (const auto& statistic : kPipelineStatistics) {
+    average.*statistic.second /= samples_.size();
+  }
+
+  return average;
+}
+
+void OcclusionCache::update(uint64_t objectId, uint64_t samples, uint64_t frame) {
+  Entry& entry = entries_[objectId];
+  entry.samples = samples;
+  entry.frame = frame;
+}
+
+std::optional<uint64_t> OcclusionCache::getSamples(uint64_t objectId) const {
+  auto it = entries_.find(objectId);
+  if (it == entries_.end()) {
+    return {};
+  }
+
+  return it->second.samples;
+}
+
+bool OcclusionCache::isVisible(uint64_t objectId, uint64_t currentFrame, uint64_t maxAge) const {
+  auto it = entries_.find(objectId);
+  if (it == entries_.end() || currentFrame - it->second.frame > maxAge) {
+    return true;
+  }
+
+  return it->second.samples > 0u;
+}
+
+void OcclusionCache::evict(uint64_t frame) {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    it = it->second.frame < frame ? entries_.erase(it) : std::next(it);
+  }
+}
+
+size_t OcclusionCache::size() const {
+  return entries_.size();
+}
+
+void OcclusionCache::clear() {
+  entries_.clear();
+}
+
+} // namespace logi
@@ -0,0 +1,264 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/query/query_service.hpp"
+#include "logi/base/exception.hpp"
+#include "logi/device/logical_device.hpp"
+
+namespace logi {
+
+namespace {
+
+void resetQueries(const LogicalDevice& logicalDevice, const QueryPool& queryPool, uint32_t queryCount) {
+  if (queryCount == 0u) {
+    return;
+  }
+
+  if (logicalDevice.getDispatcher().vkResetQueryPool != nullptr) {
+    queryPool.resetQueryPool(0u, queryCount);
+  } else {
+    queryPool.resetQueryPoolEXT(0u, queryCount);
+  }
+}
+
+const vk::QueryResultFlags kReadbackFlags = vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability;
+
+} // namespace
+
+QueryService::QueryService(const MemoryAllocator& memoryAllocator, uint32_t framesInFlight,
+                           uint32_t maxPipelineStatisticsQueries, uint32_t maxOcclusionQueries,
+                           const vk::QueryPipelineStatisticFlags& pipelineStatistics, size_t statisticsWindow)
+  : memoryAllocator_(memoryAllocator), frames_(framesInFlight), frameIndex_(framesInFlight - 1u),
+    maxPipelineStatisticsQueries_(pipelineStatistics ? maxPipelineStatisticsQueries : 0u),
+    maxOcclusionQueries_(maxOcclusionQueries), pipelineStatistics_(pipelineStatistics),
+    statisticsWindow_(statisticsWindow) {
+  if (framesInFlight == 0u) {
+    throw IllegalInvocation("QueryService requires at least one frame in flight.");
+  }
+
+  LogicalDevice logicalDevice = memoryAllocator_.getLogicalDevice();
+  vk::DeviceSize readbackSize = getOcclusionOffset() + maxOcclusionQueries_ * 2u * sizeof(uint64_t);
+
+  for (Frame& frame : frames_) {
+    if (maxPipelineStatisticsQueries_ > 0u) {
+      frame.pipelineStatisticsPool = logicalDevice.createQueryPool(vk::QueryPoolCreateInfo(
+        {}, vk::QueryType::ePipelineStatistics, maxPipelineStatisticsQueries_, pipelineStatistics_));
+      resetQueries(logicalDevice, frame.pipelineStatisticsPool, maxPipelineStatisticsQueries_);
+      frame.passNames.reserve(maxPipelineStatisticsQueries_);
+    }
+
+    if (maxOcclusionQueries_ > 0u) {
+      frame.occlusionPool =
+        logicalDevice.createQueryPool(vk::QueryPoolCreateInfo({}, vk::QueryType::eOcclusion, maxOcclusionQueries_));
+      resetQueries(logicalDevice, frame.occlusionPool, maxOcclusionQueries_);
+      frame.objectIds.reserve(maxOcclusionQueries_);
+    }
+
+    if (readbackSize > 0u) {
+      vk::BufferCreateInfo bufferCreateInfo({}, readbackSize, vk::BufferUsageFlagBits::eTransferDst);
+      VmaAllocationCreateInfo allocationCreateInfo = {};
+      allocationCreateInfo.usage = VMA_MEMORY_USAGE_GPU_TO_CPU;
+
+      frame.readbackBuffer = memoryAllocator_.createBuffer(bufferCreateInfo, allocationCreateInfo);
+#ifdef VULKAN_HPP_NO_EXCEPTIONS
+      frame.readback = static_cast<const uint64_t*>(frame.readbackBuffer.mapMemory().value);
+#else
+      frame.readback = static_cast<const uint64_t*>(frame.readbackBuffer.mapMemory());
+#endif
+    }
+  }
+}
+
+uint32_t QueryService::beginFrame() {
+  if (frames_.empty()) {
+    return 0u;
+  }
+
+  frameIndex_ = (frameIndex_ + 1u) % static_cast<uint32_t>(frames_.size());
+  frameNumber_++;
+
+  Frame& frame = frames_[frameIndex_];
+  collect(frame);
+  frame.frameNumber = frameNumber_;
+
+  uint64_t maxAge = 2u * frames_.size();
+  if (frameNumber_ > maxAge) {
+    occlusionCache_.evict(frameNumber_ - maxAge);
+  }
+
+  return frameIndex_;
+}
+
+uint32_t QueryService::beginPipelineStatistics(const CommandBuffer& commandBuffer, const std::string& passName) {
+  Frame& frame = frames_[frameIndex_];
+  if (frame.passNames.size() >= maxPipelineStatisticsQueries_) {
+    return kInvalidQuery;
+  }
+
+  auto query = static_cast<uint32_t>(frame.passNames.size());
+  frame.passNames.emplace_back(passName);
+  commandBuffer.beginQuery(frame.pipelineStatisticsPool, query, {});
+  return query;
+}
+
+void QueryService::endPipelineStatistics(const CommandBuffer& commandBuffer, uint32_t query) {
+  if (query != kInvalidQuery) {
+    commandBuffer.endQuery(frames_[frameIndex_].pipelineStatisticsPool, query);
+  }
+}
+
+uint32_t QueryService::beginOcclusion(const CommandBuffer& commandBuffer, uint64_t objectId, bool precise) {
+  Frame& frame = frames_[frameIndex_];
+  if (frame.objectIds.size() >= maxOcclusionQueries_) {
+    return kInvalidQuery;
+  }
+
+  auto query = static_cast<uint32_t>(frame.objectIds.size());
+  frame.objectIds.emplace_back(objectId);
+  vk::QueryControlFlags flags;
+  if (precise) {
+    flags = vk::QueryControlFlagBits::ePrecise;
+  }
+
+  commandBuffer.beginQuery(frame.occlusionPool, query, flags);
+  return query;
+}
+
+void QueryService::endOcclusion(const CommandBuffer& commandBuffer, uint32_t query) {
+  if (query != kInvalidQuery) {
+    commandBuffer.endQuery(frames_[frameIndex_].occlusionPool, query);
+  }
+}
+
+void QueryService::resolve(const CommandBuffer& commandBuffer) {
+  Frame& frame = frames_[frameIndex_];
+  if (frame.passNames.empty() && frame.objectIds.empty()) {
+    return;
+  }
+
+  // Results are copied without waiting. Queries that did not execute are copied as unavailable.
+  if (!frame.passNames.empty()) {
+    commandBuffer.copyQueryPoolResults(frame.pipelineStatisticsPool, 0u, static_cast<uint32_t>(frame.passNames.size()),
+                                       frame.readbackBuffer, 0u, getPipelineStatisticsStride(), kReadbackFlags);
+  }
+  if (!frame.objectIds.empty()) {
+    commandBuffer.copyQueryPoolResults(frame.occlusionPool, 0u, static_cast<uint32_t>(frame.objectIds.size()),
+                                       frame.readbackBuffer, getOcclusionOffset(), 2u * sizeof(uint64_t),
+                                       kReadbackFlags);
+  }
+
+  vk::MemoryBarrier barrier(vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eHostRead);
+  commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eHost, {}, barrier,
+                                {}, {});
+  frame.resolved = true;
+}
+
+const PipelineStatisticsHistory* QueryService::getPassStatistics(const std::string& passName) const {
+  auto it = passStatistics_.find(passName);
+  return it != passStatistics_.end() ? &it->second : nullptr;
+}
+
+const std::unordered_map<std::string, PipelineStatisticsHistory>& QueryService::getPassStatistics() const {
+  return passStatistics_;
+}
+
+const OcclusionCache& QueryService::getOcclusionCache() const {
+  return occlusionCache_;
+}
+
+bool QueryService::isVisible(uint64_t objectId) const {
+  return occlusionCache_.isVisible(objectId, frameNumber_, 2u * frames_.size());
+}
+
+uint64_t QueryService::getFrameNumber() const {
+  return frameNumber_;
+}
+
+uint32_t QueryService::getFrameIndex() const {
+  return frameIndex_;
+}
+
+uint32_t QueryService::getFramesInFlight() const {
+  return static_cast<uint32_t>(frames_.size());
+}
+
+void QueryService::destroy() {
+  for (Frame& frame : frames_) {
+    if (frame.pipelineStatisticsPool) {
+      frame.pipelineStatisticsPool.destroy();
+    }
+    if (frame.occlusionPool) {
+      frame.occlusionPool.destroy();
+    }
+    if (frame.readbackBuffer) {
+      frame.readbackBuffer.unmapMemory();
+      memoryAllocator_.destroyBuffer(frame.readbackBuffer);
+    }
+  }
+
+  frames_.clear();
+  frameIndex_ = 0u;
+  passStatistics_.clear();
+  occlusionCache_.clear();
+}
+
+void QueryService::collect(Frame& frame) {
+  if (frame.resolved) {
+    frame.readbackBuffer.invalidate();
+
+    // Passes recorded several times per frame contribute the sum of their queries to the frame's sample.
+    std::unordered_map<std::string, PipelineStatistics> frameStatistics;
+    size_t words = getPipelineStatisticsStride() / sizeof(uint64_t);
+    for (size_t i = 0u; i < frame.passNames.size(); i++) {
+      const uint64_t* values = frame.readback + i * words;
+      if (values[words - 1u] != 0u) {
+        frameStatistics[frame.passNames[i]] += unpackPipelineStatistics(pipelineStatistics_, values);
+      }
+    }
+
+    for (const auto& entry : frameStatistics) {
+      passStatistics_.try_emplace(entry.first, statisticsWindow_).first->second.addSample(entry.second);
+    }
+
+    const uint64_t* occlusionResults = frame.readback + getOcclusionOffset() / sizeof(uint64_t);
+    for (size_t i = 0u; i < frame.objectIds.size(); i++) {
+      const uint64_t* result = occlusionResults + 2u * i;
+      if (result[1] != 0u) {
+        occlusionCache_.update(frame.objectIds[i], result[0], frame.frameNumber);
+      }
+    }
+  }
+
+  LogicalDevice logicalDevice = memoryAllocator_.getLogicalDevice();
+  resetQueries(logicalDevice, frame.pipelineStatisticsPool, static_cast<uint32_t>(frame.passNames.size()));
+  resetQueries(logicalDevice, frame.occlusionPool, static_cast<uint32_t>(frame.objectIds.size()));
+  frame.passNames.clear();
+  frame.objectIds.clear();
+  frame.resolved = false;
+}
+
+vk::DeviceSize QueryService::getPipelineStatisticsStride() const {
+  // Counters followed by the availability value.
+  return (getPipelineStatisticCount(pipelineStatistics_) + 1u) * sizeof(uint64_t);
+}
+
+vk::DeviceSize QueryService::getOcclusionOffset() const {
+  return maxPipelineStatisticsQueries_ * getPipelineStatisticsStride();
+}
+
+} // namespace logi
@@ -0,0 +1,256 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/queue/async_queue.hpp"
+#include "logi/base/exception.hpp"
+
+namespace logi {
+
+// region AsyncQueueToken
+
+AsyncQueueToken::AsyncQueueToken(std::shared_ptr<State> state) : state_(std::move(state)) {}
+
+bool AsyncQueueToken::isValid() const {
+  return state_ != nullptr;
+}
+
+bool AsyncQueueToken::isComplete() const {
+  return state_ != nullptr && state_->complete.load(std::memory_order_acquire);
+}
+
+vk::Result AsyncQueueToken::getResult() const {
+  return isComplete() ? state_->result : vk::Result::eNotReady;
+}
+
+// endregion
+
+// region AsyncQueue
+
+AsyncQueue::AsyncQueue(const Queue& queue, size_t capacity)
+  : queue_(queue), ring_(std::make_unique<MpscRing<Operation>>(capacity)) {
+  worker_ = std::thread(&AsyncQueue::work, this);
+}
+
+AsyncQueue::~AsyncQueue() {
+  destroy();
+}
+
+AsyncQueueToken AsyncQueue::submit(const vk::ArrayProxy<const vk::SubmitInfo>& submits, vk::Fence fence) {
+  Operation operation;
+  operation.type = OperationType::eSubmit;
+  for (const vk::SubmitInfo& submitInfo : submits) {
+    operation.submits.add(submitInfo);
+  }
+  operation.fence = fence;
+
+  return push(std::move(operation));
+}
+
+AsyncQueueToken AsyncQueue::presentKHR(const vk::PresentInfoKHR& presentInfo) {
+  if (presentInfo.pNext != nullptr || presentInfo.pResults != nullptr) {
+    throw IllegalInvocation("AsyncQueue does not support pNext and pResults of PresentInfoKHR.");
+  }
+
+  Operation operation;
+  operation.type = OperationType::ePresent;
+  operation.waitSemaphores.assign(presentInfo.pWaitSemaphores,
+                                  presentInfo.pWaitSemaphores + presentInfo.waitSemaphoreCount);
+  operation.swapchains.assign(presentInfo.pSwapchains, presentInfo.pSwapchains + presentInfo.swapchainCount);
+  operation.imageIndices.assign(presentInfo.pImageIndices, presentInfo.pImageIndices + presentInfo.swapchainCount);
+
+  return push(std::move(operation));
+}
+
+AsyncQueueToken AsyncQueue::execute(QueueFunction function) {
+  Operation operation;
+  operation.type = OperationType::eExecute;
+  operation.function = std::move(function);
+
+  return push(std::move(operation));
+}
+
+vk::Result AsyncQueue::wait(const AsyncQueueToken& token) const {
+  if (!token.isValid()) {
+    throw IllegalInvocation("Waiting for an invalid AsyncQueueToken.");
+  }
+
+  if (!token.isComplete()) {
+    std::unique_lock<std::mutex> lock(completionMutex_);
+    completed_.wait(lock, [&token]() { return token.isComplete(); });
+  }
+
+#ifndef VULKAN_HPP_NO_EXCEPTIONS
+  if (token.state_->exception) {
+    std::rethrow_exception(token.state_->exception);
+  }
+#endif
+
+  return token.state_->result;
+}
+
+void AsyncQueue::drain() {
+  wait(execute([](const Queue&) { return vk::Result::eSuccess; }));
+}
+
+vk::Result AsyncQueue::waitIdle() {
+  return wait(execute([](const Queue& queue) {
+#ifdef VULKAN_HPP_NO_EXCEPTIONS
+    return queue.waitIdle();
+#else
+    queue.waitIdle();
+    return vk::Result::eSuccess;
+#endif
+  }));
+}
+
+size_t AsyncQueue::getPendingCount() const {
+  return pendingCount_.load(std::memory_order_relaxed);
+}
+
+const Queue& AsyncQueue::getQueue() const {
+  return queue_;
+}
+
+void AsyncQueue::destroy() {
+  if (!worker_.joinable()) {
+    return;
+  }
+
+  stopping_.store(true);
+  if (sleeping_.exchange(false)) {
+    std::lock_guard<std::mutex> lock(workMutex_);
+    workAvailable_.notify_one();
+  }
+
+  worker_.join();
+  ring_.reset();
+  queue_ = {};
+  stopping_.store(false);
+}
+
+AsyncQueueToken AsyncQueue::push(Operation&& operation) {
+  if (!ring_) {
+    throw IllegalInvocation("AsyncQueue is not initialized.");
+  }
+
+  auto state = std::make_shared<AsyncQueueToken::State>();
+  operation.state = state;
+  pendingCount_.fetch_add(1u, std::memory_order_relaxed);
+
+  while (!ring_->tryPush(std::move(operation))) {
+    std::this_thread::yield();
+  }
+
+  // Pairs with the fence in work: either the submission thread sees the pushed operation or this thread sees that it
+  // went to sleep and wakes it up.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping_.exchange(false)) {
+    std::lock_guard<std::mutex> lock(workMutex_);
+    workAvailable_.notify_one();
+  }
+
+  return AsyncQueueToken(std::move(state));
+}
+
+void AsyncQueue::execute(Operation& operation) {
+  vk::Result result = vk::Result::eSuccess;
+  std::exception_ptr exception;
+
+#ifndef VULKAN_HPP_NO_EXCEPTIONS
+  try {
+#endif
+    switch (operation.type) {
+      case OperationType::eSubmit: {
+        const std::vector<vk::SubmitInfo>& submitInfos = operation.submits.build();
+#ifdef VULKAN_HPP_NO_EXCEPTIONS
+        result = queue_.submit(submitInfos, operation.fence);
+#else
+        queue_.submit(submitInfos, operation.fence);
+#endif
+        break;
+      }
+      case OperationType::ePresent: {
+        operation.presentInfo = vk::PresentInfoKHR(static_cast<uint32_t>(operation.waitSemaphores.size()),
+                                                   operation.waitSemaphores.data(),
+                                                   static_cast<uint32_t>(operation.swapchains.size()),
+                                                   operation.swapchains.data(), operation.imageIndices.data());
+        result = queue_.presentKHR(operation.presentInfo);
+        break;
+      }
+      case OperationType::eExecute: {
+        result = operation.function(queue_);
+        break;
+      }
+    }
+#ifndef VULKAN_HPP_NO_EXCEPTIONS
+  } catch (const vk::SystemError& error) {
+    result = static_cast<vk::Result>(error.code().value());
+    exception = std::current_exception();
+  } catch (...) {
+    result = vk::Result::eErrorUnknown;
+    exception = std::current_exception();
+  }
+#endif
+
+  AsyncQueueToken::State& state = *operation.state;
+  state.result = result;
+  state.exception = exception;
+  pendingCount_.fetch_sub(1u, std::memory_order_relaxed);
+
+  {
+    // Completing under the mutex guarantees that a waiter either sees the completion or is woken up.
+    std::lock_guard<std::mutex> lock(completionMutex_);
+    state.complete.store(true, std::memory_order_release);
+  }
+  completed_.notify_all();
+}
+
+void AsyncQueue::work() {
+  Operation operation;
+
+  while (true) {
+    if (ring_->tryPop(operation)) {
+      execute(operation);
+      operation = Operation();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(workMutex_);
+    sleeping_.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (ring_->tryPop(operation)) {
+      sleeping_.store(false);
+      lock.unlock();
+      execute(operation);
+      operation = Operation();
+      continue;
+    }
+
+    if (stopping_.load()) {
+      sleeping_.store(false);
+      break;
+    }
+
+    workAvailable_.wait(lock, [this]() { return !sleeping_.load(); });
+  }
+}
+
+// endregion
+
+} // namespace logi
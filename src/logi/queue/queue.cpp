@@ -81,10 +81,53 @@ QueueFamily Queue::getQueueFamily() const {
   return QueueFamily(object_->getQueueFamily().shared_from_this());
 }
 
+HandleRef<VulkanInstance> Queue::getInstanceRef() const {
+  return HandleRef<VulkanInstance>(object_->getInstance());
+}
+
+HandleRef<PhysicalDevice> Queue::getPhysicalDeviceRef() const {
+  return HandleRef<PhysicalDevice>(object_->getPhysicalDevice());
+}
+
+HandleRef<LogicalDevice> Queue::getLogicalDeviceRef() const {
+  return HandleRef<LogicalDevice>(object_->getLogicalDevice());
+}
+
+HandleRef<QueueFamily> Queue::getQueueFamilyRef() const {
+  return HandleRef<QueueFamily>(object_->getQueueFamily());
+}
+
 const vk::DispatchLoaderDynamic& Queue::getDispatcher() const {
   return object_->getDispatcher();
 }
 
+CommandStatistics Queue::getLastSubmitStatistics() const {
+  return object_->getLastSubmitStatistics();
+}
+
+CommandStatistics Queue::getFrameStatistics() const {
+  return object_->getFrameStatistics();
+}
+
+CommandStatistics Queue::endStatisticsFrame() const {
+  return object_->endStatisticsFrame();
+}
+
+vk::ResultValueType<GpuFuture>::type Queue::submitFuture(const vk::ArrayProxy<const vk::SubmitInfo>& submits,
+                                                         vk::Fence fence) const {
+  return object_->submitFuture(submits, fence);
+}
+
+vk::ResultValueType<GpuFuture>::type Queue::submitFuture(const vk::ArrayProxy<const vk::CommandBuffer>& commandBuffers,
+                                                         const std::vector<GpuFuture>& waitFutures,
+                                                         vk::PipelineStageFlags waitStages, vk::Fence fence) const {
+  return object_->submitFuture(commandBuffers, waitFutures, waitStages, fence);
+}
+
+void Queue::pollGpuFutures() const {
+  object_->pollGpuFutures();
+}
+
 Queue::operator const vk::Queue&() const {
   static vk::Queue nullHandle(nullptr);
   return (object_) ? object_->operator const vk::Queue&() : nullHandle;
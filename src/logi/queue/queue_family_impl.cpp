@@ -17,6 +17,7 @@
  */
 
 #include "logi/queue/queue_family_impl.hpp"
+#include "logi/command/command_buffer_impl.hpp"
 #include "logi/command/command_pool_impl.hpp"
 #include "logi/device/logical_device_impl.hpp"
 #include "logi/device/physical_device_impl.hpp"
@@ -59,6 +60,35 @@ void QueueFamilyImpl::destroyQueue(size_t id) {
   VulkanObjectComposite<QueueImpl>::destroyObject(id);
 }
 
+void QueueFamilyImpl::recordPreambleCommandBuffer(std::shared_ptr<CommandBufferImpl>& commandBuffer,
+                                                  const ResourceBarriers& barriers) {
+  // Preamble command buffers are recorded during submission, possibly on different threads than the command buffers
+  // they precede, hence they are allocated from a pool owned by the queue family.
+  std::lock_guard<std::mutex> lock(preambleMutex_);
+
+  if (!preamblePool_) {
+    preamblePool_ = createCommandPool(vk::CommandPoolCreateFlagBits::eResetCommandBuffer |
+                                      vk::CommandPoolCreateFlagBits::eTransient);
+  }
+  if (!commandBuffer) {
+    commandBuffer = preamblePool_->allocateCommandBuffer(vk::CommandBufferLevel::ePrimary);
+  }
+
+  commandBuffer->begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+  commandBuffer->pipelineBarrier(barriers.srcStageMask, barriers.dstStageMask, {}, {}, barriers.bufferBarriers,
+                                 barriers.imageBarriers);
+  commandBuffer->end();
+}
+
+void QueueFamilyImpl::freePreambleCommandBuffer(const std::shared_ptr<CommandBufferImpl>& commandBuffer) {
+  std::lock_guard<std::mutex> lock(preambleMutex_);
+
+  // Preamble command buffers are implicitly freed with the pool.
+  if (preamblePool_ && commandBuffer->valid()) {
+    preamblePool_->freeCommandBuffers({commandBuffer->id()});
+  }
+}
+
 VulkanInstanceImpl& QueueFamilyImpl::getInstance() const {
   return logicalDevice_.getInstance();
 }
@@ -88,6 +118,10 @@ QueueFamilyImpl::operator uint32_t() const {
 }
 
 void QueueFamilyImpl::free() {
+  {
+    std::lock_guard<std::mutex> lock(preambleMutex_);
+    preamblePool_.reset();
+  }
   VulkanObjectComposite<QueueImpl>::destroyAllObjects();
   VulkanObjectComposite<CommandPoolImpl>::destroyAllObjects();
   VulkanObject::free();
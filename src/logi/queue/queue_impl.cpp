@@ -17,10 +17,13 @@
  */
 
 #include "logi/queue/queue_impl.hpp"
+#include "logi/base/result.hpp"
+#include "logi/command/command_buffer_impl.hpp"
 #include "logi/device/logical_device_impl.hpp"
 #include "logi/device/physical_device_impl.hpp"
 #include "logi/instance/vulkan_instance_impl.hpp"
 #include "logi/queue/queue_family_impl.hpp"
+#include "logi/synchronization/semaphore_impl.hpp"
 
 namespace logi {
 
@@ -28,7 +31,53 @@ QueueImpl::QueueImpl(QueueFamilyImpl& queueFamily, vk::Queue vkQueue) : queueFam
 
 vk::ResultValueType<void>::type QueueImpl::submit(const vk::ArrayProxy<const vk::SubmitInfo>& submits,
                                                   vk::Fence fence) const {
-  return vkQueue_.submit(submits, fence, getDispatcher());
+  LogicalDeviceImpl& logicalDevice = getLogicalDevice();
+#ifdef LOGI_ENABLE_TRACE
+  TraceScope traceScope(logicalDevice.getTraceRecorder(), "vkQueueSubmit", "queue");
+#endif
+  if (!logicalDevice.hasTrackedCommandBuffers()) {
+    vk::Result result = vkQueue_.submit(submits.size(), submits.data(), fence, getDispatcher());
+    if (result == vk::Result::eSuccess) {
+      recordSubmitStatistics(submits);
+    }
+    return checkResult(result, "logi::QueueImpl::submit");
+  }
+
+  // Reconcile resource states of command buffers that use CommandBuffer::transition and insert preamble command
+  // buffers with the barriers that synchronize their first accesses.
+  std::vector<vk::SubmitInfo> reconciledSubmits(submits.begin(), submits.end());
+  std::vector<std::vector<vk::CommandBuffer>> commandBuffers(submits.size());
+  bool preamblesInserted = false;
+
+  for (size_t i = 0u; i < reconciledSubmits.size(); i++) {
+    vk::SubmitInfo& submit = reconciledSubmits[i];
+
+    for (uint32_t j = 0u; j < submit.commandBufferCount; j++) {
+      const vk::CommandBuffer& commandBuffer = submit.pCommandBuffers[j];
+
+      if (const CommandBufferImpl* trackedCommandBuffer = logicalDevice.findTrackedCommandBuffer(commandBuffer)) {
+        vk::CommandBuffer preamble = trackedCommandBuffer->reconcileResourceStates();
+        if (preamble) {
+          commandBuffers[i].emplace_back(preamble);
+          preamblesInserted = true;
+        }
+      }
+
+      commandBuffers[i].emplace_back(commandBuffer);
+    }
+
+    submit.commandBufferCount = static_cast<uint32_t>(commandBuffers[i].size());
+    submit.pCommandBuffers = commandBuffers[i].data();
+  }
+
+  vk::Result result = preamblesInserted
+                        ? vkQueue_.submit(reconciledSubmits.size(), reconciledSubmits.data(), fence, getDispatcher())
+                        : vkQueue_.submit(submits.size(), submits.data(), fence, getDispatcher());
+  if (result == vk::Result::eSuccess) {
+    // Preamble command buffers only contain barriers recorded by Logi and are not counted.
+    recordSubmitStatistics(submits);
+  }
+  return checkResult(result, "logi::QueueImpl::submit");
 }
 
 vk::ResultValueType<void>::type QueueImpl::bindSparse(const vk::ArrayProxy<const vk::BindSparseInfo>& bindInfo,
@@ -37,11 +86,19 @@ vk::ResultValueType<void>::type QueueImpl::bindSparse(const vk::ArrayProxy<const
 }
 
 vk::ResultValueType<void>::type QueueImpl::waitIdle() const {
-  return vkQueue_.waitIdle(getDispatcher());
+#ifdef LOGI_ENABLE_TRACE
+  TraceScope traceScope(getLogicalDevice().getTraceRecorder(), "vkQueueWaitIdle", "wait");
+#endif
+  vk::Result result = static_cast<vk::Result>(getDispatcher().vkQueueWaitIdle(static_cast<VkQueue>(vkQueue_)));
+  return checkResult(result, "logi::QueueImpl::waitIdle");
 }
 
 vk::Result QueueImpl::presentKHR(const vk::PresentInfoKHR& presentInfo) const {
-  return vkQueue_.presentKHR(presentInfo, getDispatcher());
+#ifdef LOGI_ENABLE_TRACE
+  TraceScope traceScope(getLogicalDevice().getTraceRecorder(), "vkQueuePresentKHR", "queue");
+#endif
+  vk::Result result = vkQueue_.presentKHR(&presentInfo, getDispatcher());
+  return checkResult(result, "logi::QueueImpl::presentKHR", {vk::Result::eSuccess, vk::Result::eSuboptimalKHR});
 }
 
 void QueueImpl::beginDebugUtilsLabelEXT(const vk::DebugUtilsLabelEXT& label) const {
@@ -80,11 +137,147 @@ const vk::DispatchLoaderDynamic& QueueImpl::getDispatcher() const {
   return queueFamily_.getDispatcher();
 }
 
+CommandStatistics QueueImpl::getLastSubmitStatistics() const {
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+  std::lock_guard<std::mutex> lock(statisticsMutex_);
+  return lastSubmitStatistics_;
+#else
+  return CommandStatistics();
+#endif
+}
+
+CommandStatistics QueueImpl::getFrameStatistics() const {
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+  std::lock_guard<std::mutex> lock(statisticsMutex_);
+  return frameStatistics_;
+#else
+  return CommandStatistics();
+#endif
+}
+
+CommandStatistics QueueImpl::endStatisticsFrame() const {
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+  std::lock_guard<std::mutex> lock(statisticsMutex_);
+  CommandStatistics statistics = frameStatistics_;
+  frameStatistics_ = CommandStatistics();
+  return statistics;
+#else
+  return CommandStatistics();
+#endif
+}
+
+vk::ResultValueType<GpuFuture>::type QueueImpl::submitFuture(const vk::ArrayProxy<const vk::SubmitInfo>& submits,
+                                                             vk::Fence fence) const {
+  pollGpuFutures();
+
+  std::lock_guard<std::mutex> lock(timelineMutex_);
+  const std::shared_ptr<GpuTimeline>& timeline = acquireGpuTimeline();
+  uint64_t signalValue = timeline->allocateValue();
+  vk::Semaphore semaphore = timeline->getSemaphore();
+
+  // Timeline is signaled by an additional batch. Its signal operation includes all commands submitted before it.
+  vk::TimelineSemaphoreSubmitInfo timelineInfo(0u, nullptr, 1u, &signalValue);
+  vk::SubmitInfo signalSubmit(0u, nullptr, nullptr, 0u, nullptr, 1u, &semaphore);
+  signalSubmit.pNext = &timelineInfo;
+
+  std::vector<vk::SubmitInfo> futureSubmits(submits.begin(), submits.end());
+  futureSubmits.emplace_back(signalSubmit);
+
+  return submitTimeline(futureSubmits, fence, timeline, signalValue);
+}
+
+vk::ResultValueType<GpuFuture>::type
+  QueueImpl::submitFuture(const vk::ArrayProxy<const vk::CommandBuffer>& commandBuffers,
+                          const std::vector<GpuFuture>& waitFutures, vk::PipelineStageFlags waitStages,
+                          vk::Fence fence) const {
+  pollGpuFutures();
+
+  std::vector<vk::Semaphore> waitSemaphores;
+  std::vector<uint64_t> waitValues;
+  GpuFuture::whenAll(waitFutures).appendWaitSemaphores(waitSemaphores, waitValues);
+  std::vector<vk::PipelineStageFlags> waitStageMasks(waitSemaphores.size(), waitStages);
+
+  std::lock_guard<std::mutex> lock(timelineMutex_);
+  const std::shared_ptr<GpuTimeline>& timeline = acquireGpuTimeline();
+  uint64_t signalValue = timeline->allocateValue();
+  vk::Semaphore semaphore = timeline->getSemaphore();
+
+  vk::TimelineSemaphoreSubmitInfo timelineInfo(static_cast<uint32_t>(waitValues.size()), waitValues.data(), 1u,
+                                               &signalValue);
+  vk::SubmitInfo submitInfo(static_cast<uint32_t>(waitSemaphores.size()), waitSemaphores.data(),
+                            waitStageMasks.data(), commandBuffers.size(), commandBuffers.data(), 1u, &semaphore);
+  submitInfo.pNext = &timelineInfo;
+
+  return submitTimeline({submitInfo}, fence, timeline, signalValue);
+}
+
+void QueueImpl::pollGpuFutures() const {
+  std::shared_ptr<GpuTimeline> timeline;
+  {
+    std::lock_guard<std::mutex> lock(timelineMutex_);
+    timeline = timeline_;
+  }
+
+  // Continuations are executed outside of the lock, so that they may submit to this queue.
+  if (timeline) {
+    timeline->poll();
+  }
+}
+
 QueueImpl::operator const vk::Queue&() const {
   return vkQueue_;
 }
 
+void QueueImpl::recordSubmitStatistics(const vk::ArrayProxy<const vk::SubmitInfo>& submits) const {
+#ifdef LOGI_ENABLE_COMMAND_STATISTICS
+  CommandStatistics statistics;
+  getLogicalDevice().accumulateCommandStatistics(submits, statistics);
+
+  std::lock_guard<std::mutex> lock(statisticsMutex_);
+  lastSubmitStatistics_ = statistics;
+  frameStatistics_ += statistics;
+#endif
+}
+
+const std::shared_ptr<GpuTimeline>& QueueImpl::acquireGpuTimeline() const {
+  if (!timeline_) {
+    vk::SemaphoreTypeCreateInfo typeCreateInfo(vk::SemaphoreType::eTimeline, 0u);
+    vk::SemaphoreCreateInfo createInfo;
+    createInfo.pNext = &typeCreateInfo;
+
+    LogicalDeviceImpl& logicalDevice = getLogicalDevice();
+    std::shared_ptr<SemaphoreImpl> semaphore = logicalDevice.createSemaphore(createInfo);
+
+    timeline_ = std::make_shared<GpuTimeline>(
+      *semaphore, [semaphore]() { return semaphore->getCounterValue(); },
+      [&logicalDevice](const vk::SemaphoreWaitInfo& waitInfo, uint64_t timeout) {
+        return logicalDevice.waitSemaphores(waitInfo, timeout);
+      });
+  }
+
+  return timeline_;
+}
+
+vk::ResultValueType<GpuFuture>::type QueueImpl::submitTimeline(const std::vector<vk::SubmitInfo>& submits,
+                                                               vk::Fence fence,
+                                                               const std::shared_ptr<GpuTimeline>& timeline,
+                                                               uint64_t signalValue) const {
+  GpuFuture future(timeline, signalValue);
+#ifdef VULKAN_HPP_NO_EXCEPTIONS
+  vk::Result result = submit(submits, fence);
+#else
+  submit(submits, fence);
+  vk::Result result = vk::Result::eSuccess;
+#endif
+  return checkResult(result, future, "logi::QueueImpl::submitFuture");
+}
+
 void QueueImpl::free() {
+  // The queue can no longer be polled, so the pending continuations are executed before the timeline is released.
+  if (timeline_) {
+    timeline_->flush();
+    timeline_.reset();
+  }
   vkQueue_ = nullptr;
   VulkanObject::free();
 }
@@ -0,0 +1,144 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/queue/submit_batch_list.hpp"
+#include "logi/base/exception.hpp"
+
+namespace logi {
+
+void SubmitBatchList::add(const vk::SubmitInfo& submitInfo) {
+  const vk::TimelineSemaphoreSubmitInfo* timelineInfo = nullptr;
+
+  for (auto* next = reinterpret_cast<const vk::BaseInStructure*>(submitInfo.pNext); next != nullptr;
+       next = next->pNext) {
+    if (next->sType != vk::StructureType::eTimelineSemaphoreSubmitInfo) {
+      throw IllegalInvocation("SubmitBatchList only supports TimelineSemaphoreSubmitInfo in the pNext chain.");
+    }
+    timelineInfo = reinterpret_cast<const vk::TimelineSemaphoreSubmitInfo*>(next);
+  }
+
+  bool mergeable = submitInfo.waitSemaphoreCount == 0u && timelineInfo == nullptr;
+  Batch& batch = nextBatch(mergeable);
+
+  batch.waitSemaphores.insert(batch.waitSemaphores.end(), submitInfo.pWaitSemaphores,
+                              submitInfo.pWaitSemaphores + submitInfo.waitSemaphoreCount);
+  batch.waitStages.insert(batch.waitStages.end(), submitInfo.pWaitDstStageMask,
+                          submitInfo.pWaitDstStageMask + submitInfo.waitSemaphoreCount);
+  batch.commandBuffers.insert(batch.commandBuffers.end(), submitInfo.pCommandBuffers,
+                              submitInfo.pCommandBuffers + submitInfo.commandBufferCount);
+  batch.signalSemaphores.insert(batch.signalSemaphores.end(), submitInfo.pSignalSemaphores,
+                                submitInfo.pSignalSemaphores + submitInfo.signalSemaphoreCount);
+
+  if (timelineInfo != nullptr) {
+    batch.timeline = true;
+    if (timelineInfo->pWaitSemaphoreValues != nullptr) {
+      batch.waitValues.assign(timelineInfo->pWaitSemaphoreValues,
+                              timelineInfo->pWaitSemaphoreValues + timelineInfo->waitSemaphoreValueCount);
+    }
+    if (timelineInfo->pSignalSemaphoreValues != nullptr) {
+      batch.signalValues.assign(timelineInfo->pSignalSemaphoreValues,
+                                timelineInfo->pSignalSemaphoreValues + timelineInfo->signalSemaphoreValueCount);
+    }
+  }
+}
+
+void SubmitBatchList::add(const vk::ArrayProxy<const vk::CommandBuffer>& commandBuffers,
+                          const vk::ArrayProxy<const vk::Semaphore>& waitSemaphores,
+                          const vk::ArrayProxy<const vk::PipelineStageFlags>& waitStages,
+                          const vk::ArrayProxy<const vk::Semaphore>& signalSemaphores) {
+  if (waitSemaphores.size() != waitStages.size()) {
+    throw IllegalInvocation("Number of wait semaphores and wait stages must match.");
+  }
+
+  add(vk::SubmitInfo(waitSemaphores.size(), waitSemaphores.data(), waitStages.data(), commandBuffers.size(),
+                     commandBuffers.data(), signalSemaphores.size(), signalSemaphores.data()));
+}
+
+size_t SubmitBatchList::size() const {
+  return batchCount_;
+}
+
+bool SubmitBatchList::empty() const {
+  return batchCount_ == 0u;
+}
+
+const std::vector<vk::SubmitInfo>& SubmitBatchList::build() {
+  submitInfos_.clear();
+  timelineInfos_.clear();
+  // Reserve upfront so that pNext pointers into timelineInfos_ stay valid.
+  timelineInfos_.reserve(batchCount_);
+
+  for (size_t i = 0u; i < batchCount_; i++) {
+    const Batch& batch = batches_[i];
+    submitInfos_.emplace_back(static_cast<uint32_t>(batch.waitSemaphores.size()), batch.waitSemaphores.data(),
+                              batch.waitStages.data(), static_cast<uint32_t>(batch.commandBuffers.size()),
+                              batch.commandBuffers.data(), static_cast<uint32_t>(batch.signalSemaphores.size()),
+                              batch.signalSemaphores.data());
+
+    if (batch.timeline) {
+      timelineInfos_.emplace_back(static_cast<uint32_t>(batch.waitValues.size()), batch.waitValues.data(),
+                                  static_cast<uint32_t>(batch.signalValues.size()), batch.signalValues.data());
+      submitInfos_.back().pNext = &timelineInfos_.back();
+    }
+  }
+
+  return submitInfos_;
+}
+
+void SubmitBatchList::clear() {
+  for (size_t i = 0u; i < batchCount_; i++) {
+    Batch& batch = batches_[i];
+    batch.waitSemaphores.clear();
+    batch.waitStages.clear();
+    batch.commandBuffers.clear();
+    batch.signalSemaphores.clear();
+    batch.waitValues.clear();
+    batch.signalValues.clear();
+    batch.timeline = false;
+  }
+
+  batchCount_ = 0u;
+  submitInfos_.clear();
+  timelineInfos_.clear();
+}
+
+const SubmitBatchStatistics& SubmitBatchList::getStatistics() const {
+  return statistics_;
+}
+
+SubmitBatchList::Batch& SubmitBatchList::nextBatch(bool mergeable) {
+  statistics_.enqueuedSubmits++;
+
+  // Command buffers of a batch without semaphores may be appended to by a batch that does not wait: the combined batch
+  // starts and signals exactly as the two separate batches would.
+  if (mergeable && batchCount_ > 0u) {
+    Batch& last = batches_[batchCount_ - 1u];
+    if (last.waitSemaphores.empty() && last.signalSemaphores.empty() && !last.timeline) {
+      statistics_.mergedSubmits++;
+      return last;
+    }
+  }
+
+  if (batchCount_ == batches_.size()) {
+    batches_.emplace_back();
+  }
+
+  return batches_[batchCount_++];
+}
+
+} // namespace logi
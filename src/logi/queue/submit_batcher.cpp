@@ -0,0 +1,90 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/queue/submit_batcher.hpp"
+
+namespace logi {
+
+SubmitBatcher::SubmitBatcher(const Queue& queue) : queue_(queue) {}
+
+void SubmitBatcher::enqueue(const vk::SubmitInfo& submitInfo) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  batches_.add(submitInfo);
+}
+
+void SubmitBatcher::enqueue(const vk::ArrayProxy<const vk::CommandBuffer>& commandBuffers,
+                            const vk::ArrayProxy<const vk::Semaphore>& waitSemaphores,
+                            const vk::ArrayProxy<const vk::PipelineStageFlags>& waitStages,
+                            const vk::ArrayProxy<const vk::Semaphore>& signalSemaphores) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  batches_.add(commandBuffers, waitSemaphores, waitStages, signalSemaphores);
+}
+
+vk::ResultValueType<void>::type SubmitBatcher::flush(vk::Fence fence) {
+  // The lock is held during the submit so that concurrent flushes reach the queue in order.
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (batches_.empty() && !fence) {
+#ifdef VULKAN_HPP_NO_EXCEPTIONS
+    return vk::Result::eSuccess;
+#else
+    return;
+#endif
+  }
+
+  const std::vector<vk::SubmitInfo>& submitInfos = batches_.build();
+  flushes_++;
+
+#ifdef VULKAN_HPP_NO_EXCEPTIONS
+  vk::Result result = queue_.submit(submitInfos, fence);
+  batches_.clear();
+  return result;
+#else
+  try {
+    queue_.submit(submitInfos, fence);
+  } catch (...) {
+    batches_.clear();
+    throw;
+  }
+  batches_.clear();
+#endif
+}
+
+size_t SubmitBatcher::getPendingBatchCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return batches_.size();
+}
+
+SubmitBatchStatistics SubmitBatcher::getStatistics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  SubmitBatchStatistics statistics = batches_.getStatistics();
+  statistics.flushes = flushes_;
+  return statistics;
+}
+
+const Queue& SubmitBatcher::getQueue() const {
+  return queue_;
+}
+
+void SubmitBatcher::destroy() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  batches_.clear();
+  queue_ = {};
+}
+
+} // namespace logi
@@ -0,0 +1,506 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/render_graph/render_graph.hpp"
+#include <algorithm>
+#include "logi/base/exception.hpp"
+
+namespace logi {
+
+namespace {
+
+vk::ImageViewType getImageViewType(const RenderGraphImageInfo& info) {
+  switch (info.imageType) {
+    case vk::ImageType::e1D:
+      return info.arrayLayers > 1u ? vk::ImageViewType::e1DArray : vk::ImageViewType::e1D;
+    case vk::ImageType::e3D:
+      return vk::ImageViewType::e3D;
+    default:
+      return info.arrayLayers > 1u ? vk::ImageViewType::e2DArray : vk::ImageViewType::e2D;
+  }
+}
+
+} // namespace
+
+// region RenderGraphPassBuilder
+
+RenderGraphPassBuilder::RenderGraphPassBuilder(RenderGraph& graph, uint32_t pass) : graph_(&graph), pass_(pass) {}
+
+RenderGraphPassBuilder& RenderGraphPassBuilder::read(RenderGraphResource resource, ResourceUsage usage,
+                                                     const vk::ImageSubresourceRange& range) {
+  access(resource, usage, 0u, VK_WHOLE_SIZE);
+  description().accesses.back().imageRange = range;
+  return *this;
+}
+
+RenderGraphPassBuilder& RenderGraphPassBuilder::write(RenderGraphResource resource, ResourceUsage usage,
+                                                      const vk::ImageSubresourceRange& range) {
+  return read(resource, usage, range);
+}
+
+RenderGraphPassBuilder& RenderGraphPassBuilder::access(RenderGraphResource resource, ResourceUsage usage,
+                                                       vk::DeviceSize offset, vk::DeviceSize size) {
+  if (!resource || resource.index >= graph_->resources_.size()) {
+    throw IllegalInvocation("Invalid render graph resource.");
+  }
+
+  RenderGraphAccess access;
+  access.resource = resource;
+  access.usage = usage;
+  access.offset = offset;
+  access.size = size;
+  description().accesses.emplace_back(access);
+  return *this;
+}
+
+RenderGraphPassBuilder& RenderGraphPassBuilder::addColorAttachment(RenderGraphResource resource,
+                                                                   vk::AttachmentLoadOp loadOp,
+                                                                   const vk::ClearValue& clearValue,
+                                                                   vk::AttachmentStoreOp storeOp) {
+  access(resource, ResourceUsage::eColorAttachment, 0u, VK_WHOLE_SIZE);
+
+  RenderGraphAttachment attachment;
+  attachment.resource = resource;
+  attachment.loadOp = loadOp;
+  attachment.storeOp = storeOp;
+  attachment.clearValue = clearValue;
+  description().colorAttachments.emplace_back(attachment);
+  return *this;
+}
+
+RenderGraphPassBuilder& RenderGraphPassBuilder::setDepthStencilAttachment(RenderGraphResource resource,
+                                                                          vk::AttachmentLoadOp loadOp,
+                                                                          const vk::ClearValue& clearValue,
+                                                                          vk::AttachmentStoreOp storeOp,
+                                                                          bool readOnly) {
+  access(resource, readOnly ? ResourceUsage::eDepthStencilRead : ResourceUsage::eDepthStencilAttachment, 0u,
+         VK_WHOLE_SIZE);
+
+  RenderGraphAttachment attachment;
+  attachment.resource = resource;
+  attachment.loadOp = loadOp;
+  attachment.storeOp = storeOp;
+  attachment.clearValue = clearValue;
+  attachment.readOnly = readOnly;
+  description().depthStencilAttachment = attachment;
+  return *this;
+}
+
+RenderGraphPassBuilder& RenderGraphPassBuilder::setSideEffects(bool sideEffects) {
+  description().sideEffects = sideEffects;
+  return *this;
+}
+
+uint32_t RenderGraphPassBuilder::getIndex() const {
+  return pass_;
+}
+
+RenderGraphPassDescription& RenderGraphPassBuilder::description() const {
+  return graph_->passes_[pass_];
+}
+
+// endregion
+
+// region RenderGraph
+
+RenderGraph::RenderGraph(const LogicalDevice& logicalDevice, const MemoryAllocator& memoryAllocator)
+  : logicalDevice_(logicalDevice), memoryAllocator_(memoryAllocator) {}
+
+void RenderGraph::reset() {
+  resources_.clear();
+  importedResources_.clear();
+  passes_.clear();
+  passFunctions_.clear();
+}
+
+RenderGraphResource RenderGraph::createImage(const std::string& name, const RenderGraphImageInfo& info) {
+  RenderGraphResourceDescription description;
+  description.name = name;
+  description.type = RenderGraphResourceType::eImage;
+  description.image = info;
+  return addResource(std::move(description), {});
+}
+
+RenderGraphResource RenderGraph::createBuffer(const std::string& name, const RenderGraphBufferInfo& info) {
+  RenderGraphResourceDescription description;
+  description.name = name;
+  description.type = RenderGraphResourceType::eBuffer;
+  description.buffer = info;
+  return addResource(std::move(description), {});
+}
+
+RenderGraphResource RenderGraph::importImage(const std::string& name, const Image& image, const ImageView& imageView,
+                                             const RenderGraphImageInfo& info, const ResourceAccess& initialAccess,
+                                             const std::optional<ResourceUsage>& finalUsage) {
+  RenderGraphResourceDescription description;
+  description.name = name;
+  description.type = RenderGraphResourceType::eImage;
+  description.image = info;
+  description.image.usage = vk::ImageUsageFlags();
+  description.imported = true;
+  description.initialAccess = initialAccess;
+  description.finalUsage = finalUsage;
+
+  PhysicalResource physicalResource;
+  physicalResource.image = image;
+  physicalResource.imageView = imageView;
+  return addResource(std::move(description), physicalResource);
+}
+
+RenderGraphResource RenderGraph::importBuffer(const std::string& name, const Buffer& buffer, vk::DeviceSize size,
+                                              const ResourceAccess& initialAccess,
+                                              const std::optional<ResourceUsage>& finalUsage) {
+  RenderGraphResourceDescription description;
+  description.name = name;
+  description.type = RenderGraphResourceType::eBuffer;
+  description.buffer.size = size;
+  description.imported = true;
+  description.initialAccess = initialAccess;
+  description.finalUsage = finalUsage;
+
+  PhysicalResource physicalResource;
+  physicalResource.buffer = buffer;
+  return addResource(std::move(description), physicalResource);
+}
+
+RenderGraphPassBuilder RenderGraph::addPass(const std::string& name, RenderGraphExecuteFunction execute) {
+  passes_.emplace_back();
+  passes_.back().name = name;
+  passFunctions_.emplace_back(Pass {std::move(execute)});
+  return RenderGraphPassBuilder(*this, static_cast<uint32_t>(passes_.size() - 1u));
+}
+
+bool RenderGraph::compile() {
+  if (compiled_ && resources_ == compiledResources_ && passes_.size() == compiledPasses_.size() &&
+      std::equal(passes_.begin(), passes_.end(), compiledPasses_.begin(),
+                 [](const RenderGraphPassDescription& lhs, const RenderGraphPassDescription& rhs) {
+                   return lhs.hasSameTopology(rhs);
+                 })) {
+    return false;
+  }
+
+  destroyResources();
+  compiledResources_ = resources_;
+  compiledPasses_ = passes_;
+  createResources();
+  createRenderPasses();
+
+  compiled_ = true;
+  compileCount_++;
+  return true;
+}
+
+void RenderGraph::execute(const CommandBuffer& commandBuffer) {
+  compile();
+
+  for (const RenderGraphScheduledPass& scheduledPass : plan_.getPasses()) {
+    recordBarriers(commandBuffer, scheduledPass.barriers);
+
+    const RenderGraphPassDescription& pass = passes_[scheduledPass.pass];
+    const RenderGraphExecuteFunction& execute = passFunctions_[scheduledPass.pass].execute;
+
+    if (!pass.isGraphics()) {
+      if (execute) {
+        execute(commandBuffer, *this);
+      }
+      continue;
+    }
+
+    GraphicsPass& graphicsPass = graphicsPasses_[scheduledPass.pass];
+    clearValues_.clear();
+    for (const RenderGraphAttachment& attachment : pass.colorAttachments) {
+      clearValues_.emplace_back(attachment.clearValue);
+    }
+    if (pass.depthStencilAttachment) {
+      clearValues_.emplace_back(pass.depthStencilAttachment->clearValue);
+    }
+
+    vk::RenderPassBeginInfo beginInfo(static_cast<const vk::RenderPass&>(graphicsPass.renderPass),
+                                      static_cast<const vk::Framebuffer&>(getFramebuffer(graphicsPass, pass)),
+                                      vk::Rect2D(vk::Offset2D(0, 0), graphicsPass.extent),
+                                      static_cast<uint32_t>(clearValues_.size()), clearValues_.data());
+    commandBuffer.beginRenderPass(beginInfo, vk::SubpassContents::eInline);
+    if (execute) {
+      execute(commandBuffer, *this);
+    }
+    commandBuffer.endRenderPass();
+  }
+
+  recordBarriers(commandBuffer, plan_.getFinalBarriers());
+}
+
+vk::Image RenderGraph::getImage(RenderGraphResource resource) const {
+  const PhysicalResource& physicalResource = getPhysicalResource(resource);
+  return physicalResource.image ? static_cast<const vk::Image&>(physicalResource.image) : vk::Image();
+}
+
+const ImageView& RenderGraph::getImageView(RenderGraphResource resource) const {
+  return getPhysicalResource(resource).imageView;
+}
+
+vk::Buffer RenderGraph::getBuffer(RenderGraphResource resource) const {
+  const PhysicalResource& physicalResource = getPhysicalResource(resource);
+  return physicalResource.buffer ? static_cast<const vk::Buffer&>(physicalResource.buffer) : vk::Buffer();
+}
+
+const RenderPass& RenderGraph::getRenderPass(uint32_t pass) const {
+  return graphicsPasses_.at(pass).renderPass;
+}
+
+const RenderGraphPlan& RenderGraph::getPlan() const {
+  return plan_;
+}
+
+size_t RenderGraph::getCompileCount() const {
+  return compileCount_;
+}
+
+void RenderGraph::destroy() {
+  destroyResources();
+  reset();
+  compiledResources_.clear();
+  compiledPasses_.clear();
+  compiled_ = false;
+}
+
+RenderGraphResource RenderGraph::addResource(RenderGraphResourceDescription description,
+                                             PhysicalResource physicalResource) {
+  resources_.emplace_back(std::move(description));
+  importedResources_.emplace_back(std::move(physicalResource));
+  return RenderGraphResource {static_cast<uint32_t>(resources_.size() - 1u)};
+}
+
+void RenderGraph::createResources() {
+  transientResources_.assign(resources_.size(), PhysicalResource());
+
+  // Resources are created unbound while the plan assigns alias slots, which need their memory requirements.
+  plan_.compile(resources_, passes_, [this](uint32_t resource) {
+    const RenderGraphResourceDescription& description = resources_[resource];
+    PhysicalResource& physicalResource = transientResources_[resource];
+
+    if (description.type == RenderGraphResourceType::eBuffer) {
+      vk::BufferCreateInfo createInfo({}, description.buffer.size, plan_.getBufferUsage(resource),
+                                      vk::SharingMode::eExclusive);
+      physicalResource.buffer = logicalDevice_.createBuffer(createInfo);
+      return physicalResource.buffer.getMemoryRequirements();
+    }
+
+    const RenderGraphImageInfo& info = description.image;
+    vk::ImageCreateInfo createInfo({}, info.imageType, info.format, info.extent, info.mipLevels, info.arrayLayers,
+                                   info.samples, vk::ImageTiling::eOptimal, plan_.getImageUsage(resource),
+                                   vk::SharingMode::eExclusive);
+    physicalResource.image = logicalDevice_.createImage(createInfo);
+    return physicalResource.image.getMemoryRequirements();
+  });
+
+  // One allocation per alias slot, bound to all of its resources.
+  auto vmaAllocator = static_cast<const VmaAllocator&>(memoryAllocator_);
+  VmaAllocationCreateInfo allocationCreateInfo = {};
+  allocationCreateInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+  for (const RenderGraphAliasSlot& slot : plan_.getAliasSlots()) {
+    VmaAllocation allocation = VK_NULL_HANDLE;
+    VkResult result =
+      vmaAllocateMemory(vmaAllocator, reinterpret_cast<const VkMemoryRequirements*>(&slot.memoryRequirements),
+                        &allocationCreateInfo, &allocation, nullptr);
+    if (result != VK_SUCCESS) {
+      throw BadAllocation("Failed to allocate memory for render graph resources.");
+    }
+    allocations_.emplace_back(allocation);
+
+    for (uint32_t resource : slot.resources) {
+      PhysicalResource& physicalResource = transientResources_[resource];
+      if (slot.type == RenderGraphResourceType::eBuffer) {
+        result = vmaBindBufferMemory(vmaAllocator, allocation,
+                                     static_cast<VkBuffer>(static_cast<const vk::Buffer&>(physicalResource.buffer)));
+      } else {
+        result = vmaBindImageMemory(vmaAllocator, allocation,
+                                    static_cast<VkImage>(static_cast<const vk::Image&>(physicalResource.image)));
+      }
+
+      if (result != VK_SUCCESS) {
+        throw BadAllocation("Failed to bind memory of render graph resource.");
+      }
+    }
+  }
+
+  // Views of the whole images.
+  for (size_t i = 0u; i < resources_.size(); i++) {
+    PhysicalResource& physicalResource = transientResources_[i];
+    if (physicalResource.image) {
+      const RenderGraphImageInfo& info = resources_[i].image;
+      physicalResource.imageView = physicalResource.image.createImageView(
+        {}, getImageViewType(info), info.format, vk::ComponentMapping(),
+        vk::ImageSubresourceRange(info.aspectMask, 0u, info.mipLevels, 0u, info.arrayLayers));
+    }
+  }
+}
+
+void RenderGraph::createRenderPasses() {
+  graphicsPasses_.assign(passes_.size(), GraphicsPass());
+
+  for (const RenderGraphScheduledPass& scheduledPass : plan_.getPasses()) {
+    const RenderGraphPassDescription& pass = passes_[scheduledPass.pass];
+    if (!pass.isGraphics()) {
+      continue;
+    }
+
+    // Layouts do not change inside of the render pass, transitions are recorded by the graph.
+    std::vector<vk::AttachmentDescription> attachments;
+    std::vector<vk::AttachmentReference> colorReferences;
+    vk::AttachmentReference depthStencilReference;
+
+    for (const RenderGraphAttachment& attachment : pass.colorAttachments) {
+      const RenderGraphImageInfo& info = resources_[attachment.resource.index].image;
+      colorReferences.emplace_back(static_cast<uint32_t>(attachments.size()), vk::ImageLayout::eColorAttachmentOptimal);
+      attachments.emplace_back(vk::AttachmentDescriptionFlags(), info.format, info.samples, attachment.loadOp,
+                               attachment.storeOp, vk::AttachmentLoadOp::eDontCare, vk::AttachmentStoreOp::eDontCare,
+                               vk::ImageLayout::eColorAttachmentOptimal, vk::ImageLayout::eColorAttachmentOptimal);
+    }
+
+    if (pass.depthStencilAttachment) {
+      const RenderGraphAttachment& attachment = *pass.depthStencilAttachment;
+      const RenderGraphImageInfo& info = resources_[attachment.resource.index].image;
+      vk::ImageLayout layout = attachment.readOnly ? vk::ImageLayout::eDepthStencilReadOnlyOptimal
+                                                   : vk::ImageLayout::eDepthStencilAttachmentOptimal;
+      bool stencil = static_cast<bool>(info.aspectMask & vk::ImageAspectFlagBits::eStencil);
+
+      depthStencilReference = vk::AttachmentReference(static_cast<uint32_t>(attachments.size()), layout);
+      attachments.emplace_back(vk::AttachmentDescriptionFlags(), info.format, info.samples, attachment.loadOp,
+                               attachment.storeOp, stencil ? attachment.loadOp : vk::AttachmentLoadOp::eDontCare,
+                               stencil ? attachment.storeOp : vk::AttachmentStoreOp::eDontCare, layout, layout);
+    }
+
+    vk::SubpassDescription subpass({}, vk::PipelineBindPoint::eGraphics, 0u, nullptr,
+                                   static_cast<uint32_t>(colorReferences.size()), colorReferences.data(), nullptr,
+                                   pass.depthStencilAttachment ? &depthStencilReference : nullptr);
+    vk::RenderPassCreateInfo createInfo({}, static_cast<uint32_t>(attachments.size()), attachments.data(), 1u,
+                                        &subpass);
+
+    GraphicsPass& graphicsPass = graphicsPasses_[scheduledPass.pass];
+    graphicsPass.renderPass = logicalDevice_.createRenderPass(createInfo);
+
+    const RenderGraphAttachment& firstAttachment =
+      pass.colorAttachments.empty() ? *pass.depthStencilAttachment : pass.colorAttachments.front();
+    const vk::Extent3D& extent = resources_[firstAttachment.resource.index].image.extent;
+    graphicsPass.extent = vk::Extent2D(extent.width, extent.height);
+  }
+}
+
+void RenderGraph::destroyResources() {
+  for (GraphicsPass& graphicsPass : graphicsPasses_) {
+    for (CachedFramebuffer& entry : graphicsPass.framebuffers) {
+      entry.framebuffer.destroy();
+    }
+    if (graphicsPass.renderPass) {
+      graphicsPass.renderPass.destroy();
+    }
+  }
+  graphicsPasses_.clear();
+
+  // Image views are destroyed together with their images.
+  for (PhysicalResource& physicalResource : transientResources_) {
+    if (physicalResource.image) {
+      physicalResource.image.destroy();
+    }
+    if (physicalResource.buffer) {
+      physicalResource.buffer.destroy();
+    }
+  }
+  transientResources_.clear();
+
+  if (!allocations_.empty()) {
+    auto vmaAllocator = static_cast<const VmaAllocator&>(memoryAllocator_);
+    for (VmaAllocation allocation : allocations_) {
+      vmaFreeMemory(vmaAllocator, allocation);
+    }
+    allocations_.clear();
+  }
+}
+
+const Framebuffer& RenderGraph::getFramebuffer(GraphicsPass& graphicsPass, const RenderGraphPassDescription& pass) {
+  std::vector<ImageView> key;
+  for (const RenderGraphAttachment& attachment : pass.colorAttachments) {
+    key.emplace_back(getImageView(attachment.resource));
+  }
+  if (pass.depthStencilAttachment) {
+    key.emplace_back(getImageView(pass.depthStencilAttachment->resource));
+  }
+
+  // Framebuffers of destroyed views (e.g. of a recreated swapchain) can no longer be used. Views are keyed by their
+  // Logi objects, which stay distinct even if the driver reuses the Vulkan handle of a destroyed view.
+  auto stale = std::remove_if(graphicsPass.framebuffers.begin(), graphicsPass.framebuffers.end(),
+                              [](const CachedFramebuffer& entry) {
+                                return std::any_of(entry.attachments.begin(), entry.attachments.end(),
+                                                   [](const ImageView& view) { return !view; });
+                              });
+  for (auto it = stale; it != graphicsPass.framebuffers.end(); ++it) {
+    it->framebuffer.destroy();
+  }
+  graphicsPass.framebuffers.erase(stale, graphicsPass.framebuffers.end());
+
+  // Imported images (e.g. swapchain images) may change every frame, hence framebuffers are cached per set of views.
+  for (const CachedFramebuffer& entry : graphicsPass.framebuffers) {
+    if (entry.attachments == key) {
+      return entry.framebuffer;
+    }
+  }
+
+  std::vector<vk::ImageView> attachments;
+  for (const ImageView& view : key) {
+    attachments.emplace_back(static_cast<const vk::ImageView&>(view));
+  }
+  vk::FramebufferCreateInfo createInfo({}, static_cast<const vk::RenderPass&>(graphicsPass.renderPass),
+                                       static_cast<uint32_t>(attachments.size()), attachments.data(),
+                                       graphicsPass.extent.width, graphicsPass.extent.height, 1u);
+  graphicsPass.framebuffers.push_back({std::move(key), logicalDevice_.createFramebuffer(createInfo)});
+  return graphicsPass.framebuffers.back().framebuffer;
+}
+
+void RenderGraph::recordBarriers(const CommandBuffer& commandBuffer, const RenderGraphBarriers& barriers) {
+  if (barriers.empty()) {
+    return;
+  }
+
+  // Resolve the handles of the resources in the current frame.
+  imageBarriers_ = barriers.barriers.imageBarriers;
+  for (size_t i = 0u; i < imageBarriers_.size(); i++) {
+    imageBarriers_[i].image = getImage(RenderGraphResource {barriers.imageResources[i]});
+  }
+
+  bufferBarriers_ = barriers.barriers.bufferBarriers;
+  for (size_t i = 0u; i < bufferBarriers_.size(); i++) {
+    bufferBarriers_[i].buffer = getBuffer(RenderGraphResource {barriers.bufferResources[i]});
+  }
+
+  commandBuffer.pipelineBarrier(barriers.barriers.srcStageMask, barriers.barriers.dstStageMask, {}, {},
+                                bufferBarriers_, imageBarriers_);
+}
+
+const RenderGraph::PhysicalResource& RenderGraph::getPhysicalResource(RenderGraphResource resource) const {
+  if (!resource || resource.index >= resources_.size()) {
+    throw IllegalInvocation("Invalid render graph resource.");
+  }
+
+  return resources_[resource.index].imported ? importedResources_[resource.index]
+                                             : transientResources_.at(resource.index);
+}
+
+// endregion
+
+} // namespace logi
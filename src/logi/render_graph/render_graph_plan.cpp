@@ -0,0 +1,551 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/render_graph/render_graph_plan.hpp"
+#include <algorithm>
+
+namespace logi {
+
+namespace {
+
+const vk::AccessFlags kWriteAccessMask =
+  vk::AccessFlagBits::eShaderWrite | vk::AccessFlagBits::eColorAttachmentWrite |
+  vk::AccessFlagBits::eDepthStencilAttachmentWrite | vk::AccessFlagBits::eTransferWrite |
+  vk::AccessFlagBits::eHostWrite | vk::AccessFlagBits::eMemoryWrite;
+
+bool isWrite(ResourceUsage usage) {
+  return static_cast<bool>(getResourceAccess(usage).accessMask & kWriteAccessMask);
+}
+
+/**
+ * @brief Placeholder handle of a buffer resource in the plan barriers. Barriers of adjacent ranges are merged when
+ *        their buffers match, so each resource needs a distinct handle. Replaced by the physical buffer at execution.
+ */
+vk::Buffer getPlaceholderBuffer(uint32_t resource) {
+  // Functional cast, since VkBuffer is a pointer on 64-bit platforms and an integer otherwise.
+  return vk::Buffer(VkBuffer(static_cast<uintptr_t>(resource) + 1u));
+}
+
+/**
+ * @brief Load operation of the attachment that corresponds to the access or eLoad if the access is not an attachment.
+ */
+vk::AttachmentLoadOp getLoadOp(const RenderGraphPassDescription& pass, const RenderGraphAccess& access) {
+  for (const RenderGraphAttachment& attachment : pass.colorAttachments) {
+    if (attachment.resource.index == access.resource.index && access.usage == ResourceUsage::eColorAttachment) {
+      return attachment.loadOp;
+    }
+  }
+  if (pass.depthStencilAttachment && pass.depthStencilAttachment->resource.index == access.resource.index &&
+      access.usage == ResourceUsage::eDepthStencilAttachment) {
+    return pass.depthStencilAttachment->loadOp;
+  }
+
+  return vk::AttachmentLoadOp::eLoad;
+}
+
+/**
+ * @brief Accesses that do not write read the resource. Attachments that are cleared or not loaded are only written.
+ */
+bool isRead(const RenderGraphPassDescription& pass, const RenderGraphAccess& access) {
+  ResourceAccess resourceAccess = getResourceAccess(access.usage);
+  if (!(resourceAccess.accessMask & kWriteAccessMask)) {
+    return true;
+  }
+
+  return (resourceAccess.accessMask & ~kWriteAccessMask) && getLoadOp(pass, access) == vk::AttachmentLoadOp::eLoad;
+}
+
+vk::ImageUsageFlags getImageUsageFlags(ResourceUsage usage) {
+  switch (usage) {
+    case ResourceUsage::eTransferSrc:
+      return vk::ImageUsageFlagBits::eTransferSrc;
+    case ResourceUsage::eTransferDst:
+      return vk::ImageUsageFlagBits::eTransferDst;
+    case ResourceUsage::eVertexShaderRead:
+    case ResourceUsage::eFragmentShaderRead:
+    case ResourceUsage::eComputeShaderRead:
+      return vk::ImageUsageFlagBits::eSampled;
+    case ResourceUsage::eComputeShaderWrite:
+    case ResourceUsage::eComputeShaderReadWrite:
+    case ResourceUsage::eGeneral:
+      return vk::ImageUsageFlagBits::eStorage;
+    case ResourceUsage::eColorAttachment:
+      return vk::ImageUsageFlagBits::eColorAttachment;
+    case ResourceUsage::eDepthStencilAttachment:
+      return vk::ImageUsageFlagBits::eDepthStencilAttachment;
+    case ResourceUsage::eDepthStencilRead:
+      return vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eSampled;
+    default:
+      return {};
+  }
+}
+
+vk::BufferUsageFlags getBufferUsageFlags(ResourceUsage usage) {
+  switch (usage) {
+    case ResourceUsage::eTransferSrc:
+      return vk::BufferUsageFlagBits::eTransferSrc;
+    case ResourceUsage::eTransferDst:
+      return vk::BufferUsageFlagBits::eTransferDst;
+    case ResourceUsage::eVertexBuffer:
+      return vk::BufferUsageFlagBits::eVertexBuffer;
+    case ResourceUsage::eIndexBuffer:
+      return vk::BufferUsageFlagBits::eIndexBuffer;
+    case ResourceUsage::eIndirectBuffer:
+      return vk::BufferUsageFlagBits::eIndirectBuffer;
+    case ResourceUsage::eUniformBuffer:
+      return vk::BufferUsageFlagBits::eUniformBuffer;
+    case ResourceUsage::eVertexShaderRead:
+    case ResourceUsage::eFragmentShaderRead:
+    case ResourceUsage::eComputeShaderRead:
+    case ResourceUsage::eComputeShaderWrite:
+    case ResourceUsage::eComputeShaderReadWrite:
+    case ResourceUsage::eGeneral:
+      return vk::BufferUsageFlagBits::eStorageBuffer;
+    default:
+      return {};
+  }
+}
+
+} // namespace
+
+// region Descriptions
+
+bool RenderGraphImageInfo::operator==(const RenderGraphImageInfo& other) const {
+  return format == other.format && extent == other.extent && imageType == other.imageType &&
+         mipLevels == other.mipLevels && arrayLayers == other.arrayLayers && samples == other.samples &&
+         aspectMask == other.aspectMask && usage == other.usage;
+}
+
+bool RenderGraphBufferInfo::operator==(const RenderGraphBufferInfo& other) const {
+  return size == other.size && usage == other.usage;
+}
+
+bool RenderGraphResourceDescription::operator==(const RenderGraphResourceDescription& other) const {
+  return name == other.name && type == other.type && image == other.image && buffer == other.buffer &&
+         imported == other.imported && initialAccess == other.initialAccess && finalUsage == other.finalUsage;
+}
+
+bool RenderGraphAccess::operator==(const RenderGraphAccess& other) const {
+  return resource.index == other.resource.index && usage == other.usage && imageRange == other.imageRange &&
+         offset == other.offset && size == other.size;
+}
+
+bool RenderGraphPassDescription::hasSameTopology(const RenderGraphPassDescription& other) const {
+  auto sameAttachment = [](const RenderGraphAttachment& lhs, const RenderGraphAttachment& rhs) {
+    return lhs.resource.index == rhs.resource.index && lhs.loadOp == rhs.loadOp && lhs.storeOp == rhs.storeOp &&
+           lhs.readOnly == rhs.readOnly;
+  };
+
+  if (name != other.name || accesses != other.accesses || sideEffects != other.sideEffects ||
+      colorAttachments.size() != other.colorAttachments.size() ||
+      depthStencilAttachment.has_value() != other.depthStencilAttachment.has_value()) {
+    return false;
+  }
+
+  for (size_t i = 0u; i < colorAttachments.size(); i++) {
+    if (!sameAttachment(colorAttachments[i], other.colorAttachments[i])) {
+      return false;
+    }
+  }
+
+  return !depthStencilAttachment || sameAttachment(*depthStencilAttachment, *other.depthStencilAttachment);
+}
+
+// endregion
+
+void RenderGraphPlan::compile(const std::vector<RenderGraphResourceDescription>& resources,
+                              const std::vector<RenderGraphPassDescription>& passes,
+                              const MemoryRequirementsFunction& getMemoryRequirements) {
+  std::vector<bool> needed;
+  cull(resources, passes, needed);
+  schedule(resources, passes, needed);
+  computeUsage(resources, passes);
+  assignAliasSlots(resources, getMemoryRequirements);
+  computeBarriers(resources, passes);
+}
+
+const std::vector<RenderGraphScheduledPass>& RenderGraphPlan::getPasses() const {
+  return passes_;
+}
+
+const RenderGraphBarriers& RenderGraphPlan::getFinalBarriers() const {
+  return finalBarriers_;
+}
+
+size_t RenderGraphPlan::getCulledPassCount() const {
+  return culledPassCount_;
+}
+
+const RenderGraphLifetime& RenderGraphPlan::getLifetime(uint32_t resource) const {
+  return lifetimes_.at(resource);
+}
+
+vk::ImageUsageFlags RenderGraphPlan::getImageUsage(uint32_t resource) const {
+  return imageUsage_.at(resource);
+}
+
+vk::BufferUsageFlags RenderGraphPlan::getBufferUsage(uint32_t resource) const {
+  return bufferUsage_.at(resource);
+}
+
+const std::vector<RenderGraphAliasSlot>& RenderGraphPlan::getAliasSlots() const {
+  return aliasSlots_;
+}
+
+uint32_t RenderGraphPlan::getAliasSlot(uint32_t resource) const {
+  return resourceAliasSlots_.at(resource);
+}
+
+void RenderGraphPlan::cull(const std::vector<RenderGraphResourceDescription>& resources,
+                           const std::vector<RenderGraphPassDescription>& passes, std::vector<bool>& needed) const {
+  // Walk passes backwards. A pass is needed if it has side effects or writes a resource that is read later by a needed
+  // pass. Imported resources are visible outside of the graph, hence they are always live.
+  std::vector<bool> live(resources.size());
+  for (size_t i = 0u; i < resources.size(); i++) {
+    live[i] = resources[i].imported;
+  }
+
+  needed.assign(passes.size(), false);
+
+  for (size_t i = passes.size(); i-- > 0u;) {
+    const RenderGraphPassDescription& pass = passes[i];
+
+    bool passNeeded = pass.sideEffects;
+    for (const RenderGraphAccess& access : pass.accesses) {
+      passNeeded = passNeeded || (isWrite(access.usage) && live[access.resource.index]);
+    }
+
+    if (!passNeeded) {
+      continue;
+    }
+
+    needed[i] = true;
+    for (const RenderGraphAccess& access : pass.accesses) {
+      if (isRead(pass, access)) {
+        live[access.resource.index] = true;
+      }
+    }
+  }
+}
+
+void RenderGraphPlan::schedule(const std::vector<RenderGraphResourceDescription>& resources,
+                               const std::vector<RenderGraphPassDescription>& passes,
+                               const std::vector<bool>& needed) {
+  constexpr uint32_t kNone = ~0u;
+  size_t passCount = passes.size();
+
+  // Build dependencies in declaration order: read after write, write after write and write after read.
+  std::vector<std::vector<uint32_t>> successors(passCount);
+  std::vector<uint32_t> predecessorCount(passCount, 0u);
+  std::vector<uint32_t> lastWriters(resources.size(), kNone);
+  std::vector<std::vector<uint32_t>> readers(resources.size());
+  uint32_t lastSideEffectPass = kNone;
+  std::vector<uint32_t> dependencies;
+
+  auto addDependency = [&](uint32_t from, uint32_t to) {
+    if (from == kNone || from == to) {
+      return;
+    }
+    std::vector<uint32_t>& fromSuccessors = successors[from];
+    if (std::find(fromSuccessors.begin(), fromSuccessors.end(), to) == fromSuccessors.end()) {
+      fromSuccessors.emplace_back(to);
+      predecessorCount[to]++;
+    }
+  };
+
+  for (uint32_t i = 0u; i < passCount; i++) {
+    if (!needed[i]) {
+      continue;
+    }
+
+    const RenderGraphPassDescription& pass = passes[i];
+    for (const RenderGraphAccess& access : pass.accesses) {
+      uint32_t resource = access.resource.index;
+      addDependency(lastWriters[resource], i);
+      if (isWrite(access.usage)) {
+        for (uint32_t reader : readers[resource]) {
+          addDependency(reader, i);
+        }
+      }
+    }
+
+    // Side effects are not visible to the graph, hence passes with side effects keep their relative order.
+    if (pass.sideEffects) {
+      addDependency(lastSideEffectPass, i);
+      lastSideEffectPass = i;
+    }
+
+    for (const RenderGraphAccess& access : pass.accesses) {
+      uint32_t resource = access.resource.index;
+      if (isWrite(access.usage)) {
+        lastWriters[resource] = i;
+        readers[resource].clear();
+      } else {
+        readers[resource].emplace_back(i);
+      }
+    }
+  }
+
+  // Topological order. Among the ready passes prefer the first one that does not depend on the previously scheduled
+  // pass, which moves consumers away from their producers and gives the GPU independent work between them.
+  passes_.clear();
+  culledPassCount_ = 0u;
+  std::vector<uint32_t> ready;
+  for (uint32_t i = 0u; i < passCount; i++) {
+    if (!needed[i]) {
+      culledPassCount_++;
+    } else if (predecessorCount[i] == 0u) {
+      ready.emplace_back(i);
+    }
+  }
+
+  uint32_t previous = kNone;
+  while (!ready.empty()) {
+    auto next = ready.begin();
+    if (previous != kNone) {
+      const std::vector<uint32_t>& previousSuccessors = successors[previous];
+      auto independent = std::find_if(ready.begin(), ready.end(), [&](uint32_t pass) {
+        return std::find(previousSuccessors.begin(), previousSuccessors.end(), pass) == previousSuccessors.end();
+      });
+      if (independent != ready.end()) {
+        next = independent;
+      }
+    }
+
+    uint32_t pass = *next;
+    ready.erase(next);
+    passes_.emplace_back();
+    passes_.back().pass = pass;
+
+    for (uint32_t successor : successors[pass]) {
+      if (--predecessorCount[successor] == 0u) {
+        ready.insert(std::upper_bound(ready.begin(), ready.end(), successor), successor);
+      }
+    }
+    previous = pass;
+  }
+
+  // Lifetimes in execution order.
+  lifetimes_.assign(resources.size(), RenderGraphLifetime());
+  for (uint32_t position = 0u; position < passes_.size(); position++) {
+    for (const RenderGraphAccess& access : passes[passes_[position].pass].accesses) {
+      RenderGraphLifetime& lifetime = lifetimes_[access.resource.index];
+      if (!lifetime.used()) {
+        lifetime.firstPass = position;
+      }
+      lifetime.lastPass = position;
+    }
+  }
+}
+
+void RenderGraphPlan::computeUsage(const std::vector<RenderGraphResourceDescription>& resources,
+                                   const std::vector<RenderGraphPassDescription>& passes) {
+  imageUsage_.assign(resources.size(), vk::ImageUsageFlags());
+  bufferUsage_.assign(resources.size(), vk::BufferUsageFlags());
+
+  for (size_t i = 0u; i < resources.size(); i++) {
+    imageUsage_[i] = resources[i].image.usage;
+    bufferUsage_[i] = resources[i].buffer.usage;
+  }
+
+  for (const RenderGraphScheduledPass& scheduledPass : passes_) {
+    for (const RenderGraphAccess& access : passes[scheduledPass.pass].accesses) {
+      uint32_t resource = access.resource.index;
+      if (resources[resource].type == RenderGraphResourceType::eImage) {
+        imageUsage_[resource] |= getImageUsageFlags(access.usage);
+      } else {
+        bufferUsage_[resource] |= getBufferUsageFlags(access.usage);
+      }
+    }
+  }
+}
+
+void RenderGraphPlan::assignAliasSlots(const std::vector<RenderGraphResourceDescription>& resources,
+                                       const MemoryRequirementsFunction& getMemoryRequirements) {
+  std::vector<uint32_t> transients;
+  for (uint32_t i = 0u; i < resources.size(); i++) {
+    if (!resources[i].imported && lifetimes_[i].used()) {
+      transients.emplace_back(i);
+    }
+  }
+  std::stable_sort(transients.begin(), transients.end(), [this](uint32_t lhs, uint32_t rhs) {
+    return lifetimes_[lhs].firstPass < lifetimes_[rhs].firstPass;
+  });
+
+  aliasSlots_.clear();
+  resourceAliasSlots_.assign(resources.size(), kNoAliasSlot);
+
+  for (uint32_t resource : transients) {
+    vk::MemoryRequirements requirements = getMemoryRequirements(resource);
+    const RenderGraphLifetime& lifetime = lifetimes_[resource];
+
+    // Best fit among the slots whose last resource is no longer used and that share a memory type.
+    uint32_t bestSlot = kNoAliasSlot;
+    vk::DeviceSize bestGrowth = 0u;
+    for (uint32_t i = 0u; i < aliasSlots_.size(); i++) {
+      const RenderGraphAliasSlot& slot = aliasSlots_[i];
+      if (slot.type != resources[resource].type || lifetimes_[slot.resources.back()].lastPass >= lifetime.firstPass ||
+          !(slot.memoryRequirements.memoryTypeBits & requirements.memoryTypeBits)) {
+        continue;
+      }
+
+      vk::DeviceSize size = slot.memoryRequirements.size;
+      vk::DeviceSize growth = requirements.size > size ? requirements.size - size : 0u;
+      if (bestSlot == kNoAliasSlot || growth < bestGrowth) {
+        bestSlot = i;
+        bestGrowth = growth;
+      }
+    }
+
+    if (bestSlot == kNoAliasSlot) {
+      bestSlot = static_cast<uint32_t>(aliasSlots_.size());
+      aliasSlots_.emplace_back();
+      aliasSlots_.back().type = resources[resource].type;
+      aliasSlots_.back().memoryRequirements = requirements;
+    }
+
+    RenderGraphAliasSlot& slot = aliasSlots_[bestSlot];
+    slot.memoryRequirements.size = std::max(slot.memoryRequirements.size, requirements.size);
+    slot.memoryRequirements.alignment = std::max(slot.memoryRequirements.alignment, requirements.alignment);
+    slot.memoryRequirements.memoryTypeBits &= requirements.memoryTypeBits;
+    slot.resources.emplace_back(resource);
+    resourceAliasSlots_[resource] = bestSlot;
+  }
+}
+
+void RenderGraphPlan::computeBarriers(const std::vector<RenderGraphResourceDescription>& resources,
+                                      const std::vector<RenderGraphPassDescription>& passes) {
+  // Stages and writes of each resource over the whole graph. The first use of a transient resource must wait for the
+  // previous resource in its alias slot, which for the first resource is the last one of the previous execution.
+  std::vector<vk::PipelineStageFlags> stageMasks(resources.size());
+  std::vector<vk::AccessFlags> writeAccessMasks(resources.size());
+  for (const RenderGraphScheduledPass& scheduledPass : passes_) {
+    for (const RenderGraphAccess& access : passes[scheduledPass.pass].accesses) {
+      ResourceAccess resourceAccess = getResourceAccess(access.usage);
+      stageMasks[access.resource.index] |= resourceAccess.stageMask;
+      writeAccessMasks[access.resource.index] |= resourceAccess.accessMask & kWriteAccessMask;
+    }
+  }
+
+  std::vector<uint32_t> predecessors(resources.size(), RenderGraphResource::kInvalidIndex);
+  for (const RenderGraphAliasSlot& slot : aliasSlots_) {
+    for (size_t i = 0u; i < slot.resources.size(); i++) {
+      predecessors[slot.resources[i]] = slot.resources[i > 0u ? i - 1u : slot.resources.size() - 1u];
+    }
+  }
+
+  // Transient resources start undefined, imported resources start in their initial state.
+  std::vector<ImageState> imageStates(resources.size());
+  std::vector<BufferState> bufferStates(resources.size());
+  ResourceBarriers seedBarriers;
+
+  for (size_t i = 0u; i < resources.size(); i++) {
+    const RenderGraphResourceDescription& resource = resources[i];
+    vk::ImageLayout initialLayout = resource.imported ? resource.initialAccess.layout : vk::ImageLayout::eUndefined;
+
+    if (resource.type == RenderGraphResourceType::eImage) {
+      imageStates[i] = ImageState(vk::Image(), resource.image.aspectMask, resource.image.mipLevels,
+                                  resource.image.arrayLayers, initialLayout);
+      if (resource.imported && resource.initialAccess.stageMask) {
+        imageStates[i].transition(RenderGraphAccess().imageRange, resource.initialAccess, false, seedBarriers);
+      }
+    } else {
+      bufferStates[i] = BufferState(getPlaceholderBuffer(static_cast<uint32_t>(i)), resource.buffer.size, true);
+      if (resource.imported && resource.initialAccess.stageMask) {
+        bufferStates[i].transition(0u, VK_WHOLE_SIZE, resource.initialAccess, seedBarriers);
+      }
+    }
+  }
+
+  auto collect = [](RenderGraphBarriers& barriers, uint32_t resource, size_t imageCount, size_t bufferCount) {
+    barriers.imageResources.resize(barriers.barriers.imageBarriers.size(), resource);
+    barriers.bufferResources.resize(barriers.barriers.bufferBarriers.size(), resource);
+    return barriers.barriers.imageBarriers.size() > imageCount || barriers.barriers.bufferBarriers.size() > bufferCount;
+  };
+
+  for (uint32_t position = 0u; position < passes_.size(); position++) {
+    RenderGraphBarriers& barriers = passes_[position].barriers;
+    ResourceBarriers& resourceBarriers = barriers.barriers;
+    const RenderGraphPassDescription& pass = passes[passes_[position].pass];
+    std::vector<uint32_t> aliasedBuffers;
+
+    for (const RenderGraphAccess& access : pass.accesses) {
+      uint32_t resource = access.resource.index;
+      ResourceAccess resourceAccess = getResourceAccess(access.usage);
+      size_t imageCount = resourceBarriers.imageBarriers.size();
+      size_t bufferCount = resourceBarriers.bufferBarriers.size();
+      bool firstPass = !resources[resource].imported && lifetimes_[resource].firstPass == position;
+
+      if (resources[resource].type == RenderGraphResourceType::eImage) {
+        // Contents of attachments that are not loaded do not need to be preserved.
+        bool discardContents = getLoadOp(pass, access) != vk::AttachmentLoadOp::eLoad;
+        imageStates[resource].transition(access.imageRange, resourceAccess, discardContents, resourceBarriers);
+      } else {
+        bufferStates[resource].transition(access.offset, access.size, resourceAccess, resourceBarriers);
+
+        // Untouched buffer ranges need no barrier, but aliased memory must wait for the previous resource.
+        if (firstPass && resourceBarriers.bufferBarriers.size() == bufferCount &&
+            std::find(aliasedBuffers.begin(), aliasedBuffers.end(), resource) == aliasedBuffers.end()) {
+          resourceBarriers.bufferBarriers.emplace_back(vk::AccessFlags(), resourceAccess.accessMask,
+                                                       VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+                                                       getPlaceholderBuffer(resource), 0u, VK_WHOLE_SIZE);
+          resourceBarriers.dstStageMask |= resourceAccess.stageMask;
+          aliasedBuffers.emplace_back(resource);
+        }
+      }
+
+      bool added = collect(barriers, resource, imageCount, bufferCount);
+
+      if (firstPass && added) {
+        uint32_t predecessor = predecessors[resource];
+        resourceBarriers.srcStageMask |= stageMasks[predecessor];
+        for (size_t i = imageCount; i < resourceBarriers.imageBarriers.size(); i++) {
+          resourceBarriers.imageBarriers[i].srcAccessMask |= writeAccessMasks[predecessor];
+        }
+        for (size_t i = bufferCount; i < resourceBarriers.bufferBarriers.size(); i++) {
+          resourceBarriers.bufferBarriers[i].srcAccessMask |= writeAccessMasks[predecessor];
+        }
+      }
+    }
+
+    // Barriers without a source stage (e.g. first layout transition) start at the top of the pipe.
+    if (!resourceBarriers.empty() && !resourceBarriers.srcStageMask) {
+      resourceBarriers.srcStageMask = vk::PipelineStageFlagBits::eTopOfPipe;
+    }
+  }
+
+  finalBarriers_ = RenderGraphBarriers();
+  for (uint32_t i = 0u; i < resources.size(); i++) {
+    const RenderGraphResourceDescription& resource = resources[i];
+    if (!resource.imported || !resource.finalUsage) {
+      continue;
+    }
+
+    ResourceAccess resourceAccess = getResourceAccess(*resource.finalUsage);
+    size_t imageCount = finalBarriers_.barriers.imageBarriers.size();
+    size_t bufferCount = finalBarriers_.barriers.bufferBarriers.size();
+    if (resource.type == RenderGraphResourceType::eImage) {
+      imageStates[i].transition(RenderGraphAccess().imageRange, resourceAccess, false, finalBarriers_.barriers);
+    } else {
+      bufferStates[i].transition(0u, VK_WHOLE_SIZE, resourceAccess, finalBarriers_.barriers);
+    }
+    collect(finalBarriers_, i, imageCount, bufferCount);
+  }
+}
+
+} // namespace logi
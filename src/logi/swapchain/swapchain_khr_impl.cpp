@@ -17,6 +17,7 @@
  */
 
 #include "logi/swapchain/swapchain_khr_impl.hpp"
+#include "logi/base/result.hpp"
 #include "logi/device/logical_device_impl.hpp"
 #include "logi/swapchain/swapchain_image_impl.hpp"
 
@@ -45,20 +46,39 @@ const std::vector<std::shared_ptr<SwapchainImageImpl>>& SwapchainKHRImpl::getIma
 
 vk::ResultValue<uint32_t> SwapchainKHRImpl::acquireNextImageKHR(uint64_t timeout, const vk::Semaphore& semaphore,
                                                                 const vk::Fence& fence) const {
+#ifdef LOGI_ENABLE_TRACE
+  TraceScope traceScope(logicalDevice_.getTraceRecorder(), "vkAcquireNextImageKHR", "swapchain");
+#endif
   auto vkDevice = static_cast<vk::Device>(logicalDevice_);
-  return vkDevice.acquireNextImageKHR(vkSwapchainKHR_, timeout, semaphore, fence, getDispatcher());
+  uint32_t imageIndex = 0u;
+  vk::Result result =
+    vkDevice.acquireNextImageKHR(vkSwapchainKHR_, timeout, semaphore, fence, &imageIndex, getDispatcher());
+
+  return vk::ResultValue<uint32_t>(checkResult(result, "logi::SwapchainKHRImpl::acquireNextImageKHR",
+                                               {vk::Result::eSuccess, vk::Result::eTimeout, vk::Result::eNotReady,
+                                                vk::Result::eSuboptimalKHR}),
+                                   imageIndex);
 }
 
 vk::ResultValue<uint32_t>
   SwapchainKHRImpl::acquireNextImage2KHR(uint64_t timeout, const vk::Semaphore& semaphore, const vk::Fence& fence,
                                          uint32_t deviceMask,
                                          const ConstVkNextProxy<vk::AcquireNextImageInfoKHR>& next = {}) const {
+#ifdef LOGI_ENABLE_TRACE
+  TraceScope traceScope(logicalDevice_.getTraceRecorder(), "vkAcquireNextImage2KHR", "swapchain");
+#endif
   auto vkDevice = static_cast<vk::Device>(logicalDevice_);
 
   vk::AcquireNextImageInfoKHR acquireImageInfo(vkSwapchainKHR_, timeout, semaphore, fence, deviceMask);
   acquireImageInfo.pNext = next;
 
-  return vkDevice.acquireNextImage2KHR(acquireImageInfo, getDispatcher());
+  uint32_t imageIndex = 0u;
+  vk::Result result = vkDevice.acquireNextImage2KHR(&acquireImageInfo, &imageIndex, getDispatcher());
+
+  return vk::ResultValue<uint32_t>(checkResult(result, "logi::SwapchainKHRImpl::acquireNextImage2KHR",
+                                               {vk::Result::eSuccess, vk::Result::eTimeout, vk::Result::eNotReady,
+                                                vk::Result::eSuboptimalKHR}),
+                                   imageIndex);
 }
 
 vk::ResultValueType<uint64_t>::type SwapchainKHRImpl::getCounterEXT(vk::SurfaceCounterFlagBitsEXT counter) const {
@@ -60,7 +60,7 @@ const vk::DispatchLoaderDynamic& DeferredOperationKHRImpl::getDispatcher() const
 }
 
 void DeferredOperationKHRImpl::destroy() const {
-  logicalDevice_.destroyEvent(id());
+  logicalDevice_.destroyDeferredOperationKHR(id());
 }
 
 DeferredOperationKHRImpl::operator const vk::DeferredOperationKHR&() const {
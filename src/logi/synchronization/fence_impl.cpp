@@ -17,6 +17,7 @@
  */
 
 #include "logi/synchronization/fence_impl.hpp"
+#include "logi/base/result.hpp"
 #include "logi/device/logical_device_impl.hpp"
 
 namespace logi {
@@ -49,22 +50,33 @@ vk::Result FenceImpl::getStatus() const {
 }
 
 vk::Result FenceImpl::wait(const std::vector<vk::Fence>& fences, vk::Bool32 waitAll, uint64_t timeout) const {
+#ifdef LOGI_ENABLE_TRACE
+  TraceScope traceScope(logicalDevice_.getTraceRecorder(), "vkWaitForFences", "wait");
+#endif
   auto vkDevice = static_cast<vk::Device>(logicalDevice_);
-  return vkDevice.waitForFences(fences, waitAll, timeout, getDispatcher());
+  vk::Result result =
+    vkDevice.waitForFences(static_cast<uint32_t>(fences.size()), fences.data(), waitAll, timeout, getDispatcher());
+  return checkResult(result, "logi::FenceImpl::wait", {vk::Result::eSuccess, vk::Result::eTimeout});
 }
 vk::Result FenceImpl::wait(uint64_t timeout) const {
+#ifdef LOGI_ENABLE_TRACE
+  TraceScope traceScope(logicalDevice_.getTraceRecorder(), "vkWaitForFences", "wait");
+#endif
   auto vkDevice = static_cast<vk::Device>(logicalDevice_);
-  return vkDevice.waitForFences({vkFence_}, true, timeout, getDispatcher());
+  vk::Result result = vkDevice.waitForFences(1u, &vkFence_, true, timeout, getDispatcher());
+  return checkResult(result, "logi::FenceImpl::wait", {vk::Result::eSuccess, vk::Result::eTimeout});
 }
 
 vk::ResultValueType<void>::type FenceImpl::reset(const std::vector<vk::Fence>& fences) const {
   auto vkDevice = static_cast<vk::Device>(logicalDevice_);
-  return vkDevice.resetFences(fences, getDispatcher());
+  vk::Result result = vkDevice.resetFences(static_cast<uint32_t>(fences.size()), fences.data(), getDispatcher());
+  return checkResult(result, "logi::FenceImpl::reset");
 }
 
 vk::ResultValueType<void>::type FenceImpl::reset() const {
   auto vkDevice = static_cast<vk::Device>(logicalDevice_);
-  return vkDevice.resetFences({vkFence_}, getDispatcher());
+  vk::Result result = vkDevice.resetFences(1u, &vkFence_, getDispatcher());
+  return checkResult(result, "logi::FenceImpl::reset");
 }
 
 vk::ResultValueType<void>::type FenceImpl::importFdKHR(const vk::FenceImportFlags& flags,
@@ -0,0 +1,171 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/synchronization/gpu_future.hpp"
+#include <algorithm>
+
+namespace logi {
+
+// region GpuTimeline
+
+GpuTimeline::GpuTimeline(const vk::Semaphore& semaphore, CounterSource counterSource, WaitFunction waitFunction)
+  : semaphore_(semaphore), counterSource_(std::move(counterSource)), waitFunction_(std::move(waitFunction)) {}
+
+uint64_t GpuTimeline::allocateValue() {
+  return lastValue_.fetch_add(1u) + 1u;
+}
+
+uint64_t GpuTimeline::poll() {
+  uint64_t value = counterSource_();
+
+  uint64_t completedValue = completedValue_.load();
+  while (completedValue < value && !completedValue_.compare_exchange_weak(completedValue, value)) {
+  }
+  completedValue = std::max(completedValue, value);
+
+  continuations_.collect(completedValue);
+  return completedValue;
+}
+
+bool GpuTimeline::isComplete(uint64_t value) {
+  return completedValue_.load() >= value || poll() >= value;
+}
+
+void GpuTimeline::then(uint64_t value, std::function<void()> callback) {
+  if (completedValue_.load() >= value) {
+    callback();
+    return;
+  }
+
+  continuations_.enqueue(value, std::move(callback));
+  // Value may have been completed by a concurrent poll before the continuation was enqueued.
+  continuations_.collect(completedValue_.load());
+}
+
+size_t GpuTimeline::getPendingContinuationCount() const {
+  return continuations_.size();
+}
+
+size_t GpuTimeline::flush() {
+  return continuations_.flush();
+}
+
+vk::Result GpuTimeline::wait(const vk::SemaphoreWaitInfo& waitInfo, uint64_t timeout) const {
+  return waitFunction_(waitInfo, timeout);
+}
+
+const vk::Semaphore& GpuTimeline::getSemaphore() const {
+  return semaphore_;
+}
+
+// endregion
+
+// region GpuFuture
+
+GpuFuture::GpuFuture(std::shared_ptr<GpuTimeline> timeline, uint64_t value) {
+  points_.push_back({std::move(timeline), value});
+}
+
+GpuFuture GpuFuture::whenAll(const std::vector<GpuFuture>& futures) {
+  GpuFuture result;
+
+  for (const GpuFuture& future : futures) {
+    for (const TimelinePoint& point : future.points_) {
+      // Values of a timeline complete in order, so only the highest value of each timeline is kept.
+      auto it = std::find_if(result.points_.begin(), result.points_.end(),
+                             [&point](const TimelinePoint& other) { return other.timeline == point.timeline; });
+      if (it == result.points_.end()) {
+        result.points_.push_back(point);
+      } else {
+        it->value = std::max(it->value, point.value);
+      }
+    }
+  }
+
+  return result;
+}
+
+bool GpuFuture::isValid() const {
+  return !points_.empty();
+}
+
+bool GpuFuture::isReady() const {
+  for (const TimelinePoint& point : points_) {
+    if (!point.timeline->isComplete(point.value)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+vk::Result GpuFuture::wait(uint64_t timeout) const {
+  if (isReady()) {
+    return vk::Result::eSuccess;
+  }
+
+  std::vector<vk::Semaphore> semaphores;
+  std::vector<uint64_t> values;
+  appendWaitSemaphores(semaphores, values);
+
+  vk::SemaphoreWaitInfo waitInfo({}, static_cast<uint32_t>(semaphores.size()), semaphores.data(), values.data());
+  vk::Result result = points_.front().timeline->wait(waitInfo, timeout);
+
+  if (result == vk::Result::eSuccess) {
+    for (const TimelinePoint& point : points_) {
+      point.timeline->poll();
+    }
+  }
+
+  return result;
+}
+
+void GpuFuture::then(std::function<void()> callback) const {
+  if (points_.empty()) {
+    callback();
+    return;
+  }
+
+  if (points_.size() == 1u) {
+    points_.front().timeline->then(points_.front().value, std::move(callback));
+    return;
+  }
+
+  // Callback is executed by the continuation of the last completed timeline.
+  auto remaining = std::make_shared<std::atomic<size_t>>(points_.size());
+  auto sharedCallback = std::make_shared<std::function<void()>>(std::move(callback));
+
+  for (const TimelinePoint& point : points_) {
+    point.timeline->then(point.value, [remaining, sharedCallback]() {
+      if (remaining->fetch_sub(1u) == 1u) {
+        (*sharedCallback)();
+      }
+    });
+  }
+}
+
+void GpuFuture::appendWaitSemaphores(std::vector<vk::Semaphore>& semaphores, std::vector<uint64_t>& values) const {
+  for (const TimelinePoint& point : points_) {
+    semaphores.emplace_back(point.timeline->getSemaphore());
+    values.emplace_back(point.value);
+  }
+}
+
+// endregion
+
+} // namespace logi
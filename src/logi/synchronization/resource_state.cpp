@@ -0,0 +1,555 @@
+/**
+ * Project Logi source code
+ * Copyright (C) 2019 Primoz Lavric
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "logi/synchronization/resource_state.hpp"
+#include <algorithm>
+
+namespace logi {
+
+namespace {
+
+const vk::AccessFlags kWriteAccessMask =
+  vk::AccessFlagBits::eShaderWrite | vk::AccessFlagBits::eColorAttachmentWrite |
+  vk::AccessFlagBits::eDepthStencilAttachmentWrite | vk::AccessFlagBits::eTransferWrite |
+  vk::AccessFlagBits::eHostWrite | vk::AccessFlagBits::eMemoryWrite;
+
+/**
+ * @brief Execution and memory dependency of a single subresource.
+ */
+struct Dependency {
+  vk::PipelineStageFlags srcStageMask;
+  vk::PipelineStageFlags dstStageMask;
+  vk::AccessFlags srcAccessMask;
+  vk::AccessFlags dstAccessMask;
+  vk::ImageLayout oldLayout = vk::ImageLayout::eUndefined;
+  vk::ImageLayout newLayout = vk::ImageLayout::eUndefined;
+
+  bool operator==(const Dependency& other) const {
+    return srcStageMask == other.srcStageMask && dstStageMask == other.dstStageMask &&
+           srcAccessMask == other.srcAccessMask && dstAccessMask == other.dstAccessMask &&
+           oldLayout == other.oldLayout && newLayout == other.newLayout;
+  }
+};
+
+bool contains(const vk::PipelineStageFlags& mask, const vk::PipelineStageFlags& flags) {
+  return (mask & flags) == flags;
+}
+
+bool contains(const vk::AccessFlags& mask, const vk::AccessFlags& flags) {
+  return (mask & flags) == flags;
+}
+
+/**
+ * @brief State of a subresource right after it was accessed with the given access.
+ *
+ * @param access      Access of the subresource.
+ * @param transition  True if the access was preceded by a layout transition.
+ */
+ResourceState stateAfter(const ResourceAccess& access, bool transition) {
+  ResourceState state;
+  state.layout = access.layout;
+
+  vk::AccessFlags writeAccessMask = access.accessMask & kWriteAccessMask;
+  if (writeAccessMask) {
+    state.writeStageMask = access.stageMask;
+    state.writeAccessMask = writeAccessMask;
+  } else {
+    state.readStageMask = access.stageMask;
+    state.visibleStageMask = access.stageMask;
+    state.visibleAccessMask = access.accessMask;
+
+    // Layout transition is a write that is already available. Other stages only need an execution dependency chained
+    // after the stages of the transition barrier.
+    if (transition) {
+      state.writeStageMask = access.stageMask;
+    }
+  }
+
+  return state;
+}
+
+/**
+ * @brief   Advance the subresource state with the given access.
+ *
+ * @return  True if the access requires a dependency.
+ */
+bool applyAccess(SubresourceState& subresource, const ResourceAccess& access, bool discardContents,
+                 Dependency& dependency) {
+  bool writes = static_cast<bool>(access.accessMask & kWriteAccessMask);
+
+  if (!subresource.known) {
+    // First access. The dependency is resolved when the state is reconciled.
+    subresource.known = true;
+    subresource.firstAccess = access;
+    subresource.firstAccessOpen = !writes;
+    subresource.state = stateAfter(access, false);
+    return false;
+  }
+
+  ResourceState& state = subresource.state;
+  bool layoutChange = state.layout != access.layout;
+
+  if (!writes && !layoutChange) {
+    // Read after read does not need a dependency, but later writes must wait for all readers.
+    if (subresource.firstAccessOpen) {
+      subresource.firstAccess.stageMask |= access.stageMask;
+      subresource.firstAccess.accessMask |= access.accessMask;
+      state.readStageMask |= access.stageMask;
+      state.visibleStageMask |= access.stageMask;
+      state.visibleAccessMask |= access.accessMask;
+      return false;
+    }
+
+    if (!state.writeStageMask ||
+        (contains(state.visibleStageMask, access.stageMask) && contains(state.visibleAccessMask, access.accessMask))) {
+      state.readStageMask |= access.stageMask;
+      return false;
+    }
+
+    // Read after write. Widen the destination scope with the previous readers, so that every combination of the
+    // visible stages and access types is covered by some barrier.
+    state.visibleStageMask |= access.stageMask;
+    state.visibleAccessMask |= access.accessMask;
+    state.readStageMask |= access.stageMask;
+
+    dependency.srcStageMask = state.writeStageMask;
+    dependency.srcAccessMask = state.writeAccessMask;
+    dependency.dstStageMask = state.visibleStageMask;
+    dependency.dstAccessMask = state.visibleAccessMask;
+    dependency.oldLayout = state.layout;
+    dependency.newLayout = state.layout;
+    return true;
+  }
+
+  // Write after read, write after write or layout transition.
+  subresource.firstAccessOpen = false;
+
+  vk::PipelineStageFlags srcStageMask = state.writeStageMask | state.readStageMask;
+  bool required = layoutChange || srcStageMask;
+
+  dependency.srcStageMask = srcStageMask ? srcStageMask : vk::PipelineStageFlags(vk::PipelineStageFlagBits::eTopOfPipe);
+  dependency.srcAccessMask = discardContents ? vk::AccessFlags() : state.writeAccessMask;
+  dependency.dstStageMask = access.stageMask;
+  // Write after read only needs an execution dependency.
+  dependency.dstAccessMask = (state.writeAccessMask || layoutChange) ? access.accessMask : vk::AccessFlags();
+  dependency.oldLayout = discardContents ? vk::ImageLayout::eUndefined : state.layout;
+  dependency.newLayout = access.layout;
+
+  state = stateAfter(access, layoutChange);
+  return required;
+}
+
+/**
+ * @brief Advance the state of a resource with the first accesses of a command buffer and return the dependency that
+ *        must precede the command buffer.
+ */
+bool reconcileSubresource(SubresourceState& subresource, const SubresourceState& commandBufferSubresource,
+                          Dependency& dependency) {
+  if (!subresource.known) {
+    subresource.known = true;
+  }
+
+  bool required = applyAccess(subresource, commandBufferSubresource.firstAccess, false, dependency);
+
+  // If the command buffer only read the subresource, the state after the first access already includes all of its
+  // reads. Otherwise the state after the command buffer is the state of its last access.
+  if (!commandBufferSubresource.firstAccessOpen) {
+    subresource.state = commandBufferSubresource.state;
+  }
+  subresource.firstAccessOpen = false;
+
+  return required;
+}
+
+void addDependency(ResourceBarriers& barriers, const Dependency& dependency) {
+  barriers.srcStageMask |= dependency.srcStageMask;
+  barriers.dstStageMask |= dependency.dstStageMask;
+}
+
+/**
+ * @brief Collects barriers of image subresources, merging consecutive array layers and mip levels with the same
+ *        dependency.
+ */
+class ImageBarrierBuilder {
+ public:
+  ImageBarrierBuilder(vk::Image image, vk::ImageAspectFlags aspectMask, ResourceBarriers& barriers)
+    : image_(image), aspectMask_(aspectMask), barriers_(barriers), first_(barriers.imageBarriers.size()) {}
+
+  void add(uint32_t mipLevel, uint32_t arrayLayer, const Dependency& dependency) {
+    addDependency(barriers_, dependency);
+
+    if (barriers_.imageBarriers.size() > first_ && dependency == last_) {
+      vk::ImageSubresourceRange& range = barriers_.imageBarriers.back().subresourceRange;
+      if (range.levelCount == 1u && range.baseMipLevel == mipLevel &&
+          range.baseArrayLayer + range.layerCount == arrayLayer) {
+        range.layerCount++;
+        return;
+      }
+    }
+
+    barriers_.imageBarriers.emplace_back(
+      dependency.srcAccessMask, dependency.dstAccessMask, dependency.oldLayout, dependency.newLayout,
+      VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, image_,
+      vk::ImageSubresourceRange(aspectMask_, mipLevel, 1u, arrayLayer, 1u));
+    last_ = dependency;
+  }
+
+  /**
+   * @brief Merge barriers of consecutive mip levels that cover the same array layers.
+   */
+  void finish() {
+    std::vector<vk::ImageMemoryBarrier>& imageBarriers = barriers_.imageBarriers;
+    if (imageBarriers.size() <= first_) {
+      return;
+    }
+
+    size_t last = first_;
+    for (size_t i = first_ + 1u; i < imageBarriers.size(); i++) {
+      vk::ImageMemoryBarrier& merged = imageBarriers[last];
+      const vk::ImageMemoryBarrier& barrier = imageBarriers[i];
+      const vk::ImageSubresourceRange& mergedRange = merged.subresourceRange;
+      const vk::ImageSubresourceRange& range = barrier.subresourceRange;
+
+      if (merged.srcAccessMask == barrier.srcAccessMask && merged.dstAccessMask == barrier.dstAccessMask &&
+          merged.oldLayout == barrier.oldLayout && merged.newLayout == barrier.newLayout &&
+          mergedRange.baseArrayLayer == range.baseArrayLayer && mergedRange.layerCount == range.layerCount &&
+          mergedRange.baseMipLevel + mergedRange.levelCount == range.baseMipLevel) {
+        merged.subresourceRange.levelCount += range.levelCount;
+      } else {
+        imageBarriers[++last] = barrier;
+      }
+    }
+
+    imageBarriers.resize(last + 1u);
+  }
+
+ private:
+  vk::Image image_;
+  vk::ImageAspectFlags aspectMask_;
+  ResourceBarriers& barriers_;
+  size_t first_;
+  Dependency last_;
+};
+
+void addBufferBarrier(ResourceBarriers& barriers, vk::Buffer buffer, vk::DeviceSize offset, vk::DeviceSize size,
+                      const Dependency& dependency) {
+  addDependency(barriers, dependency);
+
+  if (!barriers.bufferBarriers.empty()) {
+    vk::BufferMemoryBarrier& last = barriers.bufferBarriers.back();
+    if (last.buffer == buffer && last.offset + last.size == offset && last.srcAccessMask == dependency.srcAccessMask &&
+        last.dstAccessMask == dependency.dstAccessMask) {
+      last.size += size;
+      return;
+    }
+  }
+
+  barriers.bufferBarriers.emplace_back(dependency.srcAccessMask, dependency.dstAccessMask, VK_QUEUE_FAMILY_IGNORED,
+                                       VK_QUEUE_FAMILY_IGNORED, buffer, offset, size);
+}
+
+} // namespace
+
+// region Resource Access
+
+bool ResourceAccess::operator==(const ResourceAccess& other) const {
+  return stageMask == other.stageMask && accessMask == other.accessMask && layout == other.layout;
+}
+
+bool ResourceAccess::operator!=(const ResourceAccess& other) const {
+  return !(*this == other);
+}
+
+ResourceAccess getResourceAccess(ResourceUsage usage) {
+  using Stage = vk::PipelineStageFlagBits;
+  using Access = vk::AccessFlagBits;
+  using Layout = vk::ImageLayout;
+
+  switch (usage) {
+    case ResourceUsage::eTransferSrc:
+      return {Stage::eTransfer, Access::eTransferRead, Layout::eTransferSrcOptimal};
+    case ResourceUsage::eTransferDst:
+      return {Stage::eTransfer, Access::eTransferWrite, Layout::eTransferDstOptimal};
+    case ResourceUsage::eVertexBuffer:
+      return {Stage::eVertexInput, Access::eVertexAttributeRead, Layout::eUndefined};
+    case ResourceUsage::eIndexBuffer:
+      return {Stage::eVertexInput, Access::eIndexRead, Layout::eUndefined};
+    case ResourceUsage::eIndirectBuffer:
+      return {Stage::eDrawIndirect, Access::eIndirectCommandRead, Layout::eUndefined};
+    case ResourceUsage::eUniformBuffer:
+      return {Stage::eVertexShader | Stage::eFragmentShader | Stage::eComputeShader, Access::eUniformRead,
+              Layout::eUndefined};
+    case ResourceUsage::eVertexShaderRead:
+      return {Stage::eVertexShader, Access::eShaderRead, Layout::eShaderReadOnlyOptimal};
+    case ResourceUsage::eFragmentShaderRead:
+      return {Stage::eFragmentShader, Access::eShaderRead, Layout::eShaderReadOnlyOptimal};
+    case ResourceUsage::eComputeShaderRead:
+      return {Stage::eComputeShader, Access::eShaderRead, Layout::eShaderReadOnlyOptimal};
+    case ResourceUsage::eComputeShaderWrite:
+      return {Stage::eComputeShader, Access::eShaderWrite, Layout::eGeneral};
+    case ResourceUsage::eComputeShaderReadWrite:
+      return {Stage::eComputeShader, Access::eShaderRead | Access::eShaderWrite, Layout::eGeneral};
+    case ResourceUsage::eColorAttachment:
+      return {Stage::eColorAttachmentOutput, Access::eColorAttachmentRead | Access::eColorAttachmentWrite,
+              Layout::eColorAttachmentOptimal};
+    case ResourceUsage::eDepthStencilAttachment:
+      return {Stage::eEarlyFragmentTests | Stage::eLateFragmentTests,
+              Access::eDepthStencilAttachmentRead | Access::eDepthStencilAttachmentWrite,
+              Layout::eDepthStencilAttachmentOptimal};
+    case ResourceUsage::eDepthStencilRead:
+      return {Stage::eEarlyFragmentTests | Stage::eLateFragmentTests | Stage::eFragmentShader,
+              Access::eDepthStencilAttachmentRead | Access::eShaderRead, Layout::eDepthStencilReadOnlyOptimal};
+    case ResourceUsage::eHostRead:
+      return {Stage::eHost, Access::eHostRead, Layout::eGeneral};
+    case ResourceUsage::eHostWrite:
+      return {Stage::eHost, Access::eHostWrite, Layout::eGeneral};
+    case ResourceUsage::eGeneral:
+      return {Stage::eAllCommands, Access::eMemoryRead | Access::eMemoryWrite, Layout::eGeneral};
+    case ResourceUsage::ePresent:
+      return {Stage::eBottomOfPipe, vk::AccessFlags(), Layout::ePresentSrcKHR};
+  }
+
+  return {Stage::eAllCommands, Access::eMemoryRead | Access::eMemoryWrite, Layout::eGeneral};
+}
+
+bool ResourceState::operator==(const ResourceState& other) const {
+  return layout == other.layout && writeStageMask == other.writeStageMask &&
+         writeAccessMask == other.writeAccessMask && readStageMask == other.readStageMask &&
+         visibleStageMask == other.visibleStageMask && visibleAccessMask == other.visibleAccessMask;
+}
+
+bool ResourceState::operator!=(const ResourceState& other) const {
+  return !(*this == other);
+}
+
+bool SubresourceState::operator==(const SubresourceState& other) const {
+  return known == other.known && firstAccessOpen == other.firstAccessOpen && state == other.state &&
+         firstAccess == other.firstAccess;
+}
+
+bool SubresourceState::operator!=(const SubresourceState& other) const {
+  return !(*this == other);
+}
+
+bool ResourceBarriers::empty() const {
+  return bufferBarriers.empty() && imageBarriers.empty();
+}
+
+void ResourceBarriers::clear() {
+  srcStageMask = vk::PipelineStageFlags();
+  dstStageMask = vk::PipelineStageFlags();
+  bufferBarriers.clear();
+  imageBarriers.clear();
+}
+
+// endregion
+
+// region Image State
+
+ImageState::ImageState(vk::Image image, vk::ImageAspectFlags aspectMask, uint32_t mipLevels, uint32_t arrayLayers)
+  : image_(image), aspectMask_(aspectMask), mipLevels_(mipLevels), arrayLayers_(arrayLayers),
+    subresources_(static_cast<size_t>(mipLevels) * arrayLayers) {}
+
+ImageState::ImageState(vk::Image image, vk::ImageAspectFlags aspectMask, uint32_t mipLevels, uint32_t arrayLayers,
+                       vk::ImageLayout layout)
+  : ImageState(image, aspectMask, mipLevels, arrayLayers) {
+  for (SubresourceState& subresource : subresources_) {
+    subresource.known = true;
+    subresource.state.layout = layout;
+  }
+}
+
+void ImageState::transition(const vk::ImageSubresourceRange& range, const ResourceAccess& access,
+                            bool discardContents, ResourceBarriers& barriers) {
+  uint32_t levelEnd = (range.levelCount == VK_REMAINING_MIP_LEVELS)
+                        ? mipLevels_
+                        : std::min(mipLevels_, range.baseMipLevel + range.levelCount);
+  uint32_t layerEnd = (range.layerCount == VK_REMAINING_ARRAY_LAYERS)
+                        ? arrayLayers_
+                        : std::min(arrayLayers_, range.baseArrayLayer + range.layerCount);
+
+  ImageBarrierBuilder builder(image_, aspectMask_, barriers);
+  Dependency dependency;
+
+  for (uint32_t mipLevel = range.baseMipLevel; mipLevel < levelEnd; mipLevel++) {
+    for (uint32_t arrayLayer = range.baseArrayLayer; arrayLayer < layerEnd; arrayLayer++) {
+      if (applyAccess(subresources_[index(mipLevel, arrayLayer)], access, discardContents, dependency)) {
+        builder.add(mipLevel, arrayLayer, dependency);
+      }
+    }
+  }
+
+  builder.finish();
+}
+
+void ImageState::reconcile(const ImageState& commandBufferState, ResourceBarriers& barriers) {
+  ImageBarrierBuilder builder(image_, aspectMask_, barriers);
+  Dependency dependency;
+
+  uint32_t mipLevels = std::min(mipLevels_, commandBufferState.mipLevels_);
+  uint32_t arrayLayers = std::min(arrayLayers_, commandBufferState.arrayLayers_);
+
+  for (uint32_t mipLevel = 0u; mipLevel < mipLevels; mipLevel++) {
+    for (uint32_t arrayLayer = 0u; arrayLayer < arrayLayers; arrayLayer++) {
+      const SubresourceState& used = commandBufferState.subresources_[commandBufferState.index(mipLevel, arrayLayer)];
+      if (used.known && reconcileSubresource(subresources_[index(mipLevel, arrayLayer)], used, dependency)) {
+        builder.add(mipLevel, arrayLayer, dependency);
+      }
+    }
+  }
+
+  builder.finish();
+}
+
+const SubresourceState* ImageState::getSubresourceState(uint32_t mipLevel, uint32_t arrayLayer) const {
+  const SubresourceState& subresource = subresources_.at(index(mipLevel, arrayLayer));
+  return subresource.known ? &subresource : nullptr;
+}
+
+vk::Image ImageState::getImage() const {
+  return image_;
+}
+
+vk::ImageAspectFlags ImageState::getAspectMask() const {
+  return aspectMask_;
+}
+
+uint32_t ImageState::getMipLevels() const {
+  return mipLevels_;
+}
+
+uint32_t ImageState::getArrayLayers() const {
+  return arrayLayers_;
+}
+
+size_t ImageState::index(uint32_t mipLevel, uint32_t arrayLayer) const {
+  return static_cast<size_t>(mipLevel) * arrayLayers_ + arrayLayer;
+}
+
+// endregion
+
+// region Buffer State
+
+BufferState::BufferState(vk::Buffer buffer, vk::DeviceSize size) : BufferState(buffer, size, false) {}
+
+BufferState::BufferState(vk::Buffer buffer, vk::DeviceSize size, bool known) : buffer_(buffer), size_(size) {
+  SubresourceState state;
+  state.known = known;
+  ranges_.push_back({0u, size, state});
+}
+
+void BufferState::transition(vk::DeviceSize offset, vk::DeviceSize size, const ResourceAccess& access,
+                             ResourceBarriers& barriers) {
+  if (size == VK_WHOLE_SIZE) {
+    size = size_ - offset;
+  }
+
+  // Buffers have no layout.
+  ResourceAccess bufferAccess = access;
+  bufferAccess.layout = vk::ImageLayout::eUndefined;
+
+  Dependency dependency;
+  for (size_t i = split(offset, size); i < ranges_.size() && ranges_[i].offset < offset + size; i++) {
+    Range& range = ranges_[i];
+    if (applyAccess(range.state, bufferAccess, false, dependency)) {
+      addBufferBarrier(barriers, buffer_, range.offset, range.size, dependency);
+    }
+  }
+
+  merge();
+}
+
+void BufferState::reconcile(const BufferState& commandBufferState, ResourceBarriers& barriers) {
+  Dependency dependency;
+
+  for (const Range& used : commandBufferState.ranges_) {
+    if (!used.state.known) {
+      continue;
+    }
+
+    for (size_t i = split(used.offset, used.size); i < ranges_.size() && ranges_[i].offset < used.offset + used.size;
+         i++) {
+      Range& range = ranges_[i];
+      if (reconcileSubresource(range.state, used.state, dependency)) {
+        addBufferBarrier(barriers, buffer_, range.offset, range.size, dependency);
+      }
+    }
+  }
+
+  merge();
+}
+
+const SubresourceState* BufferState::getSubresourceState(vk::DeviceSize offset) const {
+  for (const Range& range : ranges_) {
+    if (offset >= range.offset && offset < range.offset + range.size) {
+      return range.state.known ? &range.state : nullptr;
+    }
+  }
+
+  return nullptr;
+}
+
+size_t BufferState::getRangeCount() const {
+  return ranges_.size();
+}
+
+vk::Buffer BufferState::getBuffer() const {
+  return buffer_;
+}
+
+vk::DeviceSize BufferState::getSize() const {
+  return size_;
+}
+
+size_t BufferState::split(vk::DeviceSize offset, vk::DeviceSize size) {
+  auto splitAt = [this](vk::DeviceSize position) {
+    for (size_t i = 0u; i < ranges_.size(); i++) {
+      Range& range = ranges_[i];
+      if (position == range.offset) {
+        return i;
+      }
+      if (position > range.offset && position < range.offset + range.size) {
+        Range tail {position, range.offset + range.size - position, range.state};
+        range.size = position - range.offset;
+        ranges_.insert(ranges_.begin() + static_cast<std::ptrdiff_t>(i) + 1, tail);
+        return i + 1u;
+      }
+    }
+    return ranges_.size();
+  };
+
+  splitAt(offset + size);
+  return splitAt(offset);
+}
+
+void BufferState::merge() {
+  size_t last = 0u;
+  for (size_t i = 1u; i < ranges_.size(); i++) {
+    if (ranges_[i].state == ranges_[last].state) {
+      ranges_[last].size += ranges_[i].size;
+    } else {
+      ranges_[++last] = ranges_[i];
+    }
+  }
+
+  ranges_.resize(std::min(ranges_.size(), last + 1u));
+}
+
+// endregion
+
+} // namespace logi
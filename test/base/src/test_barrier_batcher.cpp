@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "logi/command/barrier_batcher.hpp"
+#include "logi/command/command_dispatch_table.hpp"
+
+namespace {
+
+vk::ImageMemoryBarrier imageBarrier(vk::Image image, vk::ImageLayout oldLayout, vk::ImageLayout newLayout,
+                                    uint32_t baseMipLevel) {
+  vk::ImageMemoryBarrier barrier;
+  barrier.oldLayout = oldLayout;
+  barrier.newLayout = newLayout;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.image = image;
+  barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+  barrier.subresourceRange.baseMipLevel = baseMipLevel;
+  barrier.subresourceRange.levelCount = 1u;
+  barrier.subresourceRange.baseArrayLayer = 0u;
+  barrier.subresourceRange.layerCount = 1u;
+  return barrier;
+}
+
+} // namespace
+
+TEST(BarrierBatcher, MergesStageMasksAndMemoryBarriers) {
+  logi::CommandDispatchTable dispatch;
+  logi::BarrierBatcher batcher(vk::CommandBuffer(), dispatch);
+  ASSERT_TRUE(batcher.empty());
+
+  batcher.add(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eComputeShader, {},
+              vk::MemoryBarrier(vk::AccessFlagBits::eShaderWrite, vk::AccessFlagBits::eShaderRead), {}, {});
+  batcher.add(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eVertexShader, {},
+              vk::MemoryBarrier(vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eShaderRead), {}, {});
+
+  ASSERT_FALSE(batcher.empty());
+  ASSERT_EQ(batcher.getSrcStageMask(),
+            vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eTransfer);
+  ASSERT_EQ(batcher.getDstStageMask(),
+            vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eVertexShader);
+  ASSERT_EQ(batcher.getMemoryBarriers().size(), 1u);
+  ASSERT_EQ(batcher.getMemoryBarriers()[0].srcAccessMask,
+            vk::AccessFlagBits::eShaderWrite | vk::AccessFlagBits::eTransferWrite);
+
+  ASSERT_EQ(batcher.getStatistics().batchedCalls, 2u);
+  ASSERT_EQ(batcher.getStatistics().batchedBarriers, 2u);
+  ASSERT_EQ(batcher.getStatistics().mergedBarriers, 1u);
+  ASSERT_EQ(batcher.getStatistics().flushes, 0u);
+}
+
+TEST(BarrierBatcher, CollapsesLayoutTransitions) {
+  logi::CommandDispatchTable dispatch;
+  logi::BarrierBatcher batcher(vk::CommandBuffer(), dispatch);
+  vk::Image image(reinterpret_cast<VkImage>(1u));
+
+  // Upload loop: one barrier per mip level.
+  for (uint32_t mip = 0u; mip < 4u; mip++) {
+    batcher.add(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer, {}, {}, {},
+                imageBarrier(image, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, mip));
+  }
+  ASSERT_EQ(batcher.getImageMemoryBarriers().size(), 4u);
+  ASSERT_EQ(batcher.getStatistics().mergedBarriers, 0u);
+
+  // Chained transition of the same subresource is merged into the pending one.
+  batcher.add(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader, {}, {}, {},
+              imageBarrier(image, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal, 2u));
+
+  const auto& barriers = batcher.getImageMemoryBarriers();
+  ASSERT_EQ(barriers.size(), 4u);
+  ASSERT_EQ(barriers[2].oldLayout, vk::ImageLayout::eUndefined);
+  ASSERT_EQ(barriers[2].newLayout, vk::ImageLayout::eShaderReadOnlyOptimal);
+  ASSERT_EQ(barriers[3].newLayout, vk::ImageLayout::eTransferDstOptimal);
+  ASSERT_EQ(batcher.getStatistics().mergedBarriers, 1u);
+
+  batcher.clear();
+  ASSERT_TRUE(batcher.empty());
+  ASSERT_TRUE(batcher.getImageMemoryBarriers().empty());
+}
+
+TEST(BarrierBatcher, MergesBufferRanges) {
+  logi::CommandDispatchTable dispatch;
+  logi::BarrierBatcher batcher(vk::CommandBuffer(), dispatch);
+  vk::Buffer buffer(reinterpret_cast<VkBuffer>(1u));
+
+  vk::BufferMemoryBarrier first(vk::AccessFlagBits::eShaderWrite, vk::AccessFlagBits::eShaderRead,
+                                VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, buffer, 0u, 256u);
+  vk::BufferMemoryBarrier second(vk::AccessFlagBits::eShaderWrite, vk::AccessFlagBits::eIndirectCommandRead,
+                                 VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, buffer, 0u, 256u);
+  vk::BufferMemoryBarrier disjoint(vk::AccessFlagBits::eShaderWrite, vk::AccessFlagBits::eShaderRead,
+                                   VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, buffer, 256u, 256u);
+
+  batcher.add(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eComputeShader, {}, {}, first, {});
+  batcher.add(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eDrawIndirect, {}, {}, second, {});
+  batcher.add(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eComputeShader, {}, {}, disjoint,
+              {});
+
+  const auto& barriers = batcher.getBufferMemoryBarriers();
+  ASSERT_EQ(barriers.size(), 2u);
+  ASSERT_EQ(barriers[0].dstAccessMask, vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eIndirectCommandRead);
+  ASSERT_EQ(batcher.getStatistics().mergedBarriers, 1u);
+  ASSERT_EQ(batcher.getStatistics().batchedCalls, 3u);
+}
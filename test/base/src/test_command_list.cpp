@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "logi/command/command_list.hpp"
+
+using logi::CommandList;
+using logi::CommandType;
+
+namespace {
+
+vk::Pipeline makePipeline(uintptr_t id) {
+  return vk::Pipeline(reinterpret_cast<VkPipeline>(id));
+}
+
+vk::PipelineLayout makePipelineLayout(uintptr_t id) {
+  return vk::PipelineLayout(reinterpret_cast<VkPipelineLayout>(id));
+}
+
+vk::DescriptorSet makeDescriptorSet(uintptr_t id) {
+  return vk::DescriptorSet(reinterpret_cast<VkDescriptorSet>(id));
+}
+
+vk::Buffer makeBuffer(uintptr_t id) {
+  return vk::Buffer(reinterpret_cast<VkBuffer>(id));
+}
+
+} // namespace
+
+TEST(CommandList, RecordAndDecode) {
+  CommandList commandList;
+
+  std::vector<vk::DescriptorSet> sets {makeDescriptorSet(1u), makeDescriptorSet(2u), makeDescriptorSet(3u)};
+  std::vector<uint32_t> dynamicOffsets {64u, 128u};
+  vk::Rect2D scissor({4, 5}, {6u, 7u});
+
+  commandList.bindPipeline(vk::PipelineBindPoint::eGraphics, makePipeline(42u));
+  commandList.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, makePipelineLayout(9u), 1u, sets, dynamicOffsets);
+  commandList.setScissor(0u, scissor);
+  commandList.pushConstants<float>(makePipelineLayout(9u), vk::ShaderStageFlagBits::eVertex, 16u, {1.0f, 2.0f, 3.0f});
+  commandList.draw(3u, 1u, 0u, 0u);
+
+  ASSERT_EQ(commandList.size(), 5u);
+  ASSERT_EQ(commandList.byteSize() % CommandList::kAlignment, 0u);
+
+  std::vector<CommandType> types;
+  for (CommandList::Command command : commandList) {
+    types.emplace_back(command.type());
+    ASSERT_EQ(command.size() % CommandList::kAlignment, 0u);
+
+    switch (command.type()) {
+      case CommandType::eBindPipeline: {
+        ASSERT_EQ(command.get<CommandList::BindPipeline>().pipeline, makePipeline(42u));
+        break;
+      }
+      case CommandType::eBindDescriptorSets: {
+        const auto& args = command.get<CommandList::BindDescriptorSets>();
+        ASSERT_EQ(args.firstSet, 1u);
+        ASSERT_EQ(args.descriptorSets.count, 3u);
+        ASSERT_EQ(args.dynamicOffsets.count, 2u);
+        ASSERT_EQ(command.data(args.descriptorSets)[2], makeDescriptorSet(3u));
+        ASSERT_EQ(command.data(args.dynamicOffsets)[1], 128u);
+        break;
+      }
+      case CommandType::eSetScissor: {
+        const auto& args = command.get<CommandList::SetScissor>();
+        ASSERT_EQ(args.scissors.count, 1u);
+        ASSERT_EQ(command.data(args.scissors)->extent.height, 7u);
+        break;
+      }
+      case CommandType::ePushConstants: {
+        const auto& args = command.get<CommandList::PushConstants>();
+        ASSERT_EQ(args.offset, 16u);
+        ASSERT_EQ(args.values.count, 3u * sizeof(float));
+        ASSERT_EQ(reinterpret_cast<const float*>(command.data(args.values))[2], 3.0f);
+        break;
+      }
+      case CommandType::eDraw: {
+        ASSERT_EQ(command.get<CommandList::Draw>().vertexCount, 3u);
+        break;
+      }
+      default:
+        FAIL();
+    }
+  }
+
+  ASSERT_EQ(types, (std::vector<CommandType> {CommandType::eBindPipeline, CommandType::eBindDescriptorSets,
+                                              CommandType::eSetScissor, CommandType::ePushConstants,
+                                              CommandType::eDraw}));
+}
+
+TEST(CommandList, BarrierNextChainsAreNotRecorded) {
+  CommandList commandList;
+  int extension = 0;
+
+  vk::MemoryBarrier memoryBarrier(vk::AccessFlagBits::eShaderWrite, vk::AccessFlagBits::eShaderRead);
+  memoryBarrier.pNext = &extension;
+  vk::BufferMemoryBarrier bufferBarrier(vk::AccessFlagBits::eShaderWrite, vk::AccessFlagBits::eShaderRead, 0u, 0u,
+                                        makeBuffer(3u), 0u, 64u);
+  bufferBarrier.pNext = &extension;
+  vk::ImageMemoryBarrier imageBarrier;
+  imageBarrier.pNext = &extension;
+
+  commandList.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eFragmentShader,
+                              {}, memoryBarrier, bufferBarrier, imageBarrier);
+
+  CommandList::Command command = *commandList.begin();
+  const auto& args = command.get<CommandList::PipelineBarrier>();
+  ASSERT_EQ(command.data(args.memoryBarriers)->pNext, nullptr);
+  ASSERT_EQ(command.data(args.bufferMemoryBarriers)->pNext, nullptr);
+  ASSERT_EQ(command.data(args.imageMemoryBarriers)->pNext, nullptr);
+
+  // Remaining members are recorded unchanged.
+  ASSERT_EQ(command.data(args.memoryBarriers)->dstAccessMask, vk::AccessFlags(vk::AccessFlagBits::eShaderRead));
+  ASSERT_EQ(command.data(args.bufferMemoryBarriers)->buffer, makeBuffer(3u));
+  ASSERT_EQ(command.data(args.bufferMemoryBarriers)->size, 64u);
+
+  // Caller's structures are left untouched.
+  ASSERT_EQ(memoryBarrier.pNext, &extension);
+}
+
+TEST(CommandList, Statistics) {
+  CommandList commandList;
+  std::vector<vk::DescriptorSet> sets {makeDescriptorSet(1u)};
+  std::vector<vk::BufferCopy> regions {vk::BufferCopy(0u, 0u, 64u), vk::BufferCopy(64u, 128u, 32u)};
+  std::vector<vk::BufferMemoryBarrier> barriers(3u);
+
+  commandList.bindPipeline(vk::PipelineBindPoint::eGraphics, makePipeline(1u));
+  commandList.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, makePipelineLayout(2u), 0u, sets, {});
+  commandList.draw(3u, 1u, 0u, 0u);
+  commandList.drawIndexedIndirect(makeBuffer(3u), 0u, 4u, 20u);
+  commandList.dispatch(1u, 1u, 1u);
+  commandList.copyBuffer(makeBuffer(4u), makeBuffer(5u), regions);
+  commandList.fillBuffer(makeBuffer(5u), 0u, 16u, 0u);
+  commandList.fillBuffer(makeBuffer(5u), 0u, VK_WHOLE_SIZE, 0u);
+  commandList.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eVertexShader, {}, {},
+                              barriers, {});
+
+  const logi::CommandStatistics& statistics = commandList.getStatistics();
+  ASSERT_EQ(statistics.commandBuffers, 0u);
+  ASSERT_EQ(statistics.pipelineBinds, 1u);
+  ASSERT_EQ(statistics.descriptorSetBinds, 1u);
+  ASSERT_EQ(statistics.draws, 2u);
+  ASSERT_EQ(statistics.dispatches, 1u);
+  ASSERT_EQ(statistics.copies, 3u);
+  ASSERT_EQ(statistics.copyBytes, 112u);
+  ASSERT_EQ(statistics.barrierCommands, 1u);
+  ASSERT_EQ(statistics.barriers, 3u);
+
+  // Appended lists add their counters, cleared lists reset them.
+  CommandList copy;
+  copy.append(commandList);
+  copy.append(commandList);
+  ASSERT_EQ(copy.getStatistics().draws, 4u);
+  ASSERT_EQ(copy.getStatistics().copyBytes, 224u);
+
+  commandList.clear();
+  ASSERT_EQ(commandList.getStatistics().draws, 0u);
+  ASSERT_EQ(commandList.getStatistics().barriers, 0u);
+}
+
+TEST(CommandList, ClearKeepsCapacity) {
+  CommandList commandList;
+  for (uint32_t i = 0u; i < 1000u; i++) {
+    commandList.draw(3u, 1u, i, 0u);
+  }
+
+  size_t byteSize = commandList.byteSize();
+  size_t capacity = commandList.capacity();
+  commandList.clear();
+  ASSERT_TRUE(commandList.empty());
+  ASSERT_EQ(commandList.byteSize(), 0u);
+  ASSERT_EQ(commandList.capacity(), capacity);
+  ASSERT_EQ(commandList.begin(), commandList.end());
+
+  for (uint32_t i = 0u; i < 1000u; i++) {
+    commandList.draw(3u, 1u, i, 0u);
+  }
+  ASSERT_EQ(commandList.byteSize(), byteSize);
+  ASSERT_EQ(commandList.capacity(), capacity);
+}
+
+TEST(CommandList, Append) {
+  CommandList first;
+  first.setLineWidth(2.0f);
+
+  CommandList second;
+  std::vector<vk::Buffer> buffers {makeBuffer(1u), makeBuffer(2u)};
+  std::vector<vk::DeviceSize> offsets {0u, 256u};
+  second.bindVertexBuffers(0u, buffers, offsets);
+  second.endRenderPass();
+
+  first.append(second);
+  ASSERT_EQ(first.size(), 3u);
+
+  auto it = first.begin();
+  ASSERT_EQ((*it).get<CommandList::SetLineWidth>().lineWidth, 2.0f);
+
+  ++it;
+  const auto& bind = (*it).get<CommandList::BindVertexBuffers>();
+  ASSERT_EQ(bind.buffers.count, 2u);
+  ASSERT_EQ((*it).data(bind.offsets)[1], 256u);
+
+  ++it;
+  ASSERT_EQ((*it).type(), CommandType::eEndRenderPass);
+  ASSERT_EQ(++it, first.end());
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "logi/command/command_state_cache.hpp"
+
+namespace {
+
+vk::Pipeline makePipeline(uintptr_t id) {
+  return vk::Pipeline(reinterpret_cast<VkPipeline>(id));
+}
+
+vk::PipelineLayout makePipelineLayout(uintptr_t id) {
+  return vk::PipelineLayout(reinterpret_cast<VkPipelineLayout>(id));
+}
+
+vk::DescriptorSet makeDescriptorSet(uintptr_t id) {
+  return vk::DescriptorSet(reinterpret_cast<VkDescriptorSet>(id));
+}
+
+vk::Buffer makeBuffer(uintptr_t id) {
+  return vk::Buffer(reinterpret_cast<VkBuffer>(id));
+}
+
+} // namespace
+
+TEST(CommandStateCache, ElidesRepeatedPipelineBinds) {
+  logi::CommandStateCache cache;
+  vk::Pipeline pipelineA = makePipeline(1u);
+  vk::Pipeline pipelineB = makePipeline(2u);
+
+  ASSERT_TRUE(cache.bindPipeline(vk::PipelineBindPoint::eGraphics, pipelineA));
+  ASSERT_FALSE(cache.bindPipeline(vk::PipelineBindPoint::eGraphics, pipelineA));
+  ASSERT_TRUE(cache.bindPipeline(vk::PipelineBindPoint::eCompute, pipelineA));
+  ASSERT_TRUE(cache.bindPipeline(vk::PipelineBindPoint::eGraphics, pipelineB));
+  ASSERT_TRUE(cache.bindPipeline(vk::PipelineBindPoint::eGraphics, pipelineA));
+
+  const logi::StateCacheStatistics& statistics = cache.getStatistics();
+  ASSERT_EQ(statistics.filteredCalls, 5u);
+  ASSERT_EQ(statistics.elidedCalls, 1u);
+  ASSERT_EQ(statistics.elidedPipelineBinds, 1u);
+}
+
+TEST(CommandStateCache, PipelineChangeForgetsDynamicState) {
+  logi::CommandStateCache cache;
+  vk::Viewport viewport;
+  viewport.width = 1920.0f;
+  viewport.height = 1080.0f;
+
+  cache.bindPipeline(vk::PipelineBindPoint::eGraphics, makePipeline(1u));
+  ASSERT_TRUE(cache.setViewport(0u, viewport));
+  ASSERT_FALSE(cache.setViewport(0u, viewport));
+  ASSERT_TRUE(cache.setLineWidth(1.0f));
+  ASSERT_FALSE(cache.setLineWidth(1.0f));
+
+  // Rebinding the same pipeline keeps the state.
+  cache.bindPipeline(vk::PipelineBindPoint::eGraphics, makePipeline(1u));
+  ASSERT_FALSE(cache.setViewport(0u, viewport));
+
+  // Compute pipelines do not affect graphics dynamic state.
+  cache.bindPipeline(vk::PipelineBindPoint::eCompute, makePipeline(3u));
+  ASSERT_FALSE(cache.setLineWidth(1.0f));
+
+  cache.bindPipeline(vk::PipelineBindPoint::eGraphics, makePipeline(2u));
+  ASSERT_TRUE(cache.setViewport(0u, viewport));
+  ASSERT_TRUE(cache.setLineWidth(1.0f));
+  ASSERT_EQ(cache.getStatistics().elidedDynamicStates, 4u);
+}
+
+TEST(CommandStateCache, DescriptorSets) {
+  logi::CommandStateCache cache;
+  vk::PipelineLayout layoutA = makePipelineLayout(1u);
+  vk::PipelineLayout layoutB = makePipelineLayout(2u);
+  std::vector<vk::DescriptorSet> sets = {makeDescriptorSet(10u), makeDescriptorSet(11u)};
+
+  ASSERT_TRUE(cache.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, layoutA, 0u, sets, {}));
+  ASSERT_FALSE(cache.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, layoutA, 0u, sets, {}));
+
+  // Subset of the bound sets.
+  ASSERT_FALSE(cache.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, layoutA, 1u, sets[1], {}));
+  ASSERT_TRUE(cache.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, layoutA, 1u, sets[0], {}));
+  ASSERT_TRUE(cache.bindDescriptorSets(vk::PipelineBindPoint::eCompute, layoutA, 0u, sets, {}));
+
+  // Different layout forgets the other sets.
+  ASSERT_TRUE(cache.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, layoutB, 1u, sets[0], {}));
+  ASSERT_TRUE(cache.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, layoutB, 0u, sets[0], {}));
+
+  // Dynamic offsets are compared per bind.
+  std::vector<uint32_t> offsets = {0u, 256u};
+  ASSERT_TRUE(cache.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, layoutA, 0u, sets, offsets));
+  ASSERT_FALSE(cache.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, layoutA, 0u, sets, offsets));
+  ASSERT_TRUE(cache.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, layoutA, 1u, sets[1], offsets[1]));
+  offsets[1] = 512u;
+  ASSERT_TRUE(cache.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, layoutA, 0u, sets, offsets));
+  ASSERT_TRUE(cache.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, layoutA, 0u, sets, {}));
+
+  ASSERT_EQ(cache.getStatistics().elidedDescriptorSetBinds, 3u);
+}
+
+TEST(CommandStateCache, BuffersAndStencil) {
+  logi::CommandStateCache cache;
+  std::vector<vk::Buffer> buffers = {makeBuffer(1u), makeBuffer(2u)};
+  std::vector<vk::DeviceSize> offsets = {0u, 64u};
+
+  ASSERT_TRUE(cache.bindVertexBuffers(0u, buffers, offsets));
+  ASSERT_FALSE(cache.bindVertexBuffers(0u, buffers, offsets));
+  ASSERT_FALSE(cache.bindVertexBuffers(1u, buffers[1], offsets[1]));
+  ASSERT_TRUE(cache.bindVertexBuffers(1u, buffers[1], offsets[0]));
+  ASSERT_TRUE(cache.bindVertexBuffers(2u, buffers[1], offsets[0]));
+
+  ASSERT_TRUE(cache.bindIndexBuffer(buffers[0], 0u, vk::IndexType::eUint16));
+  ASSERT_FALSE(cache.bindIndexBuffer(buffers[0], 0u, vk::IndexType::eUint16));
+  ASSERT_TRUE(cache.bindIndexBuffer(buffers[0], 0u, vk::IndexType::eUint32));
+
+  ASSERT_TRUE(cache.setStencilReference(vk::StencilFaceFlagBits::eFrontAndBack, 1u));
+  ASSERT_FALSE(cache.setStencilReference(vk::StencilFaceFlagBits::eFront, 1u));
+  ASSERT_TRUE(cache.setStencilReference(vk::StencilFaceFlagBits::eBack, 2u));
+  ASSERT_FALSE(cache.setStencilReference(vk::StencilFaceFlagBits::eFront, 1u));
+  ASSERT_TRUE(cache.setStencilReference(vk::StencilFaceFlagBits::eFrontAndBack, 1u));
+
+  cache.invalidate();
+  ASSERT_TRUE(cache.bindVertexBuffers(0u, buffers, offsets));
+  ASSERT_TRUE(cache.bindIndexBuffer(buffers[0], 0u, vk::IndexType::eUint32));
+
+  const logi::StateCacheStatistics& statistics = cache.getStatistics();
+  ASSERT_EQ(statistics.elidedBufferBinds, 3u);
+  ASSERT_EQ(statistics.elidedDynamicStates, 2u);
+  ASSERT_EQ(statistics.elidedCalls, 5u);
+}
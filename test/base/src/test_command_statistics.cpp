@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "logi/command/command_statistics.hpp"
+
+namespace {
+
+logi::CommandStatistics makeStatistics(uint64_t draws, uint64_t barriers, uint64_t copyBytes) {
+  logi::CommandStatistics statistics;
+  statistics.commandBuffers = 1u;
+  statistics.draws = draws;
+  statistics.barrierCommands = barriers > 0u ? 1u : 0u;
+  statistics.barriers = barriers;
+  statistics.copies = copyBytes > 0u ? 1u : 0u;
+  statistics.copyBytes = copyBytes;
+  return statistics;
+}
+
+vk::CommandBuffer makeCommandBuffer(uintptr_t id) {
+  return vk::CommandBuffer(reinterpret_cast<VkCommandBuffer>(id));
+}
+
+} // namespace
+
+TEST(CommandStatistics, EmptyByDefault) {
+  logi::CommandStatistics statistics;
+  ASSERT_EQ(statistics.commandBuffers, 0u);
+  ASSERT_EQ(statistics.draws, 0u);
+  ASSERT_EQ(statistics.dispatches, 0u);
+  ASSERT_EQ(statistics.barriers, 0u);
+  ASSERT_EQ(statistics.copyBytes, 0u);
+}
+
+TEST(CommandStatistics, AccumulateSubmitsIntoFrame) {
+  logi::CommandStatistics frame;
+  frame += makeStatistics(10u, 2u, 0u);
+  frame += makeStatistics(5u, 0u, 256u);
+
+  ASSERT_EQ(frame.commandBuffers, 2u);
+  ASSERT_EQ(frame.draws, 15u);
+  ASSERT_EQ(frame.barrierCommands, 1u);
+  ASSERT_EQ(frame.barriers, 2u);
+  ASSERT_EQ(frame.copies, 1u);
+  ASSERT_EQ(frame.copyBytes, 256u);
+}
+
+TEST(CommandStatistics, AddLeavesOperandsUnchanged) {
+  logi::CommandStatistics lhs = makeStatistics(1u, 3u, 0u);
+  logi::CommandStatistics rhs = makeStatistics(2u, 0u, 64u);
+  logi::CommandStatistics sum = lhs + rhs;
+
+  ASSERT_EQ(sum.draws, 3u);
+  ASSERT_EQ(sum.barriers, 3u);
+  ASSERT_EQ(sum.copyBytes, 64u);
+  ASSERT_EQ(lhs.draws, 1u);
+  ASSERT_EQ(rhs.draws, 2u);
+}
+
+TEST(CommandStatistics, SubmitIncludesExecutedSecondaries) {
+  logi::CommandStatisticsRegistry registry;
+  vk::CommandBuffer primaryHandle = makeCommandBuffer(1u);
+  std::vector<vk::CommandBuffer> secondaryHandles {makeCommandBuffer(2u), makeCommandBuffer(3u)};
+
+  logi::CommandStatistics primary = makeStatistics(0u, 1u, 0u);
+  logi::CommandStatistics secondaries[2] = {makeStatistics(100u, 0u, 0u), makeStatistics(50u, 2u, 0u)};
+  registry.add(primaryHandle, primary);
+  registry.add(secondaryHandles[0], secondaries[0]);
+  registry.add(secondaryHandles[1], secondaries[1]);
+
+  // Same as CommandBuffer::executeCommands recorded into the primary command buffer.
+  registry.accumulate(secondaryHandles, primary);
+
+  logi::CommandStatistics submit;
+  vk::SubmitInfo submitInfo(0u, nullptr, nullptr, 1u, &primaryHandle);
+  registry.accumulate(submitInfo, submit);
+
+  ASSERT_EQ(submit.commandBuffers, 3u);
+  ASSERT_EQ(submit.draws, 150u);
+  ASSERT_EQ(submit.barrierCommands, 2u);
+  ASSERT_EQ(submit.barriers, 3u);
+
+  // Removed command buffers are no longer counted.
+  registry.remove(primaryHandle);
+  logi::CommandStatistics removed;
+  registry.accumulate(submitInfo, removed);
+  ASSERT_EQ(removed.commandBuffers, 0u);
+}
@@ -0,0 +1,264 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "logi/base/vulkan_object.hpp"
+
+namespace {
+
+std::atomic<size_t> freeCount {0u};
+
+class ChildImpl : public logi::VulkanObject {
+ public:
+  explicit ChildImpl(size_t value) : value(value) {}
+
+  size_t value;
+
+ protected:
+  void free() override {
+    freeCount++;
+    VulkanObject::free();
+  }
+};
+
+class ParentImpl : public logi::VulkanObject, public logi::VulkanObjectComposite<ChildImpl> {
+ public:
+  const std::shared_ptr<ChildImpl>& createChild(size_t value) {
+    return createObject(value);
+  }
+
+  void destroyChild(size_t id) {
+    destroyObject(id);
+  }
+
+  void destroyChildren(const std::vector<size_t>& ids) {
+    destroyObjects(ids);
+  }
+
+  void destroyChildIf(size_t id, const ChildImpl& expected) {
+    destroyObjectIf(id, [&expected](const ChildImpl& child) { return &child == &expected; });
+  }
+
+  void destroyChildrenIf(const std::vector<size_t>& ids, const std::vector<const ChildImpl*>& expected) {
+    destroyObjectsIf(ids, [&expected](size_t i, const ChildImpl& child) { return &child == expected[i]; });
+  }
+
+  void destroyChildren() {
+    destroyAllObjects();
+  }
+};
+
+constexpr size_t kThreadCount = 8u;
+constexpr size_t kIterations = 20000u;
+
+} // namespace
+
+TEST(CompositeThreading, ConcurrentCreateDestroy) {
+  freeCount = 0u;
+  ParentImpl parent;
+  std::atomic<size_t> created {0u};
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0u; t < kThreadCount; t++) {
+    threads.emplace_back([&parent, &created, t]() {
+      std::vector<size_t> ids;
+
+      for (size_t i = 0u; i < kIterations; i++) {
+        const std::shared_ptr<ChildImpl>& child = parent.createChild(t * kIterations + i);
+        size_t id = child->id();
+        created++;
+
+        ASSERT_EQ(parent.getObject(id)->value, t * kIterations + i);
+        ids.emplace_back(id);
+
+        // Destroy every other object immediately, keep the rest for the final teardown.
+        if (i % 2u == 0u) {
+          parent.destroyChild(ids.back());
+          ids.pop_back();
+        }
+      }
+    });
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(parent.getHandles().size(), created - freeCount);
+  parent.destroyChildren();
+  ASSERT_EQ(freeCount, created.load());
+  ASSERT_TRUE(parent.getHandles().empty());
+}
+
+TEST(CompositeThreading, RacingDestroyFreesOnce) {
+  freeCount = 0u;
+  ParentImpl parent;
+
+  for (size_t i = 0u; i < 1000u; i++) {
+    size_t id = parent.createChild(i)->id();
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0u; t < 4u; t++) {
+      threads.emplace_back([&parent, id]() { parent.destroyChild(id); });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+
+  ASSERT_EQ(freeCount, 1000u);
+  ASSERT_TRUE(parent.getHandles().empty());
+}
+
+TEST(CompositeThreading, ConcurrentBulkDestroy) {
+  freeCount = 0u;
+  ParentImpl parent;
+  std::vector<size_t> ids;
+  for (size_t i = 0u; i < 10000u; i++) {
+    ids.emplace_back(parent.createChild(i)->id());
+  }
+
+  // Overlapping id sets, every object must be freed exactly once.
+  std::vector<std::thread> threads;
+  for (size_t t = 0u; t < 4u; t++) {
+    threads.emplace_back([&parent, &ids]() { parent.destroyChildren(ids); });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(freeCount, ids.size());
+  ASSERT_TRUE(parent.getHandles().empty());
+}
+
+TEST(CompositeThreading, ConcurrentLookup) {
+  ParentImpl parent;
+  std::vector<size_t> ids;
+  for (size_t i = 0u; i < 1000u; i++) {
+    ids.emplace_back(parent.createChild(i)->id());
+  }
+
+  std::atomic<bool> running {true};
+  std::thread writer([&parent, &running]() {
+    while (running) {
+      parent.destroyChild(parent.createChild(0u)->id());
+    }
+  });
+
+  std::vector<std::thread> readers;
+  for (size_t t = 0u; t < 4u; t++) {
+    readers.emplace_back([&parent, &ids]() {
+      for (size_t round = 0u; round < 100u; round++) {
+        for (size_t i = 0u; i < ids.size(); i++) {
+          ASSERT_TRUE(parent.hasObject(ids[i]));
+          ASSERT_EQ(parent.getObject(ids[i])->value, i);
+        }
+      }
+    });
+  }
+
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+  running = false;
+  writer.join();
+
+  parent.destroyChildren();
+}
+
+namespace {
+
+class OtherChildImpl : public logi::VulkanObject {};
+
+class MultiParentImpl : public logi::VulkanObject,
+                        public logi::VulkanObjectComposite<ChildImpl>,
+                        public logi::VulkanObjectComposite<OtherChildImpl> {
+ public:
+  const std::shared_ptr<ChildImpl>& createChild(size_t value) {
+    return VulkanObjectComposite<ChildImpl>::createObject(value);
+  }
+
+  const std::shared_ptr<OtherChildImpl>& createOtherChild() {
+    return VulkanObjectComposite<OtherChildImpl>::createObject();
+  }
+
+  void destroyOtherChild(size_t id) {
+    VulkanObjectComposite<OtherChildImpl>::destroyObject(id);
+  }
+
+  bool hasChild(size_t id) const {
+    return VulkanObjectComposite<ChildImpl>::hasObject(id);
+  }
+
+  bool hasOtherChild(size_t id) const {
+    return VulkanObjectComposite<OtherChildImpl>::hasObject(id);
+  }
+
+  void destroyChildren() {
+    VulkanObjectComposite<ChildImpl>::destroyAllObjects();
+    VulkanObjectComposite<OtherChildImpl>::destroyAllObjects();
+  }
+};
+
+} // namespace
+
+TEST(CompositeThreading, KeysAreLocalToComposite) {
+  freeCount = 0u;
+  MultiParentImpl parent;
+  size_t childId = parent.createChild(7u)->id();
+  size_t otherId = parent.createOtherChild()->id();
+
+  // Keys are slot keys of each composite, so objects of different types share them. Destroying an object must go
+  // through the composite of its own type (e.g. DeferredOperationKHRImpl::destroy must not destroy an event).
+  ASSERT_EQ(childId, otherId);
+  parent.destroyOtherChild(otherId);
+  ASSERT_FALSE(parent.hasOtherChild(otherId));
+  ASSERT_TRUE(parent.hasChild(childId));
+  ASSERT_EQ(freeCount, 0u);
+
+  parent.destroyChildren();
+  ASSERT_EQ(freeCount, 1u);
+}
+
+namespace {
+
+class DerivedChildImpl : public ChildImpl {
+ public:
+  using ChildImpl::ChildImpl;
+};
+
+class DerivedParentImpl : public logi::VulkanObject, public logi::VulkanObjectComposite<DerivedChildImpl> {
+ public:
+  const std::shared_ptr<DerivedChildImpl>& createChild(size_t value) {
+    return createObject(value);
+  }
+
+  void destroyChildren() {
+    destroyAllObjects();
+  }
+};
+
+} // namespace
+
+TEST(CompositeThreading, DerivedHandleThroughWrongParent) {
+  freeCount = 0u;
+  ParentImpl parent;
+  DerivedParentImpl derivedParent;
+  const std::shared_ptr<ChildImpl>& child = parent.createChild(1u);
+  std::shared_ptr<ChildImpl> derived = derivedParent.createChild(2u);
+
+  // Handle of the derived type is accepted by the parent of the base type (e.g. LogicalDevice::destroyBuffer with a
+  // VMABuffer) and its key matches the key of the parent's own object.
+  ASSERT_EQ(derived->id(), child->id());
+  parent.destroyChildIf(derived->id(), *derived);
+  parent.destroyChildrenIf({derived->id()}, {derived.get()});
+  ASSERT_TRUE(parent.hasObject(child->id()));
+  ASSERT_EQ(freeCount, 0u);
+
+  parent.destroyChildIf(child->id(), *child);
+  ASSERT_EQ(freeCount, 1u);
+
+  derivedParent.destroyChildren();
+  ASSERT_EQ(freeCount, 2u);
+}
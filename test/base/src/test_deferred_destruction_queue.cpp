@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "logi/base/deferred_destruction_queue.hpp"
+
+TEST(DeferredDestructionQueue, CollectRetired) {
+  logi::DeferredDestructionQueue queue;
+  std::vector<int> destroyed;
+
+  queue.enqueue(3u, [&destroyed]() { destroyed.emplace_back(3); });
+  queue.enqueue(1u, [&destroyed]() { destroyed.emplace_back(1); });
+  queue.enqueue(2u, [&destroyed]() { destroyed.emplace_back(2); });
+  queue.enqueue(2u, [&destroyed]() { destroyed.emplace_back(2); });
+
+  ASSERT_EQ(queue.collect(0u), 0u);
+  ASSERT_EQ(queue.size(), 4u);
+
+  ASSERT_EQ(queue.collect(2u), 3u);
+  ASSERT_EQ(destroyed, (std::vector<int> {1, 2, 2}));
+  ASSERT_EQ(queue.size(), 1u);
+
+  ASSERT_EQ(queue.flush(), 1u);
+  ASSERT_EQ(destroyed.back(), 3);
+  ASSERT_EQ(queue.size(), 0u);
+}
+
+TEST(DeferredDestructionQueue, ReentrantEnqueue) {
+  logi::DeferredDestructionQueue queue;
+  bool childDestroyed = false;
+
+  // Destroying an object may defer destruction of another one.
+  queue.enqueue(1u, [&queue, &childDestroyed]() {
+    queue.enqueue(2u, [&childDestroyed]() { childDestroyed = true; });
+  });
+
+  ASSERT_EQ(queue.collect(1u), 1u);
+  ASSERT_FALSE(childDestroyed);
+  ASSERT_EQ(queue.collect(2u), 1u);
+  ASSERT_TRUE(childDestroyed);
+}
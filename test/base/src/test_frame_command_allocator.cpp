@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "logi/base/exception.hpp"
+#include "logi/command/frame_command_allocator.hpp"
+
+TEST(FrameCommandAllocator, RejectsZeroFramesInFlight) {
+  // Validated before any command pool is created, so no device is needed.
+  ASSERT_THROW(logi::FrameCommandAllocator(logi::QueueFamily(), 0u), logi::IllegalInvocation);
+}
+
+TEST(FrameCommandAllocator, RejectsEmptyCommandPools) {
+  ASSERT_THROW(logi::FrameCommandAllocator(std::vector<logi::CommandPool>()), logi::IllegalInvocation);
+}
+
+TEST(FrameCommandAllocator, CyclesFrames) {
+  // Frames without recorded commands or submits are neither reset nor waited on, so empty pools suffice.
+  logi::FrameCommandAllocator allocator(std::vector<logi::CommandPool>(3u));
+  ASSERT_EQ(allocator.getFramesInFlight(), 3u);
+
+  // The first frame is frame 0, after which the frames are reused in order.
+  ASSERT_EQ(allocator.beginFrame(), 0u);
+  ASSERT_EQ(allocator.getFrameIndex(), 0u);
+  ASSERT_EQ(allocator.beginFrame(), 1u);
+  ASSERT_EQ(allocator.beginFrame(), 2u);
+  ASSERT_EQ(allocator.beginFrame(), 0u);
+  ASSERT_EQ(allocator.getFrameIndex(), 0u);
+  ASSERT_EQ(allocator.getCommandBufferCount(), 0u);
+}
+
+TEST(FrameCommandAllocator, WithoutFrames) {
+  logi::FrameCommandAllocator allocator;
+  ASSERT_EQ(allocator.beginFrame(), 0u);
+  ASSERT_THROW(allocator.allocateCommandBuffer(), logi::IllegalInvocation);
+  allocator.endFrame(logi::Fence());
+
+  logi::FrameCommandAllocator destroyed(std::vector<logi::CommandPool>(2u));
+  destroyed.beginFrame();
+  destroyed.endFrame(logi::Fence());
+  destroyed.destroy();
+
+  ASSERT_EQ(destroyed.getFramesInFlight(), 0u);
+  ASSERT_EQ(destroyed.beginFrame(), 0u);
+  ASSERT_EQ(destroyed.beginFrame(), 0u);
+  ASSERT_THROW(destroyed.allocateCommandBuffer(), logi::IllegalInvocation);
+  destroyed.endFrame(logi::Semaphore(), 1u);
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "logi/synchronization/gpu_future.hpp"
+
+namespace {
+
+vk::Semaphore makeSemaphore(uintptr_t id) {
+  return vk::Semaphore(reinterpret_cast<VkSemaphore>(id));
+}
+
+/**
+ * @brief Timeline whose counter is advanced by the test instead of the GPU. Waiting completes the awaited values.
+ */
+struct FakeTimeline {
+  explicit FakeTimeline(uintptr_t id)
+    : timeline(std::make_shared<logi::GpuTimeline>(
+        makeSemaphore(id), [this]() { return counter.load(); },
+        [this](const vk::SemaphoreWaitInfo& waitInfo, uint64_t timeout) { return wait(waitInfo, timeout); })) {}
+
+  vk::Result wait(const vk::SemaphoreWaitInfo& waitInfo, uint64_t timeout) {
+    waitInfos.emplace_back(waitInfo.semaphoreCount);
+    if (timeout == 0u) {
+      return vk::Result::eTimeout;
+    }
+
+    for (uint32_t i = 0u; i < waitInfo.semaphoreCount; i++) {
+      if (waitInfo.pSemaphores[i] == timeline->getSemaphore()) {
+        counter = std::max(counter.load(), waitInfo.pValues[i]);
+      }
+    }
+    return vk::Result::eSuccess;
+  }
+
+  std::atomic<uint64_t> counter {0u};
+  std::vector<uint32_t> waitInfos;
+  std::shared_ptr<logi::GpuTimeline> timeline;
+};
+
+} // namespace
+
+TEST(GpuFuture, DefaultIsReady) {
+  logi::GpuFuture future;
+  bool executed = false;
+
+  ASSERT_FALSE(future.isValid());
+  ASSERT_TRUE(future.isReady());
+  ASSERT_EQ(future.wait(0u), vk::Result::eSuccess);
+
+  future.then([&executed]() { executed = true; });
+  ASSERT_TRUE(executed);
+}
+
+TEST(GpuFuture, ReadyAfterCounterPassesValue) {
+  FakeTimeline fake(1u);
+  logi::GpuFuture first(fake.timeline, fake.timeline->allocateValue());
+  logi::GpuFuture second(fake.timeline, fake.timeline->allocateValue());
+
+  ASSERT_FALSE(first.isReady());
+  fake.counter = 1u;
+  ASSERT_TRUE(first.isReady());
+  ASSERT_FALSE(second.isReady());
+
+  ASSERT_EQ(second.wait(0u), vk::Result::eTimeout);
+  ASSERT_EQ(second.wait(), vk::Result::eSuccess);
+  ASSERT_TRUE(second.isReady());
+}
+
+TEST(GpuFuture, WhenAllKeepsHighestValuePerTimeline) {
+  FakeTimeline a(1u);
+  FakeTimeline b(2u);
+
+  uint64_t a1 = a.timeline->allocateValue();
+  uint64_t a2 = a.timeline->allocateValue();
+  uint64_t b1 = b.timeline->allocateValue();
+
+  logi::GpuFuture all = logi::GpuFuture::whenAll(
+    {logi::GpuFuture(a.timeline, a2), logi::GpuFuture(b.timeline, b1), logi::GpuFuture(a.timeline, a1)});
+
+  std::vector<vk::Semaphore> semaphores;
+  std::vector<uint64_t> values;
+  all.appendWaitSemaphores(semaphores, values);
+
+  ASSERT_EQ(semaphores, (std::vector<vk::Semaphore> {a.timeline->getSemaphore(), b.timeline->getSemaphore()}));
+  ASSERT_EQ(values, (std::vector<uint64_t> {a2, b1}));
+
+  a.counter = a1;
+  b.counter = b1;
+  ASSERT_FALSE(all.isReady());
+  a.counter = a2;
+  ASSERT_TRUE(all.isReady());
+
+  // Waiting on a combined future waits on all of its semaphores at once.
+  logi::GpuFuture pending = logi::GpuFuture::whenAll(
+    {logi::GpuFuture(a.timeline, a.timeline->allocateValue()),
+     logi::GpuFuture(b.timeline, b.timeline->allocateValue())});
+  ASSERT_EQ(pending.wait(), vk::Result::eSuccess);
+  ASSERT_EQ(a.waitInfos.back(), 2u);
+}
+
+TEST(GpuFuture, ThenOnMultipleTimelinesRunsOnce) {
+  FakeTimeline a(1u);
+  FakeTimeline b(2u);
+  int executed = 0;
+
+  logi::GpuFuture all = logi::GpuFuture::whenAll(
+    {logi::GpuFuture(a.timeline, a.timeline->allocateValue()),
+     logi::GpuFuture(b.timeline, b.timeline->allocateValue())});
+  all.then([&executed]() { executed++; });
+
+  ASSERT_EQ(a.timeline->getPendingContinuationCount(), 1u);
+  ASSERT_EQ(b.timeline->getPendingContinuationCount(), 1u);
+
+  a.counter = 1u;
+  a.timeline->poll();
+  ASSERT_EQ(executed, 0);
+
+  // Polling again must not count the completed timeline twice.
+  a.timeline->poll();
+  ASSERT_EQ(executed, 0);
+
+  b.counter = 1u;
+  b.timeline->poll();
+  ASSERT_EQ(executed, 1);
+
+  a.timeline->poll();
+  b.timeline->poll();
+  ASSERT_EQ(executed, 1);
+  ASSERT_EQ(a.timeline->getPendingContinuationCount(), 0u);
+  ASSERT_EQ(b.timeline->getPendingContinuationCount(), 0u);
+}
+
+TEST(GpuFuture, FlushExecutesPendingContinuations) {
+  FakeTimeline fake(1u);
+  bool executed = false;
+
+  logi::GpuFuture(fake.timeline, fake.timeline->allocateValue()).then([&executed]() { executed = true; });
+  ASSERT_FALSE(executed);
+
+  ASSERT_EQ(fake.timeline->flush(), 1u);
+  ASSERT_TRUE(executed);
+  ASSERT_EQ(fake.timeline->getPendingContinuationCount(), 0u);
+}
+
+TEST(GpuFuture, ConcurrentPollNeverMovesBackwards) {
+  constexpr uint64_t kValueCount = 2000u;
+  constexpr size_t kPollerCount = 4u;
+
+  FakeTimeline fake(1u);
+  std::atomic<uint64_t> executed {0u};
+  std::atomic<bool> outOfOrder {false};
+
+  for (uint64_t i = 0u; i < kValueCount; i++) {
+    uint64_t value = fake.timeline->allocateValue();
+    fake.timeline->then(value, [&fake, &executed, &outOfOrder, value]() {
+      if (fake.counter.load() < value) {
+        outOfOrder = true;
+      }
+      executed++;
+    });
+  }
+
+  std::atomic<bool> done {false};
+  std::vector<std::thread> pollers;
+  for (size_t i = 0u; i < kPollerCount; i++) {
+    pollers.emplace_back([&fake, &done, &outOfOrder]() {
+      uint64_t lastCompleted = 0u;
+      while (!done.load()) {
+        uint64_t completed = fake.timeline->poll();
+        if (completed < lastCompleted) {
+          outOfOrder = true;
+        }
+        lastCompleted = completed;
+      }
+    });
+  }
+
+  for (uint64_t value = 1u; value <= kValueCount; value++) {
+    fake.counter = value;
+    if (value % 64u == 0u) {
+      std::this_thread::yield();
+    }
+  }
+
+  done = true;
+  for (std::thread& thread : pollers) {
+    thread.join();
+  }
+  fake.timeline->poll();
+
+  ASSERT_FALSE(outOfOrder.load());
+  ASSERT_EQ(executed.load(), kValueCount);
+  ASSERT_TRUE(fake.timeline->isComplete(kValueCount));
+  ASSERT_EQ(fake.timeline->getPendingContinuationCount(), 0u);
+}
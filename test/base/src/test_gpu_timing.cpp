@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "logi/base/exception.hpp"
+#include "logi/query/gpu_profiler.hpp"
+#include "logi/query/gpu_timing.hpp"
+
+TEST(GpuClockCalibration, ElapsedTicksWrapAround) {
+  logi::GpuClockCalibration calibration(1.0f, 36u);
+  uint64_t mask = (uint64_t(1u) << 36u) - 1u;
+
+  ASSERT_EQ(calibration.elapsedTicks(100u, 250u), 150u);
+  ASSERT_EQ(calibration.elapsedTicks(mask - 9u, 20u), 30u);
+
+  logi::GpuClockCalibration fullRange(1.0f, 64u);
+  ASSERT_EQ(fullRange.elapsedTicks(~uint64_t(0u) - 4u, 5u), 10u);
+}
+
+TEST(GpuClockCalibration, ToNanoseconds) {
+  logi::GpuClockCalibration calibration(2.5f, 64u);
+  ASSERT_DOUBLE_EQ(calibration.toNanoseconds(400u), 1000.0);
+}
+
+TEST(GpuClockCalibration, ToHostNanoseconds) {
+  logi::GpuClockCalibration calibration(2.0f, 32u);
+  ASSERT_FALSE(calibration.isCalibrated());
+
+  calibration.calibrate(1000u, 5000000u, 30u);
+  ASSERT_TRUE(calibration.isCalibrated());
+  ASSERT_EQ(calibration.getMaxDeviation(), 30u);
+
+  ASSERT_EQ(calibration.toHostNanoseconds(1500u), 5001000);
+  // Timestamps written before the calibration map to earlier host times.
+  ASSERT_EQ(calibration.toHostNanoseconds(500u), 4999000);
+
+  // Calibration point close to the wrap around of the valid bits.
+  calibration.calibrate(0xFFFFFFF0u, 5000000u);
+  ASSERT_EQ(calibration.toHostNanoseconds(0x10u), 5000064);
+}
+
+TEST(GpuZoneStatistics, RollingWindow) {
+  logi::GpuZoneStatistics statistics(3u);
+  ASSERT_EQ(statistics.getSampleCount(), 0u);
+  ASSERT_DOUBLE_EQ(statistics.getAverage(), 0.0);
+
+  statistics.addSample(1.0);
+  statistics.addSample(2.0);
+  statistics.addSample(3.0);
+  ASSERT_DOUBLE_EQ(statistics.getAverage(), 2.0);
+  ASSERT_DOUBLE_EQ(statistics.getMin(), 1.0);
+  ASSERT_DOUBLE_EQ(statistics.getMax(), 3.0);
+
+  // Oldest sample is replaced.
+  statistics.addSample(7.0);
+  ASSERT_EQ(statistics.getSampleCount(), 3u);
+  ASSERT_EQ(statistics.getTotalSampleCount(), 4u);
+  ASSERT_DOUBLE_EQ(statistics.getLast(), 7.0);
+  ASSERT_DOUBLE_EQ(statistics.getAverage(), 4.0);
+  ASSERT_DOUBLE_EQ(statistics.getMin(), 2.0);
+  ASSERT_DOUBLE_EQ(statistics.getMax(), 7.0);
+}
+
+TEST(GpuProfiler, RejectsZeroFramesInFlight) {
+  // Validated before the queue family is accessed, so no device is needed.
+  ASSERT_THROW(logi::GpuProfiler(logi::QueueFamily(), 0u), logi::IllegalInvocation);
+}
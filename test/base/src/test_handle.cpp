@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include "logi/base/handle.hpp"
+#include "logi/base/vulkan_object.hpp"
+
+namespace {
+
+class ObjectImpl : public logi::VulkanObject, public std::enable_shared_from_this<ObjectImpl> {
+ public:
+  explicit ObjectImpl(int value) : value(value) {}
+
+  int value;
+};
+
+class Object : public logi::Handle<ObjectImpl> {
+ public:
+  using Handle::Handle;
+
+  int value() const {
+    return object_->value;
+  }
+};
+
+} // namespace
+
+TEST(Handle, RefDoesNotShareOwnership) {
+  auto impl = std::make_shared<ObjectImpl>(5);
+  Object object(impl);
+  ASSERT_TRUE(object.owning());
+  ASSERT_EQ(impl.use_count(), 2);
+
+  logi::HandleRef<Object> ref(object);
+  logi::HandleRef<Object> copy = ref;
+  ASSERT_EQ(impl.use_count(), 2);
+  ASSERT_FALSE(ref->owning());
+  ASSERT_TRUE(static_cast<bool>(copy));
+  ASSERT_EQ(copy->value(), 5);
+  ASSERT_EQ(ref, logi::HandleRef<Object>(object));
+  ASSERT_EQ(ref.lock(), object);
+  ASSERT_EQ(ref, copy);
+}
+
+TEST(Handle, RefLock) {
+  auto impl = std::make_shared<ObjectImpl>(7);
+  logi::HandleRef<Object> ref(*impl);
+
+  Object locked = ref.lock();
+  ASSERT_TRUE(locked.owning());
+  ASSERT_EQ(impl.use_count(), 2);
+  ASSERT_EQ(locked.value(), 7);
+
+  logi::HandleRef<Object> null;
+  ASSERT_FALSE(static_cast<bool>(null));
+  ASSERT_FALSE(null.lock().owning());
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "logi/base/mpsc_ring.hpp"
+
+TEST(MpscRing, PushPopInOrder) {
+  logi::MpscRing<int> ring(3u);
+  ASSERT_EQ(ring.capacity(), 4u);
+
+  for (int i = 0; i < 4; i++) {
+    int value = i;
+    ASSERT_TRUE(ring.tryPush(std::move(value)));
+  }
+
+  int value = 4;
+  ASSERT_FALSE(ring.tryPush(std::move(value)));
+  ASSERT_EQ(value, 4);
+
+  for (int i = 0; i < 4; i++) {
+    ASSERT_TRUE(ring.tryPop(value));
+    ASSERT_EQ(value, i);
+  }
+  ASSERT_FALSE(ring.tryPop(value));
+}
+
+TEST(MpscRing, MultipleProducers) {
+  constexpr size_t kProducerCount = 4u;
+  constexpr size_t kValueCount = 10000u;
+  logi::MpscRing<size_t> ring(64u);
+
+  std::vector<std::thread> producers;
+  for (size_t producer = 0u; producer < kProducerCount; producer++) {
+    producers.emplace_back([&ring, producer]() {
+      for (size_t i = 0u; i < kValueCount; i++) {
+        size_t value = producer * kValueCount + i;
+        while (!ring.tryPush(std::move(value))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // Values of each producer must arrive in the order in which they were pushed.
+  std::vector<size_t> next(kProducerCount, 0u);
+  size_t received = 0u;
+  while (received < kProducerCount * kValueCount) {
+    size_t value;
+    if (!ring.tryPop(value)) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    size_t producer = value / kValueCount;
+    ASSERT_EQ(value % kValueCount, next[producer]);
+    next[producer]++;
+    received++;
+  }
+
+  for (std::thread& thread : producers) {
+    thread.join();
+  }
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "logi/base/object_pool.hpp"
+
+namespace {
+
+struct PooledObject {
+  explicit PooledObject(int value) : value(value) {}
+
+  int value;
+  double payload[8] = {};
+};
+
+} // namespace
+
+TEST(ObjectPool, AllocateShared) {
+  auto pool = std::make_shared<logi::ObjectPool>(16u);
+  std::vector<std::shared_ptr<PooledObject>> objects;
+
+  for (int i = 0; i < 40; i++) {
+    objects.emplace_back(std::allocate_shared<PooledObject>(logi::PoolAllocator<PooledObject>(pool), i));
+  }
+
+  ASSERT_EQ(pool->allocatedBlocks(), 40u);
+  ASSERT_EQ(pool->capacity(), 48u);
+  for (int i = 0; i < 40; i++) {
+    ASSERT_EQ(objects[i]->value, i);
+  }
+
+  objects.clear();
+  ASSERT_EQ(pool->allocatedBlocks(), 0u);
+  ASSERT_EQ(pool->capacity(), 48u);
+}
+
+TEST(ObjectPool, BlocksAreReused) {
+  auto pool = std::make_shared<logi::ObjectPool>(4u);
+  logi::PoolAllocator<PooledObject> allocator(pool);
+
+  auto first = std::allocate_shared<PooledObject>(allocator, 1);
+  const void* address = first.get();
+  first.reset();
+
+  auto second = std::allocate_shared<PooledObject>(allocator, 2);
+  ASSERT_EQ(address, second.get());
+  ASSERT_EQ(pool->capacity(), 4u);
+}
+
+TEST(ObjectPool, PoolOutlivesOwner) {
+  std::shared_ptr<PooledObject> object;
+
+  {
+    auto pool = std::make_shared<logi::ObjectPool>();
+    object = std::allocate_shared<PooledObject>(logi::PoolAllocator<PooledObject>(pool), 7);
+  }
+
+  // Allocator held by the control block keeps the pool alive.
+  ASSERT_EQ(object->value, 7);
+  object.reset();
+}
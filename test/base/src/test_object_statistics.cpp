@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include "logi/base/object_statistics.hpp"
+#include "logi/base/vulkan_object.hpp"
+
+using namespace std::chrono_literals;
+
+TEST(ObjectStatistics, Counters) {
+  logi::ObjectCounters counters;
+
+  counters.recordCreate();
+  counters.recordCreate();
+  counters.recordCreate();
+  counters.recordDestroy(5ms);
+  counters.recordDestroy(2s);
+
+  logi::ObjectTypeStatistics statistics;
+  counters.accumulate(statistics);
+
+  ASSERT_EQ(statistics.liveCount, 1u);
+  ASSERT_EQ(statistics.peakCount, 3u);
+  ASSERT_EQ(statistics.createdCount, 3u);
+  ASSERT_EQ(statistics.destroyedCount, 2u);
+  ASSERT_EQ(statistics.ageHistogram[0], 1u);
+  ASSERT_EQ(statistics.ageHistogram[3], 1u);
+
+  // Counters of multiple parents are summed.
+  counters.accumulate(statistics);
+  ASSERT_EQ(statistics.liveCount, 2u);
+}
+
+TEST(ObjectStatistics, Rates) {
+  logi::ObjectRateTracker tracker;
+  auto start = std::chrono::steady_clock::now();
+
+  logi::ObjectStatistics first;
+  first.types.emplace_back();
+  first.types.back().typeName = "Buffer";
+  tracker.update(first, start);
+
+  logi::ObjectStatistics second = first;
+  second.types.back().createdCount = 200u;
+  second.types.back().destroyedCount = 50u;
+  tracker.update(second, start + 2s);
+
+  const logi::ObjectTypeStatistics* buffers = second.find("Buffer");
+  ASSERT_NE(buffers, nullptr);
+  ASSERT_DOUBLE_EQ(second.interval, 2.0);
+  ASSERT_DOUBLE_EQ(buffers->createRate, 100.0);
+  ASSERT_DOUBLE_EQ(buffers->destroyRate, 25.0);
+  ASSERT_EQ(second.find("Image"), nullptr);
+}
+
+TEST(ObjectStatistics, Json) {
+  logi::ObjectStatistics statistics;
+  statistics.types.emplace_back();
+  statistics.types.back().typeName = "Fence";
+  statistics.types.back().liveCount = 4u;
+
+  std::string json = statistics.toJson();
+  ASSERT_NE(json.find("\"type\":\"Fence\""), std::string::npos);
+  ASSERT_NE(json.find("\"live\":4"), std::string::npos);
+  ASSERT_NE(json.find("\"ageHistogram\":[0,0,0,0,0,0]"), std::string::npos);
+}
+
+#ifdef LOGI_ENABLE_OBJECT_STATISTICS
+namespace {
+
+class ChildImpl : public logi::VulkanObject {};
+
+class ParentImpl : public logi::VulkanObject, public logi::VulkanObjectComposite<ChildImpl> {
+ public:
+  size_t createChild() {
+    return createObject()->id();
+  }
+
+  void destroyChild(size_t id) {
+    destroyObject(id);
+  }
+};
+
+} // namespace
+
+TEST(ObjectStatistics, CompositeTracking) {
+  ParentImpl parent;
+  size_t a = parent.createChild();
+  parent.createChild();
+  parent.destroyChild(a);
+
+  logi::ObjectTypeStatistics statistics;
+  parent.getObjectCounters().accumulate(statistics);
+  ASSERT_EQ(statistics.liveCount, 1u);
+  ASSERT_EQ(statistics.peakCount, 2u);
+  ASSERT_EQ(statistics.destroyedCount, 1u);
+}
+#endif
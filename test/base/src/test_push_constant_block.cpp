@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <tuple>
+#include <vector>
+#include "logi/program/push_constant_block.hpp"
+
+namespace {
+
+using Push = std::tuple<vk::ShaderStageFlags, uint32_t, uint32_t>;
+
+std::vector<Push> split(const logi::PushConstantBlock& block, uint32_t offset, uint32_t size) {
+  std::vector<Push> pushes;
+  block.forEachSegment(offset, size, [&](vk::ShaderStageFlags stages, uint32_t segmentOffset, uint32_t segmentSize) {
+    pushes.emplace_back(stages, segmentOffset, segmentSize);
+  });
+  return pushes;
+}
+
+// Vertex stage uses the transform, fragment stage uses the transform tail and the color.
+logi::PushConstantBlock createBlock() {
+  return logi::PushConstantBlock(
+    {{"transform", 0u, 64u}, {"color", 64u, 16u}, {"unused", 80u, 16u}},
+    {vk::PushConstantRange(vk::ShaderStageFlagBits::eVertex, 0u, 64u),
+     vk::PushConstantRange(vk::ShaderStageFlagBits::eFragment, 48u, 32u)});
+}
+
+} // namespace
+
+TEST(PushConstantBlock, Segments) {
+  logi::PushConstantBlock block = createBlock();
+  ASSERT_EQ(block.getSize(), 80u);
+  ASSERT_EQ(block.getMemberIndex("color"), 1u);
+  ASSERT_THROW(block.getMemberIndex("missing"), logi::IllegalInvocation);
+
+  const std::vector<vk::PushConstantRange>& segments = block.getSegments();
+  ASSERT_EQ(segments.size(), 3u);
+  ASSERT_EQ(segments[0].stageFlags, vk::ShaderStageFlags(vk::ShaderStageFlagBits::eVertex));
+  ASSERT_EQ(segments[0].size, 48u);
+  ASSERT_EQ(segments[1].stageFlags, vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment);
+  ASSERT_EQ(segments[1].offset, 48u);
+  ASSERT_EQ(segments[1].size, 16u);
+  ASSERT_EQ(segments[2].stageFlags, vk::ShaderStageFlags(vk::ShaderStageFlagBits::eFragment));
+  ASSERT_EQ(segments[2].offset, 64u);
+}
+
+TEST(PushConstantBlock, SplitsPushesBySegments) {
+  logi::PushConstantBlock block = createBlock();
+
+  std::vector<Push> pushes = split(block, 0u, 80u);
+  ASSERT_EQ(pushes.size(), 3u);
+  ASSERT_EQ(pushes[1], Push(vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment, 48u, 16u));
+
+  pushes = split(block, 64u, 16u);
+  ASSERT_EQ(pushes.size(), 1u);
+  ASSERT_EQ(pushes[0], Push(vk::ShaderStageFlagBits::eFragment, 64u, 16u));
+
+  pushes = split(block, 40u, 16u);
+  ASSERT_EQ(pushes.size(), 2u);
+  ASSERT_EQ(pushes[0], Push(vk::ShaderStageFlagBits::eVertex, 40u, 8u));
+  ASSERT_EQ(pushes[1], Push(vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment, 48u, 8u));
+
+  // Member that is not used by any stage.
+  ASSERT_TRUE(split(block, 80u, 16u).empty());
+}
+
+TEST(PushConstantBlock, MergesEqualStages) {
+  logi::PushConstantBlock block({}, {vk::PushConstantRange(vk::ShaderStageFlagBits::eVertex, 0u, 16u),
+                                     vk::PushConstantRange(vk::ShaderStageFlagBits::eFragment, 0u, 16u)});
+  ASSERT_EQ(block.getSegments().size(), 1u);
+  ASSERT_EQ(block.getSegments()[0].stageFlags, vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment);
+}
+
+TEST(PushConstantData, TracksWrittenRange) {
+  logi::PushConstantBlock block = createBlock();
+  logi::PushConstantData data(block);
+  ASSERT_FALSE(data.isDirty());
+
+  float color[4] = {1.0f, 0.5f, 0.25f, 1.0f};
+  data.set("color", color);
+  ASSERT_TRUE(data.isDirty());
+  ASSERT_EQ(data.getDirtyOffset(), 64u);
+  ASSERT_EQ(data.getDirtySize(), 16u);
+  ASSERT_EQ(reinterpret_cast<const float*>(data.getData() + 64u)[1], 0.5f);
+
+  uint32_t value = 7u;
+  data.set(0u, value);
+  ASSERT_EQ(data.getDirtyOffset(), 0u);
+  ASSERT_EQ(data.getDirtySize(), 80u);
+
+  double tooLarge[3] = {};
+  ASSERT_THROW(data.set("color", tooLarge), logi::IllegalInvocation);
+
+  data.clearDirty();
+  ASSERT_FALSE(data.isDirty());
+  data.markDirty();
+  ASSERT_EQ(data.getDirtySize(), 80u);
+}
+
+TEST(PushConstantData, AlignsWrittenRange) {
+  logi::PushConstantBlock block = createBlock();
+  logi::PushConstantData data(block);
+
+  uint16_t half = 3u;
+  data.write(66u, sizeof(half), &half);
+  ASSERT_EQ(data.getDirtyOffset(), 64u);
+  ASSERT_EQ(data.getDirtySize(), 4u);
+
+  uint8_t byte = 1u;
+  data.write(73u, sizeof(byte), &byte);
+  ASSERT_EQ(data.getDirtyOffset(), 64u);
+  ASSERT_EQ(data.getDirtySize(), 12u);
+
+  // Block whose size is not a multiple of 4 is not pushed past its end.
+  logi::PushConstantBlock unaligned({}, {vk::PushConstantRange(vk::ShaderStageFlagBits::eVertex, 0u, 6u)});
+  logi::PushConstantData unalignedData(unaligned);
+  unalignedData.write(5u, sizeof(byte), &byte);
+  ASSERT_EQ(unalignedData.getDirtyOffset(), 4u);
+  ASSERT_EQ(unalignedData.getDirtySize(), 2u);
+
+  // Empty writes do not mark anything dirty.
+  data.clearDirty();
+  data.write(10u, 0u, &byte);
+  ASSERT_FALSE(data.isDirty());
+}
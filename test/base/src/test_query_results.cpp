@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "logi/base/exception.hpp"
+#include "logi/query/query_results.hpp"
+#include "logi/query/query_service.hpp"
+
+TEST(QueryResults, UnpackPipelineStatistics) {
+  vk::QueryPipelineStatisticFlags flags = vk::QueryPipelineStatisticFlagBits::eComputeShaderInvocations |
+                                          vk::QueryPipelineStatisticFlagBits::eVertexShaderInvocations |
+                                          vk::QueryPipelineStatisticFlagBits::eFragmentShaderInvocations;
+  ASSERT_EQ(logi::getPipelineStatisticCount(flags), 3u);
+
+  // Values are ordered by flag bit, not by the order the flags were combined in.
+  const uint64_t values[] = {100u, 2000u, 30u};
+  logi::PipelineStatistics statistics = logi::unpackPipelineStatistics(flags, values);
+  ASSERT_EQ(statistics.vertexShaderInvocations, 100u);
+  ASSERT_EQ(statistics.fragmentShaderInvocations, 2000u);
+  ASSERT_EQ(statistics.computeShaderInvocations, 30u);
+  ASSERT_EQ(statistics.inputAssemblyVertices, 0u);
+}
+
+TEST(QueryResults, PipelineStatisticsHistory) {
+  logi::PipelineStatisticsHistory history(2u);
+  ASSERT_EQ(history.getAverage().vertexShaderInvocations, 0u);
+
+  logi::PipelineStatistics sample;
+  sample.vertexShaderInvocations = 10u;
+  history.addSample(sample);
+  sample.vertexShaderInvocations = 20u;
+  history.addSample(sample);
+  ASSERT_EQ(history.getAverage().vertexShaderInvocations, 15u);
+
+  // Oldest sample is replaced.
+  sample.vertexShaderInvocations = 40u;
+  history.addSample(sample);
+  ASSERT_EQ(history.getSampleCount(), 2u);
+  ASSERT_EQ(history.getLast().vertexShaderInvocations, 40u);
+  ASSERT_EQ(history.getAverage().vertexShaderInvocations, 30u);
+}
+
+TEST(QueryResults, OcclusionCacheVisibility) {
+  logi::OcclusionCache cache;
+
+  // Unknown objects are visible.
+  ASSERT_TRUE(cache.isVisible(7u, 10u, 4u));
+  ASSERT_FALSE(cache.getSamples(7u).has_value());
+
+  cache.update(7u, 0u, 8u);
+  cache.update(9u, 64u, 8u);
+  ASSERT_FALSE(cache.isVisible(7u, 10u, 4u));
+  ASSERT_TRUE(cache.isVisible(9u, 10u, 4u));
+  ASSERT_EQ(cache.getSamples(9u).value(), 64u);
+
+  // Stale results are ignored.
+  ASSERT_TRUE(cache.isVisible(7u, 13u, 4u));
+
+  cache.update(9u, 1u, 12u);
+  cache.evict(10u);
+  ASSERT_EQ(cache.size(), 1u);
+  ASSERT_EQ(cache.getSamples(9u).value(), 1u);
+}
+
+TEST(QueryService, RejectsZeroFramesInFlight) {
+  // Validated before any query pool or readback buffer is created, so no device is needed.
+  ASSERT_THROW(logi::QueryService(logi::MemoryAllocator(), 0u), logi::IllegalInvocation);
+}
@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+#include "logi/render_graph/render_graph_plan.hpp"
+
+using logi::RenderGraphAccess;
+using logi::RenderGraphAttachment;
+using logi::RenderGraphPassDescription;
+using logi::RenderGraphPlan;
+using logi::RenderGraphResource;
+using logi::RenderGraphResourceDescription;
+using logi::ResourceUsage;
+
+namespace {
+
+class GraphBuilder {
+ public:
+  RenderGraphResource image(const std::string& name) {
+    RenderGraphResourceDescription description;
+    description.name = name;
+    description.image.format = vk::Format::eR8G8B8A8Unorm;
+    resources.emplace_back(description);
+    return RenderGraphResource {static_cast<uint32_t>(resources.size() - 1u)};
+  }
+
+  RenderGraphResource backbuffer() {
+    RenderGraphResource resource = image("backbuffer");
+    resources.back().imported = true;
+    resources.back().initialAccess =
+      logi::ResourceAccess {vk::PipelineStageFlagBits::eColorAttachmentOutput, {}, vk::ImageLayout::eUndefined};
+    resources.back().finalUsage = ResourceUsage::ePresent;
+    return resource;
+  }
+
+  RenderGraphPassDescription& pass(const std::string& name) {
+    passes.emplace_back();
+    passes.back().name = name;
+    return passes.back();
+  }
+
+  static void access(RenderGraphPassDescription& pass, RenderGraphResource resource, ResourceUsage usage) {
+    RenderGraphAccess access;
+    access.resource = resource;
+    access.usage = usage;
+    pass.accesses.emplace_back(access);
+  }
+
+  static void colorAttachment(RenderGraphPassDescription& pass, RenderGraphResource resource,
+                              vk::AttachmentLoadOp loadOp = vk::AttachmentLoadOp::eClear) {
+    RenderGraphAttachment attachment;
+    attachment.resource = resource;
+    attachment.loadOp = loadOp;
+    pass.colorAttachments.emplace_back(attachment);
+    access(pass, resource, ResourceUsage::eColorAttachment);
+  }
+
+  void compile(RenderGraphPlan& plan) const {
+    plan.compile(resources, passes, [](uint32_t) {
+      vk::MemoryRequirements requirements;
+      requirements.size = 1024u;
+      requirements.alignment = 256u;
+      requirements.memoryTypeBits = 1u;
+      return requirements;
+    });
+  }
+
+  std::vector<RenderGraphResourceDescription> resources;
+  std::vector<RenderGraphPassDescription> passes;
+};
+
+std::vector<uint32_t> scheduledPasses(const RenderGraphPlan& plan) {
+  std::vector<uint32_t> order;
+  for (const logi::RenderGraphScheduledPass& pass : plan.getPasses()) {
+    order.emplace_back(pass.pass);
+  }
+  return order;
+}
+
+} // namespace
+
+TEST(RenderGraph, CullsUnusedPasses) {
+  GraphBuilder graph;
+  RenderGraphResource backbuffer = graph.backbuffer();
+  RenderGraphResource unused = graph.image("unused");
+
+  GraphBuilder::colorAttachment(graph.pass("unused"), unused);
+  GraphBuilder::colorAttachment(graph.pass("present"), backbuffer);
+
+  RenderGraphPlan plan;
+  graph.compile(plan);
+
+  ASSERT_EQ(plan.getCulledPassCount(), 1u);
+  ASSERT_EQ(scheduledPasses(plan), std::vector<uint32_t>({1u}));
+  ASSERT_FALSE(plan.getLifetime(unused.index).used());
+  ASSERT_EQ(plan.getAliasSlot(unused.index), RenderGraphPlan::kNoAliasSlot);
+}
+
+TEST(RenderGraph, OrdersIndependentPassesBetweenProducerAndConsumer) {
+  GraphBuilder graph;
+  RenderGraphResource backbuffer = graph.backbuffer();
+  RenderGraphResource shadow = graph.image("shadow");
+  RenderGraphResource blurred = graph.image("blurred");
+  RenderGraphResource ao = graph.image("ao");
+
+  GraphBuilder::colorAttachment(graph.pass("shadow"), shadow);
+  RenderGraphPassDescription& blur = graph.pass("blur");
+  GraphBuilder::access(blur, shadow, ResourceUsage::eFragmentShaderRead);
+  GraphBuilder::colorAttachment(blur, blurred);
+  GraphBuilder::colorAttachment(graph.pass("ao"), ao);
+  RenderGraphPassDescription& lighting = graph.pass("lighting");
+  GraphBuilder::access(lighting, blurred, ResourceUsage::eFragmentShaderRead);
+  GraphBuilder::access(lighting, ao, ResourceUsage::eFragmentShaderRead);
+  GraphBuilder::colorAttachment(lighting, backbuffer);
+
+  RenderGraphPlan plan;
+  graph.compile(plan);
+
+  ASSERT_EQ(plan.getCulledPassCount(), 0u);
+  ASSERT_EQ(scheduledPasses(plan), std::vector<uint32_t>({0u, 2u, 1u, 3u}));
+}
+
+TEST(RenderGraph, AliasesDisjointTransients) {
+  GraphBuilder graph;
+  RenderGraphResource backbuffer = graph.backbuffer();
+  RenderGraphResource first = graph.image("first");
+  RenderGraphResource second = graph.image("second");
+  RenderGraphResource third = graph.image("third");
+
+  // first: [0, 1], second: [1, 2], third: [2, 3]
+  GraphBuilder::colorAttachment(graph.pass("0"), first);
+  RenderGraphPassDescription& pass1 = graph.pass("1");
+  GraphBuilder::access(pass1, first, ResourceUsage::eFragmentShaderRead);
+  GraphBuilder::colorAttachment(pass1, second);
+  RenderGraphPassDescription& pass2 = graph.pass("2");
+  GraphBuilder::access(pass2, second, ResourceUsage::eFragmentShaderRead);
+  GraphBuilder::colorAttachment(pass2, third);
+  RenderGraphPassDescription& pass3 = graph.pass("3");
+  GraphBuilder::access(pass3, third, ResourceUsage::eFragmentShaderRead);
+  GraphBuilder::colorAttachment(pass3, backbuffer);
+
+  RenderGraphPlan plan;
+  graph.compile(plan);
+
+  ASSERT_EQ(plan.getAliasSlots().size(), 2u);
+  ASSERT_EQ(plan.getAliasSlot(first.index), plan.getAliasSlot(third.index));
+  ASSERT_NE(plan.getAliasSlot(first.index), plan.getAliasSlot(second.index));
+  ASSERT_EQ(plan.getAliasSlot(backbuffer.index), RenderGraphPlan::kNoAliasSlot);
+  ASSERT_EQ(plan.getImageUsage(first.index),
+            vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eSampled);
+
+  // Third resource reuses the memory of the first one and must wait for its last read.
+  const logi::ResourceBarriers& barriers = plan.getPasses()[2].barriers.barriers;
+  ASSERT_TRUE(barriers.srcStageMask & vk::PipelineStageFlagBits::eFragmentShader);
+}
+
+TEST(RenderGraph, Barriers) {
+  GraphBuilder graph;
+  RenderGraphResource backbuffer = graph.backbuffer();
+  RenderGraphResource color = graph.image("color");
+
+  GraphBuilder::colorAttachment(graph.pass("scene"), color);
+  RenderGraphPassDescription& post = graph.pass("post");
+  GraphBuilder::access(post, color, ResourceUsage::eFragmentShaderRead);
+  GraphBuilder::colorAttachment(post, backbuffer);
+
+  RenderGraphPlan plan;
+  graph.compile(plan);
+  ASSERT_EQ(plan.getPasses().size(), 2u);
+
+  // Transient starts undefined and waits for its uses in the previous execution.
+  const logi::RenderGraphBarriers& scene = plan.getPasses()[0].barriers;
+  ASSERT_EQ(scene.barriers.imageBarriers.size(), 1u);
+  ASSERT_EQ(scene.imageResources[0], color.index);
+  ASSERT_EQ(scene.barriers.imageBarriers[0].oldLayout, vk::ImageLayout::eUndefined);
+  ASSERT_EQ(scene.barriers.imageBarriers[0].newLayout, vk::ImageLayout::eColorAttachmentOptimal);
+  ASSERT_TRUE(scene.barriers.srcStageMask & vk::PipelineStageFlagBits::eFragmentShader);
+
+  const logi::RenderGraphBarriers& postBarriers = plan.getPasses()[1].barriers;
+  ASSERT_EQ(postBarriers.barriers.imageBarriers.size(), 2u);
+  for (size_t i = 0u; i < postBarriers.imageResources.size(); i++) {
+    const vk::ImageMemoryBarrier& barrier = postBarriers.barriers.imageBarriers[i];
+    if (postBarriers.imageResources[i] == color.index) {
+      ASSERT_EQ(barrier.oldLayout, vk::ImageLayout::eColorAttachmentOptimal);
+      ASSERT_EQ(barrier.newLayout, vk::ImageLayout::eShaderReadOnlyOptimal);
+      ASSERT_EQ(barrier.srcAccessMask, vk::AccessFlags(vk::AccessFlagBits::eColorAttachmentWrite));
+    } else {
+      ASSERT_EQ(postBarriers.imageResources[i], backbuffer.index);
+      ASSERT_EQ(barrier.oldLayout, vk::ImageLayout::eUndefined);
+    }
+  }
+  ASSERT_TRUE(postBarriers.barriers.srcStageMask & vk::PipelineStageFlagBits::eColorAttachmentOutput);
+
+  const logi::RenderGraphBarriers& final = plan.getFinalBarriers();
+  ASSERT_EQ(final.barriers.imageBarriers.size(), 1u);
+  ASSERT_EQ(final.imageResources[0], backbuffer.index);
+  ASSERT_EQ(final.barriers.imageBarriers[0].newLayout, vk::ImageLayout::ePresentSrcKHR);
+}
+
+TEST(RenderGraph, AdjacentBufferRangesOfDifferentBuffers) {
+  GraphBuilder graph;
+  RenderGraphResource backbuffer = graph.backbuffer();
+  RenderGraphResource buffers[2];
+  for (RenderGraphResource& buffer : buffers) {
+    RenderGraphResourceDescription description;
+    description.type = logi::RenderGraphResourceType::eBuffer;
+    description.buffer.size = 256u;
+    description.imported = true;
+    description.initialAccess = logi::getResourceAccess(ResourceUsage::eComputeShaderWrite);
+    graph.resources.emplace_back(description);
+    buffer = RenderGraphResource {static_cast<uint32_t>(graph.resources.size() - 1u)};
+  }
+
+  // Range of the second buffer starts where the range of the first one ends.
+  RenderGraphPassDescription& pass = graph.pass("read");
+  for (uint32_t i = 0u; i < 2u; i++) {
+    RenderGraphAccess access;
+    access.resource = buffers[i];
+    access.usage = ResourceUsage::eFragmentShaderRead;
+    access.offset = i * 128u;
+    access.size = 128u;
+    pass.accesses.emplace_back(access);
+  }
+  GraphBuilder::colorAttachment(pass, backbuffer);
+
+  RenderGraphPlan plan;
+  graph.compile(plan);
+
+  const logi::RenderGraphBarriers& barriers = plan.getPasses()[0].barriers;
+  ASSERT_EQ(barriers.barriers.bufferBarriers.size(), 2u);
+  for (uint32_t i = 0u; i < 2u; i++) {
+    ASSERT_EQ(barriers.bufferResources[i], buffers[i].index);
+    ASSERT_EQ(barriers.barriers.bufferBarriers[i].offset, i * 128u);
+    ASSERT_EQ(barriers.barriers.bufferBarriers[i].size, 128u);
+  }
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include "logi/synchronization/resource_state.hpp"
+
+using logi::BufferState;
+using logi::ImageState;
+using logi::ResourceBarriers;
+using logi::ResourceUsage;
+using logi::getResourceAccess;
+
+namespace {
+
+const vk::ImageSubresourceRange kWholeImage(vk::ImageAspectFlagBits::eColor, 0u, VK_REMAINING_MIP_LEVELS, 0u,
+                                            VK_REMAINING_ARRAY_LAYERS);
+
+vk::Image testImage() {
+  return vk::Image(reinterpret_cast<VkImage>(1u));
+}
+
+vk::Buffer testBuffer() {
+  return vk::Buffer(reinterpret_cast<VkBuffer>(1u));
+}
+
+} // namespace
+
+TEST(ResourceState, ImageUploadMergesSubresources) {
+  ImageState image(testImage(), vk::ImageAspectFlagBits::eColor, 4u, 2u, vk::ImageLayout::eUndefined);
+  ResourceBarriers barriers;
+
+  image.transition(kWholeImage, getResourceAccess(ResourceUsage::eTransferDst), false, barriers);
+  ASSERT_EQ(barriers.imageBarriers.size(), 1u);
+
+  const vk::ImageMemoryBarrier& barrier = barriers.imageBarriers[0];
+  ASSERT_EQ(barrier.oldLayout, vk::ImageLayout::eUndefined);
+  ASSERT_EQ(barrier.newLayout, vk::ImageLayout::eTransferDstOptimal);
+  ASSERT_EQ(barrier.srcAccessMask, vk::AccessFlags());
+  ASSERT_EQ(barrier.dstAccessMask, vk::AccessFlags(vk::AccessFlagBits::eTransferWrite));
+  ASSERT_EQ(barrier.subresourceRange.levelCount, 4u);
+  ASSERT_EQ(barrier.subresourceRange.layerCount, 2u);
+  ASSERT_EQ(barriers.srcStageMask, vk::PipelineStageFlags(vk::PipelineStageFlagBits::eTopOfPipe));
+  ASSERT_EQ(barriers.dstStageMask, vk::PipelineStageFlags(vk::PipelineStageFlagBits::eTransfer));
+}
+
+TEST(ResourceState, ReadAfterWrite) {
+  ImageState image(testImage(), vk::ImageAspectFlagBits::eColor, 1u, 1u, vk::ImageLayout::eUndefined);
+  ResourceBarriers barriers;
+
+  image.transition(kWholeImage, getResourceAccess(ResourceUsage::eTransferDst), false, barriers);
+  barriers.clear();
+
+  image.transition(kWholeImage, getResourceAccess(ResourceUsage::eFragmentShaderRead), false, barriers);
+  ASSERT_EQ(barriers.imageBarriers.size(), 1u);
+  ASSERT_EQ(barriers.imageBarriers[0].srcAccessMask, vk::AccessFlags(vk::AccessFlagBits::eTransferWrite));
+  ASSERT_EQ(barriers.imageBarriers[0].newLayout, vk::ImageLayout::eShaderReadOnlyOptimal);
+  barriers.clear();
+
+  // Same read again is already synchronized.
+  image.transition(kWholeImage, getResourceAccess(ResourceUsage::eFragmentShaderRead), false, barriers);
+  ASSERT_TRUE(barriers.empty());
+
+  // Read in another stage still needs the write to be made visible.
+  image.transition(kWholeImage, getResourceAccess(ResourceUsage::eVertexShaderRead), false, barriers);
+  ASSERT_EQ(barriers.imageBarriers.size(), 1u);
+  ASSERT_EQ(barriers.imageBarriers[0].oldLayout, vk::ImageLayout::eShaderReadOnlyOptimal);
+  ASSERT_TRUE(barriers.dstStageMask & vk::PipelineStageFlagBits::eVertexShader);
+}
+
+TEST(ResourceState, WriteAfterReadIsExecutionDependency) {
+  BufferState buffer(testBuffer(), 1024u, true);
+  ResourceBarriers barriers;
+
+  buffer.transition(0u, VK_WHOLE_SIZE, getResourceAccess(ResourceUsage::eComputeShaderRead), barriers);
+  ASSERT_TRUE(barriers.empty());
+
+  buffer.transition(0u, VK_WHOLE_SIZE, getResourceAccess(ResourceUsage::eComputeShaderWrite), barriers);
+  ASSERT_EQ(barriers.bufferBarriers.size(), 1u);
+  ASSERT_EQ(barriers.bufferBarriers[0].srcAccessMask, vk::AccessFlags());
+  ASSERT_EQ(barriers.bufferBarriers[0].dstAccessMask, vk::AccessFlags());
+}
+
+TEST(ResourceState, BufferRanges) {
+  BufferState buffer(testBuffer(), 1024u, true);
+  ResourceBarriers barriers;
+
+  buffer.transition(0u, 256u, getResourceAccess(ResourceUsage::eComputeShaderWrite), barriers);
+  ASSERT_TRUE(barriers.empty());
+  ASSERT_EQ(buffer.getRangeCount(), 2u);
+
+  buffer.transition(0u, VK_WHOLE_SIZE, getResourceAccess(ResourceUsage::eVertexBuffer), barriers);
+  ASSERT_EQ(barriers.bufferBarriers.size(), 1u);
+  ASSERT_EQ(barriers.bufferBarriers[0].offset, 0u);
+  ASSERT_EQ(barriers.bufferBarriers[0].size, 256u);
+  ASSERT_EQ(barriers.bufferBarriers[0].srcAccessMask, vk::AccessFlags(vk::AccessFlagBits::eShaderWrite));
+  ASSERT_EQ(barriers.bufferBarriers[0].dstAccessMask, vk::AccessFlags(vk::AccessFlagBits::eVertexAttributeRead));
+}
+
+TEST(ResourceState, ReconcileFirstUse) {
+  ImageState resource(testImage(), vk::ImageAspectFlagBits::eColor, 1u, 1u, vk::ImageLayout::eUndefined);
+  ResourceBarriers barriers;
+  resource.transition(kWholeImage, getResourceAccess(ResourceUsage::eTransferDst), false, barriers);
+  barriers.clear();
+
+  // Command buffer does not know the state of the image, the first use is recorded without a barrier.
+  ImageState commandBuffer(testImage(), vk::ImageAspectFlagBits::eColor, 1u, 1u);
+  commandBuffer.transition(kWholeImage, getResourceAccess(ResourceUsage::eColorAttachment), false, barriers);
+  ASSERT_TRUE(barriers.empty());
+  commandBuffer.transition(kWholeImage, getResourceAccess(ResourceUsage::eFragmentShaderRead), false, barriers);
+  ASSERT_EQ(barriers.imageBarriers.size(), 1u);
+  ASSERT_EQ(barriers.imageBarriers[0].oldLayout, vk::ImageLayout::eColorAttachmentOptimal);
+  barriers.clear();
+
+  // Submission synchronizes the actual state with the first use.
+  resource.reconcile(commandBuffer, barriers);
+  ASSERT_EQ(barriers.imageBarriers.size(), 1u);
+  ASSERT_EQ(barriers.imageBarriers[0].oldLayout, vk::ImageLayout::eTransferDstOptimal);
+  ASSERT_EQ(barriers.imageBarriers[0].newLayout, vk::ImageLayout::eColorAttachmentOptimal);
+  ASSERT_EQ(barriers.imageBarriers[0].srcAccessMask, vk::AccessFlags(vk::AccessFlagBits::eTransferWrite));
+
+  ASSERT_EQ(resource.getSubresourceState(0u, 0u)->state.layout, vk::ImageLayout::eShaderReadOnlyOptimal);
+}
+
+TEST(ResourceState, ReconcileReadOnlyCommandBuffers) {
+  ImageState resource(testImage(), vk::ImageAspectFlagBits::eColor, 1u, 1u, vk::ImageLayout::eUndefined);
+  ResourceBarriers barriers;
+  resource.transition(kWholeImage, getResourceAccess(ResourceUsage::eTransferDst), false, barriers);
+  resource.transition(kWholeImage, getResourceAccess(ResourceUsage::eFragmentShaderRead), false, barriers);
+  barriers.clear();
+
+  // Command buffer that only reads in an already synchronized stage needs no barrier.
+  ImageState first(testImage(), vk::ImageAspectFlagBits::eColor, 1u, 1u);
+  first.transition(kWholeImage, getResourceAccess(ResourceUsage::eFragmentShaderRead), false, barriers);
+  resource.reconcile(first, barriers);
+  ASSERT_TRUE(barriers.empty());
+
+  // Read in a new stage must still be chained after the layout transition.
+  ImageState second(testImage(), vk::ImageAspectFlagBits::eColor, 1u, 1u);
+  second.transition(kWholeImage, getResourceAccess(ResourceUsage::eVertexShaderRead), false, barriers);
+  resource.reconcile(second, barriers);
+  ASSERT_EQ(barriers.imageBarriers.size(), 1u);
+  ASSERT_EQ(barriers.imageBarriers[0].oldLayout, vk::ImageLayout::eShaderReadOnlyOptimal);
+  ASSERT_EQ(barriers.srcStageMask, vk::PipelineStageFlags(vk::PipelineStageFlagBits::eFragmentShader));
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "logi/base/result.hpp"
+
+namespace {
+
+// Success codes used by SwapchainKHRImpl::acquireNextImageKHR and QueueImpl::presentKHR.
+vk::Result checkAcquire(vk::Result result) {
+  return logi::checkResult(
+    result, "acquire", {vk::Result::eSuccess, vk::Result::eTimeout, vk::Result::eNotReady, vk::Result::eSuboptimalKHR});
+}
+
+vk::Result checkPresent(vk::Result result) {
+  return logi::checkResult(result, "present", {vk::Result::eSuccess, vk::Result::eSuboptimalKHR});
+}
+
+} // namespace
+
+TEST(Result, SwapchainSuboptimalIsNotAnError) {
+  ASSERT_EQ(checkAcquire(vk::Result::eSuboptimalKHR), vk::Result::eSuboptimalKHR);
+  ASSERT_EQ(checkPresent(vk::Result::eSuboptimalKHR), vk::Result::eSuboptimalKHR);
+  ASSERT_EQ(checkAcquire(vk::Result::eTimeout), vk::Result::eTimeout);
+}
+
+TEST(Result, SwapchainOutOfDate) {
+#ifdef VULKAN_HPP_NO_EXCEPTIONS
+  ASSERT_EQ(checkAcquire(vk::Result::eErrorOutOfDateKHR), vk::Result::eErrorOutOfDateKHR);
+  ASSERT_EQ(checkPresent(vk::Result::eErrorOutOfDateKHR), vk::Result::eErrorOutOfDateKHR);
+#else
+  ASSERT_THROW(checkAcquire(vk::Result::eErrorOutOfDateKHR), vk::OutOfDateKHRError);
+  ASSERT_THROW(checkPresent(vk::Result::eErrorOutOfDateKHR), vk::OutOfDateKHRError);
+#endif
+}
+
+TEST(Result, SubmitFailure) {
+#ifdef VULKAN_HPP_NO_EXCEPTIONS
+  ASSERT_EQ(logi::checkResult(vk::Result::eSuccess, "submit"), vk::Result::eSuccess);
+  ASSERT_EQ(logi::checkResult(vk::Result::eErrorDeviceLost, "submit"), vk::Result::eErrorDeviceLost);
+#else
+  ASSERT_NO_THROW(logi::checkResult(vk::Result::eSuccess, "submit"));
+  ASSERT_THROW(logi::checkResult(vk::Result::eErrorDeviceLost, "submit"), vk::DeviceLostError);
+#endif
+}
+
+TEST(Result, MapMemory) {
+  uint64_t memory = 0u;
+  void* mapped = &memory;
+
+#ifdef VULKAN_HPP_NO_EXCEPTIONS
+  vk::ResultValue<void*> success = logi::checkResult(vk::Result::eSuccess, mapped, "map");
+  ASSERT_EQ(success.result, vk::Result::eSuccess);
+  ASSERT_EQ(success.value, &memory);
+
+  vk::ResultValue<void*> failure = logi::checkResult(vk::Result::eErrorMemoryMapFailed, mapped, "map");
+  ASSERT_EQ(failure.result, vk::Result::eErrorMemoryMapFailed);
+#else
+  ASSERT_EQ(logi::checkResult(vk::Result::eSuccess, mapped, "map"), &memory);
+  ASSERT_THROW(logi::checkResult(vk::Result::eErrorMemoryMapFailed, mapped, "map"), vk::MemoryMapFailedError);
+#endif
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <set>
+#include "logi/base/slot_map.hpp"
+
+TEST(SlotMap, InsertFindErase) {
+  logi::SlotMap<int> map;
+
+  auto a = map.insert(1);
+  auto b = map.insert(2);
+
+  ASSERT_EQ(map.size(), 2u);
+  ASSERT_NE(a, b);
+  ASSERT_EQ(*map.find(a), 1);
+  ASSERT_EQ(*map.find(b), 2);
+
+  ASSERT_EQ(map.erase(a), 1);
+  ASSERT_EQ(map.size(), 1u);
+  ASSERT_EQ(map.find(a), nullptr);
+  ASSERT_EQ(*map.find(b), 2);
+}
+
+TEST(SlotMap, StaleKeyDetection) {
+  logi::SlotMap<int> map;
+
+  auto a = map.insert(1);
+  map.erase(a);
+  auto b = map.insert(2);
+
+  // Slot is reused, but the generation differs.
+  ASSERT_EQ(logi::SlotMap<int>::keyIndex(a), logi::SlotMap<int>::keyIndex(b));
+  ASSERT_NE(a, b);
+  ASSERT_FALSE(map.contains(a));
+  ASSERT_EQ(map.erase(a), 0);
+  ASSERT_EQ(*map.find(b), 2);
+
+  map.clear();
+  ASSERT_FALSE(map.contains(b));
+  ASSERT_TRUE(map.empty());
+}
+
+TEST(SlotMap, StableReferences) {
+  logi::SlotMap<std::shared_ptr<int>> map;
+
+  auto key = map.insert(std::make_shared<int>(42));
+  const std::shared_ptr<int>* value = map.find(key);
+
+  std::vector<logi::SlotMap<std::shared_ptr<int>>::key_type> keys;
+  for (int i = 0; i < 10000; i++) {
+    keys.emplace_back(map.insert(std::make_shared<int>(i)));
+  }
+  for (size_t i = 0; i < keys.size(); i += 2) {
+    map.erase(keys[i]);
+  }
+
+  ASSERT_EQ(value, map.find(key));
+  ASSERT_EQ(**value, 42);
+}
+
+TEST(SlotMap, DenseIteration) {
+  logi::SlotMap<int> map;
+  std::vector<logi::SlotMap<int>::key_type> keys;
+
+  for (int i = 0; i < 1000; i++) {
+    keys.emplace_back(map.insert(i));
+  }
+  for (size_t i = 0; i < keys.size(); i += 3) {
+    map.erase(keys[i]);
+  }
+
+  std::set<int> visited;
+  map.forEach([&visited](int value) { visited.insert(value); });
+
+  ASSERT_EQ(visited.size(), map.size());
+  for (size_t i = 0; i < map.size(); i++) {
+    ASSERT_EQ(*map.find(map.keyAt(i)), map.at(i));
+    ASSERT_NE(map.at(i) % 3, 0);
+  }
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "logi/base/exception.hpp"
+#include "logi/queue/submit_batch_list.hpp"
+
+namespace {
+
+vk::CommandBuffer makeCommandBuffer(uintptr_t id) {
+  return vk::CommandBuffer(reinterpret_cast<VkCommandBuffer>(id));
+}
+
+vk::Semaphore makeSemaphore(uintptr_t id) {
+  return vk::Semaphore(reinterpret_cast<VkSemaphore>(id));
+}
+
+} // namespace
+
+TEST(SubmitBatchList, MergeSubmitsWithoutSemaphores) {
+  logi::SubmitBatchList list;
+  list.add(makeCommandBuffer(1u));
+  list.add(makeCommandBuffer(2u), {}, {}, makeSemaphore(10u));
+
+  ASSERT_EQ(list.size(), 1u);
+  const std::vector<vk::SubmitInfo>& submitInfos = list.build();
+  ASSERT_EQ(submitInfos.size(), 1u);
+  ASSERT_EQ(submitInfos[0].commandBufferCount, 2u);
+  ASSERT_EQ(submitInfos[0].pCommandBuffers[0], makeCommandBuffer(1u));
+  ASSERT_EQ(submitInfos[0].pCommandBuffers[1], makeCommandBuffer(2u));
+  ASSERT_EQ(submitInfos[0].signalSemaphoreCount, 1u);
+  ASSERT_EQ(list.getStatistics().enqueuedSubmits, 2u);
+  ASSERT_EQ(list.getStatistics().mergedSubmits, 1u);
+}
+
+TEST(SubmitBatchList, KeepSemaphoreOrdering) {
+  logi::SubmitBatchList list;
+  vk::PipelineStageFlags stage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+
+  // Signaling batch must not absorb later work and waiting batch must not be merged into earlier work.
+  list.add(makeCommandBuffer(1u), {}, {}, makeSemaphore(10u));
+  list.add(makeCommandBuffer(2u));
+  list.add(makeCommandBuffer(3u), makeSemaphore(10u), stage);
+
+  const std::vector<vk::SubmitInfo>& submitInfos = list.build();
+  ASSERT_EQ(submitInfos.size(), 3u);
+  ASSERT_EQ(submitInfos[2].waitSemaphoreCount, 1u);
+  ASSERT_EQ(submitInfos[2].pWaitSemaphores[0], makeSemaphore(10u));
+  ASSERT_EQ(submitInfos[2].pWaitDstStageMask[0], stage);
+  ASSERT_EQ(list.getStatistics().mergedSubmits, 0u);
+
+  ASSERT_THROW(list.add(makeCommandBuffer(4u), makeSemaphore(10u), {}), logi::IllegalInvocation);
+}
+
+TEST(SubmitBatchList, CopyTimelineValues) {
+  logi::SubmitBatchList list;
+  vk::Semaphore timeline = makeSemaphore(20u);
+  vk::PipelineStageFlags stage = vk::PipelineStageFlagBits::eTopOfPipe;
+  vk::CommandBuffer commandBuffer = makeCommandBuffer(1u);
+
+  {
+    uint64_t waitValue = 3u;
+    uint64_t signalValue = 4u;
+    vk::TimelineSemaphoreSubmitInfo timelineInfo(1u, &waitValue, 1u, &signalValue);
+    vk::SubmitInfo submitInfo(1u, &timeline, &stage, 1u, &commandBuffer, 1u, &timeline);
+    submitInfo.pNext = &timelineInfo;
+    list.add(submitInfo);
+  }
+  list.add(makeCommandBuffer(2u));
+
+  const std::vector<vk::SubmitInfo>& submitInfos = list.build();
+  ASSERT_EQ(submitInfos.size(), 2u);
+  ASSERT_EQ(submitInfos[1].pNext, nullptr);
+
+  auto* timelineInfo = static_cast<const vk::TimelineSemaphoreSubmitInfo*>(submitInfos[0].pNext);
+  ASSERT_NE(timelineInfo, nullptr);
+  ASSERT_EQ(timelineInfo->pWaitSemaphoreValues[0], 3u);
+  ASSERT_EQ(timelineInfo->pSignalSemaphoreValues[0], 4u);
+
+  list.clear();
+  ASSERT_TRUE(list.empty());
+  ASSERT_TRUE(list.build().empty());
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include "logi/base/trace_recorder.hpp"
+
+TEST(TraceRecorder, RecordsOnlyWhileRecording) {
+  logi::TraceRecorder recorder(16u);
+  recorder.recordComplete("ignored", "test", 0, 10);
+  ASSERT_TRUE(recorder.getEvents().empty());
+
+  recorder.start();
+  recorder.recordComplete("submit", "queue", 1000, 3500);
+  recorder.recordInstant("present", "queue", 4000);
+  recorder.stop();
+  recorder.recordInstant("ignored", "test", 5000);
+
+  std::vector<logi::TraceEvent> events = recorder.getEvents();
+  ASSERT_EQ(events.size(), 2u);
+  ASSERT_EQ(events[0].name, "submit");
+  ASSERT_EQ(events[0].phase, 'X');
+  ASSERT_EQ(events[0].duration, 2500);
+  ASSERT_EQ(events[1].name, "present");
+  ASSERT_EQ(events[1].phase, 'i');
+  ASSERT_EQ(events[0].track, events[1].track);
+  ASSERT_NE(events[0].track, logi::TraceRecorder::kGpuTrack);
+}
+
+TEST(TraceRecorder, RingBufferKeepsNewestEvents) {
+  logi::TraceRecorder recorder(3u);
+  recorder.start();
+  for (int64_t i = 0; i < 5; i++) {
+    recorder.recordComplete("event" + std::to_string(i), "test", i, i + 1);
+  }
+
+  std::vector<logi::TraceEvent> events = recorder.getEvents();
+  ASSERT_EQ(events.size(), 3u);
+  ASSERT_EQ(events[0].name, "event2");
+  ASSERT_EQ(events[2].name, "event4");
+  ASSERT_EQ(recorder.getOverwrittenEventCount(), 2u);
+
+  recorder.clear();
+  ASSERT_TRUE(recorder.getEvents().empty());
+}
+
+TEST(TraceRecorder, ThreadTracks) {
+  logi::TraceRecorder recorder;
+  recorder.start();
+  recorder.recordInstant("main", "test", 0);
+  std::thread([&recorder]() { recorder.recordInstant("worker", "test", 1); }).join();
+  recorder.recordComplete("gpu", "gpu", 0, 5, logi::TraceRecorder::kGpuTrack);
+
+  std::vector<logi::TraceEvent> events = recorder.getEvents();
+  ASSERT_EQ(events.size(), 3u);
+  ASSERT_NE(events[0].track, events[1].track);
+  ASSERT_EQ(events[2].track, logi::TraceRecorder::kGpuTrack);
+}
+
+TEST(TraceRecorder, ChromeTraceJson) {
+  logi::TraceRecorder recorder;
+  recorder.start();
+  recorder.recordComplete("draw \"main\"", "gpu", 1500, 4250, logi::TraceRecorder::kGpuTrack);
+
+  std::string json = recorder.exportChromeTrace();
+  ASSERT_NE(json.find("\"traceEvents\""), std::string::npos);
+  ASSERT_NE(json.find("\"name\":\"draw \\\"main\\\"\""), std::string::npos);
+  ASSERT_NE(json.find("\"ts\":1.500,\"dur\":2.750"), std::string::npos);
+  ASSERT_NE(json.find("\"tid\":0}"), std::string::npos);
+}
+
+TEST(TraceRecorder, Scope) {
+  logi::TraceRecorder recorder;
+  recorder.start();
+  {
+    logi::TraceScope scope(recorder, "scope", "test");
+  }
+
+  std::vector<logi::TraceEvent> events = recorder.getEvents();
+  ASSERT_EQ(events.size(), 1u);
+  ASSERT_EQ(events[0].name, "scope");
+  ASSERT_GE(events[0].duration, 0);
+}